@@ -18,12 +18,12 @@ namespace Modules {
 
 
 // Static member definitions
-std::unordered_map<std::string, CurlResponseData> CurlResponseWrapper::response_data_map_;
-std::unordered_map<std::string, std::unique_ptr<CurlClient>> CurlClientWrapper::client_map_;
-std::unordered_map<std::string, std::string> CurlClientWrapper::base_url_map_;
-std::unordered_map<std::string, Symbols::ObjectMap> CurlClientWrapper::default_headers_map_;
-std::unordered_map<std::string, int> CurlClientWrapper::timeout_map_;
-std::unordered_map<std::string, bool> CurlClientWrapper::follow_redirects_map_;
+thread_local std::unordered_map<std::string, CurlResponseData> CurlResponseWrapper::response_data_map_;
+thread_local std::unordered_map<std::string, std::unique_ptr<CurlClient>> CurlClientWrapper::client_map_;
+thread_local std::unordered_map<std::string, std::string> CurlClientWrapper::base_url_map_;
+thread_local std::unordered_map<std::string, Symbols::ObjectMap> CurlClientWrapper::default_headers_map_;
+thread_local std::unordered_map<std::string, int> CurlClientWrapper::timeout_map_;
+thread_local std::unordered_map<std::string, bool> CurlClientWrapper::follow_redirects_map_;
 
 // CurlClient implementation
 size_t CurlClient::write_callback(void * ptr, size_t size, size_t nmemb, void * userdata) {
@@ -74,7 +74,7 @@ class CurlClient {
 // CurlResponse wrapper class for VoidScript OOP interface
 class CurlResponseWrapper {
   private:
-    static std::unordered_map<std::string, CurlResponseData> response_data_map_;
+    static thread_local std::unordered_map<std::string, CurlResponseData> response_data_map_;
 
   public:
     static Symbols::ValuePtr construct(Symbols::FunctionArguments& args);
@@ -95,11 +95,11 @@ class CurlResponseWrapper {
 // CurlClient wrapper class for VoidScript OOP interface
 class CurlClientWrapper {
   private:
-    static std::unordered_map<std::string, std::unique_ptr<CurlClient>> client_map_;
-    static std::unordered_map<std::string, std::string> base_url_map_;
-    static std::unordered_map<std::string, Symbols::ObjectMap> default_headers_map_;
-    static std::unordered_map<std::string, int> timeout_map_;
-    static std::unordered_map<std::string, bool> follow_redirects_map_;
+    static thread_local std::unordered_map<std::string, std::unique_ptr<CurlClient>> client_map_;
+    static thread_local std::unordered_map<std::string, std::string> base_url_map_;
+    static thread_local std::unordered_map<std::string, Symbols::ObjectMap> default_headers_map_;
+    static thread_local std::unordered_map<std::string, int> timeout_map_;
+    static thread_local std::unordered_map<std::string, bool> follow_redirects_map_;
 
   public:
     // Constructors
@@ -3,6 +3,7 @@
 
 #include <fmt/args.h>
 
+#include "Interpreter/Output.hpp"
 #include "Symbols/RegistrationMacros.hpp"
 
 // Register module functions
@@ -30,7 +31,7 @@ void Modules::FormatModule::registerFunctions() {
                           for (const auto & arg : _args) {
                               store.push_back(arg.toString());
                           }
-                          std::cout << fmt::vformat(format, store);
+                          Interpreter::Output::out() << fmt::vformat(format, store);
                           return Symbols::ValuePtr::null();
                       });
 
@@ -21,10 +21,7 @@ namespace Modules {
 
 
 // Static member definitions
-std::unordered_map<std::string, std::unique_ptr<MariaDBClient>> MariaDBWrapper::connection_map_;
-
-// File-scope static flag to prevent multiple registrations
-static bool methodsRegistered = false;
+thread_local std::unordered_map<std::string, std::unique_ptr<MariaDBClient>> MariaDBWrapper::connection_map_;
 
 // MariaDBClient implementation
 MariaDBClient::MariaDBClient() : connection(nullptr), connected(false) {
@@ -176,13 +173,13 @@ Symbols::ValuePtr MariaDBClient::executeSelect(MYSQL_RES* result) {
         return Symbols::ValuePtr(empty_result, true);
     }
 
-    Symbols::ObjectMap result_map;
+    Symbols::ArrayVector rows;
     MYSQL_ROW row;
     MYSQL_FIELD* fields = mysql_fetch_fields(result);
     unsigned int num_fields = mysql_num_fields(result);
 
     // Process each row
-    int row_index = 0;
+    rows.reserve(mysql_num_rows(result));
     while ((row = mysql_fetch_row(result))) {
         Symbols::ObjectMap row_map;
 
@@ -193,12 +190,11 @@ Symbols::ValuePtr MariaDBClient::executeSelect(MYSQL_RES* result) {
             row_map[field_name] = Symbols::ValuePtr(field_value);
         }
 
-        result_map[std::to_string(row_index)] = Symbols::ValuePtr(row_map, true);
-        row_index++;
+        rows.emplace_back(Symbols::ValuePtr(row_map, true));
     }
 
     mysql_free_result(result);
-    return Symbols::ValuePtr(result_map, true);
+    return Symbols::ValuePtr(std::move(rows));
 }
 
 // MariaDBWrapper implementation
@@ -295,11 +291,8 @@ void MariaDBModule::registerFunctions() {
 }
 
 void MariaDBModule::registerOOPClasses() {
-    // Prevent multiple registrations
-    if (methodsRegistered) {
-        return;
-    }
-    methodsRegistered = true;
+    // No process-wide "already registered" flag: each thread has its own SymbolContainer, so
+    // duplicates are checked against the current container below.
 
     // Register MariaDBConnection class
     REGISTER_CLASS("MariaDBConnection");
@@ -91,7 +91,7 @@ private:
  */
 class MariaDBWrapper {
 private:
-    static std::unordered_map<std::string, std::unique_ptr<MariaDBClient>> connection_map_;
+    static thread_local std::unordered_map<std::string, std::unique_ptr<MariaDBClient>> connection_map_;
 
 public:
     static Symbols::ValuePtr construct(const std::vector<Symbols::ValuePtr>& args);
@@ -15,7 +15,7 @@ namespace Modules {
 
 
 // Static member definitions
-std::unordered_map<std::string, std::unique_ptr<MemcachedClient>> MemcachedConnectionWrapper::connection_map_;
+thread_local std::unordered_map<std::string, std::unique_ptr<MemcachedClient>> MemcachedConnectionWrapper::connection_map_;
 
 // MemcachedClient implementation
 MemcachedClient::MemcachedClient() : memc(nullptr), connected(false), servers("") {
@@ -61,7 +61,7 @@ private:
 // Connection wrapper for VoidScript OOP interface
 class MemcachedConnectionWrapper {
 private:
-    static std::unordered_map<std::string, std::unique_ptr<MemcachedClient>> connection_map_;
+    static thread_local std::unordered_map<std::string, std::unique_ptr<MemcachedClient>> connection_map_;
 
 public:
     static Symbols::ValuePtr construct(Symbols::FunctionArguments& args);
@@ -312,7 +312,7 @@ bool MongoDBModule::isConnected() const {
     return connection_ && connection_->isConnected();
 }
 
-bsoncxx::document::value MongoDBModule::convertToBSONDocument(const std::map<std::string, Symbols::ValuePtr>& document) {
+bsoncxx::document::value MongoDBModule::convertToBSONDocument(const Symbols::ObjectMap& document) {
     bsoncxx::builder::stream::document builder;
     for (const auto& [key, value] : document) {
         builder << key << Document::convertToBSONValue(value);
@@ -146,7 +146,7 @@ private:
     bool isConnected() const;
 
     // BSON conversion helpers
-    bsoncxx::document::value convertToBSONDocument(const std::map<std::string, Symbols::ValuePtr>& document);
+    bsoncxx::document::value convertToBSONDocument(const Symbols::ObjectMap& document);
     Symbols::ValuePtr convertFromBSONDocument(const bsoncxx::document::view& view);
 };
 
@@ -109,11 +109,12 @@ Symbols::ValuePtr readReply(RedisModule::Conn & c) {
             if (count < 0) {
                 return Symbols::ValuePtr::null();
             }
-            Symbols::ObjectMap arr;
+            Symbols::ArrayVector arr;
+            arr.reserve(static_cast<size_t>(count));
             for (long i = 0; i < count; ++i) {
-                arr[std::to_string(i)] = readReply(c);
+                arr.push_back(readReply(c));
             }
-            return Symbols::ValuePtr(arr);
+            return Symbols::ValuePtr(std::move(arr));
         }
         default:
             throw std::runtime_error(std::string("Redis: unexpected reply type '") + type + "'");
@@ -333,15 +334,21 @@ Symbols::ValuePtr RedisModule::commandFn(FunctionArguments & args) {
     if (args.size() != 2 || (args[1] != Symbols::Variables::Type::OBJECT && args[1] != Symbols::Variables::Type::CLASS)) {
         throw std::runtime_error("Redis::command expects (array words)");
     }
-    Conn &                   c   = connFor(args, "command");
-    const Symbols::ObjectMap & m = args[1]->get<Symbols::ObjectMap>();
+    Conn &                   c = connFor(args, "command");
     std::vector<std::string> parts;
-    for (size_t i = 0;; ++i) {
-        auto it = m.find(std::to_string(i));
-        if (it == m.end()) {
-            break;
+    if (args[1]->isArray()) {
+        for (const auto & word : args[1]->get<Symbols::ArrayVector>()) {
+            parts.push_back(word->toString());
+        }
+    } else {
+        const Symbols::ObjectMap & m = args[1]->get<Symbols::ObjectMap>();
+        for (size_t i = 0;; ++i) {
+            auto it = m.find(std::to_string(i));
+            if (it == m.end()) {
+                break;
+            }
+            parts.push_back(it->second->toString());
         }
-        parts.push_back(it->second->toString());
     }
     if (parts.empty()) {
         throw std::runtime_error("Redis::command: empty command");
@@ -126,14 +126,22 @@ void SQLiteModule::bindParams(sqlite3_stmt * stmt, FunctionArguments & args, siz
         args[paramArgIndex] != Symbols::Variables::Type::CLASS) {
         throw std::runtime_error(std::string("SQLite::") + method + ": params must be an array");
     }
-    const Symbols::ObjectMap & map = args[paramArgIndex]->get<Symbols::ObjectMap>();
-    for (size_t i = 0;; ++i) {
-        auto it = map.find(std::to_string(i));
-        if (it == map.end()) {
-            break;
+    Symbols::ArrayVector params;
+    if (args[paramArgIndex]->isArray()) {
+        params = args[paramArgIndex]->get<Symbols::ArrayVector>();
+    } else {
+        const Symbols::ObjectMap & map = args[paramArgIndex]->get<Symbols::ObjectMap>();
+        for (size_t i = 0;; ++i) {
+            auto it = map.find(std::to_string(i));
+            if (it == map.end()) {
+                break;
+            }
+            params.push_back(it->second);
         }
+    }
+    for (size_t i = 0; i < params.size(); ++i) {
         const int         idx = static_cast<int>(i) + 1;  // sqlite params are 1-based
-        Symbols::ValuePtr v   = it->second;
+        Symbols::ValuePtr v   = params[i];
         switch (v->getType()) {
             case Symbols::Variables::Type::INTEGER:
                 sqlite3_bind_int64(stmt, idx, v->get<int>());
@@ -203,9 +211,8 @@ Symbols::ValuePtr SQLiteModule::query(FunctionArguments & args) {
     }
     bindParams(stmt, args, 2, "query");
 
-    Symbols::ObjectMap rows;
-    int                rowIndex = 0;
-    int                rc;
+    Symbols::ArrayVector rows;
+    int                  rc;
     while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
         Symbols::ObjectMap row;
         const int          cols = sqlite3_column_count(stmt);
@@ -232,13 +239,13 @@ Symbols::ValuePtr SQLiteModule::query(FunctionArguments & args) {
                 }
             }
         }
-        rows[std::to_string(rowIndex++)] = Symbols::ValuePtr(row);
+        rows.emplace_back(row);
     }
     sqlite3_finalize(stmt);
     if (rc != SQLITE_DONE) {
         throw std::runtime_error(std::string("SQLite::query failed: ") + sqlite3_errmsg(db));
     }
-    return Symbols::ValuePtr(rows);
+    return Symbols::ValuePtr(std::move(rows));
 }
 
 Symbols::ValuePtr SQLiteModule::lastInsertId(FunctionArguments & args) {
@@ -1527,6 +1527,23 @@ Symbols::ValuePtr XmlModule::createXPathResultObject(std::unique_ptr<XmlXPathRes
     return Symbols::ValuePtr::makeClassInstance(objMap);
 }
 
+void XmlModule::releaseScriptResources() {
+    // Objects that point into documents go before the documents.
+    validatorHolder.clear();
+    xpathResultHolder.clear();
+    xpathHolder.clear();
+    nodeListHolder.clear();
+    nodeObjectHolder.clear();
+    schemaHolder.clear();
+    dtdHolder.clear();
+    documentHolder.clear();
+    nodeHolder.clear();
+    for (auto & [_, doc] : docHolder) {
+        xmlFreeDoc(doc);
+    }
+    docHolder.clear();
+}
+
 void XmlModule::registerFunctions() {
     registerLegacyMethods();
     registerDocumentMethods();
@@ -33,17 +33,17 @@ class XmlDtd;
 class XmlValidator;
 
 // Resource management for libxml2 objects
-inline static std::unordered_map<int, xmlDocPtr>  docHolder;
-inline static std::unordered_map<int, xmlNodePtr> nodeHolder;
-inline static std::unordered_map<int, std::unique_ptr<XmlDocument>> documentHolder;
-inline static std::unordered_map<int, std::unique_ptr<XmlNode>> nodeObjectHolder;
-inline static std::unordered_map<int, std::unique_ptr<XmlNodeList>> nodeListHolder;
-inline static std::unordered_map<int, std::unique_ptr<XmlXPath>> xpathHolder;
-inline static std::unordered_map<int, std::unique_ptr<XmlXPathResult>> xpathResultHolder;
-inline static std::unordered_map<int, std::unique_ptr<XmlSchema>> schemaHolder;
-inline static std::unordered_map<int, std::unique_ptr<XmlDtd>> dtdHolder;
-inline static std::unordered_map<int, std::unique_ptr<XmlValidator>> validatorHolder;
-static int nextDoc = 1;
+inline static thread_local std::unordered_map<int, xmlDocPtr>  docHolder;
+inline static thread_local std::unordered_map<int, xmlNodePtr> nodeHolder;
+inline static thread_local std::unordered_map<int, std::unique_ptr<XmlDocument>> documentHolder;
+inline static thread_local std::unordered_map<int, std::unique_ptr<XmlNode>> nodeObjectHolder;
+inline static thread_local std::unordered_map<int, std::unique_ptr<XmlNodeList>> nodeListHolder;
+inline static thread_local std::unordered_map<int, std::unique_ptr<XmlXPath>> xpathHolder;
+inline static thread_local std::unordered_map<int, std::unique_ptr<XmlXPathResult>> xpathResultHolder;
+inline static thread_local std::unordered_map<int, std::unique_ptr<XmlSchema>> schemaHolder;
+inline static thread_local std::unordered_map<int, std::unique_ptr<XmlDtd>> dtdHolder;
+inline static thread_local std::unordered_map<int, std::unique_ptr<XmlValidator>> validatorHolder;
+static thread_local int nextDoc = 1;
 
 /**
  * @brief RAII wrapper for XML documents with enhanced functionality
@@ -405,9 +405,15 @@ class XmlModule : public BaseModule {
      */
     void registerFunctions() override;
 
+    /**
+     * @brief Free every document, node and XPath object scripts created: the holders are
+     * per thread and would otherwise grow with each request that thread serves.
+     */
+    void releaseScriptResources() override;
+
     ~XmlModule() {
-        // Deliberately does NOT touch the holders. They are `inline static` (namespace
-        // lifetime) and are destroyed at program exit in an order unspecified relative
+        // Deliberately does NOT touch the holders. They are `inline static thread_local`
+        // and are destroyed at thread or program exit in an order unspecified relative
         // to this module's owner (SymbolContainer). This destructor runs via
         // ~SymbolContainer during exit handlers, and the holders had often already been
         // destroyed by then - iterating them here was a use-after-free (SIGSEGV at
@@ -0,0 +1,141 @@
+// Cost of leaving a function early: a script whose hot function returns from inside a
+// loop, and the two mechanisms the interpreter has used to carry that `return` out.
+//
+// Statements hand break, continue and return up as a ControlFlowSignal return value
+// (Interpreter/ControlFlowSignal.hpp). They used to be C++ exceptions, so every early
+// return paid a throw, an unwind through each enclosing statement and a catch.
+//
+//   control_flow_benchmark [--calls N] [--rounds N]
+//
+// Every row is normalised to nanoseconds per call. --rounds repeats the mechanism rows and
+// keeps the fastest, which damps scheduler noise. The script runs once: the symbol table is
+// process-wide, so a second run in the same process would start from the first one's state.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include "Interpreter/ControlFlowSignal.hpp"
+#include "VoidScript.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <typename Fn> double bestNsPerCall(int rounds, long calls, Fn && fn) {
+    double best = std::numeric_limits<double>::max();
+    for (int r = 0; r < rounds; ++r) {
+        const auto start = Clock::now();
+        fn();
+        const auto end = Clock::now();
+        best           = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    return best / static_cast<double>(calls);
+}
+
+// find() returns from the middle of its loop on every call; the loop cannot run on the
+// bytecode VM because of the return, so this is the tree walker's path.
+std::string earlyReturnScript(long calls) {
+    return "function find(int $limit) int {\n"
+           "    for (int $i = 0; $i < 100; $i++) {\n"
+           "        if ($i == $limit) {\n"
+           "            return $i;\n"
+           "        }\n"
+           "    }\n"
+           "    return -1;\n"
+           "}\n"
+           "int $sum = 0;\n"
+           "for (int $n = 0; $n < " +
+           std::to_string(calls) +
+           "; $n++) {\n"
+           "    $sum = $sum + find(4);\n"
+           "}\n"
+           "if ($sum != " +
+           std::to_string(calls * 4) +
+           ") {\n"
+           "    printnl(\"wrong sum: \", $sum);\n"
+           "}\n";
+}
+
+// The old mechanism reduced to its core: the value leaves by exception.
+struct ThrownReturn {
+    Symbols::ValuePtr value;
+};
+
+__attribute__((noinline)) void throwingBody(int i) {
+    if (i >= 0) {
+        throw ThrownReturn{ Symbols::ValuePtr(i) };
+    }
+}
+
+__attribute__((noinline)) Interpreter::ControlFlowSignal signallingBody(int i) {
+    if (i >= 0) {
+        return Interpreter::ControlFlowSignal::returnValue(Symbols::ValuePtr(i));
+    }
+    return {};
+}
+
+long parseLong(const char * text, const char * flag) {
+    char *     end   = nullptr;
+    const long value = std::strtol(text, &end, 10);
+    if (*end != '\0' || value <= 0) {
+        std::fprintf(stderr, "%s expects a positive integer\n", flag);
+        std::exit(2);
+    }
+    return value;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv) {
+    long calls  = 100000;
+    int  rounds = 3;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--calls") == 0 && i + 1 < argc) {
+            calls = parseLong(argv[++i], "--calls");
+        } else if (std::strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+            rounds = static_cast<int>(parseLong(argv[++i], "--rounds"));
+        } else {
+            std::fprintf(stderr, "usage: %s [--calls N] [--rounds N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    const std::string script = earlyReturnScript(calls);
+    int               status = 0;
+    const double      scriptNs = bestNsPerCall(1, calls, [&] {
+        VoidScript voidscript("control_flow_benchmark.vs");
+        voidscript.setScriptContent(script);
+        status |= voidscript.run();
+    });
+
+    long         sink     = 0;
+    const double throwNs  = bestNsPerCall(rounds, calls, [&] {
+        for (long i = 0; i < calls; ++i) {
+            try {
+                throwingBody(static_cast<int>(i & 0xff));
+            } catch (const ThrownReturn & ret) {
+                sink += ret.value->get<int>();
+            }
+        }
+    });
+    const double signalNs = bestNsPerCall(rounds, calls, [&] {
+        for (long i = 0; i < calls; ++i) {
+            const Interpreter::ControlFlowSignal signal = signallingBody(static_cast<int>(i & 0xff));
+            if (signal.kind() == Interpreter::ControlFlowSignal::Kind::Return) {
+                sink += signal.value()->get<int>();
+            }
+        }
+    });
+
+    std::printf("%-34s %12s\n", "early return", "ns/call");
+    std::printf("%-34s %12.1f\n", "script: return inside a loop", scriptNs);
+    std::printf("%-34s %12.1f\n", "mechanism: throw + catch", throwNs);
+    std::printf("%-34s %12.1f\n", "mechanism: ControlFlowSignal", signalNs);
+    std::printf("(checksum %ld)\n", sink);
+    return status;
+}
@@ -0,0 +1,103 @@
+// Tier-up from the interpreter to native code (Interpreter/Jit.hpp): the same recursive
+// script function run interpreted, and run after it crossed the JIT threshold.
+//
+//   jit_benchmark [--depth N] [--calls N] [--threshold N]
+//
+// Each row is one process: the symbol table is process-wide, so a second run in the same
+// process would start from the first one's state, and the tier is process-wide too. The benchmark
+// runs itself with --child for each row. The JIT compiles synchronously here, so the
+// native row does not depend on how fast the background compile happens to finish. Without
+// a C compiler the function stays interpreted and both rows read about the same.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "Interpreter/Jit.hpp"
+#include "VoidScript.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string fibScript(long depth, long calls) {
+    return "function fib(int $n) int {\n"
+           "    if ($n < 2) {\n"
+           "        return $n;\n"
+           "    }\n"
+           "    return fib($n - 1) + fib($n - 2);\n"
+           "}\n"
+           "int $sum = 0;\n"
+           "for (int $k = 0; $k < " +
+           std::to_string(calls) +
+           "; $k++) {\n"
+           "    $sum = $sum + fib(" +
+           std::to_string(depth) +
+           ");\n"
+           "}\n"
+           "printnl($sum);\n";
+}
+
+long parseLong(const char * text, const char * flag) {
+    char *     end   = nullptr;
+    const long value = std::strtol(text, &end, 10);
+    if (*end != '\0' || value < 0) {
+        std::fprintf(stderr, "%s expects a non-negative integer\n", flag);
+        std::exit(2);
+    }
+    return value;
+}
+
+// Runs the script in a child process; wall time in milliseconds, or a negative number.
+double runChild(const char * self, long depth, long calls, long threshold) {
+    const std::string command = std::string("\"") + self + "\" --child --depth " + std::to_string(depth) +
+                                " --calls " + std::to_string(calls) + " --threshold " + std::to_string(threshold) +
+                                " >/dev/null";
+    const auto start  = Clock::now();
+    const int  status = std::system(command.c_str());
+    const auto end    = Clock::now();
+    return status == 0 ? std::chrono::duration<double, std::milli>(end - start).count() : -1.0;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv) {
+    long depth     = 20;
+    long calls     = 5;
+    long threshold = 1000;
+    bool child     = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--depth") == 0 && i + 1 < argc) {
+            depth = parseLong(argv[++i], "--depth");
+        } else if (std::strcmp(argv[i], "--calls") == 0 && i + 1 < argc) {
+            calls = parseLong(argv[++i], "--calls");
+        } else if (std::strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = parseLong(argv[++i], "--threshold");
+        } else if (std::strcmp(argv[i], "--child") == 0) {
+            child = true;
+        } else {
+            std::fprintf(stderr, "usage: %s [--depth N] [--calls N] [--threshold N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (child) {
+        Interpreter::Jit::Tier::instance().configure(static_cast<std::uint32_t>(threshold), false);
+        VoidScript voidscript("jit_benchmark.vs");
+        voidscript.setScriptContent(fibScript(depth, calls));
+        return voidscript.run();
+    }
+
+    const double interpreted = runChild(argv[0], depth, calls, 0);
+    const double native      = runChild(argv[0], depth, calls, threshold);
+    if (interpreted < 0 || native < 0) {
+        std::fprintf(stderr, "the script failed\n");
+        return 1;
+    }
+    std::printf("%-34s %12s\n", ("fib(" + std::to_string(depth) + ") x " + std::to_string(calls)).c_str(), "ms");
+    std::printf("%-34s %12.1f\n", "interpreted", interpreted);
+    std::printf("%-34s %12.1f\n", ("--jit=" + std::to_string(threshold) + ", compiled inline").c_str(), native);
+    return 0;
+}
@@ -0,0 +1,120 @@
+// Insert, lookup and iterate cost of Symbols::ObjectMap against the std::map it replaced,
+// at 10, 1k and 100k keys.
+//
+// ObjectMap is an insertion-ordered open-addressing hash map (Symbols/OrderedMap.hpp):
+// entries sit in one dense vector, so iteration is a linear walk, and lookups hash a
+// string_view instead of walking a tree of string compares.
+//
+//   object_map_benchmark [--rounds N]
+//
+// Every row is normalised to nanoseconds per key. --rounds repeats each measurement and
+// keeps the fastest, which damps scheduler noise on small sizes.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Symbols/Value.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Keys shaped like script property names, with a numeric suffix so they are distinct.
+std::vector<std::string> makeKeys(size_t n) {
+    std::vector<std::string> keys;
+    keys.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        keys.push_back("property_" + std::to_string(i * 2654435761u % 1000003u) + "_" + std::to_string(i));
+    }
+    return keys;
+}
+
+template <typename Fn> double bestNsPerKey(int rounds, size_t keys, Fn && fn) {
+    double best = std::numeric_limits<double>::max();
+    for (int r = 0; r < rounds; ++r) {
+        const auto start = Clock::now();
+        fn();
+        const auto end = Clock::now();
+        best           = std::min(best, std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    return best / static_cast<double>(keys);
+}
+
+struct Timings {
+    double insert;
+    double lookup;
+    double iterate;
+};
+
+// Shared body for both map types; both spell operator[], find and range-for the same way.
+template <typename Map> Timings measure(const std::vector<std::string> & keys, int rounds) {
+    const Symbols::ValuePtr value(1);
+    Timings                 t{};
+    size_t                  sink = 0;
+
+    t.insert = bestNsPerKey(rounds, keys.size(), [&] {
+        Map m;
+        for (const auto & k : keys) {
+            m[k] = value;
+        }
+        sink += m.size();
+    });
+
+    Map filled;
+    for (const auto & k : keys) {
+        filled[k] = value;
+    }
+    // Probe in a different order than insertion so the walk is not a sequential scan.
+    std::vector<std::string> probes(keys.rbegin(), keys.rend());
+    t.lookup = bestNsPerKey(rounds, probes.size(), [&] {
+        for (const auto & k : probes) {
+            sink += filled.find(k) != filled.end();
+        }
+    });
+
+    t.iterate = bestNsPerKey(rounds, keys.size(), [&] {
+        for (const auto & entry : filled) {
+            sink += entry.first.size();
+        }
+    });
+
+    if (sink == 0) {
+        std::puts("");  // keep the loops observable
+    }
+    return t;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv) {
+    int rounds = 5;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+            rounds = std::atoi(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--rounds N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (rounds <= 0) {
+        rounds = 1;
+    }
+
+    std::printf("%-8s %-10s %12s %12s %12s\n", "keys", "map", "insert ns", "lookup ns", "iterate ns");
+    for (size_t n : { size_t{ 10 }, size_t{ 1000 }, size_t{ 100000 } }) {
+        const auto    keys    = makeKeys(n);
+        const Timings ordered = measure<Symbols::ObjectMap>(keys, rounds);
+        const Timings tree    = measure<std::map<std::string, Symbols::ValuePtr>>(keys, rounds);
+        std::printf("%-8zu %-10s %12.1f %12.1f %12.1f\n", n, "ObjectMap", ordered.insert, ordered.lookup,
+                    ordered.iterate);
+        std::printf("%-8zu %-10s %12.1f %12.1f %12.1f\n", n, "std::map", tree.insert, tree.lookup, tree.iterate);
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Switch dispatch: a request router with 64 string cases, hit on every case in turn.
+// With constant labels the switch jumps through the table it builds on its first run
+// (Nodes/Statement/SwitchStatementNode.hpp); with labels read from variables it still
+// compares them in order, which is what every switch used to do.
+//
+//   switch_benchmark [--calls N] [--cases N]
+//
+// Each row is one process: the symbol table is process-wide, so a second run in the same
+// process would start from the first one's state. The benchmark runs itself with --child for each
+// row. Both scripts do the same work apart from how the labels are written.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "VoidScript.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string routerScript(long calls, long cases, bool constant) {
+    std::string script;
+    for (long c = 0; c < cases; ++c) {
+        script += "string $route" + std::to_string(c) + " = \"/route/" + std::to_string(c) + "\";\n";
+    }
+    script += "function route(string $path) int {\n    switch ($path) {\n";
+    for (long c = 0; c < cases; ++c) {
+        const std::string label = constant ? "\"/route/" + std::to_string(c) + "\"" : "$route" + std::to_string(c);
+        script += "        case " + label + ": return " + std::to_string(c) + ";\n";
+    }
+    script += "        default: return -1;\n    }\n}\n";
+    script += "object $paths = [";
+    for (long c = 0; c < cases; ++c) {
+        script += (c ? ", $route" : "$route") + std::to_string(c);
+    }
+    script += "];\n"
+              "int $sum = 0;\n"
+              "for (int $n = 0; $n < " +
+              std::to_string(calls / cases) +
+              "; $n++) {\n"
+              "    for (string $path : $paths) {\n"
+              "        $sum = $sum + route($path);\n"
+              "    }\n"
+              "}\n"
+              "printnl($sum);\n";
+    return script;
+}
+
+long parseLong(const char * text, const char * flag) {
+    char *     end   = nullptr;
+    const long value = std::strtol(text, &end, 10);
+    if (*end != '\0' || value <= 0) {
+        std::fprintf(stderr, "%s expects a positive integer\n", flag);
+        std::exit(2);
+    }
+    return value;
+}
+
+// Runs the script in a child process; wall time in milliseconds, or a negative number.
+double runChild(const char * self, long calls, long cases, bool constant) {
+    const std::string command = std::string("\"") + self + "\" --child " + (constant ? "constant" : "variable") +
+                                " --calls " + std::to_string(calls) + " --cases " + std::to_string(cases) +
+                                " >/dev/null";
+    const auto start  = Clock::now();
+    const int  status = std::system(command.c_str());
+    const auto end    = Clock::now();
+    return status == 0 ? std::chrono::duration<double, std::milli>(end - start).count() : -1.0;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv) {
+    long        calls = 200000;
+    long        cases = 64;
+    const char * child = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--calls") == 0 && i + 1 < argc) {
+            calls = parseLong(argv[++i], "--calls");
+        } else if (std::strcmp(argv[i], "--cases") == 0 && i + 1 < argc) {
+            cases = parseLong(argv[++i], "--cases");
+        } else if (std::strcmp(argv[i], "--child") == 0 && i + 1 < argc) {
+            child = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--calls N] [--cases N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (child) {
+        VoidScript voidscript("switch_benchmark.vs");
+        voidscript.setScriptContent(routerScript(calls, cases, std::strcmp(child, "constant") == 0));
+        return voidscript.run();
+    }
+
+    const double ordered = runChild(argv[0], calls, cases, false);
+    const double table   = runChild(argv[0], calls, cases, true);
+    if (ordered < 0 || table < 0) {
+        std::fprintf(stderr, "the script failed\n");
+        return 1;
+    }
+    std::printf("%-34s %12s\n", (std::to_string(cases) + " string cases, " + std::to_string(calls) + " calls").c_str(),
+                "ms");
+    std::printf("%-34s %12.1f\n", "labels from variables (in order)", ordered);
+    std::printf("%-34s %12.1f\n", "constant labels (jump table)", table);
+    return 0;
+}
@@ -0,0 +1,221 @@
+// FastCGI-style request loop: one template run again and again in the same process, as
+// fastcgi/src/main.cpp does, parsed on every request and run from the template cache
+// (src/TemplateCache.hpp).
+//
+//   template_cache_benchmark [--requests N] [--rows N] [--threads N]
+//
+// Each row is one process, so every row starts with an empty container. Every request's
+// output must equal the first one's; the cached row also rewrites the template halfway and
+// checks that the next request parses it again. The threaded row serves the requests on N
+// threads at once, as `voidscript-fcgi --threads` does, each thread with its own template
+// and output. A mismatch fails the benchmark.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Interpreter/Output.hpp"
+#include "Symbols/SymbolContainer.hpp"
+#include "TemplateCache.hpp"
+#include "VoidScript.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string pageTemplate(long rows, const std::string & version) {
+    return "<html><body>\n"
+           "<?void\n"
+           "function cell(int $i) string {\n"
+           "    return \"<td>$i</td><td>\" + number_to_string($i * $i) + \"</td>\";\n"
+           "}\n"
+           "class Page {\n"
+           "    private: string $title = \"\";\n"
+           "    public:\n"
+           "        function construct(string $title) { $this->title = $title; }\n"
+           "        function heading() string { return \"<h1>\" + $this->title + \"</h1>\"; }\n"
+           "}\n"
+           "Page $page = new Page(\"Report\");\n"
+           "printnl($page->heading());\n"
+           "?>\n"
+           "<table>\n"
+           "<?void\n"
+           "for (int $i = 0; $i < " +
+           std::to_string(rows) +
+           "; $i++) {\n"
+           "    printnl(\"<tr>\", cell($i), \"</tr>\");\n"
+           "}\n"
+           "?>\n"
+           "</table>\n"
+           "<?void printnl(\"" +
+           version + "\"); ?>\n</body></html>\n";
+}
+
+void writeTemplate(const std::string & path, long rows, const std::string & version) {
+    std::ofstream out(path, std::ios::trunc);
+    out << pageTemplate(rows, version);
+}
+
+// One request: the script's output, captured as the FastCGI server captures it.
+std::string request(const std::string & path, bool cached) {
+    std::ostringstream                  body;
+    std::ostringstream                  errors;
+    int                                 status;
+    {
+        Interpreter::Output::Redirect redirect(body, errors);
+        VoidScript                    voidscript(path, false, false, false, false, /*enableTags=*/true);
+        voidscript.setTemplateCacheEnabled(cached);
+        status = voidscript.run();
+    }
+    return status == 0 ? body.str() : std::string();
+}
+
+int child(const std::string & path, bool cached, long requests, long rows) {
+    writeTemplate(path, rows, "version 1");
+    const std::string first = request(path, cached);
+    if (first.find("version 1") == std::string::npos || first.find("<h1>Report</h1>") == std::string::npos) {
+        std::fprintf(stderr, "unexpected output:\n%s\n", first.c_str());
+        return 1;
+    }
+    // A run that left its file scope on the stack would keep every request's variables.
+    const size_t depth = Symbols::SymbolContainer::instance()->getScopeStack().size();
+    for (long r = 1; r < requests; ++r) {
+        if (request(path, cached) != first) {
+            std::fprintf(stderr, "request %ld differs from the first\n", r);
+            return 1;
+        }
+    }
+    if (Symbols::SymbolContainer::instance()->getScopeStack().size() != depth) {
+        std::fprintf(stderr, "the scope stack grew from %zu to %zu scopes\n", depth,
+                     Symbols::SymbolContainer::instance()->getScopeStack().size());
+        return 1;
+    }
+    if (!cached) {
+        return 0;
+    }
+    auto & cache = TemplateCache::instance();
+    if (cache.hits() != static_cast<std::uint64_t>(requests - 1) || cache.misses() != 1) {
+        std::fprintf(stderr, "expected %ld hits and 1 miss, got %llu and %llu\n", requests - 1,
+                     static_cast<unsigned long long>(cache.hits()), static_cast<unsigned long long>(cache.misses()));
+        return 1;
+    }
+    // A different size is a different template, whatever the clock's resolution.
+    writeTemplate(path, rows, "version 22");
+    const std::string edited = request(path, cached);
+    if (edited.find("version 22") == std::string::npos || cache.misses() != 2) {
+        std::fprintf(stderr, "the edited template was not parsed again\n");
+        return 1;
+    }
+    std::fprintf(stderr, "hits %llu misses %llu\n", static_cast<unsigned long long>(cache.hits()),
+                 static_cast<unsigned long long>(cache.misses()));
+    return 0;
+}
+
+// The requests split over @p threads threads, each with a template of its own, all cached.
+int threadedChild(const std::string & path, long threads, long requests, long rows) {
+    std::vector<std::thread> pool;
+    std::vector<int>         failed(threads, 0);
+    for (long t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            const std::string own     = path + "." + std::to_string(t);
+            const std::string version = "thread " + std::to_string(t);
+            writeTemplate(own, rows, version);
+            const std::string first = request(own, true);
+            if (first.find(version + "\n") == std::string::npos) {
+                failed[t] = 1;
+            }
+            for (long r = t + threads; r < requests && !failed[t]; r += threads) {
+                failed[t] = request(own, true) != first;
+            }
+            if (TemplateCache::instance().misses() != 1) {
+                failed[t] = 1;
+            }
+            std::remove(own.c_str());
+        });
+    }
+    int status = 0;
+    for (long t = 0; t < threads; ++t) {
+        pool[t].join();
+        if (failed[t]) {
+            std::fprintf(stderr, "thread %ld: output differs or the template was parsed again\n", t);
+            status = 1;
+        }
+    }
+    return status;
+}
+
+long parseLong(const char * text, const char * flag) {
+    char *     end   = nullptr;
+    const long value = std::strtol(text, &end, 10);
+    if (*end != '\0' || value <= 0) {
+        std::fprintf(stderr, "%s expects a positive integer\n", flag);
+        std::exit(2);
+    }
+    return value;
+}
+
+// Runs the requests in a child process; wall time in milliseconds, or a negative number.
+double runChild(const char * self, const std::string & mode, long requests, long rows, long threads) {
+    const std::string command = std::string("\"") + self + "\" --child " + mode + " --requests " +
+                                std::to_string(requests) + " --rows " + std::to_string(rows) + " --threads " +
+                                std::to_string(threads);
+    const auto start  = Clock::now();
+    const int  status = std::system(command.c_str());
+    const auto end    = Clock::now();
+    return status == 0 ? std::chrono::duration<double, std::milli>(end - start).count() : -1.0;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv) {
+    long         requests = 500;
+    long         rows     = 20;
+    long         threads  = 4;
+    const char * mode     = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--requests") == 0 && i + 1 < argc) {
+            requests = parseLong(argv[++i], "--requests");
+        } else if (std::strcmp(argv[i], "--rows") == 0 && i + 1 < argc) {
+            rows = parseLong(argv[++i], "--rows");
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = parseLong(argv[++i], "--threads");
+        } else if (std::strcmp(argv[i], "--child") == 0 && i + 1 < argc) {
+            mode = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--requests N] [--rows N] [--threads N]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (mode) {
+        const bool        cached = std::strcmp(mode, "cached") == 0;
+        const std::string path   = "template_cache_benchmark_" + std::string(mode) + ".vs";
+        if (std::strcmp(mode, "threaded") == 0) {
+            return threadedChild(path, threads, requests, rows);
+        }
+        const int status = child(path, cached, requests, rows);
+        std::remove(path.c_str());
+        return status;
+    }
+
+    const double parsed   = runChild(argv[0], "parsed", requests, rows, threads);
+    const double cached   = runChild(argv[0], "cached", requests, rows, threads);
+    const double threaded = runChild(argv[0], "threaded", requests, rows, threads);
+    if (parsed < 0 || cached < 0 || threaded < 0) {
+        std::fprintf(stderr, "the template failed\n");
+        return 1;
+    }
+    std::printf("%-34s %12s\n", (std::to_string(requests) + " requests, " + std::to_string(rows) + " rows").c_str(),
+                "ms");
+    std::printf("%-34s %12.1f\n", "parsed on every request", parsed);
+    std::printf("%-34s %12.1f\n", "template cache", cached);
+    std::printf("%-34s %12.1f\n", ("template cache, " + std::to_string(threads) + " threads").c_str(), threaded);
+    return 0;
+}
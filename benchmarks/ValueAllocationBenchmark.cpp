@@ -0,0 +1,127 @@
+// Heap allocations and time per BinaryExpressionNode evaluation.
+//
+// Every scalar result used to cost two allocations: make_shared<Value> for the value and
+// make_shared<T> for its payload. Scalars are now stored inline in the Value, so an
+// int/double/bool result costs exactly one. Strings still carry an out-of-line payload.
+//
+//   value_allocation_benchmark [--iterations N] [--max-scalar-allocs N]
+//
+// With --max-scalar-allocs the run fails if any scalar case exceeds that many
+// allocations per evaluation, which is how ctest pins the budget.
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+
+#include "Interpreter/Interpreter.hpp"
+#include "Interpreter/Nodes/Expression/BinaryExpressionNode.hpp"
+#include "Interpreter/Nodes/Expression/LiteralExpressionNode.hpp"
+
+namespace {
+std::atomic<unsigned long long> allocationCount{ 0 };
+}  // namespace
+
+void * operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void * p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void * p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void * p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+struct Result {
+    double allocsPerEval;
+    double nsPerEval;
+};
+
+Result run(const Interpreter::ExpressionNode & node, Interpreter::Interpreter & interpreter, long iterations) {
+    // Warm up once so one-time allocations (none expected, but cheap insurance) are not counted.
+    (void) node.evaluate(interpreter, "bench", 0, 0);
+
+    const auto before = allocationCount.load();
+    const auto start  = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; ++i) {
+        Symbols::ValuePtr v = node.evaluate(interpreter, "bench", 0, 0);
+        (void) v;
+    }
+    const auto end   = std::chrono::steady_clock::now();
+    const auto after = allocationCount.load();
+
+    const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return { static_cast<double>(after - before) / iterations, ns / iterations };
+}
+
+std::unique_ptr<Interpreter::ExpressionNode> literal(const Symbols::ValuePtr & v) {
+    return std::make_unique<Interpreter::LiteralExpressionNode>(v);
+}
+
+std::unique_ptr<Interpreter::ExpressionNode> binary(Symbols::ValuePtr l, const char * op, Symbols::ValuePtr r) {
+    return std::make_unique<Interpreter::BinaryExpressionNode>(literal(l), op, literal(r));
+}
+
+}  // namespace
+
+int main(int argc, char ** argv) {
+    long   iterations      = 1000000;
+    double maxScalarAllocs = -1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = std::atol(argv[++i]);
+        } else if (std::strcmp(argv[i], "--max-scalar-allocs") == 0 && i + 1 < argc) {
+            maxScalarAllocs = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "usage: %s [--iterations N] [--max-scalar-allocs N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (iterations <= 0) {
+        iterations = 1;
+    }
+
+    Interpreter::Interpreter interpreter;
+
+    struct Case {
+        const char *                                 name;
+        std::unique_ptr<Interpreter::ExpressionNode> node;
+        bool                                         scalar;
+    };
+
+    Case cases[] = {
+        { "int + int",          binary(Symbols::ValuePtr(40), "+", Symbols::ValuePtr(2)),           true  },
+        { "int < int",          binary(Symbols::ValuePtr(40), "<", Symbols::ValuePtr(2)),           true  },
+        { "double * int",       binary(Symbols::ValuePtr(1.5), "*", Symbols::ValuePtr(2)),          true  },
+        { "bool && bool",       binary(Symbols::ValuePtr(true), "&&", Symbols::ValuePtr(false)),    true  },
+        { "string + string",    binary(Symbols::ValuePtr("price: "), "+", Symbols::ValuePtr("42")), false },
+    };
+
+    bool withinBudget = true;
+    std::printf("%-18s %14s %12s\n", "case", "allocs/eval", "ns/eval");
+    for (auto & c : cases) {
+        const Result r = run(*c.node, interpreter, iterations);
+        std::printf("%-18s %14.2f %12.1f\n", c.name, r.allocsPerEval, r.nsPerEval);
+        if (c.scalar && maxScalarAllocs >= 0 && r.allocsPerEval > maxScalarAllocs) {
+            withinBudget = false;
+        }
+    }
+
+    if (!withinBudget) {
+        std::fprintf(stderr, "scalar evaluation exceeded %.2f allocations per evaluation\n", maxScalarAllocs);
+        return 1;
+    }
+    return 0;
+}
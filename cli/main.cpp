@@ -1,6 +1,8 @@
 #include <unistd.h>  // for isatty, STDIN_FILENO
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
@@ -32,6 +34,10 @@ const std::unordered_map<std::string, std::string> params = {
     { "-m, --modules",           "List loaded modules with detailed information"                                               },
     { "--module-info",           "Display detailed information about a specific module"                                        },
     { "-c, --command",           "Execute script string instead of reading from file"                                          },
+    { "--engine",                "Loop execution engine: --engine=bytecode (default) or --engine=tree to walk every statement" },
+    { "--typecheck",             "Report type errors found by static inference before running the script"                      },
+    { "--no-optimize",           "Run the script as parsed, without folding constants (for debugging)"                         },
+    { "--jit[=N]",               "Compile script functions to native code after N calls and loop iterations (default 1000)"    },
 };
 
 int main(int argc, char * argv[]) {
@@ -47,6 +53,10 @@ int main(int argc, char * argv[]) {
     bool debugParser      = false;
     bool debugInterp      = false;
     bool debugSymbolTable = false;
+    bool bytecode         = true;
+    bool typecheck        = false;
+    bool optimize         = true;
+    unsigned long jit     = 0;
 
     std::string              file;
     std::string              scriptContent;                // For -c option
@@ -104,6 +114,32 @@ int main(int argc, char * argv[]) {
                 std::cerr << usage << "\n";
                 return 1;
             }
+        } else if (a.rfind("--engine=", 0) == 0) {
+            const std::string engine = a.substr(std::string("--engine=").size());
+            if (engine == "bytecode") {
+                bytecode = true;
+            } else if (engine == "tree") {
+                bytecode = false;
+            } else {
+                std::cerr << "Error: Unknown engine '" << engine << "'\n";
+                std::cerr << usage << "\n";
+                return 1;
+            }
+        } else if (a == "--typecheck") {
+            typecheck = true;
+        } else if (a == "--no-optimize") {
+            optimize = false;
+        } else if (a == "--jit") {
+            jit = 1000;
+        } else if (a.rfind("--jit=", 0) == 0) {
+            const std::string threshold = a.substr(std::string("--jit=").size());
+            char *            end       = nullptr;
+            jit                         = std::strtoul(threshold.c_str(), &end, 10);
+            if (threshold.empty() || *end != '\0' || jit == 0 || jit > UINT32_MAX) {
+                std::cerr << "Error: --jit expects a positive threshold, got '" << threshold << "'\n";
+                std::cerr << usage << "\n";
+                return 1;
+            }
         } else if (a == "--enable-tags") {
             enableTags = true;
         } else if (a == "--suppress-tags-outside") {
@@ -241,6 +277,10 @@ int main(int argc, char * argv[]) {
     if (isCommandMode) {
         voidscript.setScriptContent(scriptContent);
     }
+    voidscript.setBytecodeEnabled(bytecode);
+    voidscript.setTypeCheckEnabled(typecheck);
+    voidscript.setOptimizeEnabled(optimize);
+    voidscript.setJitThreshold(static_cast<std::uint32_t>(jit));
 
     return voidscript.run();
 }
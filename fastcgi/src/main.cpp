@@ -1,66 +1,196 @@
 // FastCGI interface for VoidScript
+//
+//   voidscript-fcgi [--threads N]
+//   voidscript-fcgi --workers N [--max-requests M] [--max-rss MB] [--preload FILE]...
+//
+// Without options, requests are answered one at a time with FCGI_Accept() (this also
+// runs as a plain CGI program). With --threads N, N threads accept requests on the
+// FastCGI socket with FCGX_Accept_r(), each with its own interpreter state: the symbol and
+// operation containers, the header() list and the template cache are per thread (see
+// Symbols::SymbolContainer::instance()). Plugin libraries are loaded once and shared.
+// In every mode the response is streamed: see Response.
+//
+// With --workers N the process is a master: it registers the modules, loads the plugins
+// and runs the --preload templates once, then forks N workers that start with all of it
+// (copy-on-write). A worker exits after M requests or once its resident memory passes the
+// --max-rss limit, and the master forks a new one. SIGHUP reloads: the workers finish the
+// request they are answering and exit, and the master runs itself again, so changed
+// plugins and preloaded templates are picked up. SIGTERM and SIGINT stop the workers the
+// same way, then the master.
+#include <chrono>
+#include <csignal>
+#include <cerrno>
+#include <fstream>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <string>
 #include <vector>
 #include <cstdlib>
 #include <cstdio>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
 #include <fcgi_stdio.h>
+#include <fcgiapp.h>
 #include "options.h"
 #include "VoidScript.hpp"
+#include "Interpreter/Output.hpp"
+#include "Symbols/SymbolContainer.hpp"
 #ifdef FCGI
 #include "Modules/BuiltIn/HeaderModule.hpp"
 #include <algorithm>
 #include <cctype>
 #endif
 
-int main(int argc, char *argv[]) {
-    // FastCGI loop: handle each request on STDIN/STDOUT
-    while (FCGI_Accept() >= 0) {
-        // Clear headers from previous request
+namespace {
+
+struct Options {
+    int                      threads     = 0;
+    int                      workers     = 0;
+    long                     maxRequests = 0;  // per worker; 0: no limit
+    long                     maxRssKb    = 0;  // per worker; 0: no limit
+    std::vector<std::string> preload;
+};
+
+// A request parameter (CGI environment variable), or nullptr
+using Param = std::function<const char *(const char *)>;
+// Write part of the response and send it on
+using Write = std::function<void(const char *, size_t)>;
+
+void write(const Write & out, const std::string & text) {
+    out(text.data(), text.size());
+}
+
+// The script's output on its way to the client. It is held until kChunk bytes have
+// gathered or the script calls flush(), so the client gets the first part of a long page
+// while the rest is made, and a large response is never held whole. The first part sent
+// carries the headers; header() is refused from then on.
+class Response : public std::streambuf {
+  public:
+    static constexpr size_t kChunk = 64 * 1024;
+
+    explicit Response(const Write & out) : out_(out), buffer_(kChunk) { reset(); }
+
+    // Send what is held, after the headers if they have not gone yet
+    void send() {
+        sendHeaders();
+        if (pptr() > pbase()) {
+            out_(pbase(), static_cast<size_t>(pptr() - pbase()));
+            reset();
+        }
+    }
+
+  protected:
+    int_type overflow(int_type ch) override {
+        send();
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char *data, std::streamsize size) override {
+        if (size > epptr() - pptr()) {
+            send();
+            if (static_cast<size_t>(size) >= kChunk) {
+                // Too large to gather: straight through
+                out_(data, static_cast<size_t>(size));
+                return size;
+            }
+        }
+        std::memcpy(pptr(), data, static_cast<size_t>(size));
+        pbump(static_cast<int>(size));
+        return size;
+    }
+
+  private:
+    void reset() { setp(buffer_.data(), buffer_.data() + buffer_.size()); }
+
+    // Output HTTP headers (from header() calls)
+    void sendHeaders() {
+        if (headersSent_) {
+            return;
+        }
+        headersSent_ = true;
+        std::string head;
+        bool hasCT = false;
+#ifdef FCGI
+        for (const auto &kv : Modules::HeaderModule::getHeaders()) {
+            head += kv.first + ": " + kv.second + "\r\n";
+            std::string key = kv.first;
+            std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return std::tolower(c); });
+            if (key == "content-type") hasCT = true;
+        }
+        Modules::HeaderModule::lockHeaders();
+#endif
+        if (!hasCT) {
+            head += "Content-Type: text/html\r\n";
+        }
+        write(out_, head + "\r\n");
+    }
+
+    const Write &out_;
+    std::vector<char> buffer_;
+    bool headersSent_ = false;
+};
+
+// Run the script a request names and write its response
+void serve(const Param & param, const Write & out, bool scriptFromStdin) {
+    // Clear headers from previous request
 #ifdef FCGI
-        Modules::HeaderModule::clearHeaders();
+    Modules::HeaderModule::clearHeaders();
 #endif
-        // Determine script filename from environment
-        const char *pathTranslated = getenv("PATH_TRANSLATED");
-        std::string filename;
-        if (pathTranslated && pathTranslated[0] != '\0') {
-            filename = pathTranslated;
+    // Determine script filename from environment
+    const char *pathTranslated = param("PATH_TRANSLATED");
+    std::string filename;
+    if (pathTranslated && pathTranslated[0] != '\0') {
+        filename = pathTranslated;
+    } else {
+        const char *scriptEnv = param("SCRIPT_FILENAME");
+        if (scriptEnv && scriptEnv[0] != '\0') {
+            filename = scriptEnv;
+        } else if (!scriptFromStdin) {
+            // The process's stdin is the FastCGI socket, not a script
+            write(out, "Status: 400 Bad Request\r\nContent-Type: text/plain\r\n\r\nNo script filename\n");
+            return;
         } else {
-            const char *scriptEnv = getenv("SCRIPT_FILENAME");
-            if (scriptEnv && scriptEnv[0] != '\0') {
-                filename = scriptEnv;
-            } else {
-                // Fallback to reading from STDIN
-                filename = "-";
-            }
+            // Fallback to reading from STDIN
+            filename = "-";
         }
+    }
 
-        // Parse QUERY_STRING into script arguments
-        std::vector<std::string> scriptArgs;
-        const char *qs = getenv("QUERY_STRING");
-        if (qs && qs[0] != '\0') {
-            std::string qsStr(qs);
-            size_t pos = 0;
-            while (pos < qsStr.size()) {
-                size_t amp = qsStr.find('&', pos);
-                if (amp == std::string::npos) {
-                    scriptArgs.emplace_back(qsStr.substr(pos));
-                    break;
-                } else {
-                    scriptArgs.emplace_back(qsStr.substr(pos, amp - pos));
-                    pos = amp + 1;
-                }
+    // Parse QUERY_STRING into script arguments
+    std::vector<std::string> scriptArgs;
+    const char *qs = param("QUERY_STRING");
+    if (qs && qs[0] != '\0') {
+        std::string qsStr(qs);
+        size_t pos = 0;
+        while (pos < qsStr.size()) {
+            size_t amp = qsStr.find('&', pos);
+            if (amp == std::string::npos) {
+                scriptArgs.emplace_back(qsStr.substr(pos));
+                break;
+            } else {
+                scriptArgs.emplace_back(qsStr.substr(pos, amp - pos));
+                pos = amp + 1;
             }
         }
+    }
 
-        // Capture standard output and error into buffers
-        std::ostringstream outBuf;
-        std::ostringstream errBuf;
-        auto *oldOut = std::cout.rdbuf();
-        auto *oldErr = std::cerr.rdbuf();
-        std::cout.rdbuf(outBuf.rdbuf());
-        std::cerr.rdbuf(errBuf.rdbuf());
+    // Stream the script's output; errors are collected and appended once it has run
+    Response response(out);
+    std::ostream body(&response);
+    std::ostringstream errBuf;
+    int exitCode;
+    {
+        Interpreter::Output::Redirect redirect(body, errBuf, [&response] { response.send(); });
 
         // Execute the script (enable template tag parsing)
         // code is processed only between PARSER_OPEN_TAG and PARSER_CLOSE_TAG (defined in options.h)
@@ -72,47 +202,320 @@ int main(int argc, char *argv[]) {
                       /*enableTags=*/true,
                       /*suppressTagsOutside=*/false,
                       scriptArgs);
-        int exitCode = vs.run();
+        // Modules register once per thread; the parsed template is kept between requests
+        // and parsed again only when the file's mtime or size changes
+        vs.setTemplateCacheEnabled(true);
+        exitCode = vs.run();
+    }
+
+    // The rest of the script output (and the headers, if it wrote nothing)
+    response.send();
+
+    // If errors occurred, include them in response
+    std::string errors = errBuf.str();
+    if (!errors.empty() || exitCode != 0) {
+        write(out, "<pre>");
+        if (!errors.empty()) {
+            write(out, errors);
+        } else {
+            write(out, "Error code: " + std::to_string(exitCode));
+        }
+        write(out, "</pre>\n");
+    }
+}
 
-        // Restore original streams
-        std::cout.rdbuf(oldOut);
-        std::cerr.rdbuf(oldErr);
+void serve(FCGX_Request &request) {
+    serve([&request](const char *name) { return FCGX_GetParam(name, request.envp); },
+          [&request](const char *data, size_t size) {
+              if (size > 0) {
+                  FCGX_PutStr(data, static_cast<int>(size), request.out);
+                  FCGX_FFlush(request.out);
+              }
+          },
+          /*scriptFromStdin=*/false);
+}
 
-        // Output HTTP headers (from header() calls)
+// One request at a time on STDIN/STDOUT
+int serveSequential() {
+    while (FCGI_Accept() >= 0) {
+        serve([](const char *name) { return getenv(name); },
+              [](const char *data, size_t size) {
+                  if (size > 0) {
+                      fwrite((void*)data, 1, size, stdout);
+                      fflush(stdout);
+                  }
+              },
+              /*scriptFromStdin=*/true);
+        Symbols::SymbolContainer::instance()->releaseScriptResources();
+    }
+    return 0;
+}
+
+// Accept and answer requests on this thread until the socket is closed
+void worker(std::mutex &acceptMutex) {
+    FCGX_Request request;
+    FCGX_InitRequest(&request, 0, 0);
+    for (;;) {
+        int rc;
         {
-            const auto &hdrs = Modules::HeaderModule::getHeaders();
-            bool hasCT = false;
-            for (const auto &kv : hdrs) {
-                printf("%s: %s\r\n", kv.first.c_str(), kv.second.c_str());
-                std::string key = kv.first;
-                std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return std::tolower(c); });
-                if (key == "content-type") hasCT = true;
+            // Some platforms require accept() serialization
+            std::lock_guard<std::mutex> lock(acceptMutex);
+            rc = FCGX_Accept_r(&request);
+        }
+        if (rc < 0) {
+            break;
+        }
+        serve(request);
+        FCGX_Finish_r(&request);
+        // Plugin handle tables are thread_local, so this frees only this thread's handles.
+        Symbols::SymbolContainer::instance()->releaseScriptResources();
+    }
+}
+
+int serveThreaded(int threads) {
+    if (FCGX_Init() != 0) {
+        std::cerr << "voidscript-fcgi: FCGX_Init failed" << std::endl;
+        return 1;
+    }
+    std::mutex acceptMutex;
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; ++i) {
+        pool.emplace_back(worker, std::ref(acceptMutex));
+    }
+    worker(acceptMutex);
+    for (auto &thread : pool) {
+        thread.join();
+    }
+    return 0;
+}
+
+// --- Pre-forked workers (--workers) ---
+
+volatile std::sig_atomic_t stopRequested = 0;
+// Set while a worker waits in poll() for a connection, before it has accepted one: it holds
+// no request there and can exit at once
+volatile std::sig_atomic_t waiting = 0;
+
+extern "C" void stopWorker(int) {
+    stopRequested = 1;
+    if (waiting) {
+        _exit(0);
+    }
+}
+
+long residentKb() {
+    std::ifstream statm("/proc/self/statm");
+    long size = 0;
+    long resident = 0;
+    statm >> size >> resident;
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// A worker: answer requests until a limit is reached or the master stops it
+int serveWorker(const Options &options) {
+    // SA_RESTART: libfcgi does not retry a read or write a signal interrupts, so without it
+    // a stop signal would cut short the response being written
+    struct sigaction action {};
+    action.sa_handler = stopWorker;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    for (int sig : { SIGTERM, SIGINT, SIGHUP }) {
+        sigaction(sig, &action, nullptr);
+    }
+
+    FCGX_Request request;
+    FCGX_InitRequest(&request, 0, 0);
+    // The workers wait for a connection in poll() and then race to accept it. A blocking
+    // accept() would leave the losers stuck in it, out of reach of a stop signal, so the
+    // listening socket is non-blocking (Linux does not pass that on to accepted sockets)
+    // and a lost race is an EAGAIN from FCGX_Accept_r()
+    fcntl(request.listen_sock, F_SETFL, fcntl(request.listen_sock, F_GETFL) | O_NONBLOCK);
+    for (long served = 0;;) {
+        pollfd listener{ request.listen_sock, POLLIN, 0 };
+        waiting = 1;
+        if (stopRequested) {
+            break;
+        }
+        const int ready = poll(&listener, 1, -1);
+        waiting = 0;
+        if (ready < 0 && errno != EINTR) {
+            break;
+        }
+        if (ready <= 0) {
+            continue;
+        }
+        // From here on a stop signal only sets stopRequested: the request is answered first
+        const int rc = FCGX_Accept_r(&request);
+        if (rc == -EAGAIN || rc == -EWOULDBLOCK) {
+            continue;
+        }
+        if (rc < 0) {
+            break;
+        }
+        serve(request);
+        FCGX_Finish_r(&request);
+        Symbols::SymbolContainer::instance()->releaseScriptResources();
+        if (stopRequested || ++served == options.maxRequests ||
+            (options.maxRssKb > 0 && residentKb() > options.maxRssKb)) {
+            break;
+        }
+    }
+    return 0;
+}
+
+// Register the modules, load the plugins and parse the --preload templates, so the workers
+// fork with them ready. A preloaded template is run once and its output discarded.
+bool warmUp(const std::vector<std::string> &scripts) {
+    for (const auto &path : scripts) {
+        std::ostringstream out;
+        std::ostringstream err;
+        int status;
+        {
+            Interpreter::Output::Redirect redirect(out, err);
+            VoidScript vs(path, false, false, false, false, /*enableTags=*/true);
+            vs.setTemplateCacheEnabled(true);
+            status = vs.run();
+        }
+        if (status != 0) {
+            std::cerr << "voidscript-fcgi: preloading " << path << " failed: " << err.str() << std::endl;
+            return false;
+        }
+    }
+    if (scripts.empty()) {
+        VoidScript modules("voidscript-fcgi");
+    }
+#ifdef FCGI
+    Modules::HeaderModule::clearHeaders();
+#endif
+    Symbols::SymbolContainer::instance()->releaseScriptResources();
+    return true;
+}
+
+void stopWorkers(const std::map<pid_t, std::chrono::steady_clock::time_point> &workers) {
+    for (const auto &[pid, _] : workers) {
+        kill(pid, SIGTERM);
+    }
+}
+
+// The master of --workers: keep N workers running until SIGTERM or SIGINT; see the top
+// of the file
+int superviseWorkers(const Options &options, char *argv[]) {
+    using Clock = std::chrono::steady_clock;
+    if (FCGX_IsCGI()) {
+        std::cerr << "voidscript-fcgi: --workers needs a FastCGI socket on stdin" << std::endl;
+        return 2;
+    }
+    if (!warmUp(options.preload)) {
+        return 1;
+    }
+
+    // Signals are taken with sigtimedwait(); the workers unblock them (a master started by a
+    // reload inherits them blocked)
+    sigset_t signals;
+    sigemptyset(&signals);
+    for (int sig : { SIGCHLD, SIGHUP, SIGTERM, SIGINT }) {
+        sigaddset(&signals, sig);
+    }
+    sigprocmask(SIG_BLOCK, &signals, nullptr);
+
+    std::map<pid_t, Clock::time_point> workers;  // started at
+    Clock::time_point failedAt{};  // a worker failed right after it started: fork no more for a second
+    bool stopping = false;
+    for (;;) {
+        while (!stopping && workers.size() < static_cast<size_t>(options.workers) &&
+               Clock::now() - failedAt >= std::chrono::seconds(1)) {
+            const pid_t pid = fork();
+            if (pid == 0) {
+                sigprocmask(SIG_UNBLOCK, &signals, nullptr);
+                _exit(serveWorker(options));
             }
-            if (!hasCT) {
-                printf("Content-Type: text/html\r\n");
+            if (pid < 0) {
+                std::cerr << "voidscript-fcgi: fork failed: " << std::strerror(errno) << std::endl;
+                failedAt = Clock::now();
+                break;
             }
-            printf("\r\n");
+            workers.emplace(pid, Clock::now());
+        }
+        if (stopping && workers.empty()) {
+            return 0;
         }
 
-        // Write script output
-        const std::string &body = outBuf.str();
-        if (!body.empty()) {
-            fwrite((void*)body.data(), 1, body.size(), stdout);
+        const timespec second{ 1, 0 };
+        const int sig = sigtimedwait(&signals, nullptr, &second);
+        if (sig == SIGHUP) {
+            // The new master reaps these workers too (as children it does not know)
+            stopWorkers(workers);
+            execv("/proc/self/exe", argv);
+            std::cerr << "voidscript-fcgi: reload failed: " << std::strerror(errno) << std::endl;
+            return 1;
+        }
+        if (sig == SIGTERM || sig == SIGINT) {
+            stopping = true;
+            stopWorkers(workers);
         }
 
-        // If errors occurred, include them in response
-        std::string errors = errBuf.str();
-        if (!errors.empty() || exitCode != 0) {
-            printf("<pre>");
-            if (!errors.empty()) {
-                fwrite((void*)errors.data(), 1, errors.size(), stdout);
-            } else {
-                std::string codeMsg = "Error code: " + std::to_string(exitCode);
-                fwrite((void*)codeMsg.data(), 1, codeMsg.size(), stdout);
+        int status;
+        pid_t pid;
+        while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+            auto it = workers.find(pid);
+            if (it == workers.end()) {
+                continue;
+            }
+            const bool failed = !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+            if (failed && Clock::now() - it->second < std::chrono::seconds(1)) {
+                failedAt = Clock::now();
             }
-            printf("</pre>\n");
+            workers.erase(it);
         }
-        fflush(stdout);
     }
-    return 0;
-}
\ No newline at end of file
+}
+
+bool positive(const char *text, long &value) {
+    char *end = nullptr;
+    value = std::strtol(text, &end, 10);
+    return *end == '\0' && value > 0;
+}
+
+int usage(const char *self) {
+    std::cerr << "usage: " << self << " [--threads N]\n"
+              << "       " << self << " --workers N [--max-requests M] [--max-rss MB] [--preload FILE]..."
+              << std::endl;
+    return 2;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        if (flag == "--preload" && i + 1 < argc) {
+            options.preload.emplace_back(argv[++i]);
+            continue;
+        }
+        long value = 0;
+        if (i + 1 >= argc || !positive(argv[i + 1], value)) {
+            return usage(argv[0]);
+        }
+        ++i;
+        if (flag == "--threads") {
+            options.threads = static_cast<int>(value);
+        } else if (flag == "--workers") {
+            options.workers = static_cast<int>(value);
+        } else if (flag == "--max-requests") {
+            options.maxRequests = value;
+        } else if (flag == "--max-rss") {
+            options.maxRssKb = value * 1024;
+        } else {
+            return usage(argv[0]);
+        }
+    }
+    const bool workerOptions = options.maxRequests > 0 || options.maxRssKb > 0 || !options.preload.empty();
+    if ((options.threads > 0 && options.workers > 0) || (workerOptions && options.workers == 0)) {
+        return usage(argv[0]);
+    }
+    if (options.workers > 0) {
+        return superviseWorkers(options, argv);
+    }
+    return options.threads > 0 ? serveThreaded(options.threads) : serveSequential();
+}
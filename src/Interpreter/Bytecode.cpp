@@ -0,0 +1,1132 @@
+#include "Interpreter/Bytecode.hpp"
+
+#include <algorithm>
+
+#include "Interpreter/CallSiteCache.hpp"
+#include "Interpreter/Interpreter.hpp"
+
+namespace Interpreter::Bytecode {
+
+namespace {
+
+using Type = Symbols::Variables::Type;
+
+// The symbol a name refers to, found the way IdentifierExpressionNode finds it.
+Symbols::SymbolPtr lookup(Symbols::Atom name) {
+    auto * sc     = Symbols::SymbolContainer::instance();
+    auto   symbol = sc->getVariable(name);
+    return symbol ? symbol : sc->getConstant(name);
+}
+
+bool isScalar(Type type) {
+    return type == Type::INTEGER || type == Type::FLOAT || type == Type::DOUBLE || type == Type::BOOLEAN;
+}
+
+bool isNumeric(Type type) {
+    return type == Type::INTEGER || type == Type::FLOAT || type == Type::DOUBLE;
+}
+
+// One instruction per operator for each numeric register type.
+struct Family {
+    Op add, sub, mul, div, eq, ne, lt, le, gt, ge;
+};
+
+constexpr Family kIntOps{ Op::AddI, Op::SubI, Op::MulI, Op::DivI, Op::EqI,
+                          Op::NeI,  Op::LtI,  Op::LeI,  Op::GtI,  Op::GeI };
+constexpr Family kFloatOps{ Op::AddF, Op::SubF, Op::MulF, Op::DivF, Op::EqF,
+                            Op::NeF,  Op::LtF,  Op::LeF,  Op::GtF,  Op::GeF };
+constexpr Family kDoubleOps{ Op::AddD, Op::SubD, Op::MulD, Op::DivD, Op::EqD,
+                             Op::NeD,  Op::LtD,  Op::LeD,  Op::GtD,  Op::GeD };
+
+// Selects @p family's instruction for @p op; @p compare is set for the ones yielding bool.
+bool select(const Family & family, BinaryOperator op, Op & out, bool & compare) {
+    compare = true;
+    switch (op) {
+        case BinaryOperator::Equal: out = family.eq; return true;
+        case BinaryOperator::NotEqual: out = family.ne; return true;
+        case BinaryOperator::Less: out = family.lt; return true;
+        case BinaryOperator::LessEqual: out = family.le; return true;
+        case BinaryOperator::Greater: out = family.gt; return true;
+        case BinaryOperator::GreaterEqual: out = family.ge; return true;
+        default: break;
+    }
+    compare = false;
+    switch (op) {
+        case BinaryOperator::Add: out = family.add; return true;
+        case BinaryOperator::Subtract: out = family.sub; return true;
+        case BinaryOperator::Multiply: out = family.mul; return true;
+        case BinaryOperator::Divide: out = family.div; return true;
+        default: return false;
+    }
+}
+
+Op formatOp(Type type) {
+    switch (type) {
+        case Type::INTEGER: return Op::IntToString;
+        case Type::FLOAT: return Op::FloatToString;
+        case Type::DOUBLE: return Op::DoubleToString;
+        default: return Op::BoolToString;
+    }
+}
+
+bool isJump(Op op) {
+    return op == Op::Jump || op == Op::JumpIfFalse || op == Op::JumpIfLtI || op == Op::JumpIfLeI ||
+           op == Op::JumpIfGtI || op == Op::JumpIfGeI;
+}
+
+}  // namespace
+
+bool External::matches(const Symbols::SymbolPtr & symbol) const {
+    if (!symbol) {
+        return !found;
+    }
+    const auto & value = symbol->getValue();
+    return found && symbol->getKind() == kind && value.getType() == type && value->is_null() == null;
+}
+
+Compiler::Compiler(const std::string & file, int line, size_t column) : chunk_(std::make_shared<Chunk>()) {
+    // The outermost scope is the loop's own, entered before its initialiser ran.
+    scopes_.emplace_back();
+    scopes_.back().inBody = true;
+    pushSite(file, line, column);
+}
+
+Compiler::Compiler(Symbols::Atom name, const std::vector<Symbols::FunctionParameterInfo> & params, Type returnType,
+                   const std::string & file, int line, size_t column) :
+    chunk_(std::make_shared<Chunk>()),
+    function_(true),
+    name_(name),
+    returnType_(returnType) {
+    // The outermost scope is the call frame; its declarations run once.
+    scopes_.emplace_back();
+    pushSite(file, line, column);
+    for (const auto & param : params) {
+        params_.push_back(param.type);
+        const int reg = temp(param.type);
+        temps_[reg]   = false;
+        scopes_.back().locals[Symbols::AtomTable::intern(param.name)] = { reg, false };
+    }
+    chunk_->params = static_cast<int>(params.size());
+}
+
+void Compiler::pushSite(const std::string & file, int line, size_t column, bool rewraps) {
+    const int outer = sites_.empty() ? -1 : sites_.back();
+    sites_.push_back(static_cast<int>(chunk_->sites.size()));
+    chunk_->sites.push_back({ file, line, column, outer, rewraps });
+}
+
+void Compiler::enterScope(const std::string & file, int line, size_t column) {
+    scopes_.emplace_back();
+    pushSite(file, line, column);
+}
+
+void Compiler::exitScope() {
+    scopes_.pop_back();
+    popSite();
+}
+
+int Compiler::temp(Type type) {
+    chunk_->registers.push_back(Register{});
+    chunk_->strings.emplace_back();
+    types_.push_back(type);
+    temps_.push_back(true);
+    return static_cast<int>(types_.size()) - 1;
+}
+
+// Strings live in loops only; the JIT translates scalars.
+bool Compiler::holds(Type type) const {
+    return isScalar(type) || (type == Type::STRING && !function_);
+}
+
+size_t Compiler::emit(Op op, int a, int b, int c) {
+    chunk_->code.push_back({ op, a, b, c, sites_.back() });
+    return chunk_->code.size() - 1;
+}
+
+int Compiler::literal(const Symbols::ValuePtr & value) {
+    const Type type = value.getType();
+    if (!holds(type) || value->is_null()) {
+        return kFailed;
+    }
+    if (type == Type::STRING && value.get<std::string>().empty() && empty_ >= 0) {
+        return empty_;
+    }
+    const int reg = temp(type);
+    temps_[reg]   = false;
+    auto & init   = chunk_->registers[reg];
+    switch (type) {
+        case Type::STRING:
+            chunk_->strings[reg] = value.get<std::string>();
+            if (chunk_->strings[reg].empty()) {
+                empty_ = reg;
+            }
+            break;
+        case Type::INTEGER:
+            init.i = value.get<int>();
+            break;
+        case Type::FLOAT:
+            init.f = value.get<float>();
+            break;
+        case Type::DOUBLE:
+            init.d = value.get<double>();
+            break;
+        default:
+            init.b = value.get<bool>();
+            break;
+    }
+    return reg;
+}
+
+int Compiler::external(Symbols::Atom name) {
+    if (function_) {
+        // Scoping is dynamic: the name could be any caller's variable.
+        return kFailed;
+    }
+    for (const auto & known : chunk_->externals) {
+        if (known.name == name) {
+            return known.reg;
+        }
+    }
+
+    External   entry;
+    entry.name  = name;
+    const auto symbol = lookup(name);
+    if (symbol) {
+        const auto & value = symbol->getValue();
+        entry.found        = true;
+        entry.kind         = symbol->getKind();
+        entry.type         = value.getType();
+        entry.null         = value->is_null();
+        if (holds(entry.type) && !entry.null) {
+            entry.reg        = temp(entry.type);
+            temps_[entry.reg] = false;
+        }
+    }
+    chunk_->externals.push_back(entry);
+    return entry.reg;
+}
+
+int Compiler::variable(Symbols::Atom name) {
+    for (size_t i = scopes_.size(); i-- > 0;) {
+        auto &     scope = scopes_[i];
+        const auto it    = scope.locals.find(name);
+        if (it != scope.locals.end()) {
+            // The increment runs after the body, even when `continue` skipped a
+            // declaration in it; only the tree walker follows which one ran last.
+            if (scope.sealed && it->second.inBody) {
+                return kFailed;
+            }
+            return it->second.reg;
+        }
+        scope.used.insert(name);
+    }
+    return external(name);
+}
+
+int Compiler::convert(int reg, Type type) {
+    const Type from = types_[reg];
+    if (from == type) {
+        return reg;
+    }
+    Op op;
+    if (from == Type::INTEGER && type == Type::FLOAT) {
+        op = Op::IntToFloat;
+    } else if (from == Type::INTEGER && type == Type::DOUBLE) {
+        op = Op::IntToDouble;
+    } else if (from == Type::FLOAT && type == Type::DOUBLE) {
+        op = Op::FloatToDouble;
+    } else if (from == Type::DOUBLE && type == Type::FLOAT) {
+        op = Op::DoubleToFloat;
+    } else {
+        return kFailed;
+    }
+    const int out = temp(type);
+    emit(op, out, reg);
+    return out;
+}
+
+int Compiler::format(int reg) {
+    const Type type = types_[reg];
+    if (type == Type::STRING) {
+        return reg;
+    }
+    const int out = temp(Type::STRING);
+    emit(formatOp(type), out, reg);
+    return out;
+}
+
+int Compiler::binary(BinaryOperator op, int lhs, int rhs) {
+    if (lhs == kFailed || rhs == kFailed) {
+        return kFailed;
+    }
+    const Type left  = types_[lhs];
+    const Type right = types_[rhs];
+
+    if (left == Type::STRING || right == Type::STRING) {
+        if (op == BinaryOperator::Add) {
+            // A string on either side: both are formatted as Value::toString() formats them.
+            if (lhs == empty_ && right == Type::STRING) {
+                return rhs;
+            }
+            lhs           = format(lhs);
+            rhs           = format(rhs);
+            const int out = temp(Type::STRING);
+            emit(Op::Concat, out, lhs, rhs);
+            return out;
+        }
+        if ((op != BinaryOperator::Equal && op != BinaryOperator::NotEqual) || left != right) {
+            return kFailed;
+        }
+        const int out = temp(Type::BOOLEAN);
+        emit(op == BinaryOperator::Equal ? Op::EqS : Op::NeS, out, lhs, rhs);
+        return out;
+    }
+
+    if (left == Type::BOOLEAN && right == Type::BOOLEAN) {
+        // Both sides are always evaluated, as by BinaryExpressionNode.
+        Op code;
+        switch (op) {
+            case BinaryOperator::LogicalAnd: code = Op::AndB; break;
+            case BinaryOperator::LogicalOr: code = Op::OrB; break;
+            case BinaryOperator::Equal: code = Op::EqB; break;
+            case BinaryOperator::NotEqual: code = Op::NeB; break;
+            default: return kFailed;
+        }
+        const int out = temp(Type::BOOLEAN);
+        emit(code, out, lhs, rhs);
+        return out;
+    }
+
+    if (isBitwise(op)) {
+        if (left != Type::INTEGER || right != Type::INTEGER) {
+            return kFailed;
+        }
+        const Op  code = op == BinaryOperator::BitAnd    ? Op::AndI :
+                         op == BinaryOperator::BitOr     ? Op::OrI :
+                         op == BinaryOperator::BitXor    ? Op::XorI :
+                         op == BinaryOperator::ShiftLeft ? Op::ShlI :
+                                                           Op::ShrI;
+        const int out  = temp(Type::INTEGER);
+        emit(code, out, lhs, rhs);
+        return out;
+    }
+
+    if (!isNumeric(left) || !isNumeric(right)) {
+        return kFailed;
+    }
+    // The same promotion as the tree walker: double wins, then float.
+    const Type      type   = (left == Type::DOUBLE || right == Type::DOUBLE) ? Type::DOUBLE :
+                             (left == Type::FLOAT || right == Type::FLOAT)   ? Type::FLOAT :
+                                                                                Type::INTEGER;
+    const Family &  family = type == Type::DOUBLE ? kDoubleOps : type == Type::FLOAT ? kFloatOps : kIntOps;
+    Op              code;
+    bool            compare = false;
+    if (type == Type::INTEGER && op == BinaryOperator::Modulo) {
+        code = Op::ModI;
+    } else if (!select(family, op, code, compare)) {
+        return kFailed;
+    }
+    lhs = convert(lhs, type);
+    rhs = convert(rhs, type);
+    const int out = temp(compare ? Type::BOOLEAN : type);
+    emit(code, out, lhs, rhs);
+    return out;
+}
+
+int Compiler::unary(UnaryOperator op, int operand) {
+    if (operand == kFailed) {
+        return kFailed;
+    }
+    const Type type = types_[operand];
+    Op         code;
+    if (op == UnaryOperator::Plus && isNumeric(type)) {
+        return operand;
+    }
+    if (op == UnaryOperator::Negate && type == Type::INTEGER) {
+        code = Op::NegI;
+    } else if (op == UnaryOperator::Negate && type == Type::FLOAT) {
+        code = Op::NegF;
+    } else if (op == UnaryOperator::Negate && type == Type::DOUBLE) {
+        code = Op::NegD;
+    } else if (op == UnaryOperator::BitNot && type == Type::INTEGER) {
+        code = Op::NotI;
+    } else if (op == UnaryOperator::Not && type == Type::BOOLEAN) {
+        code = Op::NotB;
+    } else {
+        return kFailed;
+    }
+    const int out = temp(type);
+    emit(code, out, operand);
+    return out;
+}
+
+bool Compiler::store(int target, int value) {
+    const Type type = types_[target];
+    if (types_[value] != type) {
+        // Numbers widen to a float or double variable (tryNumericCoerce); nothing else converts.
+        if ((type != Type::FLOAT && type != Type::DOUBLE) || !isNumeric(types_[value])) {
+            return false;
+        }
+        value = convert(value, type);
+    }
+    if (type == Type::STRING && append(target, value)) {
+        return true;
+    }
+    // Write the result straight into the variable when the instruction computing it
+    // was just emitted.
+    auto & code = chunk_->code;
+    if (temps_[value] && !code.empty() && code.back().a == value && !isJump(code.back().op)) {
+        code.back().a = target;
+    } else if (type == Type::STRING) {
+        // A temporary is not read again; its text can be moved.
+        emit(Op::MoveS, target, value, temps_[value] ? 1 : 0);
+    } else {
+        emit(Op::Move, target, value);
+    }
+    return true;
+}
+
+// `$s = $s + a + b ...`: append a, b, ... to the variable in place rather than copy it
+// into a new string at every step. The concatenations are moved after the instructions
+// between them, which only compute their operands: nothing there reads the temporaries
+// the chain drops, and nothing in an expression writes a variable the loop holds, so
+// they still see the variable's old value and an error among them leaves it unchanged.
+bool Compiler::append(int target, int value) {
+    auto &              code = chunk_->code;
+    std::vector<size_t> links;  // last one first
+    int                 reg  = value;
+    size_t              end  = code.size();
+    for (;;) {
+        if (!temps_[reg]) {
+            return false;
+        }
+        size_t at = end;
+        while (at > 0 && code[at - 1].a != reg) {
+            --at;
+        }
+        if (at == 0 || code[at - 1].op != Op::Concat) {
+            return false;
+        }
+        links.push_back(--at);
+        if (code[at].c == target) {
+            return false;  // `$s + ... + $s` reads the variable before the appends
+        }
+        if (code[at].b == target) {
+            break;
+        }
+        reg = code[at].b;
+        end = at;
+    }
+    const size_t first = links.back();
+    for (size_t i = first; i < code.size(); ++i) {
+        if (isJump(code[i].op)) {
+            return false;
+        }
+    }
+
+    std::vector<Instr> appends;
+    for (auto it = links.rbegin(); it != links.rend(); ++it) {
+        Instr link = code[*it];
+        link.a     = target;
+        link.b     = target;
+        appends.push_back(link);
+    }
+    for (size_t at : links) {
+        code.erase(code.begin() + static_cast<std::ptrdiff_t>(at));
+    }
+    code.insert(code.end(), appends.begin(), appends.end());
+    return true;
+}
+
+bool Compiler::assign(Symbols::Atom name, int value) {
+    if (value == kFailed) {
+        return false;
+    }
+    const int target = variable(name);
+    if (target == kFailed) {
+        return false;
+    }
+    for (auto & known : chunk_->externals) {
+        if (known.reg == target) {
+            if (known.kind != Symbols::Kind::Variable) {
+                return false;
+            }
+            known.written = true;
+        }
+    }
+    return store(target, value);
+}
+
+bool Compiler::declare(Symbols::Atom name, Type type, int value) {
+    auto & scope = scopes_.back();
+    // A declaration that may not run on every iteration, or that shadows a name the loop
+    // has already read from outside, changes what the name means between iterations.
+    if (value == kFailed || scope.branches > 0 || scope.used.count(name) || scope.locals.count(name)) {
+        return false;
+    }
+    if (type == Type::AUTO_TYPE) {
+        type = types_[value];
+    }
+    // Only the first declaration in a loop scope converts its value; a later iteration's
+    // redeclaration stores it as it is.
+    if (!holds(type) || (scope.inBody && types_[value] != type)) {
+        return false;
+    }
+    const int reg = temp(type);
+    temps_[reg]   = false;
+    if (!store(reg, value)) {
+        return false;
+    }
+    scope.locals[name] = { reg, scope.inBody };
+    declared_.insert(name);
+    return true;
+}
+
+size_t Compiler::jumpIfFalse(int condition) {
+    // Fuse an int comparison with the branch on its result.
+    auto & code = chunk_->code;
+    if (temps_[condition] && !code.empty() && code.back().a == condition) {
+        auto & last = code.back();
+        switch (last.op) {
+            case Op::LtI:
+                last.op = Op::JumpIfGeI;
+                return code.size() - 1;
+            case Op::LeI:
+                last.op = Op::JumpIfGtI;
+                return code.size() - 1;
+            case Op::GtI:
+                last.op = Op::JumpIfLeI;
+                return code.size() - 1;
+            case Op::GeI:
+                last.op = Op::JumpIfLtI;
+                return code.size() - 1;
+            default:
+                break;
+        }
+    }
+    return emit(Op::JumpIfFalse, 0, condition);
+}
+
+bool Compiler::body(const Body & statements) {
+    for (const auto & stmt : statements) {
+        if (stmt && !stmt->lower(*this)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Compiler::branch(const ExpressionNode & condition, const Body & thenBranch, const Body & elseBranch) {
+    const int cond = condition.lower(*this);
+    if (cond == kFailed || types_[cond] != Type::BOOLEAN) {
+        return false;
+    }
+    const size_t skip = jumpIfFalse(cond);
+    ++scopes_.back().branches;
+    if (!body(thenBranch)) {
+        return false;
+    }
+    if (!elseBranch.empty()) {
+        const size_t end = emit(Op::Jump, 0);
+        patch(skip, chunk_->code.size());
+        if (!body(elseBranch)) {
+            return false;
+        }
+        patch(end, chunk_->code.size());
+    } else {
+        patch(skip, chunk_->code.size());
+    }
+    --scopes_.back().branches;
+    return true;
+}
+
+int Compiler::call(const CallSite & site, Symbols::Atom name, const std::vector<std::unique_ptr<ExpressionNode>> & args,
+                   const Site & location) {
+    if (!function_) {
+        return invoke(site, name, args, location, false);
+    }
+    // Only the function itself is known not to read or write anything outside. The
+    // interpreter binds arguments without converting them, so their types must match.
+    if (name != name_ || args.size() != params_.size() ||
+        Symbols::SymbolContainer::instance()->findFunction(Symbols::AtomTable::name(name))) {
+        return kFailed;
+    }
+    std::vector<int> regs;
+    for (size_t i = 0; i < args.size(); ++i) {
+        const int reg = args[i]->lower(*this);
+        if (reg == kFailed || types_[reg] != params_[i]) {
+            return kFailed;
+        }
+        regs.push_back(reg);
+    }
+    const int first = static_cast<int>(chunk_->operands.size());
+    chunk_->operands.insert(chunk_->operands.end(), regs.begin(), regs.end());
+    const int out = temp(returnType_);
+    emit(Op::Call, out, first, static_cast<int>(args.size()));
+    return out;
+}
+
+bool Compiler::callStatement(const CallSite & site, Symbols::Atom name,
+                             const std::vector<std::unique_ptr<ExpressionNode>> & args, const Site & location) {
+    return !function_ && invoke(site, name, args, location, true) != kFailed;
+}
+
+int Compiler::invoke(const CallSite & site, Symbols::Atom name,
+                     const std::vector<std::unique_ptr<ExpressionNode>> & args, const Site & location,
+                     bool statement) {
+    auto *              sc      = Symbols::SymbolContainer::instance();
+    const std::string & fname   = Symbols::AtomTable::name(name);
+    Type                returns = Type::NULL_TYPE;
+    resolvedCalls_              = true;
+    if (sc->findFunction(fname)) {
+        // A native's value may be anything, and one that calls back may run any function.
+        if (!statement || sc->reentrant(fname)) {
+            return kFailed;
+        }
+    } else {
+        // The function the call site resolves when the loop runs in this scope.
+        const auto function = CallSiteCache::findScript(fname, sc->getScopeStack().back());
+        if (!function || !reach(*function)) {
+            return kFailed;
+        }
+        returns = function->returnType();
+        if (!statement && returns != Type::STRING && (!isScalar(returns) || function->reach()->nullable)) {
+            return kFailed;
+        }
+    }
+
+    // Errors in the arguments are the call's; a call expression's own errors are already
+    // wrapped in its location when they reach the expression around it.
+    pushSite(location.file, location.line, location.column, !statement);
+    std::vector<int> regs;
+    for (const auto & arg : args) {
+        regs.push_back(arg->lower(*this));
+        if (regs.back() == kFailed) {
+            popSite();
+            return kFailed;
+        }
+    }
+    if (!statement) {
+        popSite();
+    }
+
+    const int first = static_cast<int>(chunk_->operands.size());
+    chunk_->operands.insert(chunk_->operands.end(), regs.begin(), regs.end());
+    const int index = static_cast<int>(chunk_->calls.size());
+    chunk_->calls.push_back({ &site, first, static_cast<std::int32_t>(regs.size()) });
+    const int out = statement ? -1 : temp(returns);
+    emit(Op::Invoke, out, index);
+    if (statement) {
+        popSite();
+        return 0;
+    }
+    return out;
+}
+
+// Gathers what @p function and every function it calls may look up outside their frames.
+bool Compiler::reach(const Symbols::FunctionSymbol & function) {
+    auto *                                       sc = Symbols::SymbolContainer::instance();
+    std::vector<const Symbols::FunctionSymbol *> pending{ &function };
+    std::unordered_set<const Symbols::FunctionSymbol *> seen;
+    while (!pending.empty()) {
+        const auto * next = pending.back();
+        pending.pop_back();
+        if (!seen.insert(next).second) {
+            continue;
+        }
+        const auto * info = next->reach();
+        if (!info || !info->known) {
+            return false;
+        }
+        reached_.insert(info->names.begin(), info->names.end());
+        // Its calls resolve from its own call frames.
+        const std::string scope = CallSiteCache::canonical(*next) + Symbols::SymbolContainer::CALL_SCOPE;
+        for (const auto & callee : info->calls) {
+            if (sc->findFunction(callee)) {
+                if (sc->reentrant(callee)) {
+                    return false;
+                }
+                continue;
+            }
+            const auto symbol = CallSiteCache::findScript(callee, scope);
+            if (!symbol) {
+                return false;
+            }
+            pending.push_back(symbol.get());
+        }
+    }
+    return true;
+}
+
+bool Compiler::ret(int value) {
+    // Anything but the declared type fails the caller's return type check.
+    if (!function_ || value == kFailed || types_[value] != returnType_) {
+        return false;
+    }
+    emit(Op::Return, 0, value);
+    return true;
+}
+
+bool Compiler::jumpOut(bool isBreak) {
+    if (loops_.empty()) {
+        return false;
+    }
+    const size_t at = emit(Op::Jump, 0);
+    (isBreak ? loops_.back().breaks : loops_.back().continues).push_back(at);
+    return true;
+}
+
+bool Compiler::loop(const ExpressionNode * condition, const StatementNode * increment, const Body & statements) {
+    const size_t top  = chunk_->code.size();
+    size_t       exit = 0;
+    if (condition) {
+        const int cond = condition->lower(*this);
+        if (cond == kFailed || types_[cond] != Type::BOOLEAN) {
+            return false;
+        }
+        exit = jumpIfFalse(cond);
+    }
+
+    loops_.emplace_back();
+    const size_t scope = scopes_.size() - 1;
+    scopes_[scope].inBody = true;
+    if (!body(statements)) {
+        return false;
+    }
+    for (size_t at : loops_.back().continues) {
+        patch(at, chunk_->code.size());
+    }
+    scopes_[scope].sealed = true;
+    if (increment && !increment->lower(*this)) {
+        return false;
+    }
+    scopes_[scope].sealed = false;
+    emit(Op::Jump, static_cast<int>(top));
+
+    if (condition) {
+        patch(exit, chunk_->code.size());
+    }
+    for (size_t at : loops_.back().breaks) {
+        patch(at, chunk_->code.size());
+    }
+    loops_.pop_back();
+    return true;
+}
+
+std::shared_ptr<const Chunk> Compiler::finish() {
+    // A called function would look up a variable that lives in a register meanwhile.
+    for (const auto & ext : chunk_->externals) {
+        if (reached_.count(ext.name)) {
+            return nullptr;
+        }
+    }
+    for (const auto name : declared_) {
+        if (reached_.count(name)) {
+            return nullptr;
+        }
+    }
+    if (!chunk_->calls.empty()) {
+        chunk_->epoch = Symbols::SymbolContainer::instance()->definitionEpoch();
+    }
+    // For a function body, running off the end without a return is the caller's error.
+    emit(Op::Halt, 0);
+    chunk_->types = types_;
+    return chunk_;
+}
+
+namespace {
+
+/** @brief One run of a chunk: its registers and the symbols its externals live in. */
+class Machine {
+  public:
+    Machine(const Chunk & chunk, const std::vector<Symbols::SymbolPtr> & symbols, Interpreter & interpreter) :
+        chunk_(chunk),
+        symbols_(symbols),
+        interpreter_(interpreter),
+        regs_(chunk.registers),
+        strings_(chunk.strings) {
+        for (size_t i = 0; i < chunk_.externals.size(); ++i) {
+            const auto & ext   = chunk_.externals[i];
+            const auto & value = symbols_[i]->getValue();
+            auto &       reg   = regs_[ext.reg];
+            switch (ext.type) {
+                case Type::STRING:
+                    strings_[ext.reg] = value.get<std::string>();
+                    break;
+                case Type::INTEGER:
+                    reg.i = value.get<int>();
+                    break;
+                case Type::FLOAT:
+                    reg.f = value.get<float>();
+                    break;
+                case Type::DOUBLE:
+                    reg.d = value.get<double>();
+                    break;
+                default:
+                    reg.b = value.get<bool>();
+                    break;
+            }
+        }
+    }
+
+    void run();
+
+  private:
+    // Store every variable the loop assigned back into its symbol.
+    void writeBack() {
+        for (size_t i = 0; i < chunk_.externals.size(); ++i) {
+            const auto & ext = chunk_.externals[i];
+            if (!ext.written) {
+                continue;
+            }
+            const auto & reg = regs_[ext.reg];
+            switch (ext.type) {
+                case Type::STRING:
+                    symbols_[i]->setValue(Symbols::ValuePtr(std::move(strings_[ext.reg])));
+                    break;
+                case Type::INTEGER:
+                    symbols_[i]->setValue(Symbols::ValuePtr(reg.i));
+                    break;
+                case Type::FLOAT:
+                    symbols_[i]->setValue(Symbols::ValuePtr(reg.f));
+                    break;
+                case Type::DOUBLE:
+                    symbols_[i]->setValue(Symbols::ValuePtr(reg.d));
+                    break;
+                default:
+                    symbols_[i]->setValue(Symbols::ValuePtr(reg.b));
+                    break;
+            }
+        }
+    }
+
+    [[noreturn]] void fail(const Instr & instr, const std::string & message) {
+        writeBack();
+        throwAt(message, instr.site);
+    }
+
+    // @p message wrapped in the location of @p site, then in that of every call expression
+    // around it, as the tree walker's handlers pass it on.
+    [[noreturn]] void throwAt(const std::string & message, int site) {
+        const auto &    at = chunk_.sites[static_cast<size_t>(site)];
+        const Exception error(message, at.file, at.line, at.column);
+        const int       outer = rewrapping(at.outer);
+        if (outer < 0) {
+            throw error;
+        }
+        throwAt(error.what(), outer);
+    }
+
+    // The innermost call expression site from @p site outwards, or -1.
+    int rewrapping(int site) const {
+        while (site >= 0 && !chunk_.sites[static_cast<size_t>(site)].rewraps) {
+            site = chunk_.sites[static_cast<size_t>(site)].outer;
+        }
+        return site;
+    }
+
+    Symbols::ValuePtr value(std::int32_t reg) const {
+        const auto & r = regs_[static_cast<size_t>(reg)];
+        switch (chunk_.types[static_cast<size_t>(reg)]) {
+            case Type::STRING: return Symbols::ValuePtr(strings_[static_cast<size_t>(reg)]);
+            case Type::INTEGER: return Symbols::ValuePtr(r.i);
+            case Type::FLOAT: return Symbols::ValuePtr(r.f);
+            case Type::DOUBLE: return Symbols::ValuePtr(r.d);
+            default: return Symbols::ValuePtr(r.b);
+        }
+    }
+
+    void invoke(const Instr & instr);
+
+    const Chunk &                           chunk_;
+    const std::vector<Symbols::SymbolPtr> & symbols_;
+    Interpreter &                           interpreter_;
+    std::vector<Register>                   regs_;
+    std::vector<std::string>                strings_;
+};
+
+void Machine::invoke(const Instr & instr) {
+    const Call &                   call = chunk_.calls[static_cast<size_t>(instr.b)];
+    std::vector<Symbols::ValuePtr> args;
+    args.reserve(static_cast<size_t>(call.count));
+    for (std::int32_t i = 0; i < call.count; ++i) {
+        args.push_back(value(chunk_.operands[static_cast<size_t>(call.first + i)]));
+    }
+    Symbols::ValuePtr result;
+    try {
+        result = call.site->invoke(interpreter_, std::move(args));
+    } catch (const std::exception & e) {
+        writeBack();
+        const int site = rewrapping(instr.site);
+        if (site < 0) {
+            throw;
+        }
+        throwAt(e.what(), site);
+    } catch (...) {
+        writeBack();
+        throw;
+    }
+    if (instr.a < 0) {
+        return;
+    }
+    // Of the callee's return type, which the call has checked, and not null.
+    const auto reg = static_cast<size_t>(instr.a);
+    switch (chunk_.types[reg]) {
+        case Type::STRING:
+            strings_[reg] = result.get<std::string>();
+            break;
+        case Type::INTEGER:
+            regs_[reg].i = result.get<int>();
+            break;
+        case Type::FLOAT:
+            regs_[reg].f = result.get<float>();
+            break;
+        case Type::DOUBLE:
+            regs_[reg].d = result.get<double>();
+            break;
+        default:
+            regs_[reg].b = result.get<bool>();
+            break;
+    }
+}
+
+void Machine::run() {
+    Register * const    r    = regs_.data();
+    std::string * const s    = strings_.data();
+    const Instr * const code = chunk_.code.data();
+    const Instr *       ip   = code;
+
+#if defined(__GNUC__)
+    // Threaded dispatch: every handler jumps straight to the next one's label.
+    static const void * const labels[] = {
+#    define VOIDSCRIPT_BYTECODE_LABEL(name) &&op_##name,
+        VOIDSCRIPT_BYTECODE_OPS(VOIDSCRIPT_BYTECODE_LABEL)
+#    undef VOIDSCRIPT_BYTECODE_LABEL
+    };
+#    define VM_DISPATCH() goto * labels[static_cast<size_t>(ip->op)]
+#    define VM_CASE(name) op_##name:
+#    define VM_BEGIN()    VM_DISPATCH();
+#    define VM_END()
+#else
+#    define VM_DISPATCH() continue
+#    define VM_CASE(name) case Op::name:
+#    define VM_BEGIN() \
+        for (;;) {     \
+            switch (ip->op) {
+#    define VM_END() \
+        }            \
+        }
+#endif
+#define VM_NEXT() \
+    ++ip;         \
+    VM_DISPATCH()
+#define VM_JUMP(target)       \
+    ip = code + (target);     \
+    VM_DISPATCH()
+#define VM_BINARY(name, out, in, expr)                  \
+    VM_CASE(name) {                                     \
+        r[ip->a].out = r[ip->b].in expr r[ip->c].in;    \
+        VM_NEXT();                                      \
+    }
+#define VM_UNARY(name, out, expr) \
+    VM_CASE(name) {               \
+        r[ip->a].out = expr;      \
+        VM_NEXT();                \
+    }
+#define VM_BRANCH(name, expr)                 \
+    VM_CASE(name) {                           \
+        if (r[ip->b].i expr r[ip->c].i) {     \
+            VM_JUMP(ip->a);                   \
+        }                                     \
+        VM_NEXT();                            \
+    }
+
+    VM_BEGIN()
+
+    VM_CASE(Move) {
+        r[ip->a] = r[ip->b];
+        VM_NEXT();
+    }
+    VM_UNARY(IntToFloat, f, static_cast<float>(r[ip->b].i))
+    VM_UNARY(IntToDouble, d, static_cast<double>(r[ip->b].i))
+    VM_UNARY(FloatToDouble, d, static_cast<double>(r[ip->b].f))
+    VM_UNARY(DoubleToFloat, f, static_cast<float>(r[ip->b].d))
+
+    VM_BINARY(AddI, i, i, +)
+    VM_BINARY(SubI, i, i, -)
+    VM_BINARY(MulI, i, i, *)
+    VM_CASE(DivI) {
+        if (r[ip->c].i == 0) {
+            fail(*ip, "Division by zero");
+        }
+        r[ip->a].i = r[ip->b].i / r[ip->c].i;
+        VM_NEXT();
+    }
+    VM_CASE(ModI) {
+        if (r[ip->c].i == 0) {
+            fail(*ip, "Modulo by zero");
+        }
+        r[ip->a].i = r[ip->b].i % r[ip->c].i;
+        VM_NEXT();
+    }
+    VM_BINARY(AndI, i, i, &)
+    VM_BINARY(OrI, i, i, |)
+    VM_BINARY(XorI, i, i, ^)
+    VM_CASE(ShlI) {
+        const int amount = r[ip->c].i;
+        if (amount < 0 || amount >= static_cast<int>(sizeof(int) * 8)) {
+            fail(*ip, "Shift amount " + std::to_string(amount) + " is out of range for '<<'");
+        }
+        r[ip->a].i = r[ip->b].i << amount;
+        VM_NEXT();
+    }
+    VM_CASE(ShrI) {
+        const int amount = r[ip->c].i;
+        if (amount < 0 || amount >= static_cast<int>(sizeof(int) * 8)) {
+            fail(*ip, "Shift amount " + std::to_string(amount) + " is out of range for '>>'");
+        }
+        r[ip->a].i = r[ip->b].i >> amount;
+        VM_NEXT();
+    }
+    VM_UNARY(NegI, i, -r[ip->b].i)
+    VM_UNARY(NotI, i, ~r[ip->b].i)
+
+    VM_BINARY(AddF, f, f, +)
+    VM_BINARY(SubF, f, f, -)
+    VM_BINARY(MulF, f, f, *)
+    VM_BINARY(DivF, f, f, /)
+    VM_UNARY(NegF, f, -r[ip->b].f)
+
+    VM_BINARY(AddD, d, d, +)
+    VM_BINARY(SubD, d, d, -)
+    VM_BINARY(MulD, d, d, *)
+    VM_BINARY(DivD, d, d, /)
+    VM_UNARY(NegD, d, -r[ip->b].d)
+
+    VM_BINARY(EqI, b, i, ==)
+    VM_BINARY(NeI, b, i, !=)
+    VM_BINARY(LtI, b, i, <)
+    VM_BINARY(LeI, b, i, <=)
+    VM_BINARY(GtI, b, i, >)
+    VM_BINARY(GeI, b, i, >=)
+    VM_BINARY(EqF, b, f, ==)
+    VM_BINARY(NeF, b, f, !=)
+    VM_BINARY(LtF, b, f, <)
+    VM_BINARY(LeF, b, f, <=)
+    VM_BINARY(GtF, b, f, >)
+    VM_BINARY(GeF, b, f, >=)
+    VM_BINARY(EqD, b, d, ==)
+    VM_BINARY(NeD, b, d, !=)
+    VM_BINARY(LtD, b, d, <)
+    VM_BINARY(LeD, b, d, <=)
+    VM_BINARY(GtD, b, d, >)
+    VM_BINARY(GeD, b, d, >=)
+    VM_BINARY(EqB, b, b, ==)
+    VM_BINARY(NeB, b, b, !=)
+    VM_BINARY(AndB, b, b, &&)
+    VM_BINARY(OrB, b, b, ||)
+    VM_UNARY(NotB, b, !r[ip->b].b)
+
+    VM_CASE(MoveS) {
+        if (ip->c) {
+            s[ip->a] = std::move(s[ip->b]);
+        } else {
+            s[ip->a] = s[ip->b];
+        }
+        VM_NEXT();
+    }
+    VM_CASE(Concat) {
+        if (ip->a == ip->b) {
+            s[ip->a] += s[ip->c];
+        } else if (ip->a == ip->c) {
+            s[ip->a].insert(0, s[ip->b]);
+        } else {
+            // Into the register's own buffer, which the previous iteration sized.
+            s[ip->a].assign(s[ip->b]);
+            s[ip->a] += s[ip->c];
+        }
+        VM_NEXT();
+    }
+    VM_CASE(IntToString) {
+        s[ip->a] = std::to_string(r[ip->b].i);
+        VM_NEXT();
+    }
+    VM_CASE(FloatToString) {
+        s[ip->a] = std::to_string(r[ip->b].f);
+        VM_NEXT();
+    }
+    VM_CASE(DoubleToString) {
+        s[ip->a] = std::to_string(r[ip->b].d);
+        VM_NEXT();
+    }
+    VM_CASE(BoolToString) {
+        s[ip->a] = r[ip->b].b ? "true" : "false";
+        VM_NEXT();
+    }
+    VM_CASE(EqS) {
+        r[ip->a].b = s[ip->b] == s[ip->c];
+        VM_NEXT();
+    }
+    VM_CASE(NeS) {
+        r[ip->a].b = s[ip->b] != s[ip->c];
+        VM_NEXT();
+    }
+
+    VM_BRANCH(JumpIfLtI, <)
+    VM_BRANCH(JumpIfLeI, <=)
+    VM_BRANCH(JumpIfGtI, >)
+    VM_BRANCH(JumpIfGeI, >=)
+    VM_CASE(Jump) {
+        VM_JUMP(ip->a);
+    }
+    VM_CASE(JumpIfFalse) {
+        if (!r[ip->b].b) {
+            VM_JUMP(ip->a);
+        }
+        VM_NEXT();
+    }
+    VM_CASE(Invoke) {
+        invoke(*ip);
+        VM_NEXT();
+    }
+    // Function bodies are compiled for the JIT only and never run here.
+    VM_CASE(Call)
+    VM_CASE(Return)
+    VM_CASE(Halt) {
+        writeBack();
+        return;
+    }
+
+    VM_END()
+
+#undef VM_BRANCH
+#undef VM_UNARY
+#undef VM_BINARY
+#undef VM_JUMP
+#undef VM_NEXT
+#undef VM_END
+#undef VM_BEGIN
+#undef VM_CASE
+#undef VM_DISPATCH
+}
+
+}  // namespace
+
+void execute(const Chunk & chunk, const std::vector<Symbols::SymbolPtr> & symbols, Interpreter & interpreter) {
+    Machine(chunk, symbols, interpreter).run();
+}
+
+bool LoopCache::bind(const std::vector<External> & externals, std::vector<Symbols::SymbolPtr> & symbols) {
+    symbols.clear();
+    symbols.reserve(externals.size());
+    for (const auto & ext : externals) {
+        auto symbol = lookup(ext.name);
+        if (!ext.matches(symbol)) {
+            return false;
+        }
+        symbols.push_back(std::move(symbol));
+    }
+    return true;
+}
+
+}  // namespace Interpreter::Bytecode
@@ -0,0 +1,347 @@
+#ifndef INTERPRETER_BYTECODE_HPP
+#define INTERPRETER_BYTECODE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Interpreter/ExpressionNode.hpp"
+#include "Interpreter/Operator.hpp"
+#include "Interpreter/StatementNode.hpp"
+#include "Symbols/Atom.hpp"
+#include "Symbols/FunctionParameterInfo.hpp"
+#include "Symbols/FunctionSymbol.hpp"
+#include "Symbols/SymbolContainer.hpp"
+#include "Symbols/Value.hpp"
+#include "Symbols/VariableTypes.hpp"
+
+namespace Interpreter {
+class Interpreter;
+}
+
+namespace Interpreter::Bytecode {
+
+// Every instruction; the VM's dispatch table is generated from the same list.
+#define VOIDSCRIPT_BYTECODE_OPS(X)                                                                       \
+    X(Move) X(IntToFloat) X(IntToDouble) X(FloatToDouble) X(DoubleToFloat)                              \
+    X(AddI) X(SubI) X(MulI) X(DivI) X(ModI) X(AndI) X(OrI) X(XorI) X(ShlI) X(ShrI) X(NegI) X(NotI)      \
+    X(AddF) X(SubF) X(MulF) X(DivF) X(NegF)                                                              \
+    X(AddD) X(SubD) X(MulD) X(DivD) X(NegD)                                                              \
+    X(EqI) X(NeI) X(LtI) X(LeI) X(GtI) X(GeI)                                                            \
+    X(EqF) X(NeF) X(LtF) X(LeF) X(GtF) X(GeF)                                                            \
+    X(EqD) X(NeD) X(LtD) X(LeD) X(GtD) X(GeD)                                                            \
+    X(EqB) X(NeB) X(AndB) X(OrB) X(NotB)                                                                 \
+    X(MoveS) X(Concat) X(IntToString) X(FloatToString) X(DoubleToString) X(BoolToString) X(EqS) X(NeS)  \
+    X(JumpIfLtI) X(JumpIfLeI) X(JumpIfGtI) X(JumpIfGeI)                                                  \
+    X(Jump) X(JumpIfFalse) X(Call) X(Invoke) X(Return) X(Halt)
+
+enum class Op : std::uint8_t {
+#define VOIDSCRIPT_BYTECODE_ENUM(name) name,
+    VOIDSCRIPT_BYTECODE_OPS(VOIDSCRIPT_BYTECODE_ENUM)
+#undef VOIDSCRIPT_BYTECODE_ENUM
+};
+
+/**
+ * @brief One three-address instruction. @c a is the destination register (or the jump
+ * target), @c b and @c c the operands; a Call's arguments are the @c c registers listed
+ * from Chunk::operands[b], an Invoke's are described by Chunk::calls[b] and its @c a is -1
+ * when the value is not used. @c site indexes Chunk::sites: the statement or call whose
+ * location a runtime error reports, the same one the tree walker would wrap it with.
+ */
+struct Instr {
+    Op           op   = Op::Halt;
+    std::int32_t a    = 0;
+    std::int32_t b    = 0;
+    std::int32_t c    = 0;
+    std::int32_t site = 0;
+};
+
+// A register holds one scalar; its type is fixed when the chunk is compiled. A string
+// register keeps its text at the same index of a separate list (Chunk::strings).
+union Register {
+    int    i;
+    float  f;
+    double d;
+    bool   b;
+};
+
+/**
+ * @brief Where an error is reported. Statements pass on an error that already has a
+ * location; a call expression wraps every error from its arguments and its callee in its
+ * own location again (@c rewraps). @c outer is the site around this one, or -1.
+ */
+struct Site {
+    std::string file;
+    int         line;
+    size_t      column;
+    int         outer   = -1;
+    bool        rewraps = false;
+};
+
+/**
+ * @brief A call a compiled loop makes through the tree walker (CallExpressionNode,
+ * CallStatementNode): everything the node does once its arguments are evaluated,
+ * including the errors it raises and how it wraps them.
+ */
+class CallSite {
+  public:
+    virtual ~CallSite() = default;
+
+    virtual Symbols::ValuePtr invoke(Interpreter & interpreter, std::vector<Symbols::ValuePtr> args) const = 0;
+};
+
+struct Call {
+    const CallSite * site;
+    std::int32_t     first;  // arguments: Chunk::operands[first, first + count)
+    std::int32_t     count;
+};
+
+/**
+ * @brief A variable the loop reads or writes but did not declare. It is looked up once
+ * when the loop starts, kept in @c reg while it runs and stored back when it ends. The
+ * chunk was compiled for the symbol kind and value type recorded here.
+ */
+struct External {
+    Symbols::Atom            name    = Symbols::kNoAtom;
+    bool                     found   = false;
+    Symbols::Kind            kind    = Symbols::Kind::Variable;
+    Symbols::Variables::Type type    = Symbols::Variables::Type::NULL_TYPE;
+    bool                     null    = false;
+    int                      reg     = -1;
+    bool                     written = false;
+
+    /** @brief Whether @p symbol is what the chunk was compiled against. */
+    bool matches(const Symbols::SymbolPtr & symbol) const;
+};
+
+/**
+ * @brief The compiled form of one loop, or of a function body for the JIT (see Jit.hpp),
+ * whose parameters are registers 0..params-1.
+ */
+struct Chunk {
+    std::vector<Instr>                    code;
+    std::vector<Register>                 registers;  // initial contents: literals filled in
+    std::vector<std::string>              strings;    // the same for string registers
+    std::vector<Symbols::Variables::Type> types;      // type of each register
+    std::vector<External>                 externals;
+    std::vector<Site>                     sites;
+    std::vector<std::int32_t>             operands;   // argument registers of the calls
+    std::vector<Call>                     calls;
+    int                                   params = 0;
+    // Definition epoch the called functions were resolved in; 0 if the loop resolved none.
+    std::uint64_t                         epoch  = 0;
+};
+
+/**
+ * @brief Lowers a loop statement to register bytecode.
+ *
+ * What lowers: int, float, double, bool and string variables and literals, the
+ * arithmetic, comparison, bitwise and logical operators, string concatenation (with the
+ * numbers and bools it formats) and comparison, interpolated strings, plain assignments,
+ * declarations, if/else, break, continue, nested C-style for and while loops, and calls.
+ * Each expression is typed when it is compiled, from the types the loop's variables have
+ * on entry, so an instruction never checks its operand types. A node that cannot lower
+ * returns a failure and the whole loop runs on the tree walker instead.
+ *
+ * A call runs through the tree walker's own call node (CallSite), with arguments from
+ * registers. The callee must be a script function whose value is a string or a scalar
+ * that is never null, or any function in statement position; a native that calls script
+ * functions back is refused. The loop keeps its variables in registers, so none of the
+ * names a called function may look up in its callers' scopes (Symbols::FunctionReach,
+ * with those of the functions it calls in turn) may be one of them.
+ *
+ * The lowering keeps the tree walker's semantics exactly, including its error messages
+ * and their locations. Where the two could differ it refuses: a declaration whose
+ * initialiser has another type (a redeclaration on the next iteration does not convert),
+ * a declaration inside if/else or of a name the loop already used from outside.
+ *
+ * In function mode the whole body of a script function is compiled the same way, for the
+ * JIT (see Jit.hpp), scalars only; the chunk is never run by the VM.
+ */
+class Compiler {
+  public:
+    using Body = std::vector<std::unique_ptr<StatementNode>>;
+
+    // Result of a failed expression lowering.
+    static constexpr int kFailed = -1;
+
+    /** @param file, line, column Location of the loop being compiled. */
+    Compiler(const std::string & file, int line, size_t column);
+
+    /**
+     * @brief Compile the body of the script function @p name instead of a loop. Its
+     * parameters take the first registers; the body may return and call the function
+     * itself, but may not read anything from outside, so it runs without its call frame.
+     */
+    Compiler(Symbols::Atom name, const std::vector<Symbols::FunctionParameterInfo> & params,
+             Symbols::Variables::Type returnType, const std::string & file, int line, size_t column);
+
+    /** @brief A literal; a register holding it, or kFailed if it has no register type. */
+    int literal(const Symbols::ValuePtr & value);
+
+    /** @brief Read of a variable or constant. */
+    int variable(Symbols::Atom name);
+
+    int binary(BinaryOperator op, int lhs, int rhs);
+    int unary(UnaryOperator op, int operand);
+
+    /** @brief `$name = value;` converting numbers as AssignmentStatementNode does. */
+    bool assign(Symbols::Atom name, int value);
+
+    /** @brief `type $name = value;` in the innermost scope. */
+    bool declare(Symbols::Atom name, Symbols::Variables::Type type, int value);
+
+    bool branch(const ExpressionNode & condition, const Body & thenBranch, const Body & elseBranch);
+
+    /**
+     * @brief A call whose value is used, made by @p site at @p location. In function mode
+     * only a call of the function being compiled, with the same argument types.
+     */
+    int call(const CallSite & site, Symbols::Atom name, const std::vector<std::unique_ptr<ExpressionNode>> & args,
+             const Site & location);
+
+    /** @brief A call statement; its value, if any, is dropped. Loops only. */
+    bool callStatement(const CallSite & site, Symbols::Atom name,
+                       const std::vector<std::unique_ptr<ExpressionNode>> & args, const Site & location);
+
+    /** @brief `return value;` from the function being compiled. */
+    bool ret(int value);
+
+    /** @brief break (@p isBreak) or continue of the innermost loop. */
+    bool jumpOut(bool isBreak);
+
+    /**
+     * @brief A loop's iterations: condition, body and increment, in the innermost scope.
+     * A nested loop opens its own scope first and lowers its initialiser in it.
+     */
+    bool loop(const ExpressionNode * condition, const StatementNode * increment, const Body & body);
+
+    /**
+     * @brief Runtime errors from here on are reported at this statement, or at this call
+     * expression if @p rewraps, until popSite().
+     */
+    void pushSite(const std::string & file, int line, size_t column, bool rewraps = false);
+    void popSite() { sites_.pop_back(); }
+
+    /** @brief A nested loop's scope; also its error site. */
+    void enterScope(const std::string & file, int line, size_t column);
+    void exitScope();
+
+    /** @brief Everything looked up from outside the loop so far, compiled or not. */
+    const std::vector<External> & externals() const { return chunk_->externals; }
+
+    /** @brief Whether the lowering resolved a function, which a new definition may change. */
+    bool resolvedCalls() const { return resolvedCalls_; }
+
+    /** @brief The chunk; nullptr if a called function may reach a variable the loop holds. */
+    std::shared_ptr<const Chunk> finish();
+
+  private:
+    struct Local {
+        int  reg;
+        bool inBody;  // declared in the body rather than a loop's initialiser
+    };
+
+    struct Scope {
+        std::unordered_map<Symbols::Atom, Local> locals;
+        std::unordered_set<Symbols::Atom>        used;     // names looked up past this scope
+        int                                      branches = 0;
+        bool                                     inBody   = false;
+        bool                                     sealed   = false;  // lowering the increment
+    };
+
+    struct LoopLabels {
+        std::vector<size_t> breaks;
+        std::vector<size_t> continues;
+    };
+
+    int    temp(Symbols::Variables::Type type);
+    bool   holds(Symbols::Variables::Type type) const;
+    size_t emit(Op op, int a, int b = 0, int c = 0);
+    size_t jumpIfFalse(int condition);
+    int    convert(int reg, Symbols::Variables::Type type);
+    int    format(int reg);
+    bool   store(int target, int value);
+    bool   append(int target, int value);
+    int    external(Symbols::Atom name);
+    bool   body(const Body & statements);
+    int    invoke(const CallSite & site, Symbols::Atom name, const std::vector<std::unique_ptr<ExpressionNode>> & args,
+                  const Site & location, bool statement);
+    bool   reach(const Symbols::FunctionSymbol & function);
+    void   patch(size_t at, size_t target) { chunk_->code[at].a = static_cast<std::int32_t>(target); }
+
+    std::shared_ptr<Chunk>                chunk_;
+    std::vector<Symbols::Variables::Type> types_;  // type of each register
+    std::vector<bool>                     temps_;  // register is an expression temporary
+    std::vector<Scope>                    scopes_;
+    std::vector<LoopLabels>               loops_;
+    std::vector<int>                      sites_;
+    int                                   empty_ = -1;  // register of the literal ""
+    std::unordered_set<Symbols::Atom>     declared_;    // every local the loop declares
+    std::unordered_set<Symbols::Atom>     reached_;     // names the called functions may look up
+    bool                                  resolvedCalls_ = false;
+    // Set for a function body: its name and declared types.
+    bool                                  function_   = false;
+    Symbols::Atom                         name_       = Symbols::kNoAtom;
+    std::vector<Symbols::Variables::Type> params_;
+    Symbols::Variables::Type              returnType_ = Symbols::Variables::Type::NULL_TYPE;
+};
+
+/** @brief Run a compiled loop against the symbols its externals resolved to. */
+void execute(const Chunk & chunk, const std::vector<Symbols::SymbolPtr> & symbols, Interpreter & interpreter);
+
+/**
+ * @brief Per-node cache of a loop's bytecode (CStyleForStatementNode, WhileStatementNode).
+ *
+ * The chunk is reused while the loop's outside variables resolve to symbols of the same
+ * kind and type, and the functions it calls are not redefined; otherwise the loop is
+ * compiled again. A loop that did not lower is not retried until the variables it looked
+ * at change, or a function is defined if it looked one up.
+ */
+class LoopCache {
+  public:
+    /**
+     * @brief Run the loop as bytecode. @p lower lowers its iterations into a Compiler.
+     * @return false if the loop does not lower; nothing has run and the caller walks it.
+     */
+    template <typename Lower> bool run(const StatementNode & loop, Interpreter & interpreter, Lower && lower) {
+        const std::uint64_t             epoch = Symbols::SymbolContainer::instance()->definitionEpoch();
+        std::vector<Symbols::SymbolPtr> symbols;
+        if (!chunk_ || (chunk_->epoch != 0 && chunk_->epoch != epoch) || !bind(chunk_->externals, symbols)) {
+            if (rejected_ && (rejectedEpoch_ == 0 || rejectedEpoch_ == epoch) && bind(*rejected_, symbols)) {
+                return false;
+            }
+            Compiler                     compiler(loop.filename_, loop.line_, loop.column_);
+            std::shared_ptr<const Chunk> chunk = lower(compiler) ? compiler.finish() : nullptr;
+            if (!chunk) {
+                chunk_.reset();
+                rejected_      = std::make_unique<std::vector<External>>(compiler.externals());
+                rejectedEpoch_ = compiler.resolvedCalls() ? epoch : 0;
+                return false;
+            }
+            chunk_ = std::move(chunk);
+            rejected_.reset();
+            if (!bind(chunk_->externals, symbols)) {
+                return false;
+            }
+        }
+        // Held here too: a function the loop calls may run it again and compile it anew.
+        const std::shared_ptr<const Chunk> chunk = chunk_;
+        execute(*chunk, symbols, interpreter);
+        return true;
+    }
+
+  private:
+    static bool bind(const std::vector<External> & externals, std::vector<Symbols::SymbolPtr> & symbols);
+
+    std::shared_ptr<const Chunk>           chunk_;
+    std::unique_ptr<std::vector<External>> rejected_;
+    std::uint64_t                          rejectedEpoch_ = 0;
+};
+
+}  // namespace Interpreter::Bytecode
+
+#endif  // INTERPRETER_BYTECODE_HPP
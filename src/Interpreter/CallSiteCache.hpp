@@ -0,0 +1,122 @@
+#ifndef INTERPRETER_CALL_SITE_CACHE_HPP
+#define INTERPRETER_CALL_SITE_CACHE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Interpreter/Jit.hpp"
+#include "Interpreter/OperationContainer.hpp"
+#include "Symbols/FunctionSymbol.hpp"
+#include "Symbols/SymbolContainer.hpp"
+
+namespace Interpreter {
+
+/**
+ * @brief Inline cache of one function call site (CallExpressionNode, CallStatementNode).
+ *
+ * Resolving a name means a lookup in the native function registry, then a walk up the
+ * calling scope's name to the nearest scope defining a script function of that name, then
+ * the lookup of its body. The result is kept until SymbolContainer's definition epoch
+ * moves; a script function is also tied to the scope name it was resolved from, since the
+ * same name can mean different functions in different scopes.
+ */
+class CallSiteCache {
+  public:
+    struct Target {
+        const Symbols::CallbackFunction *        native = nullptr;  // registered (module) function
+        std::shared_ptr<Symbols::FunctionSymbol> function;           // script function
+        // Body operations; may grow while running, so iterate by index.
+        const std::vector<std::shared_ptr<Operations::Operation>> * body = nullptr;
+        std::string                              canonical;          // scope the body was parsed in
+        std::string                              callScope;          // name of its call frames
+        Symbols::Atom                            frame = Symbols::kNoAtom;
+        std::vector<Symbols::Atom>               params;             // parameter names
+        std::shared_ptr<Jit::Function>           jit;                // tier-up state, if the JIT is on
+    };
+
+    /**
+     * @brief The function @p name refers to at this call site, or nullptr if none. The
+     * caller holds its own reference, since a nested call through the same site may
+     * resolve again while it runs.
+     */
+    std::shared_ptr<const Target> resolve(const std::string & name) {
+        auto * sc = Symbols::SymbolContainer::instance();
+        if (target_ && epoch_ == sc->definitionEpoch() &&
+            (target_->native || sc->getScopeStack().back() == scope_)) {
+            return target_;
+        }
+
+        target_.reset();
+        auto target = std::make_shared<Target>();
+        if (const auto * native = sc->findFunction(name)) {
+            target->native = native;
+            return remember(std::move(target), sc);
+        }
+
+        scope_           = sc->getScopeStack().back();
+        target->function = findScript(name, scope_);
+        if (!target->function) {
+            return nullptr;
+        }
+
+        target->canonical = canonical(*target->function);
+        target->callScope = target->canonical + Symbols::SymbolContainer::CALL_SCOPE;
+        target->frame     = Symbols::AtomTable::intern(target->canonical);
+        target->body      = Operations::Container::instance()->find(target->canonical);
+        for (const auto & param : target->function->parameters()) {
+            target->params.push_back(Symbols::AtomTable::intern(param.name));
+        }
+        if (Jit::Tier::instance().enabled()) {
+            target->jit = Jit::Tier::instance().function(target->function, target->body);
+        }
+        return remember(std::move(target), sc);
+    }
+
+    /**
+     * @brief The script function @p name means in @p scope: the one defined in the nearest
+     * of the scope and its parents. Scope names are hierarchical, like
+     * /file/path::class::method, so each parent drops the last part.
+     */
+    static std::shared_ptr<Symbols::FunctionSymbol> findScript(const std::string & name, std::string_view scope) {
+        auto *       sc  = Symbols::SymbolContainer::instance();
+        const auto & sep = Symbols::SymbolContainer::SCOPE_SEPARATOR;
+        while (!scope.empty()) {
+            if (auto table = sc->getScopeTable(std::string(scope))) {
+                auto sym = table->get(Symbols::SymbolContainer::DEFAULT_FUNCTIONS_SCOPE, name);
+                if (sym && sym->getKind() == Symbols::Kind::Function) {
+                    return std::static_pointer_cast<Symbols::FunctionSymbol>(sym);
+                }
+            }
+            const auto pos = scope.rfind(sep);
+            if (pos == std::string_view::npos) {
+                break;
+            }
+            scope = scope.substr(0, pos);
+        }
+        return nullptr;
+    }
+
+    /** @brief The scope @p function's body was parsed in; its call frames are named after it. */
+    static std::string canonical(const Symbols::FunctionSymbol & function) {
+        return function.context().empty() ? function.name() :
+                                            function.context() + Symbols::SymbolContainer::SCOPE_SEPARATOR + function.name();
+    }
+
+  private:
+    std::shared_ptr<const Target> remember(std::shared_ptr<Target> target, const Symbols::SymbolContainer * sc) {
+        target_ = std::move(target);
+        epoch_  = sc->definitionEpoch();
+        return target_;
+    }
+
+    std::shared_ptr<const Target> target_;
+    std::uint64_t                 epoch_ = 0;
+    std::string                   scope_;  // calling scope a script function was resolved from
+};
+
+}  // namespace Interpreter
+
+#endif  // INTERPRETER_CALL_SITE_CACHE_HPP
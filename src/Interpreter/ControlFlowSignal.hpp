@@ -1,28 +1,71 @@
 #ifndef INTERPRETER_CONTROL_FLOW_SIGNAL_HPP
 #define INTERPRETER_CONTROL_FLOW_SIGNAL_HPP
 
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "Symbols/Value.hpp"
+
 namespace Interpreter {
 
 /**
- * @brief Base for exceptions that carry control flow rather than report an error.
+ * @brief How a statement finished: normally, or by `break`, `continue` or `return`.
  *
- * Deliberately does NOT derive from std::exception. `break`, `continue` and `return`
- * are unwound with exceptions, but they are not failures, and a generic
- * `catch (const std::exception &)` anywhere in the interpreter must not be able to
- * absorb them.
+ * StatementNode::interpret returns one. A statement that runs a body stops at the first
+ * statement that does not finish normally and hands its signal up: loops consume break
+ * and continue, a switch consumes break, a function call consumes return and takes its
+ * value. A break or continue that reaches a function body outside any loop ends it like a
+ * return without a value; one that reaches the top level of a script is a runtime error.
  *
- * This is not a style preference. BreakException used to derive from
- * std::runtime_error, so the generic handler in TryStatementNode swallowed a `break`
- * inside a `try` and turned the enclosing loop infinite. Making these types
- * un-catchable by the generic handler removes that whole class of bug: a new catch
- * site cannot get it wrong by omission, because the compiler will not let it.
+ * These used to be thrown (BreakException, ContinueException, ReturnException), so a
+ * `return` inside a loop cost a full C++ unwind on every call. Exceptions are now only
+ * errors and script-level `throw`.
  *
- * Anything that must observe control flow catches ControlFlowSignal, or one of its
- * derived types, explicitly.
+ * A `return f(...)` in tail position may hand its call over instead of making it (see
+ * CallExpressionNode::handOver): it returns a tail call, a return without a value that
+ * the function call running the body completes by calling f in place of the frame.
  */
-class ControlFlowSignal {
+class [[nodiscard]] ControlFlowSignal {
   public:
-    virtual ~ControlFlowSignal() = default;
+    enum class Kind : std::uint8_t { Normal, Break, Continue, Return };
+
+    ControlFlowSignal() = default;
+
+    static ControlFlowSignal breakLoop() { return ControlFlowSignal(Kind::Break); }
+
+    static ControlFlowSignal continueLoop() { return ControlFlowSignal(Kind::Continue); }
+
+    static ControlFlowSignal returnValue(Symbols::ValuePtr value) {
+        ControlFlowSignal signal(Kind::Return);
+        signal.value_ = std::move(value);
+        return signal;
+    }
+
+    static ControlFlowSignal tailCall() {
+        ControlFlowSignal signal(Kind::Return);
+        signal.tail_ = true;
+        return signal;
+    }
+
+    Kind kind() const { return kind_; }
+
+    /** @brief A return that handed its call over to the function call running the body. */
+    bool tail() const { return tail_; }
+
+    bool normal() const { return kind_ == Kind::Normal; }
+
+    /** @brief The value a `return` carries; null for every other signal. */
+    Symbols::ValuePtr value() const { return value_ ? *value_ : Symbols::ValuePtr(); }
+
+  private:
+    explicit ControlFlowSignal(Kind kind) : kind_(kind) {}
+
+    Kind kind_ = Kind::Normal;
+    bool tail_ = false;
+    // Engaged only by a return: an empty ValuePtr allocates, and every statement
+    // returns a signal.
+    std::optional<Symbols::ValuePtr> value_;
 };
 
 }  // namespace Interpreter
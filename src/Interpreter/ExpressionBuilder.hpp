@@ -11,6 +11,7 @@
 #include "Nodes/Expression/DynamicMemberExpressionNode.hpp"
 #include "Nodes/Expression/EnumAccessExpressionNode.hpp"
 #include "Nodes/Expression/IdentifierExpressionNode.hpp"
+#include "Nodes/Expression/InterpolatedStringNode.hpp"
 #include "Nodes/Expression/LiteralExpressionNode.hpp"
 #include "Nodes/Expression/MemberExpressionNode.hpp"
 #include "Nodes/Expression/MethodCallExpressionNode.hpp"
@@ -156,6 +157,17 @@ inline std::unique_ptr<Interpreter::ExpressionNode> buildExpressionFromParsed(co
                     expr->name, expr->op, expr->filename, expr->line, expr->column);
             }
 
+        case Kind::Interpolation:
+            {
+                std::vector<std::unique_ptr<Interpreter::ExpressionNode>> parts;
+                parts.reserve(expr->args.size());
+                for (const auto & part : expr->args) {
+                    parts.push_back(buildExpressionFromParsed(part));
+                }
+                return std::make_unique<Interpreter::InterpolatedStringNode>(std::move(parts), expr->filename,
+                                                                             expr->line, expr->column);
+            }
+
         default:
             {
                 throw std::runtime_error("Unknown ParsedExpression kind: " +
@@ -1,9 +1,22 @@
 #ifndef INTERPRETER_FUNCTION_EXECUTOR_HPP
 #define INTERPRETER_FUNCTION_EXECUTOR_HPP
 
+#include <memory>
+#include <optional>
+#include <utility>
+
 #include "Symbols/Value.hpp"
 
 namespace Interpreter {
+
+class LocalResolver;
+class Optimizer;
+class TypeChecker;
+
+namespace Bytecode {
+class Compiler;
+}
+
 struct ExpressionNode {
     // Must be initialised. Subclasses that do not carry a source location left these as
     // stack garbage, which the error formatter then printed verbatim - producing
@@ -16,6 +29,41 @@ struct ExpressionNode {
     virtual Symbols::ValuePtr evaluate(class Interpreter & interpreter, std::string filename = "", int line = 0,
                                        size_t column = 0) const = 0;
     virtual std::string       toString() const                  = 0;
+
+    // Let the local resolver bind variable references below this node. Expressions never
+    // declare anything, so the default of binding nothing is always safe.
+    virtual void resolveLocals(LocalResolver & /*resolver*/) {}
+
+    // The type this expression is proven to produce, never null, whenever it returns (see
+    // TypeChecker). The default proves nothing, which keeps every runtime check in place.
+    virtual std::optional<Symbols::Variables::Type> inferType(TypeChecker & /*checker*/) { return std::nullopt; }
+
+    // Evaluate a condition the type checker proved boolean, without the boxed result and
+    // the type test. Only called on such conditions; the default unboxes evaluate().
+    virtual bool evaluateCondition(class Interpreter & interpreter, std::string filename = "", int line = 0,
+                                   size_t column = 0) const {
+        return evaluate(interpreter, std::move(filename), line, column).toBool();
+    }
+
+    // Whether evaluate() gives the same value on every run, wherever it runs: literals and
+    // enum members. A switch whose case labels all are builds a jump table from them.
+    virtual bool constant() const { return false; }
+
+    // The value of a literal; nullptr for any other expression.
+    virtual const Symbols::ValuePtr * literal() const { return nullptr; }
+
+    // Whether evaluate() never gives null, whatever the variables hold: operators, string
+    // building, literals other than null (see LocalResolver::returns).
+    virtual bool neverNull() const { return false; }
+
+    // Fold the children through the optimizer, then return what replaces this expression
+    // (a literal, usually), or nullptr to keep it (see Optimizer).
+    virtual std::unique_ptr<ExpressionNode> fold(Optimizer & /*optimizer*/) { return nullptr; }
+
+    // Lower this expression into a register of the loop being compiled and return it, or
+    // -1 (Bytecode::Compiler::kFailed) if it has no bytecode form; the loop then stays on
+    // the tree walker.
+    virtual int lower(Bytecode::Compiler & /*compiler*/) const { return -1; }
 };
 
 }  // namespace Interpreter
@@ -2,7 +2,7 @@
 
 #include <iostream>
 
-#include "Interpreter/ReturnException.hpp"
+#include "Interpreter/Jit.hpp"
 #include "Interpreter/ThrowException.hpp"
 #include "Symbols/SymbolContainer.hpp"
 #include "Symbols/SymbolFactory.hpp"
@@ -13,12 +13,15 @@
 #include "Nodes/Statement/EnumDeclarationNode.hpp" // Added for EnumDeclarationNode
 #include "Nodes/Statement/SwitchStatementNode.hpp" // Added for SwitchStatementNode
 #include "Nodes/Statement/BreakNode.hpp"         // Added for BreakNode
-#include "Interpreter/BreakException.hpp"        // Added for BreakException
 #include "Interpreter/ExpressionNode.hpp"        // For ExpressionNode::evaluate
 
 
 namespace Interpreter {
 
+void Interpreter::countBackEdge() {
+    Jit::Tier::instance().count(*jitFunction_);
+}
+
 void Interpreter::setThisObject(const Symbols::ValuePtr & obj) {
     thisObject_ = obj;
 }
@@ -65,29 +68,7 @@ bool Interpreter::canAccessPrivateMember(const std::string& targetClassName,
             return true;
         }
         
-        // If it's private, access is only allowed if we're currently executing within the same class
-        // or if we're accessing via $this within the class
-        if (!currentClassName_.empty() && currentClassName_ == targetClassName) {
-            return true;
-        }
-        
-        // Also check if we have a thisObject and it belongs to the target class
-        // Presence check, NOT truthiness: `if (thisObject_)` would have asked whether
-        // the object is "true", so a class instance with an empty member map would have
-        // read as absent and silently skipped this access check.
-        if (!thisObject_->is_null() && thisObject_->getType() == Symbols::Variables::Type::CLASS) {
-            const auto& objMap = thisObject_->get<Symbols::ObjectMap>();
-            auto classMetaIt = objMap.find("$class_name");
-            if (classMetaIt != objMap.end() &&
-                classMetaIt->second->getType() == Symbols::Variables::Type::STRING) {
-                std::string thisClassName = classMetaIt->second->get<std::string>();
-                if (thisClassName == targetClassName) {
-                    return true;
-                }
-            }
-        }
-        
-        return false;
+        return isInsideClass(targetClassName);
         
     } catch (const std::exception& e) {
         // If there's any exception during access checking, default to denying access
@@ -96,7 +77,30 @@ bool Interpreter::canAccessPrivateMember(const std::string& targetClassName,
     }
 }
 
-void Interpreter::run() {
+bool Interpreter::isInsideClass(const std::string& className) const {
+    // Access is allowed if we're currently executing within the same class
+    // or if we're accessing via $this within the class
+    if (!currentClassName_.empty() && currentClassName_ == className) {
+        return true;
+    }
+
+    // Also check if we have a thisObject and it belongs to the target class
+    // Presence check, NOT truthiness: `if (thisObject_)` would have asked whether
+    // the object is "true", so a class instance with an empty member map would have
+    // read as absent and silently skipped this access check.
+    if (!thisObject_->is_null() && thisObject_->getType() == Symbols::Variables::Type::CLASS) {
+        const auto& objMap = thisObject_->get<Symbols::ObjectMap>();
+        auto classMetaIt = objMap.find("$class_name");
+        if (classMetaIt != objMap.end() &&
+            classMetaIt->second->getType() == Symbols::Variables::Type::STRING &&
+            classMetaIt->second->get<std::string>() == className) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Interpreter::run() {
     // Publish this interpreter as the thread's current one for the duration of the run,
     // so native modules can call back into script functions (callUserFunction).
     Interpreter * prev = current_;
@@ -110,8 +114,19 @@ void Interpreter::run() {
     // Determine namespace to execute
     const std::string ns = Symbols::SymbolContainer::instance()->currentScopeName();
     for (const auto & operation : Operations::Container::instance()->getAll(ns)) {
-        runOperation(*operation);
+        const ControlFlowSignal signal = runOperation(*operation);
+        if (signal.kind() == ControlFlowSignal::Kind::Return) {
+            return true;
+        }
+        if (!signal.normal()) {
+            // The parser rejects these; one that still gets here is an error, not an exit.
+            const StatementNode & stmt = *operation->statement;
+            throw Exception(signal.kind() == ControlFlowSignal::Kind::Break ? "'break' outside of a loop or switch" :
+                                                                              "'continue' outside of a loop",
+                            stmt.filename_, stmt.line_, stmt.column_);
+        }
     }
+    return false;
 }
 
 Symbols::ValuePtr Interpreter::callUserFunction(const std::string & name,
@@ -156,32 +171,34 @@ Symbols::ValuePtr Interpreter::callUserFunction(const std::string & name,
     const std::string canonical = funcSym->context().empty()
                                       ? name
                                       : funcSym->context() + Symbols::SymbolContainer::SCOPE_SEPARATOR + name;
-    const std::string callScope = canonical + Symbols::SymbolContainer::CALL_SCOPE + std::to_string(get_unique_call_id());
+    const std::string callScope = canonical + Symbols::SymbolContainer::CALL_SCOPE;
+    const size_t      depth     = sc->getScopeStack().size();
 
-    sc->create(callScope);
+    auto * frame = sc->enterFrame(callScope, Symbols::AtomTable::intern(canonical));
     for (size_t i = 0; i < params.size(); ++i) {
-        sc->addVariable(Symbols::SymbolFactory::createVariable(params[i].name, args[i].clone(), callScope));
+        auto varSym = Symbols::SymbolFactory::createVariable(params[i].name, args[i].clone(), callScope);
+        sc->addVariable(varSym);
+        frame->bindSlot(i, varSym);
     }
 
     Symbols::ValuePtr returnValue;
-    for (const auto & op : Operations::Container::instance()->getAll(canonical)) {
-        try {
-            interpreter.runOperation(*op);
-        } catch (const ReturnException & ret) {
-            returnValue = ret.value();
-            break;
+    try {
+        for (const auto & op : Operations::Container::instance()->getAll(canonical)) {
+            const ControlFlowSignal signal = interpreter.runOperation(*op);
+            if (!signal.normal()) {
+                returnValue = signal.value();
+                break;
+            }
         }
+    } catch (...) {
+        sc->unwindScopeStack(depth);
+        throw;
     }
-
-    if (sc->currentScopeName() == callScope) {
-        sc->enterPreviousScope();
-    } else {
-        sc->validateAndCleanupScopeStack(callScope);
-    }
+    sc->unwindScopeStack(depth);
     return returnValue;
 }
 
-void Interpreter::runOperation(const Operations::Operation & op) {
+ControlFlowSignal Interpreter::runOperation(const Operations::Operation & op) {
 
     if (!op.statement && op.type != Operations::Type::Error) {
         throw Exception("Invalid operation: missing statement", "-", 0, 0);
@@ -193,8 +210,7 @@ void Interpreter::runOperation(const Operations::Operation & op) {
             case Operations::Type::Declaration:
             case Operations::Type::Assignment:
             case Operations::Type::Expression:
-                op.statement->interpret(*this);
-                break;
+                return op.statement->interpret(*this);
 
             // Function-related operations
             case Operations::Type::FuncDeclaration:
@@ -202,16 +218,14 @@ void Interpreter::runOperation(const Operations::Operation & op) {
             case Operations::Type::FunctionCall:
             case Operations::Type::MethodCall:
             case Operations::Type::Return:
-                op.statement->interpret(*this);
-                break;
+                return op.statement->interpret(*this);
 
             // Control flow
             case Operations::Type::Conditional:
             case Operations::Type::Loop:
             case Operations::Type::While:
             case Operations::Type::ControlFlow:  // switch
-                op.statement->interpret(*this);
-                break;
+                return op.statement->interpret(*this);
 
             // Flow control statements
             case Operations::Type::Break:
@@ -224,8 +238,7 @@ void Interpreter::runOperation(const Operations::Operation & op) {
 
             // Special cases
             case Operations::Type::Block:
-                op.statement->interpret(*this);
-                break;
+                return op.statement->interpret(*this);
 
             case Operations::Type::Error:
                 throw Exception("Error operation encountered", "-", 0, 0);
@@ -240,10 +253,7 @@ void Interpreter::runOperation(const Operations::Operation & op) {
     } catch (const std::exception & e) {
         throw Exception(e.what(), "-", 0, 0);
     }
-}
-
-unsigned long long Interpreter::get_unique_call_id() {
-    return next_call_id_++;
+    return {};
 }
 
 Symbols::ValuePtr Interpreter::executeMethod(const Symbols::ValuePtr& objectValue,
@@ -4,9 +4,12 @@
 #include <iostream>
 #include <memory>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "BaseException.hpp"
+#include "Interpreter/ControlFlowSignal.hpp"
 #include "Interpreter/Operation.hpp"
 #include "Interpreter/OperationContainer.hpp"
 #include "Symbols/SymbolContainer.hpp"
@@ -22,35 +25,77 @@ namespace Nodes::Statement {
 
 namespace Interpreter {
 
+namespace Jit {
+struct Function;
+}
+
+struct TailCall;
+
 class Exception : public BaseException {
   public:
-    Exception(const std::string & msg, const std::string & filename, int line, size_t column) {
-        rawMessage_ = msg;
+    /**
+     * @brief @p msg raised at a location, as if it had passed it @p repeats times.
+     *
+     * A location @p msg already starts with is not repeated but counted: an error unwinding
+     * through one recursive call site reads "... line: 5, column: 17 (×4000) << : ...", so
+     * its message stays as short as the error, however deep the recursion.
+     */
+    Exception(const std::string & msg, const std::string & filename, int line, size_t column, size_t repeats = 1) {
         if (filename == "-") {
             context_ = "At line: " + std::to_string(line) + ", column: " + std::to_string(column);
         } else {
             context_ = std::string(" in file \"") + filename + "\" at line: " + std::to_string(line) +
                        ", column: " + std::to_string(column);
         }
+        std::string_view  rest = msg;
+        const std::string head = std::string(kHead) + context_;
+        if (rest.substr(0, head.size()) == head) {
+            std::string_view after = rest.substr(head.size());
+            size_t           count = 1;
+            if (after.substr(0, kCount.size()) == kCount) {
+                after.remove_prefix(kCount.size());
+                count = 0;
+                while (!after.empty() && after.front() >= '0' && after.front() <= '9') {
+                    count = count * 10 + static_cast<size_t>(after.front() - '0');
+                    after.remove_prefix(1);
+                }
+                after = after.substr(0, 1) == ")" ? after.substr(1) : std::string_view();
+            }
+            if (after.substr(0, kTail.size()) == kTail) {
+                repeats += count;
+                rest = after.substr(kTail.size());
+            }
+        }
+        rawMessage_ = rest;
+        if (repeats > 1) {
+            context_ += std::string(kCount) + std::to_string(repeats) + ")";
+        }
         formattedMessage_ = formatMessage();
     }
 
-    std::string formatMessage() const override {
-        return std::string("[Runtime ERROR] >>") + context_ + " << : " + rawMessage_;
-    }
+    std::string formatMessage() const override { return std::string(kHead) + context_ + std::string(kTail) + rawMessage_; }
+
+  private:
+    static constexpr std::string_view kHead  = "[Runtime ERROR] >>";
+    static constexpr std::string_view kCount = " (\u00d7";
+    static constexpr std::string_view kTail  = " << : ";
 };
 
 class Interpreter {
   private:
     bool debug_ = false;
-    static inline unsigned long long next_call_id_ = 0;
+    bool bytecode_ = true;  // run loops that lower to bytecode on the VM (see Bytecode.hpp)
     Symbols::ValuePtr thisObject_;  // Current "this" object for method calls
     std::string currentClassName_;  // Current class context for method execution
+    Jit::Function * jitFunction_ = nullptr;  // tier-up state of the script function running
+    TailCall *      tailCall_    = nullptr;  // the function call running the innermost body
 
     // The interpreter currently executing on this thread. Set for the duration of run()
     // so that native modules can call back into script code (see callUserFunction).
     static inline thread_local Interpreter * current_ = nullptr;
 
+    void countBackEdge();
+
   public:
     /**
      * @brief Construct interpreter with optional debug output
@@ -58,6 +103,49 @@ class Interpreter {
      */
     Interpreter(bool debug = false) : debug_(debug) {}
 
+    /**
+     * @brief Choose the execution engine for loops: the bytecode VM (the default) or the
+     * tree walker for every statement, which is easier to follow when debugging
+     * @param enabled false to walk the tree everywhere
+     */
+    void setBytecodeEnabled(bool enabled) { bytecode_ = enabled; }
+
+    bool bytecodeEnabled() const { return bytecode_; }
+
+    /**
+     * @brief Make @p function the one whose loops backEdge() counts, for the duration of
+     * an interpreted call
+     * @return The previous one, to restore when the call returns
+     */
+    Jit::Function * enterJitFunction(Jit::Function * function) {
+        Jit::Function * previous = jitFunction_;
+        jitFunction_             = function;
+        return previous;
+    }
+
+    /**
+     * @brief Make @p call the function call a `return f(...)` in tail position hands its
+     * call over to (see CallExpressionNode::handOver)
+     * @return The previous one, to restore when the call returns
+     */
+    TailCall * enterTailCall(TailCall * call) {
+        TailCall * previous = tailCall_;
+        tailCall_           = call;
+        return previous;
+    }
+
+    TailCall * tailCall() const { return tailCall_; }
+
+    /**
+     * @brief A loop in the running function went round once (tree walker) or ran to the
+     * end (bytecode VM); adds to the function's JIT heat
+     */
+    void backEdge() {
+        if (jitFunction_) {
+            countBackEdge();
+        }
+    }
+
     /**
      * @brief Sets the current "this" object for method calls
      * @param obj The object to set as "this"
@@ -103,6 +191,14 @@ class Interpreter {
                                const std::string& memberName,
                                bool isProperty) const;
 
+    /**
+     * @brief Check whether the running code may see private members of a class: it is
+     * executing in that class, or on behalf of one of its instances
+     * @param className The class that owns the private member
+     * @return True if private members of the class are accessible here
+     */
+    bool isInsideClass(const std::string& className) const;
+
     /**
      * @brief Execute a method on an object
      * @param objectValue The object instance or name
@@ -115,24 +211,21 @@ class Interpreter {
                                   const std::string& methodName,
                                   const std::vector<Symbols::ValuePtr>& args);
 
-    /**
-     * @brief Get a unique identifier for function/method calls
-     * @return A unique ID for the current call
-     */
-    static unsigned long long get_unique_call_id();
-
     /**
      * @brief Execute all operations in the current namespace
      * Executes operations at file-level or function-level scope
+     * @return true if a top-level `return` ended the script early
+     * @throws Exception if a break or continue reaches the top level outside any loop
      */
-    void run();
+    bool run();
 
     /**
      * @brief Execute a single operation
      * @param op The operation to execute
+     * @return How the statement finished; a break, continue or return is handed to the caller
      * @throws Interpreter::Exception if operation execution fails
      */
-    void runOperation(const Operations::Operation& op);
+    ControlFlowSignal runOperation(const Operations::Operation& op);
 
     /**
      * @brief Invoke a user-defined VoidScript function by name from native code.
@@ -0,0 +1,414 @@
+#include "Interpreter/Jit.hpp"
+
+#include <dlfcn.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <unordered_set>
+
+namespace Interpreter::Jit {
+
+namespace {
+
+using Type     = Symbols::Variables::Type;
+using Bytecode::Op;
+
+// Arguments travel in a fixed array, so wider functions stay interpreted.
+constexpr size_t kMaxParams = 16;
+
+// A function whose native calls keep bailing out goes back to the interpreter for good.
+constexpr std::uint32_t kMaxBails = 8;
+
+// Recursion runs on the native stack; deeper calls are left to the interpreter.
+constexpr size_t kStackBudget = 4u << 20;
+
+const char * cType(Type type) {
+    switch (type) {
+        case Type::INTEGER: return "int";
+        case Type::FLOAT: return "float";
+        case Type::DOUBLE: return "double";
+        case Type::BOOLEAN: return "_Bool";
+        default: return nullptr;
+    }
+}
+
+// The union member of Bytecode::Register holding @p type.
+const char * member(Type type) {
+    switch (type) {
+        case Type::INTEGER: return "i";
+        case Type::FLOAT: return "f";
+        case Type::DOUBLE: return "d";
+        default: return "b";
+    }
+}
+
+// A register's initial contents as a C constant; empty if it has none (inf, nan).
+std::string constant(Type type, const Bytecode::Register & reg) {
+    char text[64];
+    switch (type) {
+        case Type::INTEGER:
+            std::snprintf(text, sizeof text, "(int)(%dLL)", reg.i);
+            break;
+        case Type::FLOAT:
+            if (!std::isfinite(reg.f)) {
+                return {};
+            }
+            std::snprintf(text, sizeof text, "%af", static_cast<double>(reg.f));
+            break;
+        case Type::DOUBLE:
+            if (!std::isfinite(reg.d)) {
+                return {};
+            }
+            std::snprintf(text, sizeof text, "%a", reg.d);
+            break;
+        default:
+            return reg.b ? "1" : "0";
+    }
+    return text;
+}
+
+std::string r(std::int32_t reg) {
+    return "r" + std::to_string(reg);
+}
+
+// One C statement per instruction; empty for an instruction it does not know.
+std::string statement(const Bytecode::Chunk & chunk, const Bytecode::Instr & in) {
+    const std::string a = r(in.a);
+    const std::string b = r(in.b);
+    const std::string c = r(in.c);
+    auto binary = [&](const char * op) { return a + " = " + b + " " + op + " " + c + ";"; };
+    auto branch = [&](const char * op) { return "if (" + b + " " + op + " " + c + ") goto L" + std::to_string(in.a) + ";"; };
+    switch (in.op) {
+        case Op::Move: return a + " = " + b + ";";
+        case Op::IntToFloat: return a + " = (float)" + b + ";";
+        case Op::IntToDouble:
+        case Op::FloatToDouble: return a + " = (double)" + b + ";";
+        case Op::DoubleToFloat: return a + " = (float)" + b + ";";
+
+        case Op::AddI:
+        case Op::AddF:
+        case Op::AddD: return binary("+");
+        case Op::SubI:
+        case Op::SubF:
+        case Op::SubD: return binary("-");
+        case Op::MulI:
+        case Op::MulF:
+        case Op::MulD: return binary("*");
+        case Op::DivF:
+        case Op::DivD: return binary("/");
+        case Op::DivI:
+        case Op::ModI:
+            // INT_MIN / -1 traps in C; let the interpreter decide what it means.
+            return "if (" + c + " == 0 || (" + c + " == -1 && " + b + " == INT_MIN)) longjmp(*bail, 1); " +
+                   binary(in.op == Op::DivI ? "/" : "%");
+        case Op::AndI: return binary("&");
+        case Op::OrI: return binary("|");
+        case Op::XorI: return binary("^");
+        case Op::ShlI:
+            return "if ((unsigned)" + c + " >= 32u) longjmp(*bail, 1); " + a + " = (int)((unsigned)" + b + " << " + c +
+                   ");";
+        case Op::ShrI: return "if ((unsigned)" + c + " >= 32u) longjmp(*bail, 1); " + binary(">>");
+        case Op::NegI:
+        case Op::NegF:
+        case Op::NegD: return a + " = -" + b + ";";
+        case Op::NotI: return a + " = ~" + b + ";";
+
+        case Op::EqI:
+        case Op::EqF:
+        case Op::EqD:
+        case Op::EqB: return binary("==");
+        case Op::NeI:
+        case Op::NeF:
+        case Op::NeD:
+        case Op::NeB: return binary("!=");
+        case Op::LtI:
+        case Op::LtF:
+        case Op::LtD: return binary("<");
+        case Op::LeI:
+        case Op::LeF:
+        case Op::LeD: return binary("<=");
+        case Op::GtI:
+        case Op::GtF:
+        case Op::GtD: return binary(">");
+        case Op::GeI:
+        case Op::GeF:
+        case Op::GeD: return binary(">=");
+        case Op::AndB: return binary("&&");
+        case Op::OrB: return binary("||");
+        case Op::NotB: return a + " = !" + b + ";";
+
+        case Op::JumpIfLtI: return branch("<");
+        case Op::JumpIfLeI: return branch("<=");
+        case Op::JumpIfGtI: return branch(">");
+        case Op::JumpIfGeI: return branch(">=");
+        case Op::Jump: return "goto L" + std::to_string(in.a) + ";";
+        case Op::JumpIfFalse: return "if (!" + b + ") goto L" + std::to_string(in.a) + ";";
+
+        case Op::Call: {
+            std::string call = a + " = vs_fn(bail, depth + 1";
+            for (std::int32_t i = 0; i < in.c; ++i) {
+                call += ", " + r(chunk.operands[in.b + i]);
+            }
+            return call + ");";
+        }
+        case Op::Return: return "return " + b + ";";
+        case Op::Halt: return "longjmp(*bail, 1);";  // fell off the end without a return
+
+        // Loops only: function mode never emits them.
+        case Op::MoveS:
+        case Op::Concat:
+        case Op::IntToString:
+        case Op::FloatToString:
+        case Op::DoubleToString:
+        case Op::BoolToString:
+        case Op::EqS:
+        case Op::NeS:
+        case Op::Invoke: return {};
+    }
+    return {};
+}
+
+}  // namespace
+
+Tier & Tier::instance() {
+    static Tier tier;
+    return tier;
+}
+
+Tier::~Tier() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        queue_.clear();
+    }
+    wake_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+void Tier::configure(std::uint32_t threshold, bool background) {
+    threshold_  = threshold;
+    background_ = background;
+}
+
+std::shared_ptr<Function> Tier::function(const std::shared_ptr<Symbols::FunctionSymbol> &              symbol,
+                                         const std::vector<std::shared_ptr<Operations::Operation>> * body) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &                      fn = functions_[symbol.get()];
+    if (!fn || fn->symbol.lock() != symbol) {
+        fn             = std::make_shared<Function>();
+        fn->symbol     = symbol;
+        fn->body       = body;
+        fn->returnType = symbol->returnType();
+        for (const auto & param : symbol->parameters()) {
+            fn->params.push_back(param.type);
+        }
+    }
+    return fn;
+}
+
+bool Tier::call(Function & fn, const std::vector<Symbols::ValuePtr> & args, Symbols::ValuePtr & result) {
+    const Entry entry = fn.entry.load(std::memory_order_acquire);
+    if (!entry || args.size() != fn.params.size()) {
+        return false;
+    }
+    // The interpreter binds arguments as they are, so only the declared types match.
+    Bytecode::Register in[kMaxParams];
+    for (size_t i = 0; i < args.size(); ++i) {
+        const auto & arg = args[i];
+        if (arg.getType() != fn.params[i] || arg->is_null()) {
+            return false;
+        }
+        switch (fn.params[i]) {
+            case Type::INTEGER: in[i].i = arg.get<int>(); break;
+            case Type::FLOAT: in[i].f = arg.get<float>(); break;
+            case Type::DOUBLE: in[i].d = arg.get<double>(); break;
+            default: in[i].b = arg.get<bool>(); break;
+        }
+    }
+
+    Bytecode::Register out;
+    if (entry(in, &out) != 0) {
+        if (fn.bails.fetch_add(1, std::memory_order_relaxed) + 1 >= kMaxBails) {
+            fn.entry.store(nullptr, std::memory_order_release);
+            fn.stage.store(Function::Stage::Rejected, std::memory_order_relaxed);
+        }
+        return false;
+    }
+    switch (fn.returnType) {
+        case Type::INTEGER: result = Symbols::ValuePtr(out.i); break;
+        case Type::FLOAT: result = Symbols::ValuePtr(out.f); break;
+        case Type::DOUBLE: result = Symbols::ValuePtr(out.d); break;
+        default: result = Symbols::ValuePtr(out.b); break;
+    }
+    return true;
+}
+
+void Tier::drain() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return queue_.empty() && !busy_; });
+}
+
+std::string Tier::translate(const Bytecode::Chunk & chunk, Type returnType) {
+    const char * ret = cType(returnType);
+    if (!ret || chunk.params > static_cast<int>(kMaxParams)) {
+        return {};
+    }
+
+    std::unordered_set<std::int32_t> targets;
+    for (const auto & in : chunk.code) {
+        switch (in.op) {
+            case Op::Jump:
+            case Op::JumpIfFalse:
+            case Op::JumpIfLtI:
+            case Op::JumpIfLeI:
+            case Op::JumpIfGtI:
+            case Op::JumpIfGeI:
+                targets.insert(in.a);
+                break;
+            default:
+                break;
+        }
+    }
+
+    std::string params;
+    std::string args;
+    for (int i = 0; i < chunk.params; ++i) {
+        params += std::string(", ") + cType(chunk.types[i]) + " " + r(i);
+        args += std::string(", args[") + std::to_string(i) + "]." + member(chunk.types[i]);
+    }
+    const size_t frame = 64 + 8 * chunk.types.size();
+
+    std::string src =
+        "#include <limits.h>\n"
+        "#include <setjmp.h>\n"
+        "typedef union { int i; float f; double d; _Bool b; } vs_jit_value;\n"
+        "static " + std::string(ret) + " vs_fn(jmp_buf * bail, int depth" + params + ") {\n"
+        "    if (depth > " + std::to_string(kStackBudget / frame) + ") longjmp(*bail, 1);\n";
+    for (size_t reg = chunk.params; reg < chunk.types.size(); ++reg) {
+        const char * type = cType(chunk.types[reg]);
+        const auto   init = type ? constant(chunk.types[reg], chunk.registers[reg]) : std::string();
+        if (init.empty()) {
+            return {};
+        }
+        src += std::string("    ") + type + " " + r(static_cast<std::int32_t>(reg)) + " = " + init + ";\n";
+    }
+    for (size_t at = 0; at < chunk.code.size(); ++at) {
+        const std::string stmt = statement(chunk, chunk.code[at]);
+        if (stmt.empty()) {
+            return {};
+        }
+        if (targets.count(static_cast<std::int32_t>(at))) {
+            src += "L" + std::to_string(at) + ":;\n";
+        }
+        src += "    " + stmt + "\n";
+    }
+    src += "}\n"
+           "int vs_jit_entry(const vs_jit_value * args, vs_jit_value * result) {\n"
+           "    jmp_buf bail;\n"
+           "    if (setjmp(bail)) return 1;\n"
+           "    result->" + std::string(member(returnType)) + " = vs_fn(&bail, 0" + args + ");\n"
+           "    return 0;\n"
+           "}\n";
+    return src;
+}
+
+void Tier::promote(Function & fn) {
+    auto expected = Function::Stage::Cold;
+    if (!fn.stage.compare_exchange_strong(expected, Function::Stage::Queued)) {
+        return;
+    }
+    const auto symbol = fn.symbol.lock();
+    std::string source;
+    if (symbol && fn.body && !fn.body->empty() && fn.params.size() <= kMaxParams) {
+        const auto &        first = *fn.body->front()->statement;
+        Bytecode::Compiler compiler(Symbols::AtomTable::intern(symbol->name()), symbol->parameters(), fn.returnType,
+                                    first.filename_, first.line_, first.column_);
+        bool lowered = true;
+        for (const auto & op : *fn.body) {
+            if (!op->statement || !op->statement->lower(compiler)) {
+                lowered = false;
+                break;
+            }
+        }
+        if (lowered) {
+            source = translate(*compiler.finish(), fn.returnType);
+        }
+    }
+    if (source.empty()) {
+        fn.stage.store(Function::Stage::Rejected, std::memory_order_relaxed);
+        return;
+    }
+
+    Job job{ fn.shared_from_this(), std::move(source) };
+    if (!background_) {
+        build(job);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(job));
+        if (!worker_.joinable()) {
+            worker_ = std::thread([this] { work(); });
+        }
+    }
+    wake_.notify_one();
+}
+
+void Tier::work() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+        if (stop_) {
+            return;
+        }
+        const Job job = std::move(queue_.front());
+        queue_.pop_front();
+        busy_ = true;
+        lock.unlock();
+        build(job);
+        lock.lock();
+        busy_ = false;
+        idle_.notify_all();
+    }
+}
+
+void Tier::build(const Job & job) {
+    namespace fs = std::filesystem;
+    Function & fn = *job.fn;
+
+    std::error_code ec;
+    std::string     dirTemplate = (fs::temp_directory_path(ec) / "voidscript-jit-XXXXXX").string();
+    Entry           entry       = nullptr;
+    if (!ec && ::mkdtemp(dirTemplate.data())) {
+        const fs::path dir    = dirTemplate;
+        const fs::path source = dir / "function.c";
+        const fs::path shared = dir / "function.so";
+        std::ofstream(source) << job.source;
+
+        const char *      cc      = std::getenv("CC");
+        const std::string command = std::string(cc && *cc ? cc : "cc") +
+                                    " -O2 -fPIC -shared -fwrapv -ffp-contract=off -w -o \"" + shared.string() + "\" \"" +
+                                    source.string() + "\" >/dev/null 2>&1";
+        if (std::system(command.c_str()) == 0) {
+            // Never closed: call sites may be running the code until the process exits.
+            if (void * handle = ::dlopen(shared.c_str(), RTLD_NOW | RTLD_LOCAL)) {
+                entry = reinterpret_cast<Entry>(::dlsym(handle, "vs_jit_entry"));
+            }
+        }
+        fs::remove_all(dir, ec);
+    }
+
+    if (entry) {
+        fn.entry.store(entry, std::memory_order_release);
+        fn.stage.store(Function::Stage::Native, std::memory_order_relaxed);
+    } else {
+        fn.stage.store(Function::Stage::Rejected, std::memory_order_relaxed);
+    }
+}
+
+}  // namespace Interpreter::Jit
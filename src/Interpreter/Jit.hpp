@@ -0,0 +1,138 @@
+#ifndef INTERPRETER_JIT_HPP
+#define INTERPRETER_JIT_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Interpreter/Bytecode.hpp"
+#include "Interpreter/Operation.hpp"
+#include "Symbols/FunctionSymbol.hpp"
+#include "Symbols/Value.hpp"
+#include "Symbols/VariableTypes.hpp"
+
+namespace Interpreter::Jit {
+
+/**
+ * @brief A compiled function: the arguments in, the return value out. Nonzero means the
+ * native code gave up (a division by zero, a shift out of range, recursion too deep, the
+ * end of the body reached without a return) and the call must run on the interpreter.
+ */
+using Entry = int (*)(const Bytecode::Register * args, Bytecode::Register * result);
+
+/** @brief Tier-up state of one script function, shared by every call site resolving to it. */
+struct Function : std::enable_shared_from_this<Function> {
+    enum class Stage : std::uint8_t {
+        Cold,      // interpreted; counting calls and loop back-edges
+        Queued,    // lowered, waiting for the C compiler
+        Native,    // entry is set
+        Rejected,  // does not lower, failed to compile or keeps bailing out
+    };
+
+    std::atomic<std::uint32_t> heat{ 0 };
+    std::atomic<Stage>         stage{ Stage::Cold };
+    std::atomic<Entry>         entry{ nullptr };
+    std::atomic<std::uint32_t> bails{ 0 };
+
+    std::weak_ptr<Symbols::FunctionSymbol>                      symbol;
+    const std::vector<std::shared_ptr<Operations::Operation>> * body = nullptr;
+    std::vector<Symbols::Variables::Type>                       params;
+    Symbols::Variables::Type                                    returnType = Symbols::Variables::Type::NULL_TYPE;
+};
+
+/**
+ * @brief The tier-up from the interpreter to native code, process-wide and off by default
+ * (VoidScript::setJitThreshold, `--jit`).
+ *
+ * Every interpreted call of a script function and every loop iteration inside one adds to
+ * its heat. When the heat reaches the threshold, the body is lowered with the loop
+ * Bytecode::Compiler in function mode, the chunk is translated to C, and the C compiler
+ * builds it into a shared object on a background thread; the entry point is loaded with
+ * dlopen() and published to the call sites, which run the native version from then on.
+ *
+ * Only pure scalar functions tier up: int, float, double and bool parameters and return
+ * value, a body of what the loop VM runs plus `return` and calls of the function itself,
+ * and no reads of anything declared outside it. Everything else stays interpreted, and so
+ * does a call whose arguments do not have exactly the declared types. Native code repeats
+ * nothing the interpreter would observe, so when it bails out the call simply runs again
+ * interpreted and reports the error the interpreter always reported.
+ */
+class Tier {
+  public:
+    static Tier & instance();
+
+    ~Tier();
+
+    /**
+     * @param threshold Heat at which a function is compiled; 0 turns the tier off.
+     * @param background Compile on a worker thread (false: on the calling thread, so the
+     *        function is native as soon as the threshold is reached).
+     */
+    void configure(std::uint32_t threshold, bool background = true);
+
+    bool enabled() const { return threshold_ != 0; }
+
+    /** @brief The state of @p symbol, whose body is @p body; created on first use. */
+    std::shared_ptr<Function> function(const std::shared_ptr<Symbols::FunctionSymbol> &              symbol,
+                                       const std::vector<std::shared_ptr<Operations::Operation>> * body);
+
+    /** @brief Add @p events calls or back-edges to @p fn's heat; may start its compilation. */
+    void count(Function & fn, std::uint32_t events = 1) {
+        if (fn.stage.load(std::memory_order_relaxed) == Function::Stage::Cold &&
+            fn.heat.fetch_add(events, std::memory_order_relaxed) + events >= threshold_) {
+            promote(fn);
+        }
+    }
+
+    /**
+     * @brief Run @p fn natively when it has been compiled and the arguments have exactly
+     * its parameter types.
+     * @return false if the call has to be interpreted; @p result is untouched.
+     */
+    static bool call(Function & fn, const std::vector<Symbols::ValuePtr> & args, Symbols::ValuePtr & result);
+
+    /** @brief Block until every queued compilation has finished. */
+    void drain();
+
+    /**
+     * @brief The C translation of a function chunk (Bytecode::Compiler in function mode),
+     * or an empty string if it cannot be translated.
+     */
+    static std::string translate(const Bytecode::Chunk & chunk, Symbols::Variables::Type returnType);
+
+  private:
+    struct Job {
+        std::shared_ptr<Function> fn;
+        std::string               source;
+    };
+
+    Tier() = default;
+
+    void promote(Function & fn);
+    void build(const Job & job);
+    void work();
+
+    std::uint32_t threshold_  = 0;
+    bool          background_ = true;
+
+    std::mutex              mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::deque<Job>         queue_;
+    bool                    busy_ = false;
+    bool                    stop_ = false;
+    std::thread             worker_;
+    // Keyed by address; Function::symbol tells a reused address from the same symbol.
+    std::unordered_map<const Symbols::FunctionSymbol *, std::shared_ptr<Function>> functions_;
+};
+
+}  // namespace Interpreter::Jit
+
+#endif  // INTERPRETER_JIT_HPP
@@ -0,0 +1,291 @@
+#ifndef INTERPRETER_LOCAL_RESOLVER_HPP
+#define INTERPRETER_LOCAL_RESOLVER_HPP
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Symbols/Atom.hpp"
+#include "Symbols/FunctionParameterInfo.hpp"
+#include "Symbols/FunctionSymbol.hpp"
+
+namespace Interpreter {
+
+/**
+ * @brief Where a resolved local lives at run time: the call frame is the scope @c depth
+ * levels below the innermost one (one level per enclosing loop scope), and the variable
+ * is slot @c slot of that frame. @c frame names the function whose call frames carry the
+ * slots; a scope tagged otherwise is not the frame, and the reader falls back. An unbound
+ * slot means "use the name lookup".
+ */
+struct LocalSlot {
+    int           depth = -1;
+    int           slot  = -1;
+    Symbols::Atom frame = Symbols::kNoAtom;
+
+    bool bound() const { return slot >= 0; }
+};
+
+/**
+ * @brief Binds variable references inside one function body to frame slots.
+ *
+ * Runs once per function after its body has been parsed (see Parser::parseFunctionDefinition).
+ * Statement and expression nodes report what they declare and reference through
+ * resolveLocals(); finish() then assigns the slots.
+ *
+ * Scoping at run time is dynamic (a function sees its callers' variables), so only
+ * names the function itself owns are bound: parameters, which take slots 0..n-1, and
+ * variables declared at function level. A loop pushes its own scope, tagged with an
+ * atom of its own (enterLoop()), and the variables declared in it take slots of that
+ * scope. A reference is bound to the innermost enclosing scope declaring its name, and
+ * only when no scope in between may hold the same name. Any statement the resolver
+ * cannot see into makes the whole function fall back to name lookups. An empty slot at run time (a declaration that has not run yet) also
+ * falls back, so binding never changes which variable a name refers to.
+ *
+ * The resolver also finds the `return f(...)` statements in tail position, i.e. outside
+ * a try body, whose catch would have to see the errors of f; they get the depth of the
+ * call frame below them, so that the return can find it and hand the call over (see
+ * CallExpressionNode::handOver).
+ *
+ * Last, it works out what the function can reach beyond its own frames (reach()): the
+ * names it may look up in a caller's scopes, the functions it calls, and whether a return
+ * may give null. The bytecode VM calls a function from a compiled loop only when none of
+ * those names is one the loop keeps in a register (see Bytecode::Compiler::call).
+ */
+class LocalResolver {
+  public:
+    /**
+     * @param frame  Atom of the function's scope name; its call scopes are tagged with it.
+     * @param params The function's parameters, bound by the call to slots 0..n-1.
+     */
+    LocalResolver(Symbols::Atom frame, const std::vector<Symbols::FunctionParameterInfo> & params) : frame_(frame) {
+        blocks_.push_back({ {}, {}, frame, 0 });
+        open_.push_back(0);
+        for (const auto & param : params) {
+            params_.push_back(param.name);
+        }
+    }
+
+    /**
+     * @brief A loop scope starts; declarations and references below belong to it.
+     * @return The atom the loop tags its scope with (SymbolContainer::enterLoopFrame()).
+     */
+    Symbols::Atom enterLoop() {
+        const Symbols::Atom loop =
+            Symbols::AtomTable::intern(Symbols::AtomTable::name(frame_) + "::loop_" + std::to_string(blocks_.size()));
+        open_.push_back(blocks_.size());
+        blocks_.push_back({ {}, {}, loop, branches_ });
+        return loop;
+    }
+
+    void exitLoop() { open_.pop_back(); }
+
+    /** @brief The body of a try starts; a return in it is not in tail position. */
+    void enterTry() { ++tries_; }
+
+    void exitTry() { --tries_; }
+
+    /**
+     * @brief Code that may not run whenever the statement around it does starts: a branch
+     * of an if or switch, a try or catch body. A declaration in it may leave its name unset.
+     */
+    void enterBranch() { ++branches_; }
+
+    void exitBranch() { --branches_; }
+
+    /**
+     * @brief A `type $name = ...;` declaration, or a variable a loop binds itself; gets a
+     * slot of the current scope.
+     */
+    void declareLocal(const std::string & name, LocalSlot & target) {
+        target = LocalSlot{};
+        const size_t block = open_.back();
+        blocks_[block].locals.push_back({ name, &target, order_++, branches_ > blocks_[block].branches });
+    }
+
+    /** @brief A name the current scope gains some other way (constants, catch variables). */
+    void declareOther(const std::string & name) { blocks_[open_.back()].others.insert(name); }
+
+    void reference(const std::string & name, LocalSlot & target) {
+        target = LocalSlot{};
+        refs_.push_back({ name, std::vector<size_t>(open_.begin() + 1, open_.end()), &target, order_++ });
+    }
+
+    /** @brief A call of the function @p name, resolved when it is made. */
+    void call(const std::string & name) { calls_.push_back(name); }
+
+    /**
+     * @brief The statement runs code the resolver does not see (a method, a constructor, a
+     * nested function definition). Slots are still bound; only reach() gives up.
+     */
+    void escapes() { escapes_ = true; }
+
+    /** @brief A return; @p neverNull if its value cannot be null (ExpressionNode::neverNull). */
+    void returns(bool neverNull) { nullable_ = nullable_ || !neverNull; }
+
+    /** @brief A `return f(...)`; @p target gets the call frame's depth if it is a tail call. */
+    void tailCall(LocalSlot & target) {
+        target = LocalSlot{};
+        if (tries_ == 0) {
+            tailCalls_.push_back({ static_cast<int>(open_.size()) - 1, &target });
+        }
+    }
+
+    /** @brief Resolve an optional child node (a null pointer is skipped). */
+    template <typename Node> void resolve(Node & node) {
+        if (node) {
+            node->resolveLocals(*this);
+        }
+    }
+
+    /** @brief Resolve a statement list in order. */
+    template <typename Statements> void resolveBody(Statements & body) {
+        for (auto & stmt : body) {
+            resolve(stmt);
+        }
+    }
+
+    /** @brief The resolver cannot see inside the current statement; bind nothing. */
+    void opaque() { opaque_ = true; }
+
+    /** @brief What the function reaches beyond its frames; set by finish(). */
+    std::shared_ptr<const Symbols::FunctionReach> reach() const { return reach_; }
+
+    /** @brief Assign slots; returns the number of slots the function's frame uses. */
+    int finish() {
+        auto reach = std::make_shared<Symbols::FunctionReach>();
+        reach_     = reach;
+        if (opaque_) {
+            return 0;
+        }
+        reach->known    = !escapes_;
+        reach->calls    = calls_;
+        reach->nullable = nullable_;
+        for (const auto & call : tailCalls_) {
+            *call.target = LocalSlot{ call.depth, 0, frame_ };
+        }
+
+        std::vector<Slots> slots(blocks_.size());
+        for (size_t b = 0; b < blocks_.size(); ++b) {
+            auto & scope = slots[b];
+            // Names the scope may gain without a tracked declaration cannot live in a slot.
+            scope.unbindable = blocks_[b].others;
+            if (b == 0) {
+                // Parameter i is always slot i; that is where the call binds it.
+                for (size_t i = 0; i < params_.size(); ++i) {
+                    if (!scope.index.emplace(params_[i], static_cast<int>(i)).second) {
+                        scope.unbindable.insert(params_[i]);
+                    }
+                }
+                scope.count = static_cast<int>(params_.size());
+            }
+            const int params = scope.count;
+            for (const auto & decl : blocks_[b].locals) {
+                auto [it, inserted] = scope.index.emplace(decl.name, scope.count);
+                if (inserted) {
+                    ++scope.count;
+                } else if (it->second < params) {
+                    // Redeclaring a parameter fails at run time; leave it to the name lookup.
+                    scope.unbindable.insert(decl.name);
+                }
+            }
+            for (const auto & decl : blocks_[b].locals) {
+                if (!scope.unbindable.count(decl.name)) {
+                    *decl.target = LocalSlot{ 0, scope.index.at(decl.name), blocks_[b].frame };
+                }
+            }
+        }
+
+        std::unordered_set<std::string> reached;
+        for (const auto & ref : refs_) {
+            // The innermost scope that may hold the name is the one the lookup finds.
+            bool own = false;
+            for (size_t level = ref.loops.size() + 1; level-- > 0;) {
+                const size_t block = level == 0 ? 0 : ref.loops[level - 1];
+                const auto & scope = slots[block];
+                auto         it    = scope.index.find(ref.name);
+                if (it == scope.index.end() && !scope.unbindable.count(ref.name)) {
+                    continue;
+                }
+                if (it != scope.index.end() && !scope.unbindable.count(ref.name)) {
+                    *ref.target = LocalSlot{ static_cast<int>(ref.loops.size() - level), it->second,
+                                             blocks_[block].frame };
+                    own = (block == 0 && it->second < static_cast<int>(params_.size())) || declared(block, ref);
+                }
+                break;
+            }
+            // Otherwise the slot may still be empty when the reference runs, and the lookup
+            // goes on into the caller's scopes.
+            if (!own && reached.insert(ref.name).second) {
+                reach->names.push_back(Symbols::AtomTable::intern(ref.name));
+            }
+        }
+        return slots.front().count;
+    }
+
+  private:
+    struct Declaration {
+        std::string name;
+        LocalSlot * target;
+        size_t      order;        // position in the walk, among declarations and references
+        bool        conditional;  // inside a branch of its block
+    };
+
+    struct Block {
+        std::vector<Declaration>        locals;
+        std::unordered_set<std::string> others;
+        Symbols::Atom                   frame;     // tag of the scope at run time
+        int                             branches;  // branch depth the block opened at
+    };
+
+    struct Slots {
+        std::unordered_map<std::string, int> index;
+        std::unordered_set<std::string>      unbindable;
+        int                                  count = 0;
+    };
+
+    struct Reference {
+        std::string         name;
+        std::vector<size_t> loops;  // enclosing loop blocks, outermost first
+        LocalSlot *         target;
+        size_t              order;
+    };
+
+    struct TailCall {
+        int         depth;  // enclosing loop scopes
+        LocalSlot * target;
+    };
+
+    Symbols::Atom            frame_;
+    std::vector<std::string> params_;
+    std::vector<Block>       blocks_;  // [0] is the function frame itself
+    std::vector<size_t>      open_;
+    std::vector<Reference>   refs_;
+    std::vector<TailCall>    tailCalls_;
+    std::vector<std::string> calls_;
+    int                      tries_    = 0;
+    int                      branches_ = 0;
+    size_t                   order_    = 0;
+    bool                     opaque_   = false;
+    bool                     escapes_  = false;
+    bool                     nullable_ = false;
+
+    std::shared_ptr<const Symbols::FunctionReach> reach_;
+
+    // Whether @p block surely holds @p ref's name when it runs: a declaration of it on every
+    // path through the block came first.
+    bool declared(size_t block, const Reference & ref) const {
+        for (const auto & decl : blocks_[block].locals) {
+            if (decl.name == ref.name && decl.order < ref.order && !decl.conditional) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+}  // namespace Interpreter
+
+#endif  // INTERPRETER_LOCAL_RESOLVER_HPP
@@ -5,6 +5,8 @@
 #include <string>
 
 #include "Interpreter/ExpressionNode.hpp"
+#include "Interpreter/LocalResolver.hpp"
+#include "Interpreter/Optimizer.hpp"
 #include "Interpreter/Interpreter.hpp"
 #include "Symbols/Value.hpp"
 
@@ -33,9 +35,60 @@ class ArrayAccessExpressionNode : public ExpressionNode {
         if (container != Symbols::Variables::Type::OBJECT && container != Symbols::Variables::Type::CLASS) {
             throw Exception("Attempted to index non-array", filename_, line_, column_);
         }
-        const auto & map    = container->get<Symbols::ObjectMap>();
         // Evaluate the index
-        auto         idxVal = indexExpr_->evaluate(interpreter, filename_, line_, column_);
+        auto idxVal = indexExpr_->evaluate(interpreter, filename_, line_, column_);
+        Symbols::ValuePtr element = lookup(container, idxVal);
+        // Handing out a nested object/array of a copy-on-write payload would let a write
+        // through it reach the other copy as well, so split this copy first.
+        if ((element == Symbols::Variables::Type::OBJECT || element == Symbols::Variables::Type::CLASS) &&
+            container->isShared()) {
+            container->unshare();
+            element = lookup(container, idxVal);
+        }
+        return element;
+    }
+
+    void resolveLocals(LocalResolver & resolver) override {
+        resolver.resolve(arrayExpr_);
+        resolver.resolve(indexExpr_);
+    }
+
+    std::unique_ptr<ExpressionNode> fold(Optimizer & optimizer) override {
+        optimizer.fold(arrayExpr_);
+        optimizer.fold(indexExpr_);
+        return nullptr;
+    }
+
+    std::string toString() const override { return arrayExpr_->toString() + "[" + indexExpr_->toString() + "]"; }
+
+  private:
+    // Read-only element lookup; goes through the const accessors so it never splits a
+    // shared payload. Returns undefined when the key is absent.
+    static Symbols::ValuePtr lookup(const Symbols::ValuePtr & container, const Symbols::ValuePtr & idxVal) {
+        if (container->isArray()) {
+            // Dense array: index the vector directly. A string key is only an element
+            // when it is a canonical index ("3"); anything else cannot be present.
+            const auto & elements = container->get<Symbols::ArrayVector>();
+            size_t       index    = 0;
+            if (idxVal == Symbols::Variables::Type::INTEGER) {
+                const int i = idxVal->get<int>();
+                if (i < 0) {
+                    return Symbols::ValuePtr::undefined();
+                }
+                index = static_cast<size_t>(i);
+            } else if (idxVal == Symbols::Variables::Type::STRING) {
+                if (!Symbols::Value::parseArrayIndex(idxVal.get<std::string>(), index)) {
+                    return Symbols::ValuePtr::undefined();
+                }
+            } else {
+                throw std::runtime_error("Array index must be integer or string");
+            }
+            if (index >= elements.size()) {
+                return Symbols::ValuePtr::undefined();
+            }
+            return elements[index];
+        }
+        const auto & map = container->get<Symbols::ObjectMap>();
         std::string  key;
         if (idxVal == Symbols::Variables::Type::INTEGER) {
             key = std::to_string(idxVal->get<int>());
@@ -52,9 +105,6 @@ class ArrayAccessExpressionNode : public ExpressionNode {
         return it->second;
     }
 
-    std::string toString() const override { return arrayExpr_->toString() + "[" + indexExpr_->toString() + "]"; }
-
-  private:
     std::unique_ptr<ExpressionNode> arrayExpr_;
     std::unique_ptr<ExpressionNode> indexExpr_;
     std::string                     filename_;
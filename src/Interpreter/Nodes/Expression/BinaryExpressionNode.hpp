@@ -3,339 +3,279 @@
 #include <sstream>  // For std::stringstream
 #include <string>
 
+#include "Interpreter/Bytecode.hpp"
 #include "Interpreter/ExpressionNode.hpp"
+#include "Interpreter/LocalResolver.hpp"
+#include "Interpreter/Nodes/Expression/LiteralExpressionNode.hpp"
+#include "Interpreter/Operator.hpp"
+#include "Interpreter/Optimizer.hpp"
+#include "Interpreter/TypeChecker.hpp"
 #include "Symbols/Value.hpp" // Required for ValuePtr and TypeToString
 
 namespace Interpreter {
+/**
+ * @brief lhs op rhs. The operator is resolved to a BinaryOperator when the node is built;
+ * evaluation picks the kernel for the operand types (bool, int, float/double promotion,
+ * string) and switches on the operator inside it.
+ */
 class BinaryExpressionNode : public ExpressionNode {
     std::unique_ptr<ExpressionNode> lhs_;
     std::unique_ptr<ExpressionNode> rhs_;
-    std::string                     op_;
+    std::string                     op_;  // spelling, for messages and toString()
+    BinaryOperator                  operator_;
 
   public:
     BinaryExpressionNode(std::unique_ptr<ExpressionNode> lhs, std::string op, std::unique_ptr<ExpressionNode> rhs) :
         lhs_(std::move(lhs)),
         rhs_(std::move(rhs)),
-        op_(std::move(op)) {}
+        op_(std::move(op)),
+        operator_(binaryOperator(op_)) {}
 
     Symbols::ValuePtr evaluate(Interpreter & interpreter, std::string filename, int line,
                                size_t column) const override {
 
         auto leftVal  = lhs_->evaluate(interpreter, filename, line, column);
         auto rightVal = rhs_->evaluate(interpreter, filename, line, column);
+        return apply(leftVal, rightVal);
+    }
 
+    // A comparison of two numbers of one type answers without boxing its result; anything
+    // else goes through the kernels.
+    bool evaluateCondition(Interpreter & interpreter, std::string filename, int line, size_t column) const override {
+        auto leftVal  = lhs_->evaluate(interpreter, filename, line, column);
+        auto rightVal = rhs_->evaluate(interpreter, filename, line, column);
+
+        using Symbols::Variables::Type;
+        const Type type = leftVal.getType();
+        if (isComparison(operator_) && type == rightVal.getType() && !leftVal->is_null() && !rightVal->is_null()) {
+            switch (type) {
+                case Type::INTEGER:
+                    return compare(leftVal.get<int>(), rightVal.get<int>());
+                case Type::DOUBLE:
+                    return compare(leftVal.get<double>(), rightVal.get<double>());
+                case Type::FLOAT:
+                    return compare(leftVal.get<float>(), rightVal.get<float>());
+                default:
+                    break;
+            }
+        }
+        return apply(leftVal, rightVal).toBool();
+    }
+
+    std::optional<Symbols::Variables::Type> inferType(TypeChecker & checker) override {
+        const auto lhs    = checker.infer(lhs_);
+        const auto rhs    = checker.infer(rhs_);
+        bool       fails  = false;
+        const auto proven = TypeChecker::binary(operator_, lhs, rhs, fails);
+        if (fails) {
+            checker.error("Unsupported types in binary expression: " + Symbols::Variables::TypeToString(*lhs) +
+                              " and " + Symbols::Variables::TypeToString(*rhs) + " " + toString(),
+                          *this);
+        }
+        return proven;
+    }
+
+    // A null operand compares or gives false.
+    bool neverNull() const override { return true; }
 
+    void resolveLocals(LocalResolver & resolver) override {
+        resolver.resolve(lhs_);
+        resolver.resolve(rhs_);
+    }
+
+    std::unique_ptr<ExpressionNode> fold(Optimizer & optimizer) override {
+        optimizer.fold(lhs_);
+        optimizer.fold(rhs_);
+        const auto * lhs = Optimizer::literal(lhs_);
+        const auto * rhs = Optimizer::literal(rhs_);
+        if (!lhs || !rhs) {
+            return nullptr;
+        }
+        try {
+            return std::make_unique<LiteralExpressionNode>(apply(*lhs, *rhs));
+        } catch (const std::exception &) {
+            return nullptr;  // fails the same way when it runs
+        }
+    }
+
+    int lower(Bytecode::Compiler & compiler) const override {
+        const int lhs = lhs_->lower(compiler);
+        if (lhs == Bytecode::Compiler::kFailed) {
+            return lhs;
+        }
+        return compiler.binary(operator_, lhs, rhs_->lower(compiler));
+    }
+
+    std::string toString() const override { return "(" + lhs_->toString() + " " + op_ + " " + rhs_->toString() + ")"; }
+
+  private:
+    Symbols::ValuePtr apply(const Symbols::ValuePtr & leftVal, const Symbols::ValuePtr & rightVal) const {
         // Handle NULL values in comparisons
         if (leftVal->is_null() || rightVal->is_null()) {
-            if (op_ == "==") {
+            if (operator_ == BinaryOperator::Equal) {
                 return leftVal->is_null() == rightVal->is_null();
             }
-            if (op_ == "!=") {
+            if (operator_ == BinaryOperator::NotEqual) {
                 return leftVal->is_null() != rightVal->is_null();
             }
             return false;
         }
 
-        // Boolean operations
-        if (leftVal == Symbols::Variables::Type::BOOLEAN && rightVal == Symbols::Variables::Type::BOOLEAN) {
-            bool l = leftVal.toBool();
-            bool r = rightVal.toBool();
-            if (op_ == "&&") {
-                return l && r;
-                //return std::make_shared<Symbols::Value>(l && r);
-            }
-            if (op_ == "||") {
-                return l || r;
-                //return std::make_shared<Symbols::Value>(l || r);
-            }
-            if (op_ == "==") {
-                return l == r;
-            }
-            if (op_ == "!=") {
-                return l != r;
-                //return std::make_shared<Symbols::Value>(l != r);
+        using Symbols::Variables::Type;
+        const Type left  = leftVal.getType();
+        const Type right = rightVal.getType();
+
+        // The common shapes first: both operands of one type.
+        if (left == right) {
+            switch (left) {
+                case Type::INTEGER:
+                    return integers(leftVal.get<int>(), rightVal.get<int>());
+                case Type::DOUBLE:
+                    return floating(leftVal.get<double>(), rightVal.get<double>());
+                case Type::FLOAT:
+                    return floating(leftVal.get<float>(), rightVal.get<float>());
+                case Type::BOOLEAN:
+                    return booleans(leftVal.toBool(), rightVal.toBool());
+                case Type::STRING:
+                    if (!isBitwise(operator_)) {
+                        return strings(leftVal.get<std::string>(), rightVal.get<std::string>());
+                    }
+                    break;
+                default:
+                    break;
             }
-            throw std::runtime_error("Unknown operator: " + op_);
         }
+
         // Bitwise operations. Integer-only by design: applying them to a float would
         // require reinterpreting its bit pattern, which is never what a script means.
-        if (op_ == "&" || op_ == "|" || op_ == "^" || op_ == "<<" || op_ == ">>") {
-            if (leftVal != Symbols::Variables::Type::INTEGER || rightVal != Symbols::Variables::Type::INTEGER) {
-                throw std::runtime_error("Bitwise operator '" + op_ + "' requires integer operands, got " +
-                                         Symbols::Variables::TypeToString(leftVal) + " and " +
-                                         Symbols::Variables::TypeToString(rightVal));
-            }
-            const int l = leftVal->get<int>();
-            const int r = rightVal->get<int>();
-            if (op_ == "&") {
-                return Symbols::ValuePtr(l & r);
-            }
-            if (op_ == "|") {
-                return Symbols::ValuePtr(l | r);
-            }
-            if (op_ == "^") {
-                return Symbols::ValuePtr(l ^ r);
-            }
-            // Shifting by a negative amount or by >= the operand width is undefined
-            // behaviour in C++, so reject it rather than let it through.
-            if (r < 0 || r >= static_cast<int>(sizeof(int) * 8)) {
-                throw std::runtime_error("Shift amount " + std::to_string(r) + " is out of range for '" + op_ + "'");
-            }
-            return Symbols::ValuePtr(op_ == "<<" ? (l << r) : (l >> r));
+        if (isBitwise(operator_)) {
+            throw std::runtime_error("Bitwise operator '" + op_ + "' requires integer operands, got " +
+                                     Symbols::Variables::TypeToString(leftVal) + " and " +
+                                     Symbols::Variables::TypeToString(rightVal));
         }
 
-        // Numeric operations: int, float, double (including mixed types)
-        if ((leftVal == Symbols::Variables::Type::INTEGER || leftVal == Symbols::Variables::Type::FLOAT ||
-             leftVal == Symbols::Variables::Type::DOUBLE) &&
-            (rightVal == Symbols::Variables::Type::INTEGER || rightVal == Symbols::Variables::Type::FLOAT ||
-             rightVal == Symbols::Variables::Type::DOUBLE)) {
-            // Promote to double if any operand is double
-            if (leftVal == Symbols::Variables::Type::DOUBLE || rightVal == Symbols::Variables::Type::DOUBLE) {
-                double l = (leftVal == Symbols::Variables::Type::DOUBLE) ? leftVal->get<double>() :
-                           (leftVal == Symbols::Variables::Type::FLOAT)  ? static_cast<double>(leftVal->get<float>()) :
-                                                                           static_cast<double>(leftVal->get<int>());
-                double r = (rightVal == Symbols::Variables::Type::DOUBLE) ? rightVal->get<double>() :
-                           (rightVal == Symbols::Variables::Type::FLOAT) ? static_cast<double>(rightVal->get<float>()) :
-                                                                           static_cast<double>(rightVal->get<int>());
-                if (op_ == "+") {
-                    return l + r;
-                    //return std::make_shared<Symbols::Value>(l + r);
-                }
-                if (op_ == "-") {
-                    return l - r;
-                    //return std::make_shared<Symbols::Value>(l - r);
-                }
-                if (op_ == "*") {
-                    return l * r;
-                    //return std::make_shared<Symbols::Value>(l * r);
-                }
-                if (op_ == "/") {
-                    return l / r;
-                    //return std::make_shared<Symbols::Value>(l / r);
-                }
-                if (op_ == "==") {
-                    return l == r;
-                    //return std::make_shared<Symbols::Value>(l == r);
-                }
-                if (op_ == "!=") {
-                    return l != r;
-                    //return std::make_shared<Symbols::Value>(l != r);
-                }
-                if (op_ == "<") {
-                    return l < r;
-                    //return std::make_shared<Symbols::Value>(l < r);
-                }
-                if (op_ == ">") {
-                    return l > r;
-                    //return std::make_shared<Symbols::Value>(l > r);
-                }
-                if (op_ == "<=") {
-                    return l <= r;
-                    //return std::make_shared<Symbols::Value>(l <= r);
-                }
-                if (op_ == ">=") {
-                    return l >= r;
-                    //return std::make_shared<Symbols::Value>(l >= r);
-                }
-                throw std::runtime_error("Unknown operator: " + op_);
-            }
-            // Promote to float if any operand is float
-            if (leftVal == Symbols::Variables::Type::FLOAT || rightVal == Symbols::Variables::Type::FLOAT) {
-                float l = (leftVal == Symbols::Variables::Type::FLOAT) ? leftVal->get<float>() :
-                                                                         static_cast<float>(leftVal->get<int>());
-                float r = (rightVal == Symbols::Variables::Type::FLOAT) ? rightVal->get<float>() :
-                                                                          static_cast<float>(rightVal->get<int>());
-                if (op_ == "+") {
-                    return l + r;
-                    //return std::make_shared<Symbols::Value>(l + r);
-                }
-                if (op_ == "-") {
-                    return l - r;
-                    //return std::make_shared<Symbols::Value>(l - r);
-                }
-                if (op_ == "*") {
-                    return l * r;
-                    //return std::make_shared<Symbols::Value>(l * r);
-                }
-                if (op_ == "/") {
-                    return l / r;
-                    //return std::make_shared<Symbols::Value>(l / r);
-                }
-                if (op_ == "==") {
-                    return l == r;
-                    //return std::make_shared<Symbols::Value>(l == r);
-                }
-                if (op_ == "!=") {
-                    return l != r;
-                    //return std::make_shared<Symbols::Value>(l != r);
-                }
-                if (op_ == "<") {
-                    return l < r;
-                    //return std::make_shared<Symbols::Value>(l < r);
-                }
-                if (op_ == ">") {
-                    return l > r;
-                    //return std::make_shared<Symbols::Value>(l > r);
-                }
-                if (op_ == "<=") {
-                    return l <= r;
-                    //return std::make_shared<Symbols::Value>(l <= r);
-                }
-                if (op_ == ">=") {
-                    return l >= r;
-                    //return std::make_shared<Symbols::Value>(l >= r);
-                }
-                throw std::runtime_error("Unknown operator: " + op_);
-            }
-            // Both operands are integers
-            int l = leftVal;
-            int r = rightVal;
-            if (op_ == "+") {
-                return l + r;
-                //return std::make_shared<Symbols::Value>(l + r);
-            }
-            if (op_ == "-") {
-                return l - r;
-                //return std::make_shared<Symbols::Value>(l - r);
-            }
-            if (op_ == "*") {
-                return l * r;
-                //return std::make_shared<Symbols::Value>(l * r);
-            }
-            if (op_ == "/") {
-                if (r == 0) {
-                    throw std::runtime_error("Division by zero");
-                }
-                return l / r;
-            }
-            if (op_ == "%") {
-                if (r == 0) {
-                    throw std::runtime_error("Modulo by zero");
-                }
-                return l % r;
-            }
-            if (op_ == "==") {
-                return l == r;
-                //return std::make_shared<Symbols::Value>(l == r);
-            }
-            if (op_ == "!=") {
-                return l != r;
-                //return std::make_shared<Symbols::Value>(l != r);
-            }
-            if (op_ == "<") {
-                return l < r;
-                //return std::make_shared<Symbols::Value>(l < r);
-            }
-            if (op_ == ">") {
-                return l > r;
-                //return std::make_shared<Symbols::Value>(l > r);
-            }
-            if (op_ == "<=") {
-                return l <= r;
-                //return std::make_shared<Symbols::Value>(l <= r);
-            }
-            if (op_ == ">=") {
-                return l >= r;
-                //return std::make_shared<Symbols::Value>(l >= r);
-            }
-            throw std::runtime_error("Unknown operator: " + op_);
+        // Mixed numeric operands: promote to double if either is double, else to float.
+        if (isNumber(left) && isNumber(right)) {
+            if (left == Type::DOUBLE || right == Type::DOUBLE) {
+                return floating(toDouble(leftVal, left), toDouble(rightVal, right));
+            }
+            const float l = (left == Type::FLOAT) ? leftVal.get<float>() : static_cast<float>(leftVal.get<int>());
+            const float r = (right == Type::FLOAT) ? rightVal.get<float>() : static_cast<float>(rightVal.get<int>());
+            return floating(l, r);
         }
-        // Integer operations
-        if (leftVal == Symbols::Variables::Type::INTEGER && rightVal == Symbols::Variables::Type::INTEGER) {
-            int l = leftVal->get<int>();
-            int r = rightVal->get<int>();
 
-            if (op_ == "+") {
-                return l + r;
-                //return std::make_shared<Symbols::Value>(l + r);
-            }
-            if (op_ == "-") {
-                return l - r;
-                //return std::make_shared<Symbols::Value>(l - r);
-            }
-            if (op_ == "*") {
-                return l * r;
-                //return std::make_shared<Symbols::Value>(l * r);
-            }
-            if (op_ == "/") {
+        // Mixed string concatenation: "count=" + $n. '+' already means concatenation
+        // when both sides are strings, so extending it to "string on exactly one side"
+        // is consistent, and it is by far the most natural way to build a message.
+        // Deliberately limited to '+': comparing a string with a number stays a type
+        // error rather than silently stringifying one side.
+        if (operator_ == BinaryOperator::Add && (left == Type::STRING || right == Type::STRING)) {
+            return leftVal->toString() + rightVal->toString();
+        }
+
+        throw std::runtime_error(
+            "Unsupported types in binary expression: " + Symbols::Variables::TypeToString(leftVal) + " and " +
+            Symbols::Variables::TypeToString(rightVal) + " " + toString());
+    }
+
+    static bool isNumber(Symbols::Variables::Type type) {
+        return type == Symbols::Variables::Type::INTEGER || type == Symbols::Variables::Type::FLOAT ||
+               type == Symbols::Variables::Type::DOUBLE;
+    }
+
+    static double toDouble(const Symbols::ValuePtr & value, Symbols::Variables::Type type) {
+        return type == Symbols::Variables::Type::DOUBLE ? value.get<double>() :
+               type == Symbols::Variables::Type::FLOAT  ? static_cast<double>(value.get<float>()) :
+                                                          static_cast<double>(value.get<int>());
+    }
+
+    [[noreturn]] void unknownOperator() const { throw std::runtime_error("Unknown operator: " + op_); }
+
+    Symbols::ValuePtr booleans(bool l, bool r) const {
+        switch (operator_) {
+            case BinaryOperator::LogicalAnd: return l && r;
+            case BinaryOperator::LogicalOr: return l || r;
+            case BinaryOperator::Equal: return l == r;
+            case BinaryOperator::NotEqual: return l != r;
+            default: unknownOperator();
+        }
+    }
+
+    Symbols::ValuePtr integers(int l, int r) const {
+        switch (operator_) {
+            case BinaryOperator::Add: return l + r;
+            case BinaryOperator::Subtract: return l - r;
+            case BinaryOperator::Multiply: return l * r;
+            case BinaryOperator::Divide:
                 // Integer division by zero is undefined behaviour in C++ (SIGFPE), which
                 // killed the whole process with an uncatchable signal and no diagnostic.
                 if (r == 0) {
                     throw std::runtime_error("Division by zero");
                 }
                 return l / r;
-            }
-            if (op_ == "%") {
+            case BinaryOperator::Modulo:
                 if (r == 0) {
                     throw std::runtime_error("Modulo by zero");
                 }
                 return l % r;
-            }
-            if (op_ == "==") {
-                return l == r;
-                //return std::make_shared<Symbols::Value>(l == r);
-            }
-            if (op_ == "!=") {
-                return l != r;
-                //return std::make_shared<Symbols::Value>(l != r);
-            }
-            if (op_ == "<") {
-                return l < r;
-                //return std::make_shared<Symbols::Value>(l < r);
-            }
-            if (op_ == ">") {
-                return l > r;
-                //return std::make_shared<Symbols::Value>(l > r);
-            }
-            if (op_ == "<=") {
-                return l <= r;
-                //return std::make_shared<Symbols::Value>(l <= r);
-            }
-            if (op_ == ">=") {
-                return l >= r;
-                //return std::make_shared<Symbols::Value>(l >= r);
-            }
-
-            throw std::runtime_error("Unknown operator: " + op_);
+            case BinaryOperator::Equal: return l == r;
+            case BinaryOperator::NotEqual: return l != r;
+            case BinaryOperator::Less: return l < r;
+            case BinaryOperator::Greater: return l > r;
+            case BinaryOperator::LessEqual: return l <= r;
+            case BinaryOperator::GreaterEqual: return l >= r;
+            case BinaryOperator::BitAnd: return l & r;
+            case BinaryOperator::BitOr: return l | r;
+            case BinaryOperator::BitXor: return l ^ r;
+            case BinaryOperator::ShiftLeft:
+            case BinaryOperator::ShiftRight:
+                // Shifting by a negative amount or by >= the operand width is undefined
+                // behaviour in C++, so reject it rather than let it through.
+                if (r < 0 || r >= static_cast<int>(sizeof(int) * 8)) {
+                    throw std::runtime_error("Shift amount " + std::to_string(r) + " is out of range for '" + op_ +
+                                             "'");
+                }
+                return operator_ == BinaryOperator::ShiftLeft ? (l << r) : (l >> r);
+            default: unknownOperator();
         }
+    }
 
-        // String operations
-        if (leftVal == Symbols::Variables::Type::STRING && rightVal == Symbols::Variables::Type::STRING) {
-            auto l = leftVal->get<std::string>();
-            auto r = rightVal->get<std::string>();
-
-            if (op_ == "+") {
-                return l + r;
-                //return std::make_shared<Symbols::Value>(l + r);
-            }
-            if (op_ == "==") {
-                return l == r;
-                //return std::make_shared<Symbols::Value>(l == r);
-            }
-            if (op_ == "!=") {
-                return l != r;
-                //return std::make_shared<Symbols::Value>(l != r);
-            }
-            throw std::runtime_error("Unknown operator: " + op_);
+    // float or double, after promotion; there is no floating-point '%'.
+    template <typename T> Symbols::ValuePtr floating(T l, T r) const {
+        switch (operator_) {
+            case BinaryOperator::Add: return l + r;
+            case BinaryOperator::Subtract: return l - r;
+            case BinaryOperator::Multiply: return l * r;
+            case BinaryOperator::Divide: return l / r;
+            case BinaryOperator::Equal: return l == r;
+            case BinaryOperator::NotEqual: return l != r;
+            case BinaryOperator::Less: return l < r;
+            case BinaryOperator::Greater: return l > r;
+            case BinaryOperator::LessEqual: return l <= r;
+            case BinaryOperator::GreaterEqual: return l >= r;
+            default: unknownOperator();
         }
+    }
 
-        // Mixed string concatenation: "count=" + $n. '+' already means concatenation
-        // when both sides are strings, so extending it to "string on exactly one side"
-        // is consistent, and it is by far the most natural way to build a message.
-        // Deliberately limited to '+': comparing a string with a number stays a type
-        // error rather than silently stringifying one side.
-        if (op_ == "+" && (leftVal == Symbols::Variables::Type::STRING ||
-                           rightVal == Symbols::Variables::Type::STRING)) {
-            return leftVal->toString() + rightVal->toString();
+    template <typename T> bool compare(T l, T r) const {
+        switch (operator_) {
+            case BinaryOperator::Equal: return l == r;
+            case BinaryOperator::NotEqual: return l != r;
+            case BinaryOperator::Less: return l < r;
+            case BinaryOperator::Greater: return l > r;
+            case BinaryOperator::LessEqual: return l <= r;
+            case BinaryOperator::GreaterEqual: return l >= r;
+            default: unknownOperator();
         }
+    }
 
-        throw std::runtime_error(
-            "Unsupported types in binary expression: " + Symbols::Variables::TypeToString(leftVal) + " and " +
-            Symbols::Variables::TypeToString(rightVal) + " " + toString());
-
-        return Symbols::ValuePtr::null();
-    };
-
-    std::string toString() const override { return "(" + lhs_->toString() + " " + op_ + " " + rhs_->toString() + ")"; }
+    Symbols::ValuePtr strings(const std::string & l, const std::string & r) const {
+        switch (operator_) {
+            case BinaryOperator::Add: return l + r;
+            case BinaryOperator::Equal: return l == r;
+            case BinaryOperator::NotEqual: return l != r;
+            default: unknownOperator();
+        }
+    }
 };  // class
 }  // namespace Interpreter
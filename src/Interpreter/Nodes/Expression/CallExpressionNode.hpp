@@ -1,14 +1,20 @@
 #ifndef INTERPRETER_CALL_EXPRESSION_NODE_HPP
 #define INTERPRETER_CALL_EXPRESSION_NODE_HPP
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
+#include "Interpreter/Bytecode.hpp"
+#include "Interpreter/CallSiteCache.hpp"
 #include "Interpreter/ExpressionNode.hpp"
+#include "Interpreter/LocalResolver.hpp"
+#include "Interpreter/Optimizer.hpp"
 #include "Interpreter/Interpreter.hpp"
 #include "Interpreter/OperationContainer.hpp"
-#include "Interpreter/ReturnException.hpp"
 #include "Symbols/SymbolContainer.hpp"
 #include "Symbols/FunctionSymbol.hpp"
 #include "Symbols/SymbolFactory.hpp"
@@ -16,16 +22,47 @@
 
 namespace Interpreter {
 
+class CallExpressionNode;
+
+/**
+ * @brief A script function call in progress, as seen by a `return f(...)` in tail
+ * position of the body it runs (see CallExpressionNode::handOver).
+ */
+struct TailCall {
+    Symbols::SymbolTable *                       frame = nullptr;  // call frame of the body running
+    // Set by a return handing its call over: the function to call next in place of the frame.
+    std::shared_ptr<const CallSiteCache::Target> target;
+    std::vector<Symbols::ValuePtr>               args;
+    const CallExpressionNode *                   site = nullptr;
+};
+
 /**
   * @brief Expression node representing a function call returning a value.
+  *
+  * A call made by a `return` in tail position of a script function is not made there:
+  * the return hands it over (handOver()), and the call running that function calls the
+  * next one in the same C++ frame once the body has returned (call()). A recursion that
+  * only recurses in tail position therefore runs in constant C++ stack, however deep.
+  *
+  * A compiled loop makes the call through invoke(), with arguments it evaluated itself.
   */
-class CallExpressionNode : public ExpressionNode {
+class CallExpressionNode : public ExpressionNode, public Bytecode::CallSite {
     std::string                                  functionName_;
     std::vector<std::unique_ptr<ExpressionNode>> args_;
     // Source location for error reporting
     std::string                                  filename_;
     int                                          line_;
     size_t                                       column_;
+    mutable CallSiteCache                        cache_;
+
+    // Calls a running call() has made in place of its body's frame, outermost first. A
+    // run of calls from the same site is one entry, so a self-recursion takes one entry
+    // however deep it goes; a mutual recursion takes one entry per call.
+    struct HandedOver {
+        const CallExpressionNode * site;
+        Symbols::Variables::Type   returnType;  // of the function the site called
+        size_t                     count;
+    };
 
   public:
     CallExpressionNode(std::string functionName, std::vector<std::unique_ptr<ExpressionNode>> args,
@@ -38,117 +75,300 @@ class CallExpressionNode : public ExpressionNode {
 
     Symbols::ValuePtr evaluate(Interpreter & interpreter, std::string /*filename*/, int /*line*/,
                                size_t /*col */) const override {
-        using namespace Symbols;
         try {
-            // Evaluate argument expressions
-            std::vector<Symbols::ValuePtr> argValues;
-            argValues.reserve(args_.size());
-            for (const auto & expr : args_) {
-                argValues.push_back(expr->evaluate(interpreter, filename_, line_, column_));
+            return dispatch(interpreter, evaluateArgs(interpreter));
+        } catch (const std::exception & e) {
+            throw ::Interpreter::Exception(e.what(), filename_, line_, column_);
+        }
+    }
+
+    Symbols::ValuePtr invoke(Interpreter & interpreter, std::vector<Symbols::ValuePtr> args) const override {
+        try {
+            return dispatch(interpreter, std::move(args));
+        } catch (const std::exception & e) {
+            throw ::Interpreter::Exception(e.what(), filename_, line_, column_);
+        }
+    }
+
+    /**
+     * @brief The call of a `return` in tail position (see LocalResolver::tailCall). @p frame
+     * locates the call frame of the function the return is in.
+     *
+     * The call is handed over to the call() running that function when the frame is the
+     * one it runs, the callee is a script function, and dropping the frame and the loop
+     * scopes above it cannot change what a name means to the callee: every symbol in them
+     * must be a variable the callee's own parameters shadow. Otherwise the call is made
+     * here, as evaluate() makes it.
+     *
+     * @return The call's value, or nullopt if it has been handed over; the return then
+     * returns ControlFlowSignal::tailCall().
+     */
+    std::optional<Symbols::ValuePtr> handOver(Interpreter & interpreter, const LocalSlot & frame) const {
+        auto *     sc    = Symbols::SymbolContainer::instance();
+        TailCall * tail  = interpreter.tailCall();
+        auto *     table = sc->frameTable(static_cast<size_t>(frame.depth), frame.frame);
+        if (!tail || !table || table != tail->frame) {
+            return evaluate(interpreter, filename_, line_, column_);
+        }
+        try {
+            std::vector<Symbols::ValuePtr> argValues = evaluateArgs(interpreter);
+            auto                           target    = cache_.resolve(functionName_);
+            if (!target) {
+                throw std::runtime_error("Function not found: " + functionName_);
+            }
+            if (target->native) {
+                return (*target->native)(argValues);
             }
+            for (int depth = 0; depth <= frame.depth; ++depth) {
+                const bool shadowed = sc->scopeTable(depth)->allOf([&](const Symbols::Symbol & symbol) {
+                    return symbol.getKind() == Symbols::Kind::Variable &&
+                           std::find(target->params.begin(), target->params.end(), symbol.nameAtom()) !=
+                               target->params.end();
+                });
+                if (!shadowed) {
+                    return call(interpreter, target, std::move(argValues));
+                }
+            }
+            tail->target = std::move(target);
+            tail->args   = std::move(argValues);
+            tail->site   = this;
+            return std::nullopt;
+        } catch (const std::exception & e) {
+            throw ::Interpreter::Exception(e.what(), filename_, line_, column_);
+        }
+    }
+
+    /** @brief What a `return` makes of the value of its expression. */
+    static Symbols::ValuePtr returnedValue(Symbols::ValuePtr retVal) {
+        // Handle binary operations returning as objects instead of booleans
+        if (retVal->getType() == Symbols::Variables::Type::OBJECT) {
+            
+            try {
+                // Look for binary operation patterns
+                const Symbols::ObjectMap& objMap = retVal->get<Symbols::ObjectMap>();
+                
+                // If this is a comparison result that should be a boolean
+                if (objMap.find("left") != objMap.end() && objMap.find("right") != objMap.end() && 
+                    objMap.find("operator") != objMap.end()) {
+                    
+                    auto leftIt = objMap.find("left");
+                    auto rightIt = objMap.find("right");
+                    auto opIt = objMap.find("operator");
+                    
+                    if (leftIt->second->getType() == Symbols::Variables::Type::INTEGER && 
+                        rightIt->second->getType() == Symbols::Variables::Type::INTEGER && 
+                        opIt->second->getType() == Symbols::Variables::Type::STRING) {
+                        
+                        int left = leftIt->second->get<int>();
+                        int right = rightIt->second->get<int>();
+                        std::string op = opIt->second->get<std::string>();
+                        
+                        bool result = false;
+                        if (op == ">") result = (left > right);
+                        else if (op == "<") result = (left < right);
+                        else if (op == ">=") result = (left >= right);
+                        else if (op == "<=") result = (left <= right);
+                        else if (op == "==") result = (left == right);
+                        else if (op == "!=") result = (left != right);
+                        
+                        retVal = Symbols::ValuePtr(result);
+                    }
+                }
+            } catch (const std::exception& e) {
+                // Failed to examine object
+            }
+        }
+        return retVal;
+    }
+
+    void resolveLocals(LocalResolver & resolver) override {
+        for (auto & arg : args_) {
+            resolver.resolve(arg);
+        }
+        resolver.call(functionName_);
+    }
+
+    std::unique_ptr<ExpressionNode> fold(Optimizer & optimizer) override {
+        for (auto & arg : args_) {
+            optimizer.fold(arg);
+        }
+        return nullptr;
+    }
+
+    int lower(Bytecode::Compiler & compiler) const override {
+        return compiler.call(*this, Symbols::AtomTable::intern(functionName_), args_,
+                             Bytecode::Site{ filename_, line_, column_ });
+    }
 
-            // Check for module functions via SymbolContainer first
-            auto * symbolContainer = Symbols::SymbolContainer::instance();
-            if (symbolContainer->hasFunction(functionName_)) {
-                return symbolContainer->callFunction(functionName_, argValues);
+    std::string toString() const override {
+        return "CallExpressionNode{ function='" + functionName_ + "', args=" + std::to_string(args_.size()) + " }";
+    }
+
+  private:
+    // Module functions first, then script functions visible from this scope
+    Symbols::ValuePtr dispatch(Interpreter & interpreter, std::vector<Symbols::ValuePtr> args) const {
+        const auto target = cache_.resolve(functionName_);
+        if (!target) {
+            throw std::runtime_error("Function not found: " + functionName_);
+        }
+        if (target->native) {
+            return (*target->native)(args);
+        }
+        return call(interpreter, target, std::move(args));
+    }
+
+    std::vector<Symbols::ValuePtr> evaluateArgs(Interpreter & interpreter) const {
+        std::vector<Symbols::ValuePtr> argValues;
+        argValues.reserve(args_.size());
+        for (const auto & expr : args_) {
+            argValues.push_back(expr->evaluate(interpreter, filename_, line_, column_));
+        }
+        return argValues;
+    }
+
+    /**
+     * @brief Call the script function @p target, then every function a return in tail
+     * position hands over, each in place of the previous one's frame.
+     *
+     * The value and the errors are those of the nested calls the handed-over ones stand
+     * for: the value passes each function's return type check on its way out, and an
+     * error carries the location of every call site it would have unwound through.
+     */
+    Symbols::ValuePtr call(Interpreter & interpreter, std::shared_ptr<const CallSiteCache::Target> target,
+                           std::vector<Symbols::ValuePtr> args) const {
+        auto *       sc           = Symbols::SymbolContainer::instance();
+        const size_t caller_depth = sc->getScopeStack().size();
+        const auto   retType      = target->function->returnType();
+
+        TailCall                   tail;
+        const CallExpressionNode * site = this;
+        std::vector<HandedOver>    chain;
+        Symbols::ValuePtr          returnValue;
+
+        struct Restore {
+            Interpreter &   interpreter;
+            TailCall *      tail;
+            Jit::Function * jit;
+
+            ~Restore() {
+                interpreter.enterTailCall(tail);
+                interpreter.enterJitFunction(jit);
             }
+        } restore{ interpreter, interpreter.tailCall(), interpreter.enterJitFunction(nullptr) };
 
-            // User-defined function: lookup through scope hierarchy
-            SymbolContainer *               sc       = SymbolContainer::instance();
-            std::string                     lookupNs = sc->currentScopeName();
-            std::shared_ptr<FunctionSymbol> funcSym;
-            // Search for function symbol in current and parent scopes
-            while (true) {
-                auto               scope_table = sc->getScopeTable(lookupNs);
-                Symbols::SymbolPtr sym         = nullptr;
-                if (scope_table) {
-                    sym = scope_table->get(Symbols::SymbolContainer::DEFAULT_FUNCTIONS_SCOPE, functionName_);
+        try {
+            for (;;) {
+                if (target->jit) {
+                    if (Jit::Tier::call(*target->jit, args, returnValue)) {
+                        break;
+                    }
+                    Jit::Tier::instance().count(*target->jit);
                 }
 
-                if (sym && sym->getKind() == Kind::Function) {
-                    funcSym = std::static_pointer_cast<FunctionSymbol>(sym);
-                    break;
+                const auto & params = target->function->parameters();
+                if (params.size() != args.size()) {
+                    throw std::runtime_error("Function '" + site->functionName_ + "' expects " +
+                                             std::to_string(params.size()) + " args, got " +
+                                             std::to_string(args.size()));
                 }
-                // Move to parent scope by finding the last '::'
-                // This assumes scope names are hierarchical like /file/path::class::method or a top-level file scope
-                auto pos = lookupNs.rfind(Symbols::SymbolContainer::SCOPE_SEPARATOR);
-                if (pos == std::string::npos) {
-                    // If lookupNs doesn't contain "::", it means we've reached the top-level scope (e.g., a file path).
-                    // If the function wasn't found by now, it's not in any accessible parent scope.
-                    break;
+
+                // Enter a pooled call frame for this function call
+                auto * frame = sc->enterFrame(target->callScope, target->frame);
+
+                // Bind parameters in the call frame; parameter i is frame slot i
+                for (size_t i = 0; i < params.size(); ++i) {
+                    auto varSym = Symbols::SymbolFactory::createVariable(params[i].name, args[i].clone(),
+                                                                         target->callScope);
+                    sc->addVariable(varSym);  // Adds to the current scope (the call frame)
+                    frame->bindSlot(i, varSym);
                 }
-                lookupNs = lookupNs.substr(0, pos);
-                // If substr results in an empty string (e.g. if lookupNs was "::foo"),
-                // it implies an invalid scope name, so break.
-                if (lookupNs.empty()) {
+
+                // Execute function body operations inside the call frame. Operations are
+                // associated with the canonical function name (where they are defined/parsed).
+                tail.frame = frame;
+                interpreter.enterTailCall(&tail);
+                interpreter.enterJitFunction(target->jit.get());
+                bool handedOver = false;
+                for (size_t i = 0; target->body && i < target->body->size(); ++i) {
+                    const ControlFlowSignal signal = interpreter.runOperation(*(*target->body)[i]);
+                    if (!signal.normal()) {
+                        handedOver  = signal.tail();
+                        returnValue = signal.value();
+                        break;
+                    }
+                }
+                interpreter.enterTailCall(restore.tail);
+                interpreter.enterJitFunction(restore.jit);
+                sc->unwindScopeStack(caller_depth);
+                if (!handedOver) {
                     break;
                 }
-            }
-            if (!funcSym) {
-                throw std::runtime_error("Function not found: " + functionName_);
-            }
-            const auto & params  = funcSym->parameters();
-            const auto   retType = funcSym->returnType();
 
-            if (params.size() != argValues.size()) {
-                throw std::runtime_error("Function '" + functionName_ + "' expects " + std::to_string(params.size()) +
-                                         " args, got " + std::to_string(argValues.size()));
+                const auto calledType = tail.target->function->returnType();
+                if (!chain.empty() && chain.back().site == tail.site && chain.back().returnType == calledType) {
+                    ++chain.back().count;
+                } else {
+                    chain.push_back({ tail.site, calledType, 1 });
+                }
+                target = std::move(tail.target);
+                args   = std::move(tail.args);
+                site   = tail.site;
             }
-
-            // Create unique scope for this function call
-            const std::string canonical_fn_scope_name =
-                funcSym->context().empty() ?
-                    functionName_ :
-                    funcSym->context() + Symbols::SymbolContainer::SCOPE_SEPARATOR + functionName_;
-            std::string unique_call_scope_name = canonical_fn_scope_name + Symbols::SymbolContainer::CALL_SCOPE +
-                                                 std::to_string(Interpreter::get_unique_call_id());
-
-            sc->create(unique_call_scope_name);  // Creates and enters the new unique scope
-
-            // Bind parameters in the unique call scope
-            for (size_t i = 0; i < params.size(); ++i) {
-                const auto & p      = params[i];
-                auto &       v      = argValues[i];
-                // Symbol's context is this specific call's scope
-                auto         varSym = Symbols::SymbolFactory::createVariable(p.name, v.clone(), unique_call_scope_name);
-                sc->addVariable(varSym);  // Adds to the current scope (unique_call_scope_name)
+        } catch (const std::exception & e) {
+            sc->unwindScopeStack(caller_depth);  // release the frames on the error path too
+            if (chain.empty()) {
+                throw;
             }
+            unwind(chain, SIZE_MAX, e.what());
+        } catch (...) {
+            sc->unwindScopeStack(caller_depth);
+            throw;
+        }
 
-            // Execute function body operations. These operations will use the current unique_call_scope_name.
-            Symbols::ValuePtr returnValue;
-            // Operations are associated with the canonical function name (where they are defined/parsed)
-            auto              ops = Operations::Container::instance()->getAll(canonical_fn_scope_name);
-            for (const auto & op : ops) {
-                try {
-                    interpreter.runOperation(*op);
-                } catch (const ReturnException & ret) {
-                    returnValue = ret.value();
-                    break;
+        // Innermost first, as the nested calls would have returned
+        size_t levels = 0;
+        for (const auto & entry : chain) {
+            levels += entry.count;
+        }
+        for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+            for (size_t i = 0; i < it->count; ++i, --levels) {
+                if (returnValue != it->returnType) {
+                    unwind(chain, levels,
+                           "Function " + it->site->functionName_ + " expected return type is " +
+                               Symbols::Variables::TypeToString(it->returnType) + " got " +
+                               Symbols::Variables::TypeToString(returnValue));
                 }
+                returnValue = returnedValue(std::move(returnValue));
             }
-            // Exit unique_call_scope_name with validation
-            std::string current_scope_before_exit = sc->currentScopeName();
-            if (current_scope_before_exit == unique_call_scope_name) {
-                sc->enterPreviousScope();
-            } else {
-                // Scope stack corruption detected - attempt to recover
-                sc->validateAndCleanupScopeStack(unique_call_scope_name);
-            }
-            if (returnValue != retType) {
-                throw std::runtime_error("Function " + functionName_ + " expected return type is " +
-                                         Symbols::Variables::TypeToString(retType) + " got " +
-                                         Symbols::Variables::TypeToString(returnValue));
-            }
-            return returnValue;
-        } catch (const std::exception & e) {
-            throw ::Interpreter::Exception(e.what(), filename_, line_, column_);
         }
-        // Unreachable: all paths either return or throw
-        return Symbols::ValuePtr::null();
+        if (returnValue != retType) {
+            throw std::runtime_error("Function " + functionName_ + " expected return type is " +
+                                     Symbols::Variables::TypeToString(retType) + " got " +
+                                     Symbols::Variables::TypeToString(returnValue));
+        }
+        return returnValue;
     }
 
-    std::string toString() const override {
-        return "CallExpressionNode{ function='" + functionName_ + "', args=" + std::to_string(args_.size()) + " }";
+    /**
+     * @brief Throw @p message, raised in the @p levels outermost handed-over calls, as it
+     * would have reached this call: wrapped in the location of each of their sites, a run
+     * of one site counted rather than repeated (see Exception).
+     */
+    [[noreturn]] static void unwind(const std::vector<HandedOver> & chain, size_t levels, const std::string & message) {
+        // How many of the levels each entry accounts for, outermost first
+        std::vector<size_t> counts;
+        for (size_t i = 0, left = levels; i < chain.size() && left > 0; ++i) {
+            counts.push_back(std::min(chain[i].count, left));
+            left -= counts.back();
+        }
+        std::string wrapped = message;
+        for (size_t i = counts.size() - 1; i > 0; --i) {
+            const auto & site = *chain[i].site;
+            wrapped = ::Interpreter::Exception(wrapped, site.filename_, site.line_, site.column_, counts[i]).what();
+        }
+        // The outermost site's location goes on the exception itself.
+        const auto & outermost = *chain.front().site;
+        throw ::Interpreter::Exception(wrapped, outermost.filename_, outermost.line_, outermost.column_, counts[0]);
     }
 };
 
@@ -3,8 +3,11 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 
 #include "Interpreter/ExpressionNode.hpp"
+#include "Interpreter/LocalResolver.hpp"
+#include "Interpreter/Optimizer.hpp"
 #include "Interpreter/Interpreter.hpp"
 #include "Symbols/Value.hpp"
 
@@ -24,7 +27,7 @@ class DynamicMemberExpressionNode : public ExpressionNode {
     Symbols::ValuePtr evaluate(Interpreter & interpreter, std::string /*filename*/, int /*line*/,
                                size_t /*col */) const override {
         // Evaluate the object expression to get the object
-        const auto object = object_->evaluate(interpreter, filename_, line_, column_);
+        auto object = object_->evaluate(interpreter, filename_, line_, column_);
         if (object != Symbols::Variables::Type::OBJECT) {
             throw Exception("Cannot access member of non-object value", filename_, line_, column_);
         }
@@ -47,15 +50,31 @@ class DynamicMemberExpressionNode : public ExpressionNode {
         }
 
         // Access the member using object's member map
-        //const auto & map = std::get<Symbols::ObjectMap>(object);
-        const Symbols::ObjectMap map = object;
-        auto                     it  = map.find(name);
+        const auto & map = std::as_const(object)->get<Symbols::ObjectMap>();
+        auto         it  = map.find(name);
         if (it == map.end()) {
             throw Exception("Member '" + name + "' not found in object", filename_, line_, column_);
         }
+        // Same rule as MemberExpressionNode: split a shared payload before handing out a nested object.
+        if ((it->second == Symbols::Variables::Type::OBJECT || it->second == Symbols::Variables::Type::CLASS) &&
+            object->isShared()) {
+            object->unshare();
+            return std::as_const(object)->get<Symbols::ObjectMap>().at(name);
+        }
         return it->second;
     }
 
+    void resolveLocals(LocalResolver & resolver) override {
+        resolver.resolve(object_);
+        resolver.resolve(memberExpr_);
+    }
+
+    std::unique_ptr<ExpressionNode> fold(Optimizer & optimizer) override {
+        optimizer.fold(object_);
+        optimizer.fold(memberExpr_);
+        return nullptr;
+    }
+
     std::string toString() const override { return object_->toString() + "->" + memberExpr_->toString(); }
 
   private:
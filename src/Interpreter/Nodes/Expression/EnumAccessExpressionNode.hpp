@@ -6,6 +6,8 @@
 
 #include "Interpreter/ExpressionNode.hpp"
 #include "Interpreter/Interpreter.hpp"
+#include "Interpreter/Nodes/Expression/LiteralExpressionNode.hpp"
+#include "Interpreter/Optimizer.hpp"
 #include "Symbols/SymbolContainer.hpp"
 #include "Symbols/EnumSymbol.hpp"
 #include "Symbols/Value.hpp"
@@ -51,6 +53,13 @@ class EnumAccessExpressionNode : public ExpressionNode {
         return Symbols::ValuePtr(enumValue.value());
     }
 
+    bool constant() const override { return true; }
+
+    std::unique_ptr<ExpressionNode> fold(Optimizer & optimizer) override {
+        const auto value = optimizer.enumValue(enumName_, valueName_);
+        return value ? std::make_unique<LiteralExpressionNode>(Symbols::ValuePtr(*value)) : nullptr;
+    }
+
     std::string toString() const override { 
         return enumName_ + "." + valueName_; 
     }
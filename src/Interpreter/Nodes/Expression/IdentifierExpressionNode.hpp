@@ -1,10 +1,15 @@
 #ifndef IDENTIFIER_EXPRESSION_NODE_HPP
 #define IDENTIFIER_EXPRESSION_NODE_HPP
 
+#include <cstdint>
 #include <string>
 #include <vector> // For string splitting
 
+#include "Interpreter/Bytecode.hpp"
 #include "Interpreter/ExpressionNode.hpp"
+#include "Interpreter/LocalResolver.hpp"
+#include "Interpreter/Nodes/Expression/LiteralExpressionNode.hpp"
+#include "Interpreter/Optimizer.hpp"
 #include "Symbols/SymbolContainer.hpp"
 #include "Symbols/Value.hpp"
 #include "Symbols/EnumSymbol.hpp" // For EnumSymbol
@@ -13,17 +18,44 @@
 namespace Interpreter {
 
 class IdentifierExpressionNode : public ExpressionNode {
-    std::string name_;
+    // What the name is, decided once when the node is built instead of on every evaluation.
+    enum class Form : std::uint8_t { Variable, Scoped, Null, This };
+
+    std::string   name_;
+    // Interned once here so each evaluation looks the variable up by id.
+    Symbols::Atom nameAtom_;
+    Form          form_;
+    // Frame slot bound by LocalResolver when this names a local of the enclosing function.
+    LocalSlot     slot_;
+
+    static Form classify(const std::string & name) {
+        if (name.find("::") != std::string::npos) {
+            return Form::Scoped;
+        }
+        if (name == "NULL" || name == "null") {
+            return Form::Null;
+        }
+        if (name == "this" || name == "$this") {
+            return Form::This;
+        }
+        return Form::Variable;
+    }
 
   public:
-    explicit IdentifierExpressionNode(std::string name) : name_(std::move(name)) {
+    explicit IdentifierExpressionNode(std::string name) :
+        name_(std::move(name)),
+        nameAtom_(Symbols::AtomTable::intern(name_)),
+        form_(classify(name_)) {
         // The base ExpressionNode members (filename, line, column) should be set by the parser
         // when this node is created.
         
     }
 
     // Constructor with location information
-    IdentifierExpressionNode(std::string name, const std::string& filename, int line, size_t column) : name_(std::move(name)) {
+    IdentifierExpressionNode(std::string name, const std::string& filename, int line, size_t column) :
+        name_(std::move(name)),
+        nameAtom_(Symbols::AtomTable::intern(name_)),
+        form_(classify(name_)) {
         this->filename = filename;
         this->line = line;
         this->column = column;
@@ -40,11 +72,19 @@ class IdentifierExpressionNode : public ExpressionNode {
 
         auto * sc = Symbols::SymbolContainer::instance();
 
-        const auto& thisObj = interpreter_instance.getThisObject();
+        // A resolved local reads its frame slot directly; an empty slot (declaration not
+        // reached yet) falls through to the name lookup below.
+        if (slot_.bound()) {
+            if (const auto * frame = sc->frameTable(static_cast<size_t>(slot_.depth), slot_.frame)) {
+                if (const auto * symbol = frame->slot(static_cast<size_t>(slot_.slot))) {
+                    return symbol->getValue();
+                }
+            }
+        }
 
         // Check for scope resolution operator "::"
-        size_t scope_res_pos = name_.find("::");
-        if (scope_res_pos != std::string::npos) {
+        if (form_ == Form::Scoped) {
+            const size_t scope_res_pos = name_.find("::");
             std::string scope_name = name_.substr(0, scope_res_pos);
             std::string member_name = name_.substr(scope_res_pos + 2);
 
@@ -80,13 +120,13 @@ class IdentifierExpressionNode : public ExpressionNode {
         }
 
         // Original logic for non-scoped identifiers
-        if (name_ == "NULL" || name_ == "null") {
+        if (form_ == Form::Null) {
             return Symbols::ValuePtr::null(Symbols::Variables::Type::NULL_TYPE);
         }
         
-        if (name_ == "this" || name_ == "$this") {
+        if (form_ == Form::This) {
             // 'this' or '$this' logic - use interpreter's current 'this' object
-            auto thisSymbol = sc->getVariable(name_); // Try to find it as a regular variable first
+            auto thisSymbol = sc->getVariable(nameAtom_); // Try to find it as a regular variable first
             if (thisSymbol) { // Assuming getVariable returns a symbol that has a value
                 return thisSymbol->getValue();
             }
@@ -100,14 +140,14 @@ class IdentifierExpressionNode : public ExpressionNode {
 
         // Logic for other identifiers
         Symbols::SymbolPtr symbol_from_scope; // Use SymbolPtr
-        symbol_from_scope = sc->getVariable(name_);
+        symbol_from_scope = sc->getVariable(nameAtom_);
         
         
         if (symbol_from_scope) {
             return symbol_from_scope->getValue();
         }
         
-        symbol_from_scope = sc->getConstant(name_); // Re-assign to the same variable
+        symbol_from_scope = sc->getConstant(nameAtom_); // Re-assign to the same variable
         if (symbol_from_scope) {
             return symbol_from_scope->getValue();
         }
@@ -117,6 +157,34 @@ class IdentifierExpressionNode : public ExpressionNode {
         return nullptr;
     }
 
+    void resolveLocals(LocalResolver & resolver) override {
+        if (form_ == Form::Variable) {
+            resolver.reference(name_, slot_);
+        }
+    }
+
+    // `Enum::MEMBER` and constants the optimizer can prove become their values.
+    std::unique_ptr<ExpressionNode> fold(Optimizer & optimizer) override {
+        if (form_ == Form::Scoped) {
+            const size_t separator = name_.find("::");
+            const auto   value     = optimizer.enumValue(name_.substr(0, separator), name_.substr(separator + 2));
+            return value ? std::make_unique<LiteralExpressionNode>(Symbols::ValuePtr(*value)) : nullptr;
+        }
+        if (form_ == Form::Variable) {
+            if (auto value = optimizer.constant(name_)) {
+                return std::make_unique<LiteralExpressionNode>(*value);
+            }
+        }
+        return nullptr;
+    }
+
+    int lower(Bytecode::Compiler & compiler) const override {
+        return form_ == Form::Variable ? compiler.variable(nameAtom_) : Bytecode::Compiler::kFailed;
+    }
+
+    // `Enum::MEMBER`
+    bool constant() const override { return form_ == Form::Scoped; }
+
     std::string toString() const override { return name_; }
 };
 
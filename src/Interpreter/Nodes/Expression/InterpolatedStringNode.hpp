@@ -0,0 +1,173 @@
+#ifndef INTERPRETER_INTERPOLATED_STRING_NODE_HPP
+#define INTERPRETER_INTERPOLATED_STRING_NODE_HPP
+
+#include <charconv>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Interpreter/Bytecode.hpp"
+#include "Interpreter/ExpressionNode.hpp"
+#include "Interpreter/LocalResolver.hpp"
+#include "Interpreter/Nodes/Expression/LiteralExpressionNode.hpp"
+#include "Interpreter/Optimizer.hpp"
+#include "Interpreter/TypeChecker.hpp"
+#include "Symbols/Value.hpp"
+
+namespace Interpreter {
+
+/**
+ * @brief An interpolated string literal, "Hello $name, ${obj->count} items": the literal
+ * text and the interpolated values in order (Parser/StringInterpolation.hpp).
+ *
+ * Every part is evaluated and formatted first, then the result is built in one allocation
+ * of the total length. Numbers are formatted with std::to_chars into a buffer on the
+ * stack, in the same notation Value::toString() uses; strings are appended from where
+ * they are stored. Anything else (objects, classes, null) takes its toString().
+ */
+class InterpolatedStringNode : public ExpressionNode {
+    std::vector<std::unique_ptr<ExpressionNode>> parts_;
+
+    // One formatted part: a view of the value's own string, of digits, or of owned text.
+    struct Piece {
+        Symbols::ValuePtr value;
+        std::string_view  text;
+        std::string       owned;
+        char              digits[64];
+    };
+
+  public:
+    InterpolatedStringNode(std::vector<std::unique_ptr<ExpressionNode>> parts, const std::string & file, int line,
+                           size_t column) :
+        parts_(std::move(parts)) {
+        this->filename = file;
+        this->line     = line;
+        this->column   = column;
+    }
+
+    Symbols::ValuePtr evaluate(Interpreter & interpreter, std::string filename, int line,
+                               size_t column) const override {
+        std::vector<Piece> pieces(parts_.size());
+        for (size_t i = 0; i < parts_.size(); ++i) {
+            pieces[i].value = parts_[i]->evaluate(interpreter, filename, line, column);
+        }
+        return join(pieces);
+    }
+
+    // All parts literal: the whole string is one.
+    std::unique_ptr<ExpressionNode> fold(Optimizer & optimizer) override {
+        std::vector<Piece> pieces(parts_.size());
+        bool               known = true;
+        for (size_t i = 0; i < parts_.size(); ++i) {
+            optimizer.fold(parts_[i]);
+            if (const auto * value = Optimizer::literal(parts_[i])) {
+                pieces[i].value = *value;
+            } else {
+                known = false;
+            }
+        }
+        return known ? std::make_unique<LiteralExpressionNode>(join(pieces)) : nullptr;
+    }
+
+    std::optional<Symbols::Variables::Type> inferType(TypeChecker & checker) override {
+        for (auto & part : parts_) {
+            checker.infer(part);
+        }
+        return Symbols::Variables::Type::STRING;
+    }
+
+    bool neverNull() const override { return true; }
+
+    // The parts appended in turn; as strings, they format as join() does.
+    int lower(Bytecode::Compiler & compiler) const override {
+        int result = compiler.literal(Symbols::ValuePtr(std::string()));
+        for (const auto & part : parts_) {
+            result = compiler.binary(BinaryOperator::Add, result, part->lower(compiler));
+        }
+        return result;
+    }
+
+    void resolveLocals(LocalResolver & resolver) override {
+        for (auto & part : parts_) {
+            resolver.resolve(part);
+        }
+    }
+
+    std::string toString() const override {
+        std::string result = "\"";
+        for (const auto & part : parts_) {
+            result += "${" + part->toString() + "}";
+        }
+        return result + "\"";
+    }
+
+  private:
+    static Symbols::ValuePtr join(std::vector<Piece> & pieces) {
+        size_t length = 0;
+        for (Piece & piece : pieces) {
+            format(piece);
+            length += piece.text.size();
+        }
+        std::string result;
+        result.reserve(length);
+        for (const Piece & piece : pieces) {
+            result.append(piece.text);
+        }
+        return result;
+    }
+
+    static void format(Piece & piece) {
+        using Symbols::Variables::Type;
+        const Symbols::ValuePtr & value = piece.value;
+        if (!value->is_null()) {
+            switch (value.getType()) {
+                case Type::STRING:
+                    piece.text = value.get<std::string>();
+                    return;
+                case Type::INTEGER:
+                    if (digits(piece, value.get<int>())) {
+                        return;
+                    }
+                    break;
+                case Type::DOUBLE:
+                    if (digits(piece, value.get<double>())) {
+                        return;
+                    }
+                    break;
+                case Type::FLOAT:
+                    // std::to_string(float) formats the value promoted to double.
+                    if (digits(piece, static_cast<double>(value.get<float>()))) {
+                        return;
+                    }
+                    break;
+                case Type::BOOLEAN:
+                    piece.text = value.get<bool>() ? "true" : "false";
+                    return;
+                default:
+                    break;
+            }
+        }
+        piece.owned = value.toString();
+        piece.text  = piece.owned;
+    }
+
+    static bool digits(Piece & piece, int number) {
+        const auto [end, error] = std::to_chars(std::begin(piece.digits), std::end(piece.digits), number);
+        piece.text              = std::string_view(piece.digits, end - piece.digits);
+        return error == std::errc();
+    }
+
+    // Fixed notation with six decimals, as std::to_string (printf "%f") writes it; a
+    // magnitude too large for the buffer falls back to toString().
+    static bool digits(Piece & piece, double number) {
+        const auto [end, error] =
+            std::to_chars(std::begin(piece.digits), std::end(piece.digits), number, std::chars_format::fixed, 6);
+        piece.text = std::string_view(piece.digits, end - piece.digits);
+        return error == std::errc();
+    }
+};
+
+}  // namespace Interpreter
+
+#endif  // INTERPRETER_INTERPOLATED_STRING_NODE_HPP
@@ -1,7 +1,9 @@
 #ifndef LITERAL_EXPRESSION_NODE_HPP
 #define LITERAL_EXPRESSION_NODE_HPP
 
+#include "Interpreter/Bytecode.hpp"
 #include "Interpreter/ExpressionNode.hpp"
+#include "Interpreter/TypeChecker.hpp"
 #include "Symbols/Value.hpp"
 
 namespace Interpreter {
@@ -19,6 +21,24 @@ class LiteralExpressionNode : public ExpressionNode {
 
     Symbols::ValuePtr & value() { return value_; }
 
+    bool constant() const override { return true; }
+
+    const Symbols::ValuePtr * literal() const override { return &value_; }
+
+    bool neverNull() const override { return !value_->is_null(); }
+
+    std::optional<Symbols::Variables::Type> inferType(TypeChecker & /*checker*/) override {
+        using Symbols::Variables::Type;
+        const Type type = value_.getType();
+        if (value_->is_null() || (type != Type::INTEGER && type != Type::DOUBLE && type != Type::FLOAT &&
+                                  type != Type::BOOLEAN && type != Type::STRING)) {
+            return std::nullopt;
+        }
+        return type;
+    }
+
+    int lower(Bytecode::Compiler & compiler) const override { return compiler.literal(value_); }
+
     // to string
     std::string toString() const override { return value_.toString(); }
 };
@@ -1,11 +1,15 @@
 #ifndef INTERPRETER_MEMBER_EXPRESSION_NODE_HPP
 #define INTERPRETER_MEMBER_EXPRESSION_NODE_HPP
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <utility>
 // #include <sstream> // Not strictly needed if only using toString()
 
 #include "Interpreter/ExpressionNode.hpp"
+#include "Interpreter/LocalResolver.hpp"
+#include "Interpreter/Optimizer.hpp"
 #include "Interpreter/Interpreter.hpp"
 #include "Symbols/SymbolContainer.hpp"
 #include "Symbols/Value.hpp"
@@ -36,14 +40,47 @@ class MemberExpressionNode : public ExpressionNode {
                             column_);
         }
 
-        const auto & map = objVal->get<Symbols::ObjectMap>();
+        // Const access: reading a member must not split a copy-on-write payload.
+        const auto & map = std::as_const(objVal)->get<Symbols::ObjectMap>();
+        auto *       sc  = Symbols::SymbolContainer::instance();
+
+        if (objVal->getType() == Symbols::Variables::Type::CLASS && cacheEpoch_ == sc->classEpoch()) {
+            // Another instance of the class this node last read from: the checks below
+            // gave the same answer for it, and the property sits at the same position.
+            const size_t classPos = map.position("$class_name", classPos_);
+            if (classPos != Symbols::ObjectMap::npos) {
+                const auto & classVal = map.entryAt(classPos).second;
+                if (classVal->getType() == Symbols::Variables::Type::STRING &&
+                    classVal->get<std::string>() == cacheClass_) {
+                    if (cachePrivate_ && !interpreter.isInsideClass(cacheClass_)) {
+                        throw Exception("Cannot access private property '" + propertyName_ +
+                                            "' from outside class '" + cacheClass_ + "'",
+                                        filename_, line_, column_);
+                    }
+                    const size_t keyPos = map.position(cacheKey_, keyPos_);
+                    if (keyPos != Symbols::ObjectMap::npos) {
+                        classPos_ = classPos;
+                        keyPos_   = keyPos;
+                        return propertyAt(objVal, keyPos);
+                    }
+                }
+            }
+        } else if (objVal->getType() == Symbols::Variables::Type::OBJECT) {
+            const size_t keyPos = map.position(propertyName_, keyPos_);
+            if (keyPos != Symbols::ObjectMap::npos) {
+                keyPos_ = keyPos;
+                return propertyAt(objVal, keyPos);
+            }
+        }
+
         std::string keyToLookup = propertyName_; // Default to the exact name
+        std::string cacheClass;                  // set once a class property passes every check
+        bool        cachePrivate = false;
 
         if (objVal->getType() == Symbols::Variables::Type::CLASS) {
             auto classMetaIt = map.find("$class_name");
             if (classMetaIt != map.end() && classMetaIt->second->getType() == Symbols::Variables::Type::STRING) {
                 std::string className = classMetaIt->second->get<std::string>();
-                auto* sc = Symbols::SymbolContainer::instance();
 
                 if (sc->hasClass(className)) {
                     // 1. Check for method first
@@ -83,6 +120,8 @@ class MemberExpressionNode : public ExpressionNode {
                             // Property is registered and access is allowed, but not found in this instance
                             throw Exception("Property '" + propertyName_ + "' is defined by class '" + className + "' but not initialized in this instance", filename_, line_, column_);
                         }
+                        cacheClass   = className;
+                        cachePrivate = sc->isPropertyPrivate(className, actualPropertyName);
                     } else {
                         // Property not registered in class
                         throw Exception("Property '" + propertyName_ + "' is not defined in class '" + className + "'", filename_, line_, column_);
@@ -100,7 +139,6 @@ class MemberExpressionNode : public ExpressionNode {
                  auto classMetaIt = map.find("$class_name");
                  if (classMetaIt != map.end() && classMetaIt->second->getType() == Symbols::Variables::Type::STRING) {
                     std::string className = classMetaIt->second->get<std::string>();
-                    auto* sc = Symbols::SymbolContainer::instance();
                     if (sc->hasClass(className)) {
                         // Check if the property is registered in the class (either direct name or $-prefixed)
                         if (sc->hasProperty(className, propertyName_)) {
@@ -122,15 +160,24 @@ class MemberExpressionNode : public ExpressionNode {
             throw Exception("Property '" + keyToLookup + "' (resolved from '" + propertyName_ + "') not found in object", filename_, line_, column_);
         }
         
-        // Note: do NOT use `if (!it->second)` here — ValuePtr's operator bool()
-        // treats falsy values (int 0, empty string, false) as null, which would
-        // block legitimate access to those property values. operator-> auto-
-        // fills a null shared_ptr, so the only meaningful check is is_null().
-        if (it->second->is_null()) {
-            throw Exception("Property '" + keyToLookup + "' is null in MemberExpressionNode", filename_, line_, column_);
+        const size_t keyPos = static_cast<size_t>(it - map.begin());
+        keyPos_             = keyPos;
+        if (!cacheClass.empty()) {
+            cacheClass_   = std::move(cacheClass);
+            cacheKey_     = keyToLookup;
+            cachePrivate_ = cachePrivate;
+            cacheEpoch_   = sc->classEpoch();
         }
+        return propertyAt(objVal, keyPos);
+    }
+
+    void resolveLocals(LocalResolver & resolver) override {
+        resolver.resolve(objectExpr_);
+    }
 
-        return it->second;
+    std::unique_ptr<ExpressionNode> fold(Optimizer & optimizer) override {
+        optimizer.fold(objectExpr_);
+        return nullptr;
     }
 
     std::string toString() const override { return objectExpr_->toString() + "->" + propertyName_; }
@@ -141,6 +188,39 @@ class MemberExpressionNode : public ExpressionNode {
     std::string                     filename_;
     int                             line_;
     size_t                          column_;
+
+    // Inline cache of the last class property read here: the class, the key it resolved
+    // to, whether it is private, and where the key and $class_name sat in the instance.
+    // Valid while SymbolContainer::classEpoch() is unchanged.
+    mutable std::string   cacheClass_;
+    mutable std::string   cacheKey_;
+    mutable bool          cachePrivate_ = false;
+    mutable std::uint64_t cacheEpoch_   = 0;
+    mutable size_t        classPos_     = Symbols::ObjectMap::npos;
+    mutable size_t        keyPos_       = Symbols::ObjectMap::npos;
+
+    Symbols::ValuePtr propertyAt(Symbols::ValuePtr & objVal, size_t pos) const {
+        const auto & value = std::as_const(objVal)->get<Symbols::ObjectMap>().entryAt(pos).second;
+
+        // Note: do NOT use `if (!value)` here — ValuePtr's operator bool()
+        // treats falsy values (int 0, empty string, false) as null, which would
+        // block legitimate access to those property values. operator-> auto-
+        // fills a null shared_ptr, so the only meaningful check is is_null().
+        if (value->is_null()) {
+            throw Exception("Property '" + std::as_const(objVal)->get<Symbols::ObjectMap>().entryAt(pos).first +
+                                "' is null in MemberExpressionNode",
+                            filename_, line_, column_);
+        }
+
+        // A nested object handed out of a shared payload must belong to this copy only.
+        if ((value == Symbols::Variables::Type::OBJECT || value == Symbols::Variables::Type::CLASS) &&
+            objVal->isShared()) {
+            objVal->unshare();
+            return std::as_const(objVal)->get<Symbols::ObjectMap>().entryAt(pos).second;
+        }
+
+        return value;
+    }
 };
 
 }  // namespace Interpreter
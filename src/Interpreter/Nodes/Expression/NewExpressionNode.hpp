@@ -6,9 +6,10 @@
 #include <vector>
 
 #include "Interpreter/ExpressionNode.hpp"
+#include "Interpreter/LocalResolver.hpp"
+#include "Interpreter/Optimizer.hpp"
 #include "Interpreter/Interpreter.hpp"
 #include "Interpreter/OperationContainer.hpp"
-#include "Interpreter/ReturnException.hpp"
 #include "Parser/ParsedExpression.hpp"
 
 #include "Symbols/FunctionSymbol.hpp"
@@ -44,7 +45,7 @@ class NewExpressionNode : public ExpressionNode {
     Symbols::ValuePtr evaluate(class Interpreter & interpreter, std::string filename = "", int line = 0,
                                size_t column = 0) const override {
         auto                                     sc            = Symbols::SymbolContainer::instance();
-        std::map<std::string, Symbols::ValuePtr> objProperties;
+        Symbols::ObjectMap                       objProperties;
 
         // First try to find the class info with the name as provided
         std::string       fqClassName = className_;
@@ -167,17 +168,8 @@ class NewExpressionNode : public ExpressionNode {
                 // below would find no operations and silently do nothing, so a module
                 // class such as DateTime came back uninitialised. Dispatch it the same
                 // way MethodCallExpressionNode dispatches any other native method.
-                bool constructorIsNative = false;
-                if (sc->hasClass(fqClassName)) {
-                    const Symbols::ClassInfo & classInfo = sc->getClassInfo(fqClassName);
-                    for (const auto & method : classInfo.methods) {
-                        if (method.name == foundConstructor && method.nativeImplementation) {
-                            constructorIsNative = true;
-                            break;
-                        }
-                    }
-                }
-                if (constructorIsNative) {
+                const Symbols::MethodEntry * constructorEntry = sc->findMethodEntry(fqClassName, foundConstructor);
+                if (constructorEntry && constructorEntry->native()) {
                     std::vector<Symbols::ValuePtr> nativeArgs;
                     nativeArgs.reserve(evaluatedArgs.size() + 1);
                     nativeArgs.push_back(newObject);  // the instance is always argument 0
@@ -273,20 +265,16 @@ class NewExpressionNode : public ExpressionNode {
 
                         // SET THIS OBJECT
                         interpreter.setThisObject(newObject);
-                        try {
-                            // Execute each operation
-                            for (const auto & op : operations) {
-                                interpreter.runOperation(*op);
+                        // Execute each operation; a return ends the constructor and its
+                        // value is ignored.
+                        for (const auto & op : operations) {
+                            if (!interpreter.runOperation(*op).normal()) {
+                                break;
                             }
-                        } catch (const ReturnException &) {
-                            // Constructor return value is ignored.
-                            // 'this' will be cleared by the clearThisObject() call that follows.
                         }
                         // Always clear 'this' after attempting constructor execution.
                         interpreter.clearThisObject();
 
-                    } catch (const ReturnException & re) {
-                        // Constructor return value is ignored
                     } catch (...) {
                         sc->enterPreviousScope();  // Ensure we pop the scope
                         throw;
@@ -327,20 +315,16 @@ class NewExpressionNode : public ExpressionNode {
 
                         // SET THIS OBJECT
                         interpreter.setThisObject(newObject);
-                        try {
-                            // Execute each operation
-                            for (const auto & op : operations) {
-                                interpreter.runOperation(*op);
+                        // Execute each operation; a return ends the constructor and its
+                        // value is ignored.
+                        for (const auto & op : operations) {
+                            if (!interpreter.runOperation(*op).normal()) {
+                                break;
                             }
-                        } catch (const ReturnException &) {
-                            // Constructor return value is ignored.
-                            // 'this' will be cleared by the clearThisObject() call that follows.
                         }
                         // Always clear 'this' after attempting constructor execution.
                         interpreter.clearThisObject();
 
-                    } catch (const ReturnException & re) {
-                        // Constructor return value is ignored
                     } catch (const std::exception& e) {
                         sc->enterPreviousScope();  // Ensure we pop the scope
                         throw;
@@ -363,6 +347,20 @@ class NewExpressionNode : public ExpressionNode {
         return newObject;
     }
 
+    void resolveLocals(LocalResolver & resolver) override {
+        for (auto & arg : args_) {
+            resolver.resolve(arg);
+        }
+        resolver.escapes();  // runs the constructor
+    }
+
+    std::unique_ptr<ExpressionNode> fold(Optimizer & optimizer) override {
+        for (auto & arg : args_) {
+            optimizer.fold(arg);
+        }
+        return nullptr;
+    }
+
     std::string toString() const override {
         std::string result = "NewExpressionNode[class=" + className_ + ", args=[";
         for (size_t i = 0; i < args_.size(); ++i) {
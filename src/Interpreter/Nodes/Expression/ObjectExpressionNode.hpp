@@ -6,6 +6,8 @@
 #include <vector>
 
 #include "Interpreter/ExpressionNode.hpp"
+#include "Interpreter/LocalResolver.hpp"
+#include "Interpreter/Optimizer.hpp"
 #include "Symbols/Value.hpp"
 
 namespace Interpreter {
@@ -15,10 +17,25 @@ class ObjectExpressionNode : public ExpressionNode {
     using ObjectMap = Symbols::ObjectMap;
 
     explicit ObjectExpressionNode(std::vector<std::pair<std::string, std::unique_ptr<ExpressionNode>>> members) :
-        members_(std::move(members)) {}
+        members_(std::move(members)) {
+        // Array literals and sized array declarations arrive keyed "0".."N-1" in order;
+        // those evaluate straight into a dense ArrayVector.
+        isArray_ = !members_.empty();
+        for (size_t i = 0; i < members_.size() && isArray_; ++i) {
+            isArray_ = members_[i].first == std::to_string(i);
+        }
+    }
 
     Symbols::ValuePtr evaluate(Interpreter & interpreter, std::string /*filename*/, int /*line*/,
                                size_t /*col */) const override {
+        if (isArray_) {
+            Symbols::ArrayVector elements;
+            elements.reserve(members_.size());
+            for (const auto & kv : members_) {
+                elements.push_back(kv.second->evaluate(interpreter));
+            }
+            return elements;
+        }
         ObjectMap obj;
         for (const auto & kv : members_) {
             obj[kv.first] = kv.second->evaluate(interpreter);
@@ -26,10 +43,24 @@ class ObjectExpressionNode : public ExpressionNode {
         return obj;
     }
 
+    void resolveLocals(LocalResolver & resolver) override {
+        for (auto & member : members_) {
+            resolver.resolve(member.second);
+        }
+    }
+
+    std::unique_ptr<ExpressionNode> fold(Optimizer & optimizer) override {
+        for (auto & member : members_) {
+            optimizer.fold(member.second);
+        }
+        return nullptr;
+    }
+
     std::string toString() const override { return "[object]"; }
 
   private:
     std::vector<std::pair<std::string, std::unique_ptr<ExpressionNode>>> members_;
+    bool                                                                 isArray_ = false;
 };
 
 }  // namespace Interpreter
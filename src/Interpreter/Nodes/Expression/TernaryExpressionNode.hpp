@@ -5,6 +5,9 @@
 #include <string>
 
 #include "Interpreter/ExpressionNode.hpp"
+#include "Interpreter/LocalResolver.hpp"
+#include "Interpreter/Optimizer.hpp"
+#include "Interpreter/TypeChecker.hpp"
 #include "Interpreter/Interpreter.hpp"
 #include "Symbols/Value.hpp"
 
@@ -52,6 +55,33 @@ class TernaryExpressionNode : public ExpressionNode {
                                       : elseBranch_->evaluate(interpreter, filename, line, column);
     }
 
+    bool neverNull() const override { return thenBranch_->neverNull() && elseBranch_->neverNull(); }
+
+    void resolveLocals(LocalResolver & resolver) override {
+        resolver.resolve(condition_);
+        resolver.resolve(thenBranch_);
+        resolver.resolve(elseBranch_);
+    }
+
+    // A literal condition selects its branch once, here.
+    std::unique_ptr<ExpressionNode> fold(Optimizer & optimizer) override {
+        optimizer.fold(condition_);
+        optimizer.fold(thenBranch_);
+        optimizer.fold(elseBranch_);
+        const auto taken = Optimizer::condition(condition_);
+        if (!taken) {
+            return nullptr;
+        }
+        return std::move(*taken ? thenBranch_ : elseBranch_);
+    }
+
+    std::optional<Symbols::Variables::Type> inferType(TypeChecker & checker) override {
+        checker.condition(condition_, "Ternary condition must be a boolean", filename, line, column);
+        const auto thenType = checker.infer(thenBranch_);
+        const auto elseType = checker.infer(elseBranch_);
+        return thenType == elseType ? thenType : std::nullopt;
+    }
+
     std::string toString() const override {
         return "(" + condition_->toString() + " ? " + thenBranch_->toString() + " : " + elseBranch_->toString() + ")";
     }
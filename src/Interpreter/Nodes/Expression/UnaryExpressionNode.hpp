@@ -4,103 +4,123 @@
 #include <memory>
 #include <string>
 
+#include "Interpreter/Bytecode.hpp"
 #include "Interpreter/ExpressionNode.hpp"
+#include "Interpreter/LocalResolver.hpp"
+#include "Interpreter/Nodes/Expression/LiteralExpressionNode.hpp"
+#include "Interpreter/Operator.hpp"
+#include "Interpreter/Optimizer.hpp"
+#include "Interpreter/TypeChecker.hpp"
 
 namespace Interpreter {
 
 class UnaryExpressionNode : public ExpressionNode {
     std::string                     op_;
+    UnaryOperator                   operator_;  // op_ resolved when the node is built
     std::unique_ptr<ExpressionNode> operand_;
 
   public:
     UnaryExpressionNode(std::string op, std::unique_ptr<ExpressionNode> operand) :
         op_(std::move(op)),
+        operator_(unaryOperator(op_)),
         operand_(std::move(operand)) {}
 
     Symbols::ValuePtr evaluate(Interpreter & interpreter, std::string /*filename*/, int /*line*/,
                                size_t /*col */) const override {
-        const auto value = operand_->evaluate(interpreter);
-
-        if (value == Symbols::Variables::Type::INTEGER) {
-            int v = value;
-            if (op_ == "-") {
-                return -v;
-                //return Symbols::ValuePtr(-v);
-            }
-            if (op_ == "+") {
-                return +v;
-                //return Symbols::ValuePtr(+v);
-            }
-            if (op_ == "++") {
-                return v + 1;
-                //return Symbols::ValuePtr(v + 1);
-            }
-            if (op_ == "--") {
-                return v - 1;
-                //return Symbols::ValuePtr(v - 1);
-            }
-            if (op_ == "~") {
-                // Bitwise complement is integer-only; there is no meaningful float form.
-                return ~v;
-            }
-        } else if (value == Symbols::Variables::Type::DOUBLE) {
-            double v = value;
-            if (op_ == "-") {
-                return -v;
-                //return Symbols::ValuePtr(-v);
-            }
-            if (op_ == "+") {
-                return +v;
-                //return Symbols::ValuePtr(+v);
-            }
-            if (op_ == "++") {
-                return v + 1;
-                //return Symbols::ValuePtr(v + 1);
-            }
-            if (op_ == "--") {
-                return v - 1;
-                //return Symbols::ValuePtr(v - 1);
-            }
-        } else if (value == Symbols::Variables::Type::FLOAT) {
-            float v = value;  //->get<float>();
-            if (op_ == "-") {
-                return -v;
-                //return Symbols::ValuePtr(-v);
-            }
-            if (op_ == "+") {
-                return +v;
-                //return Symbols::ValuePtr(+v);
-            }
-            if (op_ == "++") {
-                return v + 1;
-                //return Symbols::ValuePtr(v + 1);
-            }
-            if (op_ == "--") {
-                return v - 1;
-                //return Symbols::ValuePtr(v - 1);
-            }
-        } else if (value == Symbols::Variables::Type::BOOLEAN) {
-            bool v = value.toBool();
-            if (op_ == "!") {
-                return !v;
-                //return Symbols::ValuePtr(!v);
-            }
-        } else if (value == Symbols::Variables::Type::STRING) {
-            const std::string s = value;  //->get<std::string>();
-            if (op_ == "-") {
-                return s;
-                //return Symbols::ValuePtr(s);
-            }
-            if (op_ == "+") {
-                return s;
-                //return Symbols::ValuePtr(s);
-            }
+        return apply(operand_->evaluate(interpreter));
+    }
+
+    Symbols::ValuePtr apply(const Symbols::ValuePtr & value) const {
+        switch (value.getType()) {
+            case Symbols::Variables::Type::INTEGER:
+                {
+                    const int v = value.get<int>();
+                    switch (operator_) {
+                        case UnaryOperator::Negate: return -v;
+                        case UnaryOperator::Plus: return +v;
+                        case UnaryOperator::Increment: return v + 1;
+                        case UnaryOperator::Decrement: return v - 1;
+                        // Bitwise complement is integer-only; there is no meaningful float form.
+                        case UnaryOperator::BitNot: return ~v;
+                        default: break;
+                    }
+                    break;
+                }
+            case Symbols::Variables::Type::DOUBLE:
+                {
+                    const double v = value.get<double>();
+                    switch (operator_) {
+                        case UnaryOperator::Negate: return -v;
+                        case UnaryOperator::Plus: return +v;
+                        case UnaryOperator::Increment: return v + 1;
+                        case UnaryOperator::Decrement: return v - 1;
+                        default: break;
+                    }
+                    break;
+                }
+            case Symbols::Variables::Type::FLOAT:
+                {
+                    const float v = value.get<float>();
+                    switch (operator_) {
+                        case UnaryOperator::Negate: return -v;
+                        case UnaryOperator::Plus: return +v;
+                        case UnaryOperator::Increment: return v + 1;
+                        case UnaryOperator::Decrement: return v - 1;
+                        default: break;
+                    }
+                    break;
+                }
+            case Symbols::Variables::Type::BOOLEAN:
+                if (operator_ == UnaryOperator::Not) {
+                    return !value.toBool();
+                }
+                break;
+            case Symbols::Variables::Type::STRING:
+                if (operator_ == UnaryOperator::Negate || operator_ == UnaryOperator::Plus) {
+                    return value.get<std::string>();
+                }
+                break;
+            default:
+                break;
         }
 
         throw std::runtime_error("Unsupported unary operator '" + op_ +
                                  "' for type: " + Symbols::Variables::TypeToString(value));
     }
 
+    bool neverNull() const override { return true; }
+
+    void resolveLocals(LocalResolver & resolver) override {
+        resolver.resolve(operand_);
+    }
+
+    std::unique_ptr<ExpressionNode> fold(Optimizer & optimizer) override {
+        optimizer.fold(operand_);
+        const auto * operand = Optimizer::literal(operand_);
+        if (!operand) {
+            return nullptr;
+        }
+        try {
+            return std::make_unique<LiteralExpressionNode>(apply(*operand));
+        } catch (const std::exception &) {
+            return nullptr;  // fails the same way when it runs
+        }
+    }
+
+    std::optional<Symbols::Variables::Type> inferType(TypeChecker & checker) override {
+        const auto operand = checker.infer(operand_);
+        bool       fails   = false;
+        const auto proven  = TypeChecker::unary(operator_, operand, fails);
+        if (fails) {
+            checker.error("Unsupported unary operator '" + op_ + "' for type: " +
+                              Symbols::Variables::TypeToString(*operand),
+                          *this);
+        }
+        return proven;
+    }
+
+    int lower(Bytecode::Compiler & compiler) const override { return compiler.unary(operator_, operand_->lower(compiler)); }
+
     std::string toString() const override { return "(" + op_ + operand_->toString() + ")"; }
 };
 
@@ -3,9 +3,12 @@
 
 #include <iostream> // For std::cerr
 #include <string>   // For std::string
+#include "Interpreter/Bytecode.hpp"
 #include "Interpreter/ExpressionNode.hpp"
 #include "Interpreter/Interpreter.hpp"
+#include "Interpreter/LocalResolver.hpp"
 #include "Interpreter/StatementNode.hpp"
+#include "Interpreter/TypeChecker.hpp"
 #include "Symbols/NumericCoercion.hpp"
 #include "Symbols/SymbolContainer.hpp"
 #include "Symbols/Value.hpp"
@@ -21,6 +24,8 @@ class AssignmentStatementNode : public StatementNode {
     std::string                     targetName_;
     std::vector<std::string>        propertyPath_;
     std::unique_ptr<ExpressionNode> rhs_;
+    LocalSlot                       slot_;
+    mutable size_t                  propertyPos_ = Symbols::ObjectMap::npos;  // last position of the final key
   public:
     AssignmentStatementNode(std::string targetName, std::vector<std::string> propertyPath,
                             std::unique_ptr<ExpressionNode> rhs, const std::string & file, int line, size_t column) :
@@ -29,17 +34,22 @@ class AssignmentStatementNode : public StatementNode {
         propertyPath_(std::move(propertyPath)),
         rhs_(std::move(rhs)) {}
 
-    void interpret(Interpreter & interpreter) const override {
+    ControlFlowSignal interpret(Interpreter & interpreter) const override {
         using namespace Symbols;
         auto * symContainer = SymbolContainer::instance();
 
-        // +++ Add New Logging +++
-        std::string full_target_path = targetName_;
-        for(const auto& p : propertyPath_) full_target_path += "->" + p;
-        // +++ End New Logging +++
+        // A resolved local is written through its frame slot; otherwise look the name up.
+        SymbolPtr symbol;
+        if (slot_.bound()) {
+            if (auto * frame = symContainer->frameTable(static_cast<size_t>(slot_.depth), slot_.frame)) {
+                symbol = frame->slotPtr(static_cast<size_t>(slot_.slot));
+            }
+        }
 
         // First try to get the variable (most common case)
-        auto symbol = symContainer->getVariable(targetName_);
+        if (!symbol) {
+            symbol = symContainer->getVariable(targetName_);
+        }
 
         // If not found, try to get it as a constant (which will fail for assignment later)
         if (!symbol) {
@@ -102,27 +112,27 @@ class AssignmentStatementNode : public StatementNode {
                     // This is the final property to assign.
                     // Symbols::ValuePtr newValueEvaluated = rhs_->evaluate(interpreter); // Already evaluated as newValueRhs
 
-                    // Optional Type Check:
-                    if (map_ref.count(key)) {
-                        const Symbols::ValuePtr & existing_prop_val = map_ref.at(key);
-                        if (newValueRhs.getType() != Symbols::Variables::Type::NULL_TYPE && // Use newValueRhs
+                    // Instances of one class keep a property at the same position, so
+                    // try where it was last time before looking it up.
+                    const size_t pos = map_ref.position(key, propertyPos_);
+                    if (pos == Symbols::ObjectMap::npos) {
+                        map_ref[key] = newValueRhs;
+                    } else {
+                        propertyPos_ = pos;
+
+                        // Optional Type Check:
+                        Symbols::ValuePtr & existing_prop_val = map_ref.entryAt(pos).second;
+                        if (newValueRhs.getType() != Symbols::Variables::Type::NULL_TYPE &&
                             existing_prop_val.getType() != Symbols::Variables::Type::NULL_TYPE &&
-                            newValueRhs.getType() != existing_prop_val.getType()) { // Use newValueRhs
+                            newValueRhs.getType() != existing_prop_val.getType()) {
                             throw Exception("Type mismatch for property '" + key + "': expected '" +
                                                 Symbols::Variables::TypeToString(existing_prop_val.getType()) +
                                                 "' but got '" +
-                                                Symbols::Variables::TypeToString(newValueRhs.getType()) + "'", // Use newValueRhs
+                                                Symbols::Variables::TypeToString(newValueRhs.getType()) + "'",
                                             filename_, line_, column_);
                         }
-                    }
-                    // Only reference assignment, do not clone ValuePtr
-                    // map_ref[key] = newValueEvaluated;
-                    map_ref[key] = newValueRhs; // Use the already evaluated newValueRhs
-                    if (targetName_ == "this") {
-                        // Ensure 'this' object and key exist before trying to access for verification
-                        const auto& thisObj = interpreter.getThisObject();
-                        if (thisObj->getType() != Symbols::Variables::Type::NULL_TYPE && !thisObj->is_null() && map_ref.count(key)) {
-                        }
+                        // Only reference assignment, do not clone ValuePtr
+                        existing_prop_val = newValueRhs;
                     }
                 } else {
                     // Not the last property, so traverse deeper.
@@ -160,6 +170,30 @@ class AssignmentStatementNode : public StatementNode {
             // Only reference assignment, do not clone ValuePtr
             symbol->setValue(newValue);
         }
+        return {};
+    }
+
+    void resolveLocals(LocalResolver & resolver) override {
+        resolver.resolve(rhs_);
+        if (targetName_ != "this" && targetName_ != "$this") {
+            resolver.reference(targetName_, slot_);
+        }
+    }
+
+    void optimize(Optimizer & optimizer) override {
+        optimizer.fold(rhs_);
+        if (propertyPath_.empty()) {
+            optimizer.declare(targetName_);
+        }
+    }
+
+    void checkTypes(TypeChecker & checker) override { static_cast<void>(checker.infer(rhs_)); }
+
+    bool lower(Bytecode::Compiler & compiler) const override {
+        if (!propertyPath_.empty() || targetName_ == "this" || targetName_ == "$this") {
+            return false;
+        }
+        return compiler.assign(Symbols::AtomTable::intern(targetName_), rhs_->lower(compiler));
     }
 
     std::string toString() const override {
@@ -1,12 +1,11 @@
 #include "BreakNode.hpp"
 // Method definitions are now inline in BreakNode.hpp.
-// Includes like Interpreter.hpp and BreakException.hpp are now primarily needed in the header.
+// Includes like Interpreter.hpp are now primarily needed in the header.
 // Retaining some includes here in case other parts of the build system might have (incorrectly)
 // relied on this .cpp file providing them transitively. For a pure header-only approach,
 // this .cpp file would ideally be almost empty or just #include "BreakNode.hpp".
 
 #include "../../../Interpreter/Interpreter.hpp" // Retained for now
-#include "Interpreter/BreakException.hpp" // Retained for now
 
 
 namespace Interpreter::Nodes::Statement {
@@ -5,8 +5,8 @@
 #include <memory>
 
 #include "../../StatementNode.hpp" // Base class
+#include "../../Bytecode.hpp"
 #include "../../../Interpreter/Interpreter.hpp" // For Interpreter class (for Accept method)
-#include "../../../Interpreter/BreakException.hpp" // Added for BreakException
 
 // Forward declare Interpreter is no longer needed due to direct include of Interpreter.hpp
 
@@ -21,19 +21,24 @@ public:
     ) : ::Interpreter::StatementNode(file_name, file_line, line_column) {}
 
     // The Accept method is the equivalent of 'interpret' for the visitor pattern
-    void Accept(::Interpreter::Interpreter& interpreter) const {
-        this->interpret(interpreter);
+    ::Interpreter::ControlFlowSignal Accept(::Interpreter::Interpreter& interpreter) const {
+        return this->interpret(interpreter);
     }
 
+    void resolveLocals(::Interpreter::LocalResolver & /*resolver*/) override {}
+
+    void optimize(::Interpreter::Optimizer & /*optimizer*/) override {}
+
+    bool lower(::Interpreter::Bytecode::Compiler & compiler) const override { return compiler.jumpOut(true); }
+
     // Implementation for the pure virtual toString() method
     std::string toString() const override {
         return "BreakNode()";
     }
 
     // interpret() is pure virtual in StatementNode.
-    void interpret(::Interpreter::Interpreter& interpreter) const override {
-        // The 'interpreter' parameter is not used by this specific node's logic.
-        throw BreakException();
+    ::Interpreter::ControlFlowSignal interpret(::Interpreter::Interpreter& /*interpreter*/) const override {
+        return ::Interpreter::ControlFlowSignal::breakLoop();
     }
 };
 
@@ -5,11 +5,11 @@
 #include <string>
 #include <vector>
 
-#include "Interpreter/BreakException.hpp"
-#include "Interpreter/ContinueException.hpp"
+#include "Interpreter/Bytecode.hpp"
 #include "Interpreter/ExpressionNode.hpp"
 #include "Interpreter/Interpreter.hpp"
 #include "Interpreter/StatementNode.hpp"
+#include "Interpreter/TypeChecker.hpp"
 #include "Symbols/SymbolContainer.hpp"
 #include "Symbols/Value.hpp" // Required for Symbols::ValuePtr(true)
 
@@ -24,10 +24,13 @@ class CStyleForStatementNode : public StatementNode {
     std::unique_ptr<ExpressionNode>             condExpr_;
     std::unique_ptr<StatementNode>              incrStmt_;
     std::vector<std::unique_ptr<StatementNode>> body_;
-    // loopScopeName_ is no longer strictly necessary for init variable scoping,
-    // but might be useful for debugging or if loop body needs a predictable name base.
-    // For now, its direct usage for init var scoping is removed.
-    // std::string                                 loopScopeName_; 
+    mutable Bytecode::LoopCache                 bytecode_;
+    bool                                        conditionProven_ = false;  // proven boolean by the TypeChecker
+    // The loop's scope is named after the enclosing runtime scope plus this suffix, keyed
+    // by source position; the "for_" marker lets a declaration in the body run again on
+    // the next iteration.
+    std::string                                 scopeSuffix_;
+    Symbols::Atom                               frame_ = Symbols::kNoAtom;  // scope tag; see LocalResolver
 
   public:
     CStyleForStatementNode(std::unique_ptr<StatementNode> initStmt, std::unique_ptr<ExpressionNode> condExpr,
@@ -37,84 +40,73 @@ class CStyleForStatementNode : public StatementNode {
         initStmt_(std::move(initStmt)),
         condExpr_(std::move(condExpr)),
         incrStmt_(std::move(incrStmt)),
-        body_(std::move(body)) {
-        // loopScopeName_ initialization removed as its primary purpose changed.
-        // If needed for other reasons, it would be:
-        // loopScopeName_ = Symbols::SymbolContainer::instance()->currentScopeName() + "::for_" + std::to_string(line) +
-        //                  "_" + std::to_string(column);
-    }
+        body_(std::move(body)),
+        scopeSuffix_(Symbols::SymbolContainer::SCOPE_SEPARATOR + "for_" + std::to_string(line) + "_" +
+                     std::to_string(column)) {}
 
-    void interpret(Interpreter & interpreter) const override {
+    ControlFlowSignal interpret(Interpreter & interpreter) const override {
         // Get symbol container instance
         auto * symContainer = Symbols::SymbolContainer::instance();
 
         // Flag to track if the specific loop scope was entered
         bool entered_loop_scope = false;
-        // Define the name for the loop's own operational scope (for init, body, condition
-        // and increment). It is keyed by source position, so each loop in the file gets
-        // its own scope and re-entering the same loop reuses it.
-        std::string runtime_loop_scope_name = symContainer->currentScopeName() +
-                                           Symbols::SymbolContainer::SCOPE_SEPARATOR + "for_" +
-                                           std::to_string(line_) + "_" +
-                                           std::to_string(column_);
         try {
             // 1. Create and enter the loop's own scope BEFORE running the initialiser.
             // The induction variable belongs to the loop, as in C. Running the init in
             // the parent scope leaked it, so a second `for (int $i = ...)` anywhere in
             // the same scope failed with "Variable 'i' already declared".
-            if (!symContainer->getScopeTable(runtime_loop_scope_name)) {
-                symContainer->create(runtime_loop_scope_name);
-            } else {
-                // Re-entering the same loop: DeclareVariableStatementNode updates rather
-                // than rejects a redeclaration in a scope named "for_...".
-                symContainer->enter(runtime_loop_scope_name);
-            }
+            symContainer->enterLoopFrame(scopeSuffix_, frame_);
             entered_loop_scope = true;
 
             // 2. Execute the initialisation statement inside the loop scope
             if (initStmt_) {
-                initStmt_->interpret(interpreter);
+                static_cast<void>(initStmt_->interpret(interpreter));
+            }
+
+            // 3. Run the iterations on the bytecode VM when they lower to it, walk them otherwise.
+            if (interpreter.bytecodeEnabled() && bytecode_.run(*this, interpreter, [this](Bytecode::Compiler & compiler) {
+                    return compiler.loop(condExpr_.get(), incrStmt_.get(), body_);
+                })) {
+                interpreter.backEdge();
+                symContainer->enterPreviousScope();
+                return {};
             }
 
-            // 3. Loop condition, body, and increment execute within runtime_loop_scope_name
+            // Loop condition, body, and increment execute within the loop scope
             while (true) {
                 // Evaluate condition (in loop scope, can access parent scope vars like $i)
-                Symbols::ValuePtr condVal;
-                if (condExpr_) { // Condition can be null for infinite loops like for(;;)
-                    condVal = condExpr_->evaluate(interpreter);
-                } else {
-                    // If no condition expression, it's an infinite loop, effectively true.
-                    condVal = Symbols::ValuePtr(true); 
-                }
-                
-                if (condVal != Symbols::Variables::Type::BOOLEAN) {
-                    // No need to manually pop scope here, catch block will handle it
-                    throw Exception("For loop condition not boolean", filename_, line_, column_);
+                bool shouldContinue = true;  // no condition: for(;;) runs until a break
+                if (conditionProven_) {
+                    shouldContinue = condExpr_->evaluateCondition(interpreter);
+                } else if (condExpr_) {
+                    const Symbols::ValuePtr condVal = condExpr_->evaluate(interpreter);
+                    if (condVal != Symbols::Variables::Type::BOOLEAN) {
+                        // No need to manually pop scope here, catch block will handle it
+                        throw Exception("For loop condition not boolean", filename_, line_, column_);
+                    }
+                    shouldContinue = condVal.toBool();
                 }
-                bool shouldContinue = condVal.toBool();
                 if (!shouldContinue) {
                     break;
                 }
 
                 // Execute body (in loop scope)
-                try {
-                    for (const auto & stmt : body_) {
-                        if (stmt) {
-                            stmt->interpret(interpreter);
-                        }
-                    }
-                } catch (const BreakException &) {
-                    // Break out of the C-style for loop
+                const ControlFlowSignal signal = interpretBody(interpreter, body_);
+                if (signal.kind() == ControlFlowSignal::Kind::Break) {
                     break;
-                } catch (const ContinueException &) {
-                    // Skip the rest of this iteration. Fall through to the increment
-                    // below - skipping it would make the loop spin forever.
                 }
+                if (signal.kind() == ControlFlowSignal::Kind::Return) {
+                    symContainer->enterPreviousScope();
+                    return signal;
+                }
+                // A continue falls through to the increment - skipping it would make
+                // the loop spin forever.
 
                 // Execute increment (in loop scope)
                 if (incrStmt_) {
-                    incrStmt_->interpret(interpreter);
+                    static_cast<void>(incrStmt_->interpret(interpreter));
                 }
+                interpreter.backEdge();
             }
         } catch (const BaseException &) { // Any VoidScript error, including a script `throw`
             if (entered_loop_scope) {
@@ -132,6 +124,39 @@ class CStyleForStatementNode : public StatementNode {
         if (entered_loop_scope) {
             symContainer->enterPreviousScope();
         }
+        return {};
+    }
+
+    void resolveLocals(LocalResolver & resolver) override {
+        // The initialiser already runs in the loop's scope.
+        frame_ = resolver.enterLoop();
+        resolver.resolve(initStmt_);
+        resolver.resolve(condExpr_);
+        resolver.resolve(incrStmt_);
+        resolver.resolveBody(body_);
+        resolver.exitLoop();
+    }
+
+    void optimize(Optimizer & optimizer) override {
+        optimizer.nested(initStmt_);
+        optimizer.fold(condExpr_);
+        optimizer.nested(incrStmt_);
+        optimizer.body(body_);
+    }
+
+    void checkTypes(TypeChecker & checker) override {
+        checker.check(initStmt_);
+        conditionProven_ = checker.condition(condExpr_, "For loop condition not boolean", filename_, line_, column_);
+        checker.check(incrStmt_);
+        checker.checkBody(body_);
+    }
+
+    bool lower(Bytecode::Compiler & compiler) const override {
+        compiler.enterScope(filename_, line_, column_);
+        const bool lowered = (!initStmt_ || initStmt_->lower(compiler)) &&
+                             compiler.loop(condExpr_.get(), incrStmt_.get(), body_);
+        compiler.exitScope();
+        return lowered;
     }
 
     std::string toString() const override {
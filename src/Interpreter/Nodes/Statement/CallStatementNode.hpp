@@ -5,11 +5,12 @@
 #include <string>
 #include <vector>
 
+#include "Interpreter/Bytecode.hpp"
+#include "Interpreter/CallSiteCache.hpp"
 #include "Interpreter/ExpressionNode.hpp"
 #include "Interpreter/Interpreter.hpp"
 #include "Interpreter/ThrowException.hpp"
 #include "Interpreter/OperationContainer.hpp"
-#include "Interpreter/ReturnException.hpp"
 #include "Interpreter/StatementNode.hpp"
 
 #include "Symbols/FunctionSymbol.hpp"
@@ -20,11 +21,13 @@
 namespace Interpreter {
 
 /**
- * @brief Statement node representing a function call with argument expressions.
+ * @brief Statement node representing a function call with argument expressions. A
+ * compiled loop makes the call through invoke(), with arguments it evaluated itself.
  */
-class CallStatementNode : public StatementNode {
+class CallStatementNode : public StatementNode, public Bytecode::CallSite {
     std::string                                  functionName_;
     std::vector<std::unique_ptr<ExpressionNode>> args_;
+    mutable CallSiteCache                        cache_;
 
   public:
     CallStatementNode(const std::string & functionName, std::vector<std::unique_ptr<ExpressionNode>> args,
@@ -33,93 +36,14 @@ class CallStatementNode : public StatementNode {
         functionName_(functionName),
         args_(std::move(args)) {}
 
-    void interpret(Interpreter & interpreter) const override {
+    ControlFlowSignal interpret(Interpreter & interpreter) const override {
         try {
             std::vector<Symbols::ValuePtr> argValues;
             argValues.reserve(args_.size());
             for (const auto & expr : args_) {
                 argValues.push_back(expr->evaluate(interpreter));
             }
-            
-            // Check for module functions via SymbolContainer first
-            auto * symbolContainer = Symbols::SymbolContainer::instance();
-            if (symbolContainer->hasFunction(functionName_)) {
-                symbolContainer->callFunction(functionName_, argValues);
-                return;  // Function call statements don't return values
-            }
-            
-            // User-defined function: lookup through scope hierarchy
-            Symbols::SymbolContainer *               sc       = Symbols::SymbolContainer::instance();
-            std::string                              lookupNs = sc->currentScopeName();
-            std::shared_ptr<Symbols::FunctionSymbol> funcSym;
-            // Search for function symbol in current and parent scopes
-            while (true) {
-                auto               scope_table = sc->getScopeTable(lookupNs);
-                Symbols::SymbolPtr sym         = nullptr;
-                if (scope_table) {
-                    sym = scope_table->get(Symbols::SymbolContainer::DEFAULT_FUNCTIONS_SCOPE, functionName_);
-                }
-
-                if (sym && sym->getKind() == Symbols::Kind::Function) {
-                    funcSym = std::static_pointer_cast<Symbols::FunctionSymbol>(sym);
-                    break;
-                }
-                // Move to parent scope by finding the last '::'
-                // This assumes scope names are hierarchical (e.g., /file/path::class::method or a top-level file path)
-                auto pos = lookupNs.rfind(Symbols::SymbolContainer::SCOPE_SEPARATOR);
-                if (pos == std::string::npos) {
-                    // Reached top-level scope (e.g., a file path). If not found, it's not in accessible parent scopes.
-                    break;
-                }
-                lookupNs = lookupNs.substr(0, pos);
-                // If substr results in an empty string (e.g. if lookupNs was "::foo"), implies invalid scope.
-                if (lookupNs.empty()) {
-                    break;
-                }
-            }
-            if (!funcSym) {
-                throw Exception("Function not found: " + functionName_, filename_, line_, column_);
-            }
-            const auto & params = funcSym->parameters();
-            if (params.size() != argValues.size()) {
-                throw Exception("Function '" + functionName_ + "' expects " + std::to_string(params.size()) +
-                                    " args, got " + std::to_string(argValues.size()),
-                                filename_, line_, column_);
-            }
-
-            // Create unique scope for this function call
-            const std::string canonical_fn_scope_name =
-                funcSym->context().empty() ?
-                    functionName_ :
-                    funcSym->context() + Symbols::SymbolContainer::SCOPE_SEPARATOR + functionName_;
-            std::string unique_call_scope_name = canonical_fn_scope_name + Symbols::SymbolContainer::CALL_SCOPE +
-                                                 std::to_string(Interpreter::get_unique_call_id());
-
-            sc->create(unique_call_scope_name);  // Creates and enters the new unique scope
-
-            // Bind parameters in the unique call scope
-            for (size_t i = 0; i < params.size(); ++i) {
-                const auto &      p      = params[i];
-                Symbols::ValuePtr v      = argValues[i];
-                // Symbol's context is this specific call's scope
-                auto              varSym = Symbols::SymbolFactory::createVariable(p.name, v, unique_call_scope_name);
-                sc->addVariable(varSym);  // Adds to the current scope (unique_call_scope_name)
-            }
-
-            // Operations are associated with the canonical function name
-            auto ops = Operations::Container::instance()->getAll(canonical_fn_scope_name);
-            for (const auto & op : ops) {
-                try {
-                    interpreter.runOperation(*op);  // These operations will use the current unique_call_scope_name
-                } catch (const ReturnException &) {
-                    // Called in statement position, so the returned value (if any) is
-                    // discarded. Catching here rather than letting it escape keeps the
-                    // scope exit below reachable and stops ReturnException - which is not
-                    // a std::exception - from unwinding out of main into std::terminate.
-                    break;
-                }
-            }
-            sc->enterPreviousScope();           // Exit unique_call_scope_name
+            run(interpreter, argValues);
         } catch (const BaseException &) {
             // BaseException, not Exception: ThrowException also derives from it, and
             // catching only Exception here let the generic handler below flatten a
@@ -129,6 +53,36 @@ class CallStatementNode : public StatementNode {
         } catch (const std::exception & e) {
             throw Exception(e.what(), filename_, line_, column_);
         }
+        return {};
+    }
+
+    Symbols::ValuePtr invoke(Interpreter & interpreter, std::vector<Symbols::ValuePtr> args) const override {
+        try {
+            run(interpreter, args);
+        } catch (const BaseException &) {
+            throw;
+        } catch (const std::exception & e) {
+            throw Exception(e.what(), filename_, line_, column_);
+        }
+        return {};
+    }
+
+    bool lower(Bytecode::Compiler & compiler) const override {
+        return compiler.callStatement(*this, Symbols::AtomTable::intern(functionName_), args_,
+                                      Bytecode::Site{ filename_, line_, column_ });
+    }
+
+    void resolveLocals(LocalResolver & resolver) override {
+        for (auto & arg : args_) {
+            resolver.resolve(arg);
+        }
+        resolver.call(functionName_);
+    }
+
+    void optimize(Optimizer & optimizer) override {
+        for (auto & arg : args_) {
+            optimizer.fold(arg);
+        }
     }
 
     std::string toString() const override {
@@ -140,6 +94,55 @@ class CallStatementNode : public StatementNode {
     // Public access methods for compilation
     const std::string& getFunctionName() const { return functionName_; }
     const std::vector<std::unique_ptr<ExpressionNode>>& getArguments() const { return args_; }
+
+  private:
+    void run(Interpreter & interpreter, const std::vector<Symbols::ValuePtr> & argValues) const {
+        // Module functions first, then script functions visible from this scope
+        auto *     sc     = Symbols::SymbolContainer::instance();
+        const auto target = cache_.resolve(functionName_);
+        if (!target) {
+            throw Exception("Function not found: " + functionName_, filename_, line_, column_);
+        }
+        if (target->native) {
+            (*target->native)(argValues);
+            return;  // Function call statements don't return values
+        }
+
+        const auto & params = target->function->parameters();
+        if (params.size() != argValues.size()) {
+            throw Exception("Function '" + functionName_ + "' expects " + std::to_string(params.size()) +
+                                " args, got " + std::to_string(argValues.size()),
+                            filename_, line_, column_);
+        }
+
+        // Enter a pooled call frame for this function call
+        const size_t caller_depth = sc->getScopeStack().size();
+        auto *       frame        = sc->enterFrame(target->callScope, target->frame);
+
+        // Bind parameters in the call frame; parameter i is frame slot i
+        for (size_t i = 0; i < params.size(); ++i) {
+            const auto &      p      = params[i];
+            Symbols::ValuePtr v      = argValues[i];
+            auto              varSym = Symbols::SymbolFactory::createVariable(p.name, v, target->callScope);
+            sc->addVariable(varSym);  // Adds to the current scope (the call frame)
+            frame->bindSlot(i, varSym);
+        }
+
+        // Operations are associated with the canonical function name
+        try {
+            for (size_t i = 0; target->body && i < target->body->size(); ++i) {
+                // Runs inside the call frame. Called in statement position, so the
+                // returned value (if any) is discarded.
+                if (!interpreter.runOperation(*(*target->body)[i]).normal()) {
+                    break;
+                }
+            }
+        } catch (...) {
+            sc->unwindScopeStack(caller_depth);  // release the frame on the error path too
+            throw;
+        }
+        sc->unwindScopeStack(caller_depth);  // Exit the call frame
+    }
 };
 
 }  // namespace Interpreter
@@ -1,7 +1,7 @@
 #ifndef INTERPRETER_CLASS_DEFINITION_STATEMENT_NODE_HPP
 #define INTERPRETER_CLASS_DEFINITION_STATEMENT_NODE_HPP
 
-#include <algorithm>  // for std::reverse
+#include <algorithm>  // std::any_of, std::reverse
 #include <string>
 #include <vector>
 
@@ -40,7 +40,7 @@ class ClassDefinitionStatementNode : public StatementNode {
         methodNames_(std::move(methods)),
         constructorName_(constructorName) {}  // Added
 
-    void interpret(Interpreter & interpreter) const override {
+    ControlFlowSignal interpret(Interpreter & interpreter) const override {
         auto * sc = Symbols::SymbolContainer::instance();
         
         // Register the class itself (only if not already registered)
@@ -52,12 +52,23 @@ class ClassDefinitionStatementNode : public StatementNode {
             sc->addClass(classSymbol);
         }
         
-        // Register private and public properties (privacy not enforced yet)
+        // Register private and public properties (privacy not enforced yet). The parser
+        // rejects a class defined twice, so properties already on the class come from an
+        // earlier run of this definition (a cached template, see TemplateCache.hpp).
+        const auto declared = [&](const std::string & name) {
+            const auto & properties = sc->getClassInfo(className_).properties;
+            return std::any_of(properties.begin(), properties.end(),
+                               [&](const Symbols::PropertyInfo & prop) { return prop.name == name; });
+        };
         for (const auto & prop : privateProperties_) {
-            sc->addProperty(className_, prop.name, prop.type, true, prop.defaultValueExpr);
+            if (!declared(prop.name)) {
+                sc->addProperty(className_, prop.name, prop.type, true, prop.defaultValueExpr);
+            }
         }
         for (const auto & prop : publicProperties_) {
-            sc->addProperty(className_, prop.name, prop.type, false, prop.defaultValueExpr);
+            if (!declared(prop.name)) {
+                sc->addProperty(className_, prop.name, prop.type, false, prop.defaultValueExpr);
+            }
         }
         
         // Register methods (only if not already registered)
@@ -86,7 +97,22 @@ class ClassDefinitionStatementNode : public StatementNode {
         auto ops = Operations::Container::instance()->getAll(classNs);
         
         for (const auto & op : ops) {
-            interpreter.runOperation(*op);
+            ControlFlowSignal signal = interpreter.runOperation(*op);
+            if (!signal.normal()) {
+                return signal;
+            }
+        }
+        return {};
+    }
+
+    // The methods are lists of their own in the operations container; the properties are
+    // declared here, since a method may read them by name.
+    void optimize(Optimizer & optimizer) override {
+        for (const auto & prop : privateProperties_) {
+            optimizer.declare(prop.name);
+        }
+        for (const auto & prop : publicProperties_) {
+            optimizer.declare(prop.name);
         }
     }
 
@@ -7,10 +7,11 @@
 
 #include "Interpreter/StatementNode.hpp"
 // Include for unified runtime Exception
-#include "Interpreter/BreakException.hpp"
+#include "Interpreter/Bytecode.hpp"
 #include "Interpreter/ExpressionNode.hpp"
 #include "Interpreter/Interpreter.hpp"
 #include "Interpreter/ThrowException.hpp"
+#include "Interpreter/TypeChecker.hpp"
 
 namespace Interpreter {
 
@@ -21,6 +22,7 @@ class ConditionalStatementNode : public StatementNode {
     std::unique_ptr<ExpressionNode>             condition_;
     std::vector<std::unique_ptr<StatementNode>> thenBranch_;
     std::vector<std::unique_ptr<StatementNode>> elseBranch_;
+    bool                                        conditionProven_ = false;  // proven boolean by the TypeChecker
 
   public:
     ConditionalStatementNode(std::unique_ptr<ExpressionNode>             condition,
@@ -32,8 +34,13 @@ class ConditionalStatementNode : public StatementNode {
         thenBranch_(std::move(thenBranch)),
         elseBranch_(std::move(elseBranch)) {}
 
-    void interpret(class Interpreter & interpreter) const override {
+    ControlFlowSignal interpret(class Interpreter & interpreter) const override {
         try {
+            if (conditionProven_) {
+                return interpretBody(interpreter, condition_->evaluateCondition(interpreter, filename_, line_, column_)
+                                                      ? thenBranch_
+                                                      : elseBranch_);
+            }
             auto val  = condition_->evaluate(interpreter, filename_, line_, column_);
             bool cond = false;
             if (val == Symbols::Variables::Type::BOOLEAN) {
@@ -42,16 +49,7 @@ class ConditionalStatementNode : public StatementNode {
                 throw Exception("Condition did not evaluate to boolean: " + condition_->toString(), filename_, line_,
                                 column_);
             }
-            const auto & branch = cond ? thenBranch_ : elseBranch_;
-            // Only iterate if the branch is not empty
-            if (!branch.empty()) {
-                for (const auto & stmt : branch) {
-                    stmt->interpret(interpreter);
-                }
-            }
-        } catch (const BreakException &) {
-            // Re-throw BreakException so loop nodes can catch it
-            throw;
+            return interpretBody(interpreter, cond ? thenBranch_ : elseBranch_);
         } catch (const BaseException &) {
             // BaseException, not Exception: ThrowException also derives from it, and
             // catching only Exception here let the generic handler below flatten a
@@ -63,6 +61,39 @@ class ConditionalStatementNode : public StatementNode {
         }
     }
 
+    void resolveLocals(LocalResolver & resolver) override {
+        resolver.resolve(condition_);
+        resolver.enterBranch();
+        resolver.resolveBody(thenBranch_);
+        resolver.resolveBody(elseBranch_);
+        resolver.exitBranch();
+    }
+
+    // An `if` on a literal condition keeps only the branch it takes.
+    void optimize(Optimizer & optimizer) override {
+        optimizer.fold(condition_);
+        if (const auto taken = Optimizer::condition(condition_)) {
+            (*taken ? elseBranch_ : thenBranch_).clear();
+        }
+        optimizer.body(thenBranch_);
+        optimizer.body(elseBranch_);
+    }
+
+    void checkTypes(TypeChecker & checker) override {
+        conditionProven_ = checker.condition(condition_,
+                                             "Condition did not evaluate to boolean: " + condition_->toString(),
+                                             filename_, line_, column_);
+        checker.checkBody(thenBranch_);
+        checker.checkBody(elseBranch_);
+    }
+
+    bool lower(Bytecode::Compiler & compiler) const override {
+        compiler.pushSite(filename_, line_, column_);
+        const bool lowered = compiler.branch(*condition_, thenBranch_, elseBranch_);
+        compiler.popSite();
+        return lowered;
+    }
+
     std::string toString() const override {
         return "ConditionalStatementNode at " + filename_ + ":" + std::to_string(line_);
     }
@@ -23,13 +23,15 @@ class DeclareFunctionStatementNode : public StatementNode {
     std::string                     ns;
     std::string                     className_; // Class name if this is a method, empty otherwise
     bool                           isMethod_; // Whether this is a class method
+    std::shared_ptr<const Symbols::FunctionReach> reach_;  // from the body's LocalResolver
 
 
   public:
     DeclareFunctionStatementNode(const std::string & function_name, const std::string & ns,
                                  const std::vector<Symbols::FunctionParameterInfo> & params, Symbols::Variables::Type return_type,
                                  std::unique_ptr<ExpressionNode> expr, const std::string & file_name, int file_line,
-                                 size_t line_column, const std::string & class_name = "") :
+                                 size_t line_column, const std::string & class_name = "",
+                                 std::shared_ptr<const Symbols::FunctionReach> reach = nullptr) :
         StatementNode(file_name, file_line, line_column),
         functionName_(function_name),
         returnType_(return_type),
@@ -37,9 +39,10 @@ class DeclareFunctionStatementNode : public StatementNode {
         expression_(std::move(expr)),
         ns(ns),
         className_(class_name),
-        isMethod_(!class_name.empty()) {}
+        isMethod_(!class_name.empty()),
+        reach_(std::move(reach)) {}
 
-    void interpret(Interpreter & /*interpreter*/) const override {
+    ControlFlowSignal interpret(Interpreter & /*interpreter*/) const override {
         try {
             auto *sc = Symbols::SymbolContainer::instance();
             auto targetTable = sc->getScopeTable(ns); // 'ns' is the current scope for this function
@@ -49,8 +52,11 @@ class DeclareFunctionStatementNode : public StatementNode {
                 throw Exception("Target scope '" + ns + "' for function declaration does not exist", filename_, line_, column_);
             }
 
-            // Check if function already declared in the target scope's function namespace
-            if (targetTable->get(Symbols::SymbolContainer::DEFAULT_FUNCTIONS_SCOPE, functionName_)) {
+            // Check if function already declared in the target scope's function namespace.
+            // Not for methods: the class scope outlives the file's, and the parser rejects a
+            // method declared twice, so one found here is from an earlier run of this class
+            // definition (a cached template, or the file parsed again) and is replaced.
+            if (!isMethod_ && targetTable->get(Symbols::SymbolContainer::DEFAULT_FUNCTIONS_SCOPE, functionName_)) {
                 throw Exception("Function '" + functionName_ + "' already declared in scope '" + ns + "'", filename_, line_, column_);
             }
 
@@ -76,6 +82,7 @@ class DeclareFunctionStatementNode : public StatementNode {
             } else {
                 // Regular function
                 const auto func = Symbols::SymbolFactory::createFunction(functionName_, ns, params_, "", returnType_);
+                std::static_pointer_cast<Symbols::FunctionSymbol>(func)->setReach(reach_);
                 sc->addFunction(func, ns); // Explicitly define in the target scope 'ns'
             }
 
@@ -88,6 +95,20 @@ class DeclareFunctionStatementNode : public StatementNode {
         } catch (const std::exception & e) {
             throw Exception(e.what(), filename_, line_, column_);
         }
+        return {};
+    }
+
+    // A nested function is resolved on its own when it is parsed; defining it at run time
+    // changes what the enclosing function's calls resolve to.
+    void resolveLocals(LocalResolver & resolver) override { resolver.escapes(); }
+
+    // The body is a list of its own in the operations container; only the parameters are
+    // declared here.
+    void optimize(Optimizer & optimizer) override {
+        for (const auto & param : params_) {
+            optimizer.declare(param.name);
+        }
+        optimizer.fold(expression_);
     }
 
     std::string toString() const override {
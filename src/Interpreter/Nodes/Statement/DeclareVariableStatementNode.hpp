@@ -5,10 +5,13 @@
 #include <string>
 #include <utility>
 
+#include "Interpreter/Bytecode.hpp"
 #include "Interpreter/ExpressionNode.hpp"
 #include "Interpreter/Interpreter.hpp"
+#include "Interpreter/LocalResolver.hpp"
 #include "Interpreter/ThrowException.hpp"
 #include "Interpreter/StatementNode.hpp"
+#include "Interpreter/TypeChecker.hpp"
 #include "Symbols/NumericCoercion.hpp"
 #include "Symbols/SymbolContainer.hpp"
 #include "Symbols/SymbolFactory.hpp"
@@ -21,7 +24,11 @@ class DeclareVariableStatementNode : public StatementNode {
     std::unique_ptr<ExpressionNode> expression_;
     std::string                     ns;
     bool                            isConst_;
-
+    Symbols::Atom                   nameAtom_;
+    LocalSlot                       slot_;
+    // Set by the TypeChecker when the initialiser is proven to be non-null and of the
+    // declared type (or of any type for `auto`): nothing to check or convert.
+    bool                            initializerProven_ = false;
 
   public:
     // isConst: if true, declares a constant; otherwise a mutable variable
@@ -33,9 +40,10 @@ class DeclareVariableStatementNode : public StatementNode {
         variableType_(type),
         expression_(std::move(expr)),
         ns(ns),
-        isConst_(isConst) {}
+        isConst_(isConst),
+        nameAtom_(Symbols::AtomTable::intern(variableName_)) {}
 
-    void interpret(Interpreter & interpreter) const override {
+    ControlFlowSignal interpret(Interpreter & interpreter) const override {
         try {
             Symbols::ValuePtr initValue;
             if (expression_) { // Changed from initializerExpr_ to expression_
@@ -53,24 +61,17 @@ class DeclareVariableStatementNode : public StatementNode {
             // This ensures that variables declared inside functions go to the function's runtime scope,
             // not the parse-time scope stored in ns member variable
             std::string target_scope_name = sc->currentScopeName();
-            auto        targetTable       = sc->getScopeTable(target_scope_name);
-
-            if (!targetTable) {
-                // This should ideally not happen if parser/caller creates scopes correctly
-                throw Exception("Target scope '" + target_scope_name +
-                                    "' for variable declaration does not exist",
-                                filename_, line_, column_);
-            }
+            auto *      targetTable       = sc->currentTable();
 
             // Check if variable/constant already exists in the target scope's table
-            auto existing_var = targetTable->get(Symbols::SymbolContainer::DEFAULT_VARIABLES_SCOPE, variableName_);
+            auto existing_var = targetTable->get(Symbols::SymbolContainer::variablesAtom(), nameAtom_);
             if (existing_var) {
                 // If we're in a loop scope (current runtime scope name contains "for_" or "while_"), allow redeclaration
                 if (target_scope_name.find("for_") != std::string::npos ||
                     target_scope_name.find("while_") != std::string::npos) {
                     // Update the existing variable's value
                     existing_var->setValue(value);
-                    return;
+                    return {};
                 }
                 throw Exception(
                     "Variable '" + variableName_ + "' already declared in scope '" + target_scope_name + "'",
@@ -78,100 +79,34 @@ class DeclareVariableStatementNode : public StatementNode {
             }
 
             Symbols::SymbolPtr existing_const_check =
-                targetTable->get(Symbols::SymbolContainer::DEFAULT_CONSTANTS_SCOPE, variableName_);
+                targetTable->get(Symbols::SymbolContainer::constantsAtom(), nameAtom_);
             if (existing_const_check) {
                 throw Exception(
                     "Cannot redefine constant '" + variableName_ + "' in scope '" + target_scope_name + "'",
                     filename_, line_, column_);
             }
 
-            if (value == Symbols::Variables::Type::NULL_TYPE) {
-                value.setType(variableType_);
-            }
-
-            // `auto` adopts the initialiser's type, as in C++. Resolve it here so every
-            // check below - and the symbol itself - sees the real type.
             Symbols::Variables::Type variableType_resolved = variableType_;
-            if (variableType_resolved == Symbols::Variables::Type::AUTO_TYPE) {
-                if (!expression_) {
-                    throw Exception("'auto' variable '" + variableName_ + "' needs an initialiser to infer its type",
-                                    filename_, line_, column_);
-                }
+            if (initializerProven_) {
                 variableType_resolved = value.getType();
+            } else {
+                checkInitializer(value, variableType_resolved, target_scope_name);
             }
 
-            // For class types, we need to handle the comparison differently
-            if (variableType_resolved == Symbols::Variables::Type::CLASS) {
-                // The value should be either CLASS type or OBJECT type (from new ClassName())
-                if (value.getType() != Symbols::Variables::Type::CLASS &&
-                    value.getType() != Symbols::Variables::Type::OBJECT &&
-                    value.getType() != Symbols::Variables::Type::NULL_TYPE) {
-                    std::string expected = Symbols::Variables::TypeToString(variableType_resolved);
-                    std::string actual = Symbols::Variables::TypeToString(value.getType());
-                    throw Exception("Type mismatch for variable '" + variableName_ + "': expected '" + expected +
-                                        "' but got '" + actual + "' in scope '" + target_scope_name + "'",
-                                    filename_, line_, column_);
-                }
-                
-                // If it's an OBJECT from a 'new' expression, ensure we set the type to CLASS
-                if (value.getType() == Symbols::Variables::Type::OBJECT) {
-                    auto& objMap = value.get<Symbols::ObjectMap>();
-                    
-                    // Check for various class name fields
-                    auto it = objMap.find("__class__");
-                    if (it == objMap.end()) {
-                        it = objMap.find("$class_name");
-                    }
-                    
-                    if (it != objMap.end() && it->second->getType() == Symbols::Variables::Type::STRING) {
-                        // This is actually a class instance, but we need to create a new ValuePtr using makeClassInstance
-                        // Create a properly typed class instance
-                        value = Symbols::ValuePtr::makeClassInstance(objMap);
-                    }
-                } else if (value.getType() == Symbols::Variables::Type::NULL_TYPE) {
-                    // For CLASS variables initialized with NULL, create a simple null value
-                    // DO NOT call ValuePtr::null(CLASS) or makeClassInstance as it can cause infinite loops
-                    // Just manually set the type to CLASS on the existing null value
-                    value.setType(Symbols::Variables::Type::CLASS);
-                }
-            } else if (variableType_resolved == Symbols::Variables::Type::ENUM) {
-                // For enum types, allow integer values to be assigned (since enum values are integers)
-                if (value.getType() != Symbols::Variables::Type::ENUM &&
-                    value.getType() != Symbols::Variables::Type::INTEGER &&
-                    value.getType() != Symbols::Variables::Type::NULL_TYPE) {
-                    std::string expected = Symbols::Variables::TypeToString(variableType_resolved);
-                    std::string actual = Symbols::Variables::TypeToString(value.getType());
-                    throw Exception("Type mismatch for variable '" + variableName_ + "': expected '" + expected +
-                                        "' but got '" + actual + "' in scope '" + target_scope_name + "'",
-                                    filename_, line_, column_);
-                }
-                // Don't try to convert types - just allow the assignment as-is
-                // Enum variables can store integer values since enums are internally integers
-            } else if (value.getType() != variableType_resolved) {
-                // Numeric initialisers adopt the declared numeric type - every float
-                // literal lexes as double, so without this even `float $f = 2.718;`
-                // is a type error.
-                if (!Symbols::tryNumericCoerce(value, variableType_resolved)) {
-                    std::string expected = Symbols::Variables::TypeToString(variableType_resolved);
-                    std::string actual = Symbols::Variables::TypeToString(value.getType());
-                    throw Exception("Type mismatch for variable '" + variableName_ + "': expected '" + expected +
-                                        "' but got '" + actual + "' in scope '" + target_scope_name + "'",
-                                    filename_, line_, column_);
-                }
-            }
-
-
             // Create a constant or variable symbol
             // The symbol's own context should be the target scope (ns)
             std::shared_ptr<Symbols::Symbol> symbol_to_define;
             if (isConst_) {
                 symbol_to_define =
                     Symbols::SymbolFactory::createConstant(variableName_, value, target_scope_name);
-                sc->addConstant(symbol_to_define, target_scope_name); // Use current scope
+                sc->addConstant(symbol_to_define); // Use current scope
             } else {
                 symbol_to_define = Symbols::SymbolFactory::createVariable(variableName_, value,
                                                                           target_scope_name, variableType_resolved);
-                sc->addVariable(symbol_to_define, target_scope_name); // Use current scope
+                sc->addVariable(symbol_to_define); // Use current scope
+                if (slot_.bound() && targetTable->frame() == slot_.frame) {
+                    targetTable->bindSlot(static_cast<size_t>(slot_.slot), symbol_to_define);
+                }
             }
 
         } catch (const BaseException &) {
@@ -183,6 +118,47 @@ class DeclareVariableStatementNode : public StatementNode {
         } catch (const std::exception & e) {
             throw Exception(e.what(), filename_, line_, column_);
         }
+        return {};
+    }
+
+    void resolveLocals(LocalResolver & resolver) override {
+        resolver.resolve(expression_);
+        if (isConst_) {
+            resolver.declareOther(variableName_);
+        } else {
+            resolver.declareLocal(variableName_, slot_);
+        }
+    }
+
+    void optimize(Optimizer & optimizer) override {
+        optimizer.fold(expression_);
+        if (isConst_) {
+            optimizer.declareConstant(variableName_, variableType_, expression_);
+        } else {
+            optimizer.declare(variableName_);
+        }
+    }
+
+    void checkTypes(TypeChecker & checker) override {
+        const auto proven  = checker.infer(expression_);
+        initializerProven_ =
+            proven && (*proven == variableType_ || variableType_ == Symbols::Variables::Type::AUTO_TYPE);
+        if (proven && !TypeChecker::declarable(*proven, variableType_)) {
+            checker.error("Type mismatch for variable '" + variableName_ + "': expected '" +
+                              Symbols::Variables::TypeToString(variableType_) + "' but got '" +
+                              Symbols::Variables::TypeToString(*proven) + "'",
+                          filename_, line_, column_);
+        }
+    }
+
+    bool lower(Bytecode::Compiler & compiler) const override {
+        if (isConst_ || !expression_) {
+            return false;
+        }
+        compiler.pushSite(filename_, line_, column_);
+        const bool lowered = compiler.declare(nameAtom_, variableType_, expression_->lower(compiler));
+        compiler.popSite();
+        return lowered;
     }
 
     std::string toString() const override {
@@ -191,6 +167,86 @@ class DeclareVariableStatementNode : public StatementNode {
     }
 
     const std::string & getNamespace() const { return ns; }
+
+  private:
+    // Resolve `auto`, then check the initialiser against the declared type, converting it
+    // where the declaration allows.
+    void checkInitializer(Symbols::ValuePtr & value, Symbols::Variables::Type & variableType_resolved,
+                          const std::string & target_scope_name) const {
+        if (value == Symbols::Variables::Type::NULL_TYPE) {
+            value.setType(variableType_);
+        }
+
+        // `auto` adopts the initialiser's type, as in C++. Resolve it here so every
+        // check below - and the symbol itself - sees the real type.
+        if (variableType_resolved == Symbols::Variables::Type::AUTO_TYPE) {
+            if (!expression_) {
+                throw Exception("'auto' variable '" + variableName_ + "' needs an initialiser to infer its type",
+                                filename_, line_, column_);
+            }
+            variableType_resolved = value.getType();
+        }
+
+        // For class types, we need to handle the comparison differently
+        if (variableType_resolved == Symbols::Variables::Type::CLASS) {
+            // The value should be either CLASS type or OBJECT type (from new ClassName())
+            if (value.getType() != Symbols::Variables::Type::CLASS &&
+                value.getType() != Symbols::Variables::Type::OBJECT &&
+                value.getType() != Symbols::Variables::Type::NULL_TYPE) {
+                std::string expected = Symbols::Variables::TypeToString(variableType_resolved);
+                std::string actual = Symbols::Variables::TypeToString(value.getType());
+                throw Exception("Type mismatch for variable '" + variableName_ + "': expected '" + expected +
+                                    "' but got '" + actual + "' in scope '" + target_scope_name + "'",
+                                filename_, line_, column_);
+            }
+            
+            // If it's an OBJECT from a 'new' expression, ensure we set the type to CLASS
+            if (value.getType() == Symbols::Variables::Type::OBJECT) {
+                auto& objMap = value.get<Symbols::ObjectMap>();
+                
+                // Check for various class name fields
+                auto it = objMap.find("__class__");
+                if (it == objMap.end()) {
+                    it = objMap.find("$class_name");
+                }
+                
+                if (it != objMap.end() && it->second->getType() == Symbols::Variables::Type::STRING) {
+                    // This is actually a class instance, but we need to create a new ValuePtr using makeClassInstance
+                    // Create a properly typed class instance
+                    value = Symbols::ValuePtr::makeClassInstance(objMap);
+                }
+            } else if (value.getType() == Symbols::Variables::Type::NULL_TYPE) {
+                // For CLASS variables initialized with NULL, create a simple null value
+                // DO NOT call ValuePtr::null(CLASS) or makeClassInstance as it can cause infinite loops
+                // Just manually set the type to CLASS on the existing null value
+                value.setType(Symbols::Variables::Type::CLASS);
+            }
+        } else if (variableType_resolved == Symbols::Variables::Type::ENUM) {
+            // For enum types, allow integer values to be assigned (since enum values are integers)
+            if (value.getType() != Symbols::Variables::Type::ENUM &&
+                value.getType() != Symbols::Variables::Type::INTEGER &&
+                value.getType() != Symbols::Variables::Type::NULL_TYPE) {
+                std::string expected = Symbols::Variables::TypeToString(variableType_resolved);
+                std::string actual = Symbols::Variables::TypeToString(value.getType());
+                throw Exception("Type mismatch for variable '" + variableName_ + "': expected '" + expected +
+                                    "' but got '" + actual + "' in scope '" + target_scope_name + "'",
+                                filename_, line_, column_);
+            }
+            // Don't try to convert types - just allow the assignment as-is
+            // Enum variables can store integer values since enums are internally integers
+        } else if (value.getType() != variableType_resolved) {
+            // Numeric initialisers adopt the declared numeric type - every float
+            // literal lexes as double, so without this even `float $f = 2.718;`
+            // is a type error.
+            if (!Symbols::tryNumericCoerce(value, variableType_resolved)) {
+                std::string expected = Symbols::Variables::TypeToString(variableType_resolved);
+                std::string actual = Symbols::Variables::TypeToString(value.getType());
+                throw Exception("Type mismatch for variable '" + variableName_ + "': expected '" + expected +
+                                    "' but got '" + actual + "' in scope '" + target_scope_name + "'",
+                                filename_, line_, column_);
+            }
+        }
+    }
 };
 
 }  // namespace Interpreter
@@ -30,12 +30,12 @@ public:
         enumName(std::move(name)),
         enumerators(std::move(enums)) {}
 
-    void Accept(::Interpreter::Interpreter& interpreter) const { // Removed 'class' from param, added ::
-        this->interpret(interpreter);
+    ::Interpreter::ControlFlowSignal Accept(::Interpreter::Interpreter& interpreter) const { // Removed 'class' from param, added ::
+        return this->interpret(interpreter);
     }
 
     // interpret() is pure virtual in StatementNode.
-    void interpret(::Interpreter::Interpreter& interpreter) const override {
+    ControlFlowSignal interpret(::Interpreter::Interpreter& interpreter) const override {
         // 'interpreter' parameter is available for context if needed.
         std::string context_str = this->filename_ + ":" + std::to_string(this->line_) + ":" + std::to_string(this->column_);
         try {
@@ -52,8 +52,11 @@ public:
             // Interpreter::Exception should be accessible from Interpreter.hpp.
             throw ::Interpreter::Exception(e.what(), this->filename_, this->line_, this->column_);
         }
+        return {};
     }
 
+    void optimize(::Interpreter::Optimizer & optimizer) override { optimizer.declareEnum(enumName, enumerators); }
+
     // It's good practice to have a toString for debugging, though not strictly required by the task
     std::string toString() const override {
         std::string str = "EnumDeclarationNode(\n";
@@ -6,6 +6,7 @@
 
 #include "Interpreter/ExpressionNode.hpp"
 #include "Interpreter/StatementNode.hpp"
+#include "Interpreter/TypeChecker.hpp"
 
 namespace Interpreter {
 
@@ -23,11 +24,18 @@ class ExpressionStatementNode : public StatementNode {
         line_(line),
         column_(column) {}
 
-    void interpret(Interpreter & interpreter) const override {
+    ControlFlowSignal interpret(Interpreter & interpreter) const override {
         // Evaluate expression and discard result
         expr_->evaluate(interpreter, filename_, line_, column_);
+        return {};
     }
 
+    void resolveLocals(LocalResolver & resolver) override { resolver.resolve(expr_); }
+
+    void optimize(Optimizer & optimizer) override { optimizer.fold(expr_); }
+
+    void checkTypes(TypeChecker & checker) override { static_cast<void>(checker.infer(expr_)); }
+
     std::string toString() const override { return std::string("ExpressionStatement"); }
   private:
     std::string filename_;
@@ -1,17 +1,18 @@
 #ifndef INTERPRETER_FOR_STATEMENT_NODE_HPP
 #define INTERPRETER_FOR_STATEMENT_NODE_HPP
 
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "Interpreter/StatementNode.hpp"
 // Include for unified runtime Exception
-#include "Interpreter/BreakException.hpp"
-#include "Interpreter/ContinueException.hpp"
 #include "Interpreter/ExpressionNode.hpp"
 #include "Interpreter/Nodes/Expression/IdentifierExpressionNode.hpp"
 #include "Interpreter/Interpreter.hpp"
+#include "Interpreter/LocalResolver.hpp"
+#include "Interpreter/TypeChecker.hpp"
 #include "Symbols/SymbolContainer.hpp"
 #include "Symbols/SymbolFactory.hpp"
 #include "Symbols/Value.hpp"
@@ -20,36 +21,41 @@ namespace Interpreter {
 
 /**
   * @brief Statement node representing a for-in loop over object members.
+  *
+  * The key and value variables are bound once per loop and set on every iteration. A key
+  * declared `int` is an int for every key that is an array index ("0", "17"), whether the
+  * array is stored dense or as a map; other keys, and keys of any other declared type, are
+  * strings. A dense array then needs no key string per element, and a loop without a key
+  * (`for (auto $v : ...)`) gets none at all.
   */
 class ForStatementNode : public StatementNode {
   private:
-    // Symbols::Variables::Type                    keyType_;
+    Symbols::Variables::Type                    keyType_;
     std::string                                 keyName_;
     std::string                                 valueName_;
     std::unique_ptr<ExpressionNode>             iterableExpr_;
     std::vector<std::unique_ptr<StatementNode>> body_;
-    std::string                                 loopScopeName_;
+    std::string                                 scopeSuffix_;  // appended to the enclosing scope's name
+    Symbols::Atom                               frame_ = Symbols::kNoAtom;  // scope tag; see LocalResolver
+    LocalSlot                                   keySlot_;
+    LocalSlot                                   valueSlot_;
 
   public:
     ForStatementNode(Symbols::Variables::Type keyType, std::string keyName, std::string valueName,
                      std::unique_ptr<ExpressionNode> iterableExpr, std::vector<std::unique_ptr<StatementNode>> body,
-                     std::string loopScopeName, const std::string & file_name, int line, size_t column) :
+                     const std::string & file_name, int line, size_t column) :
         StatementNode(file_name, line, column),
-        //  keyType_(keyType),
+        keyType_(keyType),
         keyName_(std::move(keyName)),
         valueName_(std::move(valueName)),
         iterableExpr_(std::move(iterableExpr)),
         body_(std::move(body)),
-        loopScopeName_(std::move(loopScopeName)) {
-        // Ensure the loop scope name contains "for_" for proper scope handling
-        if (loopScopeName_.find("for_") == std::string::npos) {
-            loopScopeName_ = loopScopeName_ + Symbols::SymbolContainer::SCOPE_SEPARATOR + "for_" +
-                             std::to_string(line) + "_" + std::to_string(column);
-        }
-    }
+        scopeSuffix_(Symbols::SymbolContainer::SCOPE_SEPARATOR + "for_" + std::to_string(line) + "_" +
+                     std::to_string(column)) {}
 
-    void interpret(Interpreter & interpreter) const override {
-        bool entered_scope = false;
+    ControlFlowSignal interpret(Interpreter & interpreter) const override {
+        bool              entered_scope = false;
+        ControlFlowSignal result;  // a return from the body, handed on once the scope is left
         try {
             auto *symContainer = Symbols::SymbolContainer::instance();
             
@@ -61,47 +67,81 @@ class ForStatementNode : public StatementNode {
                 throw Exception("For-in loop applied to non-object: " + Symbols::Variables::TypeToString(iterableVal),
                                 filename_, line_, column_);
             }
-            const Symbols::ObjectMap & objMap = iterableVal;
-
-            // Build loop scope name based on current runtime scope, not parse-time scope
-            std::string runtime_loop_scope = symContainer->currentScopeName() +
-                                            Symbols::SymbolContainer::SCOPE_SEPARATOR + "for_" +
-                                            std::to_string(line_) + "_" + std::to_string(column_);
-
-            // Create and enter the loop scope
-            // The scope creation automatically maintains the scope stack hierarchy,
-            // which preserves access to parent scopes (including function call scopes with parameters)
-            if (!symContainer->getScopeTable(runtime_loop_scope)) {
-                symContainer->create(runtime_loop_scope);
-                entered_scope = true;
+            // Iterate a snapshot so the body may modify the container. A dense array only
+            // copies its element handles and runs in index order; a map copies its entries.
+            // The loop variable aliases each element, so a shared copy-on-write payload is
+            // split first; otherwise writes through it would reach the other copy.
+            iterableVal->unshare();
+            const bool           isArray = iterableVal->isArray();
+            Symbols::ArrayVector elements;
+            Symbols::ObjectMap   objMap;
+            if (isArray) {
+                elements = iterableVal->get<Symbols::ArrayVector>();
             } else {
-                symContainer->enter(runtime_loop_scope);
-                entered_scope = true;
+                objMap = iterableVal->get<Symbols::ObjectMap>();
             }
 
-            // Create the key and value variables once before the loop
-            auto keySym = Symbols::SymbolFactory::createVariable(
-                keyName_, Symbols::ValuePtr::null(Symbols::Variables::Type::STRING), runtime_loop_scope);
-            auto valSym = Symbols::SymbolFactory::createVariable(
+            // Enter the loop scope, named after the current runtime scope, not the
+            // parse-time one. The scope stack preserves access to parent scopes (including
+            // function call scopes with parameters)
+            auto * table  = symContainer->enterLoopFrame(scopeSuffix_, frame_);
+            entered_scope = true;
+            const std::string & runtime_loop_scope = symContainer->getScopeStack().back();
+
+            // Create the key and value variables once before the loop. With a single
+            // loop variable the value is all the body can see.
+            const bool keyed  = keyName_ != valueName_;
+            auto       keySym = keyed ? Symbols::SymbolFactory::createVariable(
+                                      keyName_, Symbols::ValuePtr::null(Symbols::Variables::Type::STRING),
+                                      runtime_loop_scope) :
+                                        Symbols::SymbolPtr();
+            auto       valSym = Symbols::SymbolFactory::createVariable(
                 valueName_, Symbols::ValuePtr::null(Symbols::Variables::Type::OBJECT), runtime_loop_scope);
-            symContainer->add(keySym);
+            if (keySym) {
+                symContainer->add(keySym);
+                bindSlot(table, keySlot_, keySym);
+            }
             symContainer->add(valSym);
+            bindSlot(table, valueSlot_, valSym);
+
+            // Runs the body once; returns false when the loop should stop. A continue
+            // just skips the rest of this iteration.
+            auto runBody = [&](const Symbols::ValuePtr & value) {
+                valSym->setValue(value);
 
-            for (const auto & entry : objMap) {
-                const std::string & key    = entry.first;
-                auto                keyVal = Symbols::ValuePtr(key);
-                keySym->setValue(keyVal);
-                valSym->setValue(entry.second);
+                const ControlFlowSignal signal = interpretBody(interpreter, body_);
+                if (signal.kind() == ControlFlowSignal::Kind::Return) {
+                    result = signal;
+                    return false;
+                }
+                return signal.kind() != ControlFlowSignal::Kind::Break;
+            };
 
-                try {
-                    for (const auto & stmt : body_) {
-                        stmt->interpret(interpreter);
+            const bool intKeys = keyType_ == Symbols::Variables::Type::INTEGER;
+            if (isArray) {
+                for (size_t i = 0; i < elements.size(); ++i) {
+                    if (keySym) {
+                        keySym->setValue(intKeys ? Symbols::ValuePtr(static_cast<int>(i)) :
+                                                   Symbols::ValuePtr(std::to_string(i)));
+                    }
+                    if (!runBody(elements[i])) {
+                        break;
+                    }
+                }
+            } else {
+                for (const auto & entry : objMap) {
+                    if (keySym) {
+                        size_t index = 0;
+                        if (intKeys && Symbols::Value::parseArrayIndex(entry.first, index) &&
+                            index <= static_cast<size_t>(std::numeric_limits<int>::max())) {
+                            keySym->setValue(Symbols::ValuePtr(static_cast<int>(index)));
+                        } else {
+                            keySym->setValue(Symbols::ValuePtr(entry.first));
+                        }
+                    }
+                    if (!runBody(entry.second)) {
+                        break;
                     }
-                } catch (const BreakException &) {
-                    // Break out of the for-in loop
-                    break;
-                } catch (const ContinueException &) {
-                    // Skip the rest of this iteration and carry on.
                 }
             }
         } catch (const BaseException &) {
@@ -120,9 +160,37 @@ class ForStatementNode : public StatementNode {
         if (entered_scope) {
             Symbols::SymbolContainer::instance()->enterPreviousScope();
         }
+        return result;
     }
 
+    void resolveLocals(LocalResolver & resolver) override {
+        resolver.resolve(iterableExpr_);  // evaluated before the loop scope exists
+        frame_ = resolver.enterLoop();
+        if (keyName_ != valueName_) {
+            resolver.declareLocal(keyName_, keySlot_);
+        }
+        resolver.declareLocal(valueName_, valueSlot_);
+        resolver.resolveBody(body_);
+        resolver.exitLoop();
+    }
+
+    void optimize(Optimizer & optimizer) override {
+        optimizer.fold(iterableExpr_);
+        optimizer.declare(keyName_);
+        optimizer.declare(valueName_);
+        optimizer.body(body_);
+    }
+
+    void checkTypes(TypeChecker & checker) override { checker.checkBody(body_); }
+
     std::string toString() const override { return "ForStatementNode at " + filename_ + ":" + std::to_string(line_); }
+
+  private:
+    static void bindSlot(Symbols::SymbolTable * table, const LocalSlot & slot, const Symbols::SymbolPtr & symbol) {
+        if (slot.bound() && table->frame() == slot.frame) {
+            table->bindSlot(static_cast<size_t>(slot.slot), symbol);
+        }
+    }
 };
 
 }  // namespace Interpreter
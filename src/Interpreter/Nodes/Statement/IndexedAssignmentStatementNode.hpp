@@ -15,10 +15,12 @@ namespace Interpreter {
  * @brief Statement node for assignment into an indexed container:
  *   $a[0] = expr;  $q->outputs[1] = expr;  $d->rows[1][0] = expr;
  *
- * Arrays are ObjectMaps keyed by the decimal index ("0", "1", ...), so this is the
+ * Arrays are objects keyed by the decimal index ("0", "1", ...), so this is the
  * same operation as an object property assignment, just with a key computed at
  * runtime. The container expression is evaluated to a ValuePtr, which is shared
  * rather than cloned, so writing through the returned map mutates the original.
+ * A dense array (Value::isArray) is written in place while the key is an existing
+ * index or the next one; any other key promotes it to a map first.
  */
 class IndexedAssignmentStatementNode : public StatementNode {
   private:
@@ -35,7 +37,7 @@ class IndexedAssignmentStatementNode : public StatementNode {
         indexExpr_(std::move(indexExpr)),
         rhs_(std::move(rhs)) {}
 
-    void interpret(Interpreter & interpreter) const override {
+    ControlFlowSignal interpret(Interpreter & interpreter) const override {
         using namespace Symbols;
 
         ValuePtr container = containerExpr_->evaluate(interpreter, filename_, line_, column_);
@@ -43,13 +45,11 @@ class IndexedAssignmentStatementNode : public StatementNode {
             throw Exception("Attempted to assign to an index of a non-array value", filename_, line_, column_);
         }
 
-        ObjectMap & map_ref = container->get<ObjectMap>();
-
         std::string key;
         if (!indexExpr_) {
             // Append: `$a[] = expr`. Arrays are keyed by consecutive decimal indices,
             // so the next free slot is the current size.
-            key = std::to_string(map_ref.size());
+            key = std::to_string(container->objectSize());
         } else {
             ValuePtr idxVal = indexExpr_->evaluate(interpreter, filename_, line_, column_);
             if (idxVal == Variables::Type::INTEGER) {
@@ -67,17 +67,56 @@ class IndexedAssignmentStatementNode : public StatementNode {
 
         // Match the element type check AssignmentStatementNode does for properties:
         // replacing an existing element must not silently change its type.
-        auto existing = map_ref.find(key);
-        if (existing != map_ref.end() && newValue.getType() != Variables::Type::NULL_TYPE &&
-            existing->second.getType() != Variables::Type::NULL_TYPE &&
-            newValue.getType() != existing->second.getType()) {
-            throw Exception("Type mismatch for element '" + key + "': expected '" +
-                                Variables::TypeToString(existing->second.getType()) + "' but got '" +
-                                Variables::TypeToString(newValue.getType()) + "'",
-                            filename_, line_, column_);
+        auto checkType = [&](const ValuePtr & current) {
+            if (newValue.getType() != Variables::Type::NULL_TYPE &&
+                current.getType() != Variables::Type::NULL_TYPE && newValue.getType() != current.getType()) {
+                throw Exception("Type mismatch for element '" + key + "': expected '" +
+                                    Variables::TypeToString(current.getType()) + "' but got '" +
+                                    Variables::TypeToString(newValue.getType()) + "'",
+                                filename_, line_, column_);
+            }
+        };
+
+        // An empty plain object ([] or {}) that receives index 0 starts life as a dense array.
+        size_t     index   = 0;
+        const bool isIndex = Value::parseArrayIndex(key, index);
+        if (isIndex && index == 0) {
+            container->adoptArrayStorage();
+        }
+
+        if (container->isArray()) {
+            auto & elements = container->get<ArrayVector>();
+            if (isIndex && index < elements.size()) {
+                checkType(elements[index]);
+                elements[index] = newValue;
+                return {};
+            }
+            if (isIndex && index == elements.size()) {
+                elements.push_back(newValue);
+                return {};
+            }
+        }
+
+        ObjectMap & map_ref  = container->get<ObjectMap>();
+        auto        existing = map_ref.find(key);
+        if (existing != map_ref.end()) {
+            checkType(existing->second);
         }
 
         map_ref[key] = newValue;
+        return {};
+    }
+
+    void resolveLocals(LocalResolver & resolver) override {
+        resolver.resolve(containerExpr_);
+        resolver.resolve(indexExpr_);  // null for `$a[] = ...`
+        resolver.resolve(rhs_);
+    }
+
+    void optimize(Optimizer & optimizer) override {
+        optimizer.fold(containerExpr_);
+        optimizer.fold(indexExpr_);
+        optimizer.fold(rhs_);
     }
 
     std::string toString() const override {
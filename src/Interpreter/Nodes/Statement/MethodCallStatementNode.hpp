@@ -36,7 +36,7 @@ public:
         , methodName_(std::move(methodName))
         , arguments_(std::move(args)) {}
 
-    void interpret(Interpreter& interpreter) const override {
+    ControlFlowSignal interpret(Interpreter& interpreter) const override {
         try {
             // Evaluate arguments
             std::vector<Symbols::ValuePtr> argValues;
@@ -67,59 +67,33 @@ public:
             }
             std::string className = it->second.get<std::string>();
 
-            // Build possible class scope names to search for the method
-            std::vector<std::string> class_scope_names;
-            
-            // Try multiple possible scope paths
-            // 1. Current scope + class name
-            const std::string current_scope = sc->currentScopeName();
-            class_scope_names.push_back(current_scope + Symbols::SymbolContainer::SCOPE_SEPARATOR + className);
-            
-            // 2. Just the class name (for global classes)
-            class_scope_names.push_back(className);
-            
-            // 3. File scope + class name (traditional approach)
-            class_scope_names.push_back(filename_ + Symbols::SymbolContainer::SCOPE_SEPARATOR + className);
-            
-            // Look up method in potential class scopes
-            // Check if method exists in class using the same approach as MethodCallExpressionNode
-            if (!sc->hasMethod(className, methodName_)) {
-                throw Exception("Method '" + methodName_ + "' not found in class " + className, filename_, line_, column_);
-            }
-            
-            // Get the method symbol using findMethod
-            std::shared_ptr<Symbols::Symbol> sym_method = sc->findMethod(className, methodName_);
-            std::string resolved_class_scope;
-            
-            if (sym_method) {
-                // Found via proper method lookup, resolve the class scope
-                resolved_class_scope = sc->findClassNamespace(className);
-            } else {
-                // This shouldn't happen if hasMethod returned true, but fallback anyway
+            // One lookup in the class's dispatch table, inherited methods included
+            const Symbols::MethodEntry * entry = sc->findMethodEntry(className, methodName_);
+            if (!entry) {
                 throw Exception("Method '" + methodName_ + "' not found in class " + className, filename_, line_, column_);
             }
-            
-            if (!sym_method) {
-                throw Exception("Method '" + methodName_ + "' not found in class " + className, filename_, line_, column_);
+
+            if (entry->native()) {
+                // Native methods take the object as their first argument
+                argValues.insert(argValues.begin(), objValue);
+                entry->info->nativeImplementation(argValues);
+                return {};
             }
 
             // Execute the method through the interpreter
-            std::shared_ptr<Symbols::FunctionSymbol> funcSym;
-            
-            // Both Function and Method can be cast to FunctionSymbol since Method inherits from Function
-            if (sym_method->getKind() == Symbols::Kind::Method) {
-                funcSym = std::dynamic_pointer_cast<Symbols::FunctionSymbol>(sym_method);
-            } else {
-                funcSym = std::static_pointer_cast<Symbols::FunctionSymbol>(sym_method);
+            const std::shared_ptr<Symbols::FunctionSymbol> funcSym = entry->script;
+            if (!funcSym) {
+                throw Exception("Method '" + methodName_ + "' not found in class " + className, filename_, line_, column_);
             }
             
             const auto& params = funcSym->parameters();
             
             // Create and enter method scope
-            const std::string methodNs = resolved_class_scope + Symbols::SymbolContainer::SCOPE_SEPARATOR + methodName_;
+            const std::string methodNs = entry->bodyScope;
+            const auto * methodOps = Operations::Container::instance()->find(methodNs);
             
             // Create a new scope for method execution
-            sc->create(methodNs);
+            sc->enterFrame(methodNs);
             
             // Set up the method context
             interpreter.setThisObject(objValue);
@@ -134,15 +108,10 @@ public:
 
             // Execute method body
             try {
-                for (const auto& op : Operations::Container::instance()->getAll(methodNs)) {
-                    try {
-                        interpreter.runOperation(*op);
-                    } catch (const ReturnException& re) {
-                        // Clean up
-                        interpreter.clearThisObject();
-                        sc->enterPreviousScope();
-                        // Allow return values to propagate
-                        throw;
+                for (size_t i = 0; methodOps && i < methodOps->size(); ++i) {
+                    // A statement call discards the return value
+                    if (!interpreter.runOperation(*(*methodOps)[i]).normal()) {
+                        break;
                     }
                 }
             } catch (...) {
@@ -153,6 +122,7 @@ public:
             }
 
             // Exit method scope
+            interpreter.clearThisObject();
             sc->enterPreviousScope();
 
         } catch (const Exception&) {
@@ -160,6 +130,20 @@ public:
         } catch (const std::exception& e) {
             throw Exception(e.what(), filename_, line_, column_);
         }
+        return {};
+    }
+
+    void resolveLocals(LocalResolver & resolver) override {
+        for (auto & arg : arguments_) {
+            resolver.resolve(arg);
+        }
+        resolver.escapes();
+    }
+
+    void optimize(Optimizer & optimizer) override {
+        for (auto & arg : arguments_) {
+            optimizer.fold(arg);
+        }
     }
 
     std::string toString() const override {
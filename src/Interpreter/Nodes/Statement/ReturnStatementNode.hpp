@@ -5,9 +5,12 @@
 #include <memory>
 #include <string>
 
+#include "Interpreter/Bytecode.hpp"
 #include "Interpreter/ExpressionNode.hpp"
-#include "Interpreter/ReturnException.hpp"
+#include "Interpreter/LocalResolver.hpp"
+#include "Interpreter/Nodes/Expression/CallExpressionNode.hpp"
 #include "Interpreter/StatementNode.hpp"
+#include "Interpreter/TypeChecker.hpp"
 #include "Symbols/Value.hpp"
 
 namespace Interpreter {
@@ -17,57 +20,50 @@ namespace Interpreter {
  */
 class ReturnStatementNode : public StatementNode {
     std::unique_ptr<ExpressionNode> expr_;
+    // `return f(...)`: the call, which may be handed over if the return is in tail position
+    const CallExpressionNode *       tailCall_ = nullptr;
+    LocalSlot                        tailFrame_;  // bound when it is in tail position
   public:
     explicit ReturnStatementNode(std::unique_ptr<ExpressionNode> expr, const std::string & file_name, int line,
                                  size_t column) :
         StatementNode(file_name, line, column),
-        expr_(std::move(expr)) {}
+        expr_(std::move(expr)),
+        tailCall_(dynamic_cast<const CallExpressionNode *>(expr_.get())) {}
 
-    void interpret(Interpreter & interpreter) const override {
+    ControlFlowSignal interpret(Interpreter & interpreter) const override {
         Symbols::ValuePtr retVal;
-        if (expr_) {
-            retVal = expr_->evaluate(interpreter);
-            
-            // Handle binary operations returning as objects instead of booleans
-            if (retVal->getType() == Symbols::Variables::Type::OBJECT) {
-                
-                try {
-                    // Look for binary operation patterns
-                    const Symbols::ObjectMap& objMap = retVal->get<Symbols::ObjectMap>();
-                    
-                    // If this is a comparison result that should be a boolean
-                    if (objMap.find("left") != objMap.end() && objMap.find("right") != objMap.end() && 
-                        objMap.find("operator") != objMap.end()) {
-                        
-                        auto leftIt = objMap.find("left");
-                        auto rightIt = objMap.find("right");
-                        auto opIt = objMap.find("operator");
-                        
-                        if (leftIt->second->getType() == Symbols::Variables::Type::INTEGER && 
-                            rightIt->second->getType() == Symbols::Variables::Type::INTEGER && 
-                            opIt->second->getType() == Symbols::Variables::Type::STRING) {
-                            
-                            int left = leftIt->second->get<int>();
-                            int right = rightIt->second->get<int>();
-                            std::string op = opIt->second->get<std::string>();
-                            
-                            bool result = false;
-                            if (op == ">") result = (left > right);
-                            else if (op == "<") result = (left < right);
-                            else if (op == ">=") result = (left >= right);
-                            else if (op == "<=") result = (left <= right);
-                            else if (op == "==") result = (left == right);
-                            else if (op == "!=") result = (left != right);
-                            
-                            retVal = Symbols::ValuePtr(result);
-                        }
-                    }
-                } catch (const std::exception& e) {
-                    // Failed to examine object
-                }
+        if (tailCall_ && tailFrame_.bound()) {
+            auto value = tailCall_->handOver(interpreter, tailFrame_);
+            if (!value) {
+                return ControlFlowSignal::tailCall();
             }
+            retVal = CallExpressionNode::returnedValue(std::move(*value));
+        } else if (expr_) {
+            retVal = CallExpressionNode::returnedValue(expr_->evaluate(interpreter));
         }
-        throw ReturnException(retVal);
+        return ControlFlowSignal::returnValue(retVal);
+    }
+
+    void resolveLocals(LocalResolver & resolver) override {
+        resolver.resolve(expr_);
+        resolver.returns(expr_ && expr_->neverNull());
+        if (tailCall_) {
+            resolver.tailCall(tailFrame_);
+        }
+    }
+
+    void optimize(Optimizer & optimizer) override { optimizer.fold(expr_); }
+
+    void checkTypes(TypeChecker & checker) override { static_cast<void>(checker.infer(expr_)); }
+
+    bool lower(Bytecode::Compiler & compiler) const override {
+        if (!expr_) {
+            return false;
+        }
+        compiler.pushSite(filename_, line_, column_);
+        const bool lowered = compiler.ret(expr_->lower(compiler));
+        compiler.popSite();
+        return lowered;
     }
 
     std::string toString() const override {
@@ -1,7 +1,10 @@
 #ifndef SWITCH_STATEMENT_NODE_HPP
 #define SWITCH_STATEMENT_NODE_HPP
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory> // For std::unique_ptr
 #include <optional> // For std::optional
@@ -9,7 +12,7 @@
 #include "../../StatementNode.hpp" // Base class
 #include "../../ExpressionNode.hpp" // For ExpressionNode
 #include "../../../Interpreter/Interpreter.hpp" // For Interpreter class, Exception, ValuePtr, Variables::Type
-#include "../../../Interpreter/BreakException.hpp" // For BreakException
+#include "../../TypeChecker.hpp"
 
 // Forward declare Interpreter is no longer needed due to direct include of Interpreter.hpp
 
@@ -53,11 +56,10 @@ public:
         caseBlocks(std::move(cases)),
         defaultBlock(std::move(default_case)) {}
 
-    void Accept(::Interpreter::Interpreter& interpreter) const {
-        this->interpret(interpreter);
+    ::Interpreter::ControlFlowSignal Accept(::Interpreter::Interpreter& interpreter) const {
+        return this->interpret(interpreter);
     }
 
-    // interpret() is pure virtual in StatementNode.
     // Types a switch can dispatch on. Enum values are stored as integers, so ENUM needs
     // no separate case in the comparison below.
     static bool isSwitchableType(::Symbols::Variables::Type type) {
@@ -65,7 +67,7 @@ public:
                type == ::Symbols::Variables::Type::STRING;
     }
 
-    void interpret(::Interpreter::Interpreter& interpreter) const override {
+    ::Interpreter::ControlFlowSignal interpret(::Interpreter::Interpreter& interpreter) const override {
         // Copied logic from SwitchStatementNode.cpp's interpret method:
         ::Symbols::ValuePtr switch_value = this->switchExpression->evaluate( // Added ::Symbols
             interpreter, this->filename_, this->line_, this->column_
@@ -83,88 +85,82 @@ public:
                                          expr_node.column == 0 ? this->column_ : expr_node.column);
         }
 
-        bool matched_block_found = false;
-        bool break_executed = false;
-
-        for (const auto& case_block : this->caseBlocks) {
-            if (break_executed) {
-                break; 
-            }
-
-            if (!matched_block_found) {
-                const auto& case_expr_node_ref = *case_block.expression;
-                ::Symbols::ValuePtr case_expr_value = case_block.expression->evaluate( // Added ::Symbols
-                    interpreter, 
-                    case_expr_node_ref.filename.empty() ? this->filename_ : case_expr_node_ref.filename, 
-                    case_expr_node_ref.line == 0 ? this->line_ : case_expr_node_ref.line, 
-                    case_expr_node_ref.column == 0 ? this->column_ : case_expr_node_ref.column
-                );
-                
-                if (case_expr_value->is_null() || !isSwitchableType(case_expr_value->getType())) {
-                     throw ::Interpreter::Exception("Case expression must evaluate to a non-null integer, enum or string value.",
-                                         case_expr_node_ref.filename.empty() ? this->filename_ : case_expr_node_ref.filename,
-                                         case_expr_node_ref.line == 0 ? this->line_ : case_expr_node_ref.line,
-                                         case_expr_node_ref.column == 0 ? this->column_ : case_expr_node_ref.column);
-                }
-
-                // A string switch cannot match an integer case, and vice versa. Saying
-                // so is far more useful than silently never matching.
-                const bool switchIsString = switch_value->getType() == ::Symbols::Variables::Type::STRING;
-                const bool caseIsString   = case_expr_value->getType() == ::Symbols::Variables::Type::STRING;
-                if (switchIsString != caseIsString) {
-                    throw ::Interpreter::Exception("Case type does not match the switch expression type: cannot compare " +
-                                         ::Symbols::Variables::TypeToString(switch_value->getType()) + " with " +
-                                         ::Symbols::Variables::TypeToString(case_expr_value->getType()) + ".",
-                                         case_expr_node_ref.filename.empty() ? this->filename_ : case_expr_node_ref.filename,
-                                         case_expr_node_ref.line == 0 ? this->line_ : case_expr_node_ref.line,
-                                         case_expr_node_ref.column == 0 ? this->column_ : case_expr_node_ref.column);
-                }
-
-                bool values_equal = false;
-                try {
-                    values_equal = switchIsString
-                                       ? (switch_value->get<std::string>() == case_expr_value->get<std::string>())
-                                       : (switch_value->get<int>() == case_expr_value->get<int>());
-                } catch (const std::runtime_error& e) {
-                     throw ::Interpreter::Exception(std::string("Error during case value comparison: ") + e.what(), 
-                                         case_expr_node_ref.filename.empty() ? this->filename_ : case_expr_node_ref.filename, 
-                                         case_expr_node_ref.line == 0 ? this->line_ : case_expr_node_ref.line, 
-                                         case_expr_node_ref.column == 0 ? this->column_ : case_expr_node_ref.column);
-                }
+        const bool switchIsString = switch_value->getType() == ::Symbols::Variables::Type::STRING;
+        size_t     start          = 0;
+        if (!dispatch(interpreter, switch_value, switchIsString, start)) {
+            start = match(interpreter, switch_value, switchIsString);
+        }
 
-                if (values_equal) {
-                    matched_block_found = true;
+        // Run the matched case and fall through the ones after it until a break.
+        for (size_t i = start; i < this->caseBlocks.size(); ++i) {
+            try {
+                // A break ends the switch; a continue or return belongs to an
+                // enclosing loop or function.
+                const ::Interpreter::ControlFlowSignal signal =
+                    ::Interpreter::interpretBody(interpreter, this->caseBlocks[i].statements);
+                if (signal.kind() == ::Interpreter::ControlFlowSignal::Kind::Break) {
+                    return {};
                 }
-            }
-
-            if (matched_block_found) {
-                try {
-                    for (const auto& stmt_node : case_block.statements) {
-                        stmt_node->interpret(interpreter); 
-                    }
-                } catch (const ::Interpreter::BreakException&) { 
-                    break_executed = true;
-                } catch (const ::Interpreter::Exception&) { 
-                    throw; 
-                } catch (const std::runtime_error& e) { 
-                    throw ::Interpreter::Exception(e.what(), this->filename_, this->line_, this->column_);
+                if (!signal.normal()) {
+                    return signal;
                 }
+            } catch (const ::Interpreter::Exception&) { 
+                throw; 
+            } catch (const std::runtime_error& e) { 
+                throw ::Interpreter::Exception(e.what(), this->filename_, this->line_, this->column_);
             }
         }
 
-        if (!break_executed && this->defaultBlock) {
+        if (this->defaultBlock) {
             try {
-                for (const auto& stmt_node : this->defaultBlock.value().statements) {
-                    stmt_node->interpret(interpreter); 
-                }
-            } catch (const ::Interpreter::BreakException&) {
+                const ::Interpreter::ControlFlowSignal signal =
+                    ::Interpreter::interpretBody(interpreter, this->defaultBlock.value().statements);
                 // Break in default block ends switch.
+                if (signal.kind() != ::Interpreter::ControlFlowSignal::Kind::Break) {
+                    return signal;
+                }
             } catch (const ::Interpreter::Exception&) {
                 throw;
             } catch (const std::runtime_error& e) {
                 throw ::Interpreter::Exception(e.what(), this->filename_, this->line_, this->column_);
             }
         }
+        return {};
+    }
+
+    void resolveLocals(::Interpreter::LocalResolver & resolver) override {
+        resolver.resolve(switchExpression);
+        for (auto & case_block : caseBlocks) {
+            resolver.resolve(case_block.expression);
+            resolver.enterBranch();
+            resolver.resolveBody(case_block.statements);
+            resolver.exitBranch();
+        }
+        if (defaultBlock) {
+            resolver.enterBranch();
+            resolver.resolveBody(defaultBlock->statements);
+            resolver.exitBranch();
+        }
+    }
+
+    void optimize(::Interpreter::Optimizer & optimizer) override {
+        optimizer.fold(switchExpression);
+        for (auto & case_block : caseBlocks) {
+            optimizer.fold(case_block.expression);
+            optimizer.body(case_block.statements);
+        }
+        if (defaultBlock) {
+            optimizer.body(defaultBlock->statements);
+        }
+    }
+
+    void checkTypes(::Interpreter::TypeChecker & checker) override {
+        for (auto & case_block : caseBlocks) {
+            checker.checkBody(case_block.statements);
+        }
+        if (defaultBlock) {
+            checker.checkBody(defaultBlock->statements);
+        }
     }
 
     // It's good practice to have a toString for debugging
@@ -197,6 +193,138 @@ public:
         str += ")";
         return str;
     }
+
+  private:
+    // Case labels by value, each mapped to the first case carrying it. Built on the first
+    // run when every label is constant (ExpressionNode::constant()) and evaluates to a
+    // switchable value; otherwise the switch keeps comparing the labels in order.
+    struct JumpTable {
+        enum class State : std::uint8_t { Unbuilt, Built, Sequential };
+
+        State                                   state = State::Unbuilt;
+        std::unordered_map<int, size_t>         ints;
+        std::unordered_map<std::string, size_t> strings;
+        // First integer (or enum) and first string label; caseBlocks.size() if none.
+        size_t                                  firstInt    = 0;
+        size_t                                  firstString = 0;
+    };
+
+    mutable JumpTable table_;
+
+    ::Symbols::ValuePtr evaluateLabel(::Interpreter::Interpreter& interpreter, const CaseBlock& case_block) const {
+        const auto& case_expr_node_ref = *case_block.expression;
+        return case_block.expression->evaluate(
+            interpreter,
+            case_expr_node_ref.filename.empty() ? this->filename_ : case_expr_node_ref.filename,
+            case_expr_node_ref.line == 0 ? this->line_ : case_expr_node_ref.line,
+            case_expr_node_ref.column == 0 ? this->column_ : case_expr_node_ref.column);
+    }
+
+    void buildTable(::Interpreter::Interpreter& interpreter) const {
+        const size_t count = this->caseBlocks.size();
+        table_.firstInt    = count;
+        table_.firstString = count;
+        table_.state       = JumpTable::State::Sequential;
+        for (size_t i = 0; i < count; ++i) {
+            if (!this->caseBlocks[i].expression->constant()) {
+                return;
+            }
+            ::Symbols::ValuePtr value;
+            try {
+                value = evaluateLabel(interpreter, this->caseBlocks[i]);
+            } catch (const std::exception&) {
+                return;  // e.g. an enum not declared yet; the ordered comparison reports it
+            }
+            if (value->is_null() || !isSwitchableType(value->getType())) {
+                return;
+            }
+            if (value->getType() == ::Symbols::Variables::Type::STRING) {
+                table_.firstString = std::min(table_.firstString, i);
+                table_.strings.emplace(value->get<std::string>(), i);
+            } else {
+                table_.firstInt = std::min(table_.firstInt, i);
+                table_.ints.emplace(value->get<int>(), i);
+            }
+        }
+        table_.state = JumpTable::State::Built;
+    }
+
+    /**
+     * @brief The case to start at, from the jump table: the matching one, or
+     * caseBlocks.size() for none. Returns false if the labels have to be compared in order:
+     * there is no table, or a label of the other type comes first, which is an error.
+     */
+    bool dispatch(::Interpreter::Interpreter& interpreter, const ::Symbols::ValuePtr& switch_value,
+                  bool switchIsString, size_t& start) const {
+        if (table_.state == JumpTable::State::Unbuilt) {
+            buildTable(interpreter);
+        }
+        if (table_.state != JumpTable::State::Built) {
+            return false;
+        }
+        size_t found = this->caseBlocks.size();
+        if (switchIsString) {
+            const auto it = table_.strings.find(switch_value->get<std::string>());
+            if (it != table_.strings.end()) {
+                found = it->second;
+            }
+        } else {
+            const auto it = table_.ints.find(switch_value->get<int>());
+            if (it != table_.ints.end()) {
+                found = it->second;
+            }
+        }
+        if ((switchIsString ? table_.firstInt : table_.firstString) < found) {
+            return false;
+        }
+        start = found;
+        return true;
+    }
+
+    // Compare the labels in order; the index of the matching case or caseBlocks.size().
+    size_t match(::Interpreter::Interpreter& interpreter, const ::Symbols::ValuePtr& switch_value,
+                 bool switchIsString) const {
+        for (size_t i = 0; i < this->caseBlocks.size(); ++i) {
+            const auto& case_expr_node_ref = *this->caseBlocks[i].expression;
+            ::Symbols::ValuePtr case_expr_value = evaluateLabel(interpreter, this->caseBlocks[i]);
+
+            if (case_expr_value->is_null() || !isSwitchableType(case_expr_value->getType())) {
+                 throw ::Interpreter::Exception("Case expression must evaluate to a non-null integer, enum or string value.",
+                                     case_expr_node_ref.filename.empty() ? this->filename_ : case_expr_node_ref.filename,
+                                     case_expr_node_ref.line == 0 ? this->line_ : case_expr_node_ref.line,
+                                     case_expr_node_ref.column == 0 ? this->column_ : case_expr_node_ref.column);
+            }
+
+            // A string switch cannot match an integer case, and vice versa. Saying
+            // so is far more useful than silently never matching.
+            const bool caseIsString = case_expr_value->getType() == ::Symbols::Variables::Type::STRING;
+            if (switchIsString != caseIsString) {
+                throw ::Interpreter::Exception("Case type does not match the switch expression type: cannot compare " +
+                                     ::Symbols::Variables::TypeToString(switch_value->getType()) + " with " +
+                                     ::Symbols::Variables::TypeToString(case_expr_value->getType()) + ".",
+                                     case_expr_node_ref.filename.empty() ? this->filename_ : case_expr_node_ref.filename,
+                                     case_expr_node_ref.line == 0 ? this->line_ : case_expr_node_ref.line,
+                                     case_expr_node_ref.column == 0 ? this->column_ : case_expr_node_ref.column);
+            }
+
+            bool values_equal = false;
+            try {
+                values_equal = switchIsString
+                                   ? (switch_value->get<std::string>() == case_expr_value->get<std::string>())
+                                   : (switch_value->get<int>() == case_expr_value->get<int>());
+            } catch (const std::runtime_error& e) {
+                 throw ::Interpreter::Exception(std::string("Error during case value comparison: ") + e.what(), 
+                                     case_expr_node_ref.filename.empty() ? this->filename_ : case_expr_node_ref.filename, 
+                                     case_expr_node_ref.line == 0 ? this->line_ : case_expr_node_ref.line, 
+                                     case_expr_node_ref.column == 0 ? this->column_ : case_expr_node_ref.column);
+            }
+
+            if (values_equal) {
+                return i;
+            }
+        }
+        return this->caseBlocks.size();
+    }
 };
 
 } // namespace Interpreter::Nodes::Statement
@@ -21,10 +21,14 @@ class ThrowStatementNode : public StatementNode {
         StatementNode(file, line, column),
         expression_(std::move(expression)) {}
 
-    void interpret(Interpreter & interpreter) const override {
+    ControlFlowSignal interpret(Interpreter & interpreter) const override {
         throw ThrowException(expression_->evaluate(interpreter, filename_, line_, column_), filename_, line_, column_);
     }
 
+    void resolveLocals(LocalResolver & resolver) override { resolver.resolve(expression_); }
+
+    void optimize(Optimizer & optimizer) override { optimizer.fold(expression_); }
+
     std::string toString() const override { return "ThrowStatementNode{}"; }
 };
 
@@ -5,11 +5,10 @@
 #include <string>
 #include <vector>
 
-#include "Interpreter/BreakException.hpp"
 #include "Interpreter/Interpreter.hpp"
-#include "Interpreter/ReturnException.hpp"
 #include "Interpreter/StatementNode.hpp"
 #include "Interpreter/ThrowException.hpp"
+#include "Interpreter/TypeChecker.hpp"
 #include "Symbols/SymbolContainer.hpp"
 #include "Symbols/SymbolFactory.hpp"
 #include "Symbols/Value.hpp"
@@ -22,11 +21,8 @@ namespace Interpreter {
  * Catches script-level `throw` and built-in runtime errors alike, so a script can
  * recover from e.g. a bad conversion instead of the whole process dying.
  *
- * Control flow is NOT catchable. BreakException derives from std::runtime_error, so
- * without an explicit rethrow a `break` inside a try would be swallowed and turn into
- * an infinite loop. ReturnException does not derive from std::exception at all, so it
- * passes through on its own, but it is rethrown explicitly to keep that intent visible
- * rather than dependent on a base-class detail.
+ * Control flow is not an error: a break, continue or return in either body is handed
+ * on as the statement's ControlFlowSignal and never reaches the catch.
  */
 class TryStatementNode : public StatementNode {
   private:
@@ -43,18 +39,19 @@ class TryStatementNode : public StatementNode {
         catchBody_(std::move(catchBody)),
         catchVarName_(std::move(catchVarName)) {}
 
-    void interpret(Interpreter & interpreter) const override {
+    ControlFlowSignal interpret(Interpreter & interpreter) const override {
         Symbols::ValuePtr caughtValue;
         bool              caught = false;
+        auto *            sc     = Symbols::SymbolContainer::instance();
+        // Calls the error unwound through did not pop their scopes; the catch body runs
+        // in the scope the try started in.
+        const size_t      depth  = sc->getScopeStack().size();
 
         try {
-            for (const auto & stmt : tryBody_) {
-                stmt->interpret(interpreter);
+            ControlFlowSignal signal = interpretBody(interpreter, tryBody_);
+            if (!signal.normal()) {
+                return signal;
             }
-        } catch (const ReturnException &) {
-            throw;  // control flow, not an error
-        } catch (const BreakException &) {
-            throw;  // control flow, and it IS a std::exception - must precede the catch below
         } catch (const ThrowException & e) {
             caughtValue = e.value();
             caught      = true;
@@ -65,19 +62,42 @@ class TryStatementNode : public StatementNode {
         }
 
         if (!caught) {
-            return;
+            return {};
         }
+        sc->unwindScopeStack(depth);
 
         if (!catchVarName_.empty()) {
-            auto * sc = Symbols::SymbolContainer::instance();
-            auto   sym =
+            auto sym =
                 Symbols::SymbolFactory::createVariable(catchVarName_, caughtValue, sc->currentScopeName());
             sc->addVariable(sym);
         }
 
-        for (const auto & stmt : catchBody_) {
-            stmt->interpret(interpreter);
+        return interpretBody(interpreter, catchBody_);
+    }
+
+    void resolveLocals(LocalResolver & resolver) override {
+        resolver.enterTry();
+        resolver.enterBranch();
+        resolver.resolveBody(tryBody_);
+        resolver.exitTry();
+        if (!catchVarName_.empty()) {
+            resolver.declareOther(catchVarName_);  // bound in the current scope, not a new one
         }
+        resolver.resolveBody(catchBody_);
+        resolver.exitBranch();
+    }
+
+    void optimize(Optimizer & optimizer) override {
+        optimizer.body(tryBody_);
+        if (!catchVarName_.empty()) {
+            optimizer.declare(catchVarName_);
+        }
+        optimizer.body(catchBody_);
+    }
+
+    void checkTypes(TypeChecker & checker) override {
+        checker.checkBody(tryBody_);
+        checker.checkBody(catchBody_);
     }
 
     std::string toString() const override {
@@ -4,11 +4,11 @@
 #include <memory>
 #include <string>
 
-#include "Interpreter/BreakException.hpp"
-#include "Interpreter/ContinueException.hpp"
+#include "Interpreter/Bytecode.hpp"
 #include "Interpreter/ExpressionNode.hpp"
 #include "Interpreter/Interpreter.hpp"
 #include "Interpreter/StatementNode.hpp"
+#include "Interpreter/TypeChecker.hpp"
 #include "Symbols/SymbolContainer.hpp"
 
 namespace Interpreter {
@@ -17,60 +17,64 @@ class WhileStatementNode : public StatementNode {
   private:
     std::unique_ptr<ExpressionNode>             conditionExpr_;
     std::vector<std::unique_ptr<StatementNode>> body_;
-    std::string                                 loopScopeName_;
+    std::string                                 scopeSuffix_;  // appended to the enclosing scope's name
+    Symbols::Atom                               frame_ = Symbols::kNoAtom;  // scope tag; see LocalResolver
+    mutable Bytecode::LoopCache                 bytecode_;
+    bool                                        conditionProven_ = false;  // proven boolean by the TypeChecker
 
   public:
     WhileStatementNode(std::unique_ptr<ExpressionNode> conditionExpr, std::vector<std::unique_ptr<StatementNode>> body,
                        const std::string & file_name, int line, size_t column) :
         StatementNode(file_name, line, column),
         conditionExpr_(std::move(conditionExpr)),
-        body_(std::move(body)) {
-        // Create a unique scope name for this while loop
-        loopScopeName_ = Symbols::SymbolContainer::instance()->currentScopeName() + "::while_" +
-                        std::to_string(line) + "_" + std::to_string(column);
-    }
+        body_(std::move(body)),
+        scopeSuffix_(Symbols::SymbolContainer::SCOPE_SEPARATOR + "while_" + std::to_string(line) + "_" +
+                     std::to_string(column)) {}
 
-    void interpret(Interpreter & interpreter) const override {
+    ControlFlowSignal interpret(Interpreter & interpreter) const override {
         bool entered_scope = false;
         try {
             auto* sc = Symbols::SymbolContainer::instance();
 
-            // Build loop scope name based on current runtime scope, not parse-time scope
-            std::string runtime_loop_scope = sc->currentScopeName() +
-                                           Symbols::SymbolContainer::SCOPE_SEPARATOR + "while_" +
-                                           std::to_string(line_) + "_" + std::to_string(column_);
-
-            // Create and enter the loop scope only once
-            if (!sc->getScopeTable(runtime_loop_scope)) {
-                sc->create(runtime_loop_scope);
-                entered_scope = true;
-            } else {
-                sc->enter(runtime_loop_scope);
-                entered_scope = true;
+            // Enter the loop scope, named after the current runtime scope, not the
+            // parse-time one; every iteration shares it
+            sc->enterLoopFrame(scopeSuffix_, frame_);
+            entered_scope = true;
+
+            if (interpreter.bytecodeEnabled() && bytecode_.run(*this, interpreter, [this](Bytecode::Compiler & compiler) {
+                    return compiler.loop(conditionExpr_.get(), nullptr, body_);
+                })) {
+                interpreter.backEdge();
+                sc->enterPreviousScope();
+                return {};
             }
 
             bool cond;
             while (true) {
-                auto val = conditionExpr_->evaluate(interpreter);
-                if (val->getType() != Symbols::Variables::Type::BOOLEAN) {
-                    throw Exception("Condition did not evaluate to boolean: " + conditionExpr_->toString(), filename_,
-                                    line_, column_);
+                if (conditionProven_) {
+                    cond = conditionExpr_->evaluateCondition(interpreter);
+                } else {
+                    auto val = conditionExpr_->evaluate(interpreter);
+                    if (val->getType() != Symbols::Variables::Type::BOOLEAN) {
+                        throw Exception("Condition did not evaluate to boolean: " + conditionExpr_->toString(),
+                                        filename_, line_, column_);
+                    }
+                    cond = val->get<bool>();
                 }
-                cond = val->get<bool>();
                 if (!cond) {
                     break;
                 }
 
-                try {
-                    for (const auto & stmt : body_) {
-                        stmt->interpret(interpreter);
-                    }
-                } catch (const BreakException &) {
-                    // Break out of the while loop
+                // A continue just skips the rest of this iteration.
+                const ControlFlowSignal signal = interpretBody(interpreter, body_);
+                if (signal.kind() == ControlFlowSignal::Kind::Break) {
                     break;
-                } catch (const ContinueException &) {
-                    // Skip the rest of this iteration and carry on.
                 }
+                if (signal.kind() == ControlFlowSignal::Kind::Return) {
+                    sc->enterPreviousScope();
+                    return signal;
+                }
+                interpreter.backEdge();
             }
         } catch (const BaseException &) {
             if (entered_scope) {
@@ -88,6 +92,33 @@ class WhileStatementNode : public StatementNode {
         if (entered_scope) {
             Symbols::SymbolContainer::instance()->enterPreviousScope();
         }
+        return {};
+    }
+
+    void resolveLocals(LocalResolver & resolver) override {
+        frame_ = resolver.enterLoop();
+        resolver.resolve(conditionExpr_);
+        resolver.resolveBody(body_);
+        resolver.exitLoop();
+    }
+
+    void optimize(Optimizer & optimizer) override {
+        optimizer.fold(conditionExpr_);
+        optimizer.body(body_);
+    }
+
+    void checkTypes(TypeChecker & checker) override {
+        conditionProven_ = checker.condition(conditionExpr_,
+                                             "Condition did not evaluate to boolean: " + conditionExpr_->toString(),
+                                             filename_, line_, column_);
+        checker.checkBody(body_);
+    }
+
+    bool lower(Bytecode::Compiler & compiler) const override {
+        compiler.enterScope(filename_, line_, column_);
+        const bool lowered = compiler.loop(conditionExpr_.get(), nullptr, body_);
+        compiler.exitScope();
+        return lowered;
     }
 
     std::string toString() const override { return "WhileStatementNode at " + filename_ + ":" + std::to_string(line_); }
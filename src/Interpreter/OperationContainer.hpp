@@ -13,18 +13,56 @@ class Container {
 
   public:
     /**
-     * @brief Get the Operations::Container instance.
+     * @brief Get the Operations::Container instance of the calling thread (see
+     * Symbols::SymbolContainer::instance()).
      * @return The Operations::Container instance.
      */
     static Operations::Container * instance() {
-        static Operations::Container instance_;
+        static thread_local Operations::Container instance_;
         return &instance_;
     }
 
     Container() = default;
 
+    /**
+     * @brief Collects every operation added to the container while it lives, such as those
+     * one parse produces: its file-scope statements and the bodies of what it declares.
+     */
+    class Recording {
+      public:
+        explicit Recording(Container & container) : container_(container), saved_(container.recording_) {
+            container.recording_ = &operations;
+        }
+
+        ~Recording() { container_.recording_ = saved_; }
+
+        Recording(const Recording &)             = delete;
+        Recording & operator=(const Recording &) = delete;
+
+        std::vector<std::shared_ptr<Operations::Operation>> operations;
+
+      private:
+        Container &                                           container_;
+        std::vector<std::shared_ptr<Operations::Operation>> * saved_;
+    };
+
     void add(const std::string & ns, Operations::Operation operation) {
-        this->_operations[ns].emplace_back(std::make_shared<Operations::Operation>(std::move(operation)));
+        auto & added = this->_operations[ns].emplace_back(std::make_shared<Operations::Operation>(std::move(operation)));
+        if (recording_) {
+            recording_->push_back(added);
+        }
+    }
+
+    /**
+     * @brief Append operations parsed earlier, such as those of a cached template.
+     * @param ns Namespace to append to.
+     */
+    void add(const std::string & ns, const std::vector<std::shared_ptr<Operations::Operation>> & operations) {
+        auto & table = this->_operations[ns];
+        table.insert(table.end(), operations.begin(), operations.end());
+        if (recording_) {
+            recording_->insert(recording_->end(), operations.begin(), operations.end());
+        }
     }
 
     /**
@@ -96,6 +134,16 @@ class Container {
         return {};
     }
 
+    /**
+     * @brief The operation list of a namespace, without copying it.
+     * @return The list, or nullptr. The pointer stays valid for the container's lifetime
+     * (map nodes do not move), though the list itself may still grow.
+     */
+    const std::vector<std::shared_ptr<Operations::Operation>> * find(const std::string & ns) const {
+        auto it = _operations.find(ns);
+        return it == _operations.end() ? nullptr : &it->second;
+    }
+
     /**
      * @brief Returns all operations from all namespaces
      * @return All operations in the namespace.
@@ -118,6 +166,18 @@ class Container {
         }
     }
 
+    /**
+     * @brief Clear the operations of every namespace nested in @p ns: the function, method
+     * and class bodies parsed from it. Parsing a file again appends to those lists.
+     */
+    void clearNested(const std::string & ns) {
+        const std::string prefix = ns + "::";
+        for (auto it = _operations.lower_bound(prefix); it != _operations.end() && it->first.starts_with(prefix);
+             ++it) {
+            it->second.clear();
+        }
+    }
+
     auto begin() { return _operations.begin(); }
 
     auto end() { return _operations.end(); }
@@ -139,6 +199,7 @@ class Container {
 
   private:
     std::map<std::string, std::vector<std::shared_ptr<Operations::Operation>>> _operations;
+    std::vector<std::shared_ptr<Operations::Operation>> *                      recording_ = nullptr;
 };  // class Container
 };  // namespace Operations
 
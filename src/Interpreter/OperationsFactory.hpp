@@ -28,9 +28,10 @@ class OperationsFactory {
 
     static void defineFunction(const std::string & functionName, const std::vector<Symbols::FunctionParameterInfo> & params,
                                const Symbols::Variables::Type & returnType, const std::string & ns,
-                               const std::string & fileName, int line, size_t column) {
+                               const std::string & fileName, int line, size_t column,
+                               std::shared_ptr<const Symbols::FunctionReach> reach = nullptr) {
         std::unique_ptr<DeclareFunctionStatementNode> stmt = std::make_unique<DeclareFunctionStatementNode>(
-            functionName, ns, params, returnType, nullptr, fileName, line, column);
+            functionName, ns, params, returnType, nullptr, fileName, line, column, "", std::move(reach));
         Operations::Container::instance()->add(
             ns, Operations::Operation{ Operations::Type::FuncDeclaration, functionName, std::move(stmt) });
     }
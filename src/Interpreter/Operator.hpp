@@ -0,0 +1,123 @@
+#ifndef INTERPRETER_OPERATOR_HPP
+#define INTERPRETER_OPERATOR_HPP
+
+#include <cstdint>
+#include <string_view>
+
+namespace Interpreter {
+
+/**
+ * @brief Binary operators, resolved from their spelling once when the expression node is
+ * built. Evaluation switches on this instead of comparing the operator string against
+ * every candidate in turn.
+ */
+enum class BinaryOperator : std::uint8_t {
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Modulo,
+    Equal,
+    NotEqual,
+    Less,
+    Greater,
+    LessEqual,
+    GreaterEqual,
+    LogicalAnd,
+    LogicalOr,
+    BitAnd,
+    BitOr,
+    BitXor,
+    ShiftLeft,
+    ShiftRight,
+    Unknown,  // kept so a bad operator still fails when evaluated, as it always did
+};
+
+enum class UnaryOperator : std::uint8_t {
+    Negate,
+    Plus,
+    Increment,
+    Decrement,
+    BitNot,
+    Not,
+    Unknown,
+};
+
+inline BinaryOperator binaryOperator(std::string_view op) {
+    if (op.size() == 1) {
+        switch (op[0]) {
+            case '+': return BinaryOperator::Add;
+            case '-': return BinaryOperator::Subtract;
+            case '*': return BinaryOperator::Multiply;
+            case '/': return BinaryOperator::Divide;
+            case '%': return BinaryOperator::Modulo;
+            case '<': return BinaryOperator::Less;
+            case '>': return BinaryOperator::Greater;
+            case '&': return BinaryOperator::BitAnd;
+            case '|': return BinaryOperator::BitOr;
+            case '^': return BinaryOperator::BitXor;
+            default: return BinaryOperator::Unknown;
+        }
+    }
+    if (op == "==") {
+        return BinaryOperator::Equal;
+    }
+    if (op == "!=") {
+        return BinaryOperator::NotEqual;
+    }
+    if (op == "<=") {
+        return BinaryOperator::LessEqual;
+    }
+    if (op == ">=") {
+        return BinaryOperator::GreaterEqual;
+    }
+    if (op == "&&") {
+        return BinaryOperator::LogicalAnd;
+    }
+    if (op == "||") {
+        return BinaryOperator::LogicalOr;
+    }
+    if (op == "<<") {
+        return BinaryOperator::ShiftLeft;
+    }
+    if (op == ">>") {
+        return BinaryOperator::ShiftRight;
+    }
+    return BinaryOperator::Unknown;
+}
+
+inline UnaryOperator unaryOperator(std::string_view op) {
+    if (op == "-") {
+        return UnaryOperator::Negate;
+    }
+    if (op == "+") {
+        return UnaryOperator::Plus;
+    }
+    if (op == "++") {
+        return UnaryOperator::Increment;
+    }
+    if (op == "--") {
+        return UnaryOperator::Decrement;
+    }
+    if (op == "~") {
+        return UnaryOperator::BitNot;
+    }
+    if (op == "!") {
+        return UnaryOperator::Not;
+    }
+    return UnaryOperator::Unknown;
+}
+
+inline bool isBitwise(BinaryOperator op) {
+    return op == BinaryOperator::BitAnd || op == BinaryOperator::BitOr || op == BinaryOperator::BitXor ||
+           op == BinaryOperator::ShiftLeft || op == BinaryOperator::ShiftRight;
+}
+
+inline bool isComparison(BinaryOperator op) {
+    return op == BinaryOperator::Equal || op == BinaryOperator::NotEqual || op == BinaryOperator::Less ||
+           op == BinaryOperator::Greater || op == BinaryOperator::LessEqual || op == BinaryOperator::GreaterEqual;
+}
+
+}  // namespace Interpreter
+
+#endif  // INTERPRETER_OPERATOR_HPP
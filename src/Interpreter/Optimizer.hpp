@@ -0,0 +1,261 @@
+#ifndef INTERPRETER_OPTIMIZER_HPP
+#define INTERPRETER_OPTIMIZER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Interpreter/ExpressionNode.hpp"
+#include "Symbols/EnumSymbol.hpp"
+#include "Symbols/SymbolContainer.hpp"
+#include "Symbols/Value.hpp"
+#include "Symbols/VariableTypes.hpp"
+
+namespace Interpreter {
+
+/**
+ * @brief Constant folding over the parsed statements, run once before the type checker
+ * (see VoidScript::run; `--no-optimize` leaves the tree as parsed).
+ *
+ * The pass walks the program twice through StatementNode::optimize(). The first walk only
+ * collects declarations: every name a statement declares (variables, constants,
+ * parameters, loop and catch variables, properties) and every enum. The second walk folds
+ * expressions through ExpressionNode::fold():
+ *  - an operator, ternary or interpolated string whose operands are all literals becomes
+ *    the literal it evaluates to; one that throws is left alone to throw when it runs;
+ *  - a member of an enum declared once, at file scope, becomes its integer;
+ *  - a reference to a constant declared once at file scope, with a literal of its
+ *    declared type, becomes that literal. Scoping is dynamic, so a declaration of the same
+ *    name anywhere else could shadow the constant wherever it is read; such a name is
+ *    never inlined;
+ *  - either is inlined only where its declaration has run by then: in a file-scope
+ *    statement after it. A function body may be called before the declaration runs, and
+ *    the lookup then fails, so references in function bodies are left to the lookup;
+ *  - an `if` on a literal condition keeps only the branch it takes.
+ *
+ * A statement that does not override optimize() may declare anything, which turns the
+ * inlining of constants off for the whole pass. Enums and constants already registered
+ * when the pass runs (an earlier segment of the file) are left to the name lookup.
+ *
+ * One optimizer serves every code segment of a file: each run() walks only the operations
+ * that segment's parse added, and the declarations it counted stay counted for the
+ * segments after it.
+ */
+class Optimizer {
+  public:
+    /**
+     * @brief Count what @p operations declare without folding them: operations parsed
+     * before the pass started, which may still shadow a constant the pass would inline.
+     */
+    template <typename Operations> void declarations(const Operations & operations) {
+        folding_  = false;
+        position_ = kNowhere;
+        for (const auto & op : operations) {
+            depth_ = 0;
+            visit(op->statement);
+        }
+    }
+
+    /**
+     * @param all       Every operation the parse of this segment added.
+     * @param fileScope Those of them at file scope, in order.
+     */
+    template <typename Operations> void run(const Operations & all, const Operations & fileScope) {
+        // Candidates of an earlier segment have run by now, and their nodes may be gone
+        constants_.clear();
+        for (auto & [_, decl] : enums_) {
+            decl.values = nullptr;
+        }
+        std::unordered_map<const void *, size_t> topLevel;
+        for (const auto & op : fileScope) {
+            topLevel.emplace(op.get(), topLevel.size());
+        }
+        for (const bool folding : { false, true }) {
+            folding_ = folding;
+            for (const auto & op : all) {
+                const auto it = topLevel.find(op.get());
+                position_     = it != topLevel.end() ? it->second : kNowhere;
+                depth_        = 0;
+                visit(op->statement);
+            }
+        }
+    }
+
+    /** @brief Optimize an optional child statement (a null pointer is skipped). */
+    template <typename Node> void visit(Node & node) {
+        if (node) {
+            node->optimize(*this);
+        }
+    }
+
+    /** @brief Optimize a statement nested in another, such as a loop initialiser. */
+    template <typename Node> void nested(Node & node) {
+        ++depth_;
+        visit(node);
+        --depth_;
+    }
+
+    /** @brief Optimize a nested statement list. */
+    template <typename Statements> void body(Statements & body) {
+        ++depth_;
+        for (auto & stmt : body) {
+            visit(stmt);
+        }
+        --depth_;
+    }
+
+    /** @brief Fold an optional child expression in place. */
+    void fold(std::unique_ptr<ExpressionNode> & node) {
+        if (node && folding_) {
+            if (auto folded = node->fold(*this)) {
+                node = std::move(folded);
+            }
+        }
+    }
+
+    /** @brief The value of @p node if it is a literal, else nullptr. */
+    static const Symbols::ValuePtr * literal(const std::unique_ptr<ExpressionNode> & node) {
+        return node ? node->literal() : nullptr;
+    }
+
+    /** @brief A literal condition of a loop or `if`: its value if it is a non-null boolean. */
+    static std::optional<bool> condition(const std::unique_ptr<ExpressionNode> & node) {
+        const Symbols::ValuePtr * value = literal(node);
+        if (!value || (*value)->is_null() || value->getType() != Symbols::Variables::Type::BOOLEAN) {
+            return std::nullopt;
+        }
+        return value->toBool();
+    }
+
+    /** @brief A statement declares @p name (variable, parameter, loop or catch variable). */
+    void declare(const std::string & name) {
+        if (!folding_) {
+            ++declarations_[name];
+        }
+    }
+
+    /**
+     * @brief A statement declares the constant @p name of type @p type. Only one at file
+     * scope is a candidate for inlining; @p initializer is folded when first needed.
+     */
+    void declareConstant(const std::string & name, Symbols::Variables::Type type,
+                         std::unique_ptr<ExpressionNode> & initializer) {
+        if (folding_) {
+            return;
+        }
+        ++declarations_[name];
+        if (position_ != kNowhere && depth_ == 0 && initializer) {
+            constants_[name] = { &initializer, type, position_ };
+        }
+    }
+
+    /** @brief A statement declares the enum @p name. */
+    void declareEnum(const std::string & name, const std::vector<std::pair<std::string, std::optional<int>>> & values) {
+        if (folding_) {
+            return;
+        }
+        auto & decl = enums_[name];
+        ++decl.count;
+        if (position_ != kNowhere && depth_ == 0) {
+            decl.values   = &values;
+            decl.position = position_;
+        }
+    }
+
+    /** @brief A statement the pass cannot see into: it may declare any name. */
+    void opaque() { opaque_ = true; }
+
+    /** @brief The value of enum member @p enumName.@p member when it can be inlined. */
+    std::optional<int> enumValue(const std::string & enumName, const std::string & member) {
+        const auto it = enums_.find(enumName);
+        if (it == enums_.end() || it->second.count != 1 || !it->second.values || !after(it->second.position) ||
+            Symbols::SymbolContainer::instance()->getEnum(enumName)) {
+            return std::nullopt;
+        }
+        auto & decl = it->second;
+        if (!decl.symbol) {
+            try {
+                decl.symbol = std::make_shared<Symbols::EnumSymbol>(enumName, *decl.values, "");
+            } catch (const std::exception &) {
+                decl.count = 0;  // the declaration fails when it runs; leave that to it
+                return std::nullopt;
+            }
+        }
+        return decl.symbol->GetValue(member);
+    }
+
+    /** @brief The value of constant @p name when its references can be inlined. */
+    std::optional<Symbols::ValuePtr> constant(const std::string & name) {
+        const auto it = constants_.find(name);
+        auto *     sc = Symbols::SymbolContainer::instance();
+        if (opaque_ || it == constants_.end() || declarations_[name] != 1 || !after(it->second.position) ||
+            sc->getConstant(name) || sc->getVariable(name)) {
+            return std::nullopt;
+        }
+        Constant & decl = it->second;
+        if (decl.state == Constant::State::Unfolded) {
+            decl.state = Constant::State::Folding;  // `const int $a = $a + 1;` refers to itself
+            // The initializer runs where it is declared, before the statements after it
+            const size_t reader = std::exchange(position_, decl.position);
+            fold(*decl.initializer);
+            position_  = reader;
+            decl.state = accepts(decl) ? Constant::State::Inlined : Constant::State::Kept;
+        }
+        if (decl.state != Constant::State::Inlined) {
+            return std::nullopt;
+        }
+        return *literal(*decl.initializer);
+    }
+
+  private:
+    struct Constant {
+        enum class State : std::uint8_t { Unfolded, Folding, Inlined, Kept };
+
+        std::unique_ptr<ExpressionNode> * initializer = nullptr;
+        Symbols::Variables::Type          type        = Symbols::Variables::Type::NULL_TYPE;
+        size_t                            position    = 0;  // of the file-scope statement declaring it
+        State                             state       = State::Unfolded;
+    };
+
+    struct Enum {
+        int                                                             count  = 0;
+        const std::vector<std::pair<std::string, std::optional<int>>> * values = nullptr;
+        size_t                                                          position = 0;
+        std::shared_ptr<Symbols::EnumSymbol>                            symbol;
+    };
+
+    // Position of the file-scope statement being walked; kNowhere in a function body.
+    static constexpr size_t kNowhere = SIZE_MAX;
+
+    // Whether the statement being walked runs after the file-scope statement at @p position.
+    bool after(size_t position) const { return position_ != kNowhere && position_ > position; }
+
+    // A constant is inlined when it is stored exactly as its literal initializer is, with no
+    // conversion on declaration.
+    static bool accepts(const Constant & decl) {
+        const Symbols::ValuePtr * value = literal(*decl.initializer);
+        if (!value || (*value)->is_null()) {
+            return false;
+        }
+        return value->getType() == decl.type || decl.type == Symbols::Variables::Type::AUTO_TYPE;
+    }
+
+    bool   folding_  = false;
+    bool   opaque_   = false;
+    int    depth_    = 0;
+    size_t position_ = kNowhere;
+
+    std::unordered_map<std::string, int>      declarations_;
+    std::unordered_map<std::string, Constant> constants_;
+    std::unordered_map<std::string, Enum>     enums_;
+};
+
+}  // namespace Interpreter
+
+#endif  // INTERPRETER_OPTIMIZER_HPP
@@ -0,0 +1,132 @@
+#ifndef INTERPRETER_OUTPUT_HPP
+#define INTERPRETER_OUTPUT_HPP
+
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace Interpreter {
+
+/**
+ * @brief Where a script's output goes: std::cout and std::cerr unless the calling thread
+ * redirects it.
+ *
+ * print(), printnl(), error(), the text outside template tags and the error a failed run
+ * reports are written here. Each thread of `voidscript-fcgi --threads` points its own
+ * output at the request it answers; swapping std::cout's buffer would be process-wide and
+ * mix the output of concurrent requests.
+ *
+ * ob_start() opens an output buffer: until ob_get_clean() closes it, out() collects into
+ * it instead. Buffers nest, and those a script leaves open are written out when it ends
+ * (see BufferScope).
+ */
+class Output {
+  public:
+    /** @brief The calling thread's script output: the innermost open buffer, if any. */
+    static std::ostream & out() { return buffers_.empty() ? sink() : *buffers_.back(); }
+
+    /** @brief The calling thread's script error output. */
+    static std::ostream & err() { return err_ ? *err_ : std::cerr; }
+
+    /** @brief Open an output buffer (ob_start()). */
+    static void startBuffer() { buffers_.push_back(std::make_unique<std::ostringstream>()); }
+
+    /**
+     * @brief Close the innermost output buffer (ob_get_clean()).
+     * @return false, leaving @p contents alone, if no buffer is open.
+     */
+    static bool endBuffer(std::string & contents) {
+        if (buffers_.empty()) {
+            return false;
+        }
+        contents = std::move(*buffers_.back()).str();
+        buffers_.pop_back();
+        return true;
+    }
+
+    /**
+     * @brief Pass what has been written past the open buffers on (flush()): to the terminal,
+     * or, in voidscript-fcgi, to the client, before the response is complete.
+     */
+    static void flush() {
+        sink().flush();
+        if (flush_ && *flush_) {
+            (*flush_)();
+        }
+    }
+
+    /**
+     * @brief Whether out() is the process's standard output itself: no Redirect and no open
+     * buffer. Only then may a caller write to file descriptor 1 directly (file_passthru()),
+     * after flushing std::cout and stdout.
+     */
+    static bool direct() { return out_ == nullptr && buffers_.empty(); }
+
+    /** @brief Sends the calling thread's script output to other streams while it lives. */
+    class Redirect {
+      public:
+        /**
+         * @param flush Called by flush() after @p out is flushed, for an output that holds
+         *        data back further (the FastCGI response).
+         */
+        Redirect(std::ostream & out, std::ostream & err, std::function<void()> flush = nullptr) :
+            onFlush_(std::move(flush)),
+            savedOut_(out_),
+            savedErr_(err_),
+            savedFlush_(flush_) {
+            out_   = &out;
+            err_   = &err;
+            flush_ = &onFlush_;
+        }
+
+        ~Redirect() {
+            out_   = savedOut_;
+            err_   = savedErr_;
+            flush_ = savedFlush_;
+        }
+
+        Redirect(const Redirect &)             = delete;
+        Redirect & operator=(const Redirect &) = delete;
+
+      private:
+        std::function<void()>         onFlush_;
+        std::ostream *                savedOut_;
+        std::ostream *                savedErr_;
+        const std::function<void()> * savedFlush_;
+    };
+
+    /** @brief Writes out, when it ends, the output buffers opened while it lived. */
+    class BufferScope {
+      public:
+        BufferScope() : level_(buffers_.size()) {}
+
+        ~BufferScope() {
+            std::string contents;
+            while (buffers_.size() > level_ && endBuffer(contents)) {
+                out() << contents;
+            }
+        }
+
+        BufferScope(const BufferScope &)             = delete;
+        BufferScope & operator=(const BufferScope &) = delete;
+
+      private:
+        size_t level_;
+    };
+
+  private:
+    static std::ostream & sink() { return out_ ? *out_ : std::cout; }
+
+    static inline thread_local std::ostream *                                    out_   = nullptr;
+    static inline thread_local std::ostream *                                    err_   = nullptr;
+    static inline thread_local const std::function<void()> *                     flush_ = nullptr;
+    static inline thread_local std::vector<std::unique_ptr<std::ostringstream>> buffers_;
+};
+
+}  // namespace Interpreter
+
+#endif  // INTERPRETER_OUTPUT_HPP
@@ -3,8 +3,18 @@
 
 #include <string>
 
+#include "Interpreter/ControlFlowSignal.hpp"
+#include "Interpreter/LocalResolver.hpp"
+#include "Interpreter/Optimizer.hpp"
+
 namespace Interpreter {
 
+class TypeChecker;
+
+namespace Bytecode {
+class Compiler;
+}
+
 class StatementNode {
   public:
     std::string filename_;
@@ -17,10 +27,44 @@ class StatementNode {
         column_(line_column) {}
 
     virtual ~StatementNode()                                      = default;
-    virtual void interpret(class Interpreter & interpreter) const = 0;
+    virtual ControlFlowSignal interpret(class Interpreter & interpreter) const = 0;
     virtual std::string toString() const = 0;
+
+    // Report declarations and variable references to the local resolver. Statements that
+    // do not override this are opaque: the enclosing function keeps name lookups.
+    virtual void resolveLocals(LocalResolver & resolver) { resolver.opaque(); }
+
+    // Report declarations to the optimizer, fold child expressions and optimize child
+    // statements (see Optimizer). Statements that do not override this are opaque: the
+    // pass inlines no constants, since they may declare any name.
+    virtual void optimize(Optimizer & optimizer) { optimizer.opaque(); }
+
+    // Infer the types of child expressions and note what was proven (see TypeChecker).
+    // Statements that do not override this keep all their runtime checks.
+    virtual void checkTypes(TypeChecker & /*checker*/) {}
+
+    // Lower this statement into the loop being compiled (see Bytecode::Compiler). Statements
+    // that do not override this keep the enclosing loop on the tree walker.
+    virtual bool lower(Bytecode::Compiler & /*compiler*/) const { return false; }
 };
 
+/**
+ * @brief Run a statement list in order, stopping at the first statement that does not
+ * finish normally; returns its signal, or a normal one when every statement ran.
+ */
+template <typename Statements> ControlFlowSignal interpretBody(class Interpreter & interpreter, const Statements & body) {
+    for (const auto & stmt : body) {
+        if (!stmt) {
+            continue;
+        }
+        ControlFlowSignal signal = stmt->interpret(interpreter);
+        if (!signal.normal()) {
+            return signal;
+        }
+    }
+    return {};
+}
+
 };  // namespace Interpreter
 
 #endif  // STATEMENT_NODE_HPP
@@ -0,0 +1,230 @@
+#ifndef INTERPRETER_TYPE_CHECKER_HPP
+#define INTERPRETER_TYPE_CHECKER_HPP
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Interpreter/ExpressionNode.hpp"
+#include "Interpreter/Operator.hpp"
+#include "Interpreter/StatementNode.hpp"
+#include "Symbols/VariableTypes.hpp"
+
+namespace Interpreter {
+
+/**
+ * @brief Static type inference over the parsed statements, run once before execution
+ * (see VoidScript::run).
+ *
+ * Expressions report the type they are proven to produce through inferType(); statements
+ * walk their children through checkTypes() and keep a note of what was proven, so the
+ * proven-safe ones skip their runtime check: a loop or `if` condition proven boolean is
+ * evaluated with ExpressionNode::evaluateCondition() instead of being boxed and tested,
+ * and a declaration whose initialiser already has the declared type skips the
+ * compatibility checks.
+ *
+ * A proof is a type the value always has, never null, whenever the expression returns at
+ * all. Only literals and the operators built on them prove anything: a variable's value
+ * is not pinned to its declared type (a variable may be set to null and then to any
+ * type), and scoping is dynamic, so a name may not even refer to the variable it appears
+ * to. Comparisons, `&&`, `||` and `!` yield a boolean whatever their operands are.
+ *
+ * An expression or statement that does not override the hooks proves nothing, and the
+ * node it belongs to keeps its runtime checks; the pass never changes what a script does.
+ * Operations that are certain to fail with a type error if they run are collected as
+ * diagnostics; VoidScript reports them up front when --typecheck is given.
+ */
+class TypeChecker {
+  public:
+    using Proof = std::optional<Symbols::Variables::Type>;
+
+    struct Diagnostic {
+        std::string message;
+        std::string filename;
+        int         line   = 0;
+        size_t      column = 0;
+
+        std::string toString() const {
+            return "[Type ERROR] >> in file \"" + filename + "\" at line: " + std::to_string(line) +
+                   ", column: " + std::to_string(column) + " << : " + message;
+        }
+    };
+
+    /** @brief Infer an optional child expression; a null pointer proves nothing. */
+    template <typename Node> Proof infer(Node & node) { return node ? node->inferType(*this) : std::nullopt; }
+
+    /** @brief Check an optional child statement (a null pointer is skipped). */
+    template <typename Node> void check(Node & node) {
+        if (node) {
+            const Diagnostic outer = site_;
+            site_                  = { {}, node->filename_, node->line_, node->column_ };
+            node->checkTypes(*this);
+            site_ = outer;
+        }
+    }
+
+    /** @brief Check a statement list in order. */
+    template <typename Statements> void checkBody(Statements & body) {
+        for (auto & stmt : body) {
+            check(stmt);
+        }
+    }
+
+    /**
+     * @brief Infer a condition of a loop or `if`. True when it is proven boolean; a proof
+     * of any other type is certain to fail the runtime check and is reported.
+     */
+    template <typename Node>
+    bool condition(Node & node, const std::string & message, const std::string & filename, int line, size_t column) {
+        const Proof proof = infer(node);
+        if (proof && *proof != Symbols::Variables::Type::BOOLEAN) {
+            error(message + ", got '" + Symbols::Variables::TypeToString(*proof) + "'", filename, line, column);
+        }
+        return proof == Symbols::Variables::Type::BOOLEAN;
+    }
+
+    void error(const std::string & message, const std::string & filename, int line, size_t column) {
+        diagnostics_.push_back({ message, filename, line, column });
+    }
+
+    /**
+     * @brief Report an error in an expression, at its own location when it has one and at
+     * the enclosing statement's otherwise.
+     */
+    void error(const std::string & message, const ExpressionNode & at) {
+        if (at.line > 0) {
+            error(message, at.filename, at.line, at.column);
+        } else {
+            error(message, site_.filename, site_.line, site_.column);
+        }
+    }
+
+    const std::vector<Diagnostic> & diagnostics() const { return diagnostics_; }
+
+    /**
+     * @brief Result of a binary operator on operands of the given proofs, following
+     * BinaryExpressionNode's kernels. @p fails is set when the operand types are certain
+     * to be rejected.
+     */
+    static Proof binary(BinaryOperator op, const Proof & lhs, const Proof & rhs, bool & fails) {
+        using Symbols::Variables::Type;
+        fails                 = false;
+        const bool comparison = isComparison(op) || op == BinaryOperator::LogicalAnd || op == BinaryOperator::LogicalOr;
+        if (op == BinaryOperator::Unknown) {
+            return std::nullopt;
+        }
+        if (!lhs || !rhs || !isScalar(*lhs) || !isScalar(*rhs)) {
+            // A null operand makes every operator yield a boolean, and so does a comparison.
+            return comparison ? Proof(Type::BOOLEAN) : std::nullopt;
+        }
+        const Type left  = *lhs;
+        const Type right = *rhs;
+        const Proof result = scalarBinary(op, left, right);
+        fails              = !result;
+        return comparison ? Proof(Type::BOOLEAN) : result;
+    }
+
+    /** @brief Result of a unary operator, following UnaryExpressionNode. */
+    static Proof unary(UnaryOperator op, const Proof & operand, bool & fails) {
+        using Symbols::Variables::Type;
+        fails = false;
+        if (!operand || !isScalar(*operand)) {
+            return op == UnaryOperator::Not ? Proof(Type::BOOLEAN) : std::nullopt;
+        }
+        switch (*operand) {
+            case Type::INTEGER:
+                if (op != UnaryOperator::Not && op != UnaryOperator::Unknown) {
+                    return Type::INTEGER;
+                }
+                break;
+            case Type::DOUBLE:
+            case Type::FLOAT:
+                if (op == UnaryOperator::Negate || op == UnaryOperator::Plus || op == UnaryOperator::Increment ||
+                    op == UnaryOperator::Decrement) {
+                    return *operand;
+                }
+                break;
+            case Type::BOOLEAN:
+                if (op == UnaryOperator::Not) {
+                    return Type::BOOLEAN;
+                }
+                break;
+            default:  // STRING
+                if (op == UnaryOperator::Negate || op == UnaryOperator::Plus) {
+                    return Type::STRING;
+                }
+                break;
+        }
+        fails = true;
+        return op == UnaryOperator::Not ? Proof(Type::BOOLEAN) : std::nullopt;
+    }
+
+    /**
+     * @brief Whether a declaration of type @p declared accepts a value of type @p proven,
+     * following DeclareVariableStatementNode (numeric values widen to float and double,
+     * enums take integers).
+     */
+    static bool declarable(Symbols::Variables::Type proven, Symbols::Variables::Type declared) {
+        using Symbols::Variables::Type;
+        if (proven == declared || declared == Type::AUTO_TYPE) {
+            return true;
+        }
+        if (declared == Type::ENUM) {
+            return proven == Type::INTEGER;
+        }
+        return isNumber(proven) && (declared == Type::FLOAT || declared == Type::DOUBLE);
+    }
+
+  private:
+    static bool isNumber(Symbols::Variables::Type type) {
+        return type == Symbols::Variables::Type::INTEGER || type == Symbols::Variables::Type::FLOAT ||
+               type == Symbols::Variables::Type::DOUBLE;
+    }
+
+    // The only types a proof can carry: those of literals and of operator results.
+    static bool isScalar(Symbols::Variables::Type type) {
+        return isNumber(type) || type == Symbols::Variables::Type::BOOLEAN ||
+               type == Symbols::Variables::Type::STRING;
+    }
+
+    // The type BinaryExpressionNode produces for two non-null scalars, or nothing when it
+    // throws for them.
+    static Proof scalarBinary(BinaryOperator op, Symbols::Variables::Type left, Symbols::Variables::Type right) {
+        using Symbols::Variables::Type;
+        const bool logical  = op == BinaryOperator::LogicalAnd || op == BinaryOperator::LogicalOr;
+        const bool equality = op == BinaryOperator::Equal || op == BinaryOperator::NotEqual;
+        if (left == right) {
+            switch (left) {
+                case Type::INTEGER:
+                    return logical ? std::nullopt : Proof(Type::INTEGER);
+                case Type::DOUBLE:
+                case Type::FLOAT:
+                    return (logical || isBitwise(op) || op == BinaryOperator::Modulo) ? std::nullopt : Proof(left);
+                case Type::BOOLEAN:
+                    return (logical || equality) ? Proof(Type::BOOLEAN) : std::nullopt;
+                default:  // STRING
+                    return (op == BinaryOperator::Add || equality) ? Proof(Type::STRING) : std::nullopt;
+            }
+        }
+        if (isBitwise(op)) {
+            return std::nullopt;
+        }
+        if (isNumber(left) && isNumber(right)) {
+            if (logical || op == BinaryOperator::Modulo) {
+                return std::nullopt;
+            }
+            return (left == Type::DOUBLE || right == Type::DOUBLE) ? Type::DOUBLE : Type::FLOAT;
+        }
+        if (op == BinaryOperator::Add && (left == Type::STRING || right == Type::STRING)) {
+            return Type::STRING;
+        }
+        return std::nullopt;
+    }
+
+    std::vector<Diagnostic> diagnostics_;
+    Diagnostic              site_;  // location of the statement being checked
+};
+
+}  // namespace Interpreter
+
+#endif  // INTERPRETER_TYPE_CHECKER_HPP
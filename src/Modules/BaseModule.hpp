@@ -21,9 +21,9 @@ using CallbackFunction  = std::function<Symbols::ValuePtr(FunctionArguments &)>;
 
 namespace Modules {
 
-// Global template instance for type storage
-template <typename T> static std::map<int, T> typeHolder;
-static int                                    typeCounter = 0;
+// Global template instance for type storage, per thread like the modules that use it
+template <typename T> static thread_local std::map<int, T> typeHolder;
+static thread_local int                                    typeCounter = 0;
 
 /**
  * @brief Base class for modules that register symbols into the symbol table.
@@ -44,6 +44,13 @@ class BaseModule {
      */
     virtual void registerFunctions() = 0;
 
+    /**
+     * @brief Free what scripts opened through this module (documents, handles) and kept in
+     * its tables. A long-lived host calls it between scripts, as voidscript-fcgi does after
+     * each request; the default keeps nothing.
+     */
+    virtual void releaseScriptResources() {}
+
     void setModuleName(const std::string & name) { this->moduleName = name; }
 
     std::string name() const { return this->moduleName; }
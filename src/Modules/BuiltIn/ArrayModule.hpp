@@ -3,7 +3,6 @@
 #define MODULES_ARRAYMODULE_HPP
 
 #include <algorithm>
-#include <set>
 #include <stdexcept>
 #include <string>
 #include <utility>
@@ -61,6 +60,10 @@ class ArrayModule : public BaseModule {
         REGISTER_FUNCTION("array_usort", T::OBJECT, arr_fn,
                           "Sort using callback(a, b) -> negative/zero/positive; returns a new array",
                           Modules::ArrayModule::Usort);
+        // The callback versions run script functions.
+        for (const char * name : { "array_map", "array_filter", "array_reduce", "array_usort" }) {
+            Symbols::SymbolContainer::instance()->markReentrant(name);
+        }
         REGISTER_FUNCTION("array_keys", T::OBJECT, arr1, "Return the array's keys",
                           Modules::ArrayModule::Keys);
         REGISTER_FUNCTION("array_values", T::OBJECT, arr1, "Return the array's values, reindexed from 0",
@@ -84,13 +87,17 @@ class ArrayModule : public BaseModule {
 
     // --- helpers ---------------------------------------------------------------------
 
-    // Arrays are ObjectMaps keyed by the decimal index, but the map orders keys
-    // lexicographically ("10" < "2"), so the elements must be read back by numeric index.
+    // Arrays are dense ArrayVectors, or ObjectMaps keyed by the decimal index once they have
+    // been promoted. A promoted array may have been written out of order, so it is read
+    // back by numeric index.
     static std::vector<Symbols::ValuePtr> toVector(const Symbols::ValuePtr & arr, const char * fn) {
         if (arr->getType() != Symbols::Variables::Type::OBJECT &&
             arr->getType() != Symbols::Variables::Type::CLASS) {
             throw std::runtime_error(std::string(fn) + ": expects an array");
         }
+        if (arr->isArray()) {
+            return arr->get<Symbols::ArrayVector>();
+        }
         const auto &                   map = arr->get<Symbols::ObjectMap>();
         std::vector<Symbols::ValuePtr> out;
         for (size_t i = 0;; ++i) {
@@ -103,36 +110,24 @@ class ArrayModule : public BaseModule {
         return out;
     }
 
-    // (key, value) pairs in a sensible order: numeric-indexed entries first, by index
-    // (so a >10-element array is not reordered "10" < "2"), then any remaining
-    // associative entries in the map's own order. Works for arrays and objects alike.
-    static std::vector<std::pair<std::string, Symbols::ValuePtr>> orderedEntries(const Symbols::ObjectMap & map) {
+    // (key, value) pairs in iteration order: index order for a dense array, insertion
+    // order for a map. Works for arrays and objects alike.
+    static std::vector<std::pair<std::string, Symbols::ValuePtr>> orderedEntries(const Symbols::ValuePtr & arr) {
         std::vector<std::pair<std::string, Symbols::ValuePtr>> out;
-        std::set<std::string>                                  used;
-        for (size_t i = 0;; ++i) {
-            const std::string key = std::to_string(i);
-            auto              it  = map.find(key);
-            if (it == map.end()) {
-                break;
-            }
-            out.emplace_back(key, it->second);
-            used.insert(key);
-        }
-        for (const auto & kv : map) {
-            if (used.find(kv.first) == used.end()) {
-                out.emplace_back(kv.first, kv.second);
+        if (arr->isArray()) {
+            const auto & elements = arr->get<Symbols::ArrayVector>();
+            out.reserve(elements.size());
+            for (size_t i = 0; i < elements.size(); ++i) {
+                out.emplace_back(std::to_string(i), elements[i]);
             }
+            return out;
         }
+        const auto & map = arr->get<Symbols::ObjectMap>();
+        out.assign(map.begin(), map.end());
         return out;
     }
 
-    static Symbols::ValuePtr fromVector(const std::vector<Symbols::ValuePtr> & v) {
-        Symbols::ObjectMap m;
-        for (size_t i = 0; i < v.size(); ++i) {
-            m[std::to_string(i)] = v[i];
-        }
-        return Symbols::ValuePtr(m);
-    }
+    static Symbols::ValuePtr fromVector(std::vector<Symbols::ValuePtr> v) { return Symbols::ValuePtr(std::move(v)); }
 
     // Ascending compare: numeric when both are numeric, otherwise by string form.
     static int compareValues(const Symbols::ValuePtr & a, const Symbols::ValuePtr & b) {
@@ -225,7 +220,7 @@ class ArrayModule : public BaseModule {
             throw std::runtime_error("array_keys expects (array)");
         }
         std::vector<Symbols::ValuePtr> keys;
-        for (const auto & kv : orderedEntries(args[0]->get<Symbols::ObjectMap>())) {
+        for (const auto & kv : orderedEntries(args[0])) {
             keys.push_back(Symbols::ValuePtr(kv.first));
         }
         return fromVector(keys);
@@ -237,7 +232,7 @@ class ArrayModule : public BaseModule {
             throw std::runtime_error("array_values expects (array)");
         }
         std::vector<Symbols::ValuePtr> vals;
-        for (const auto & kv : orderedEntries(args[0]->get<Symbols::ObjectMap>())) {
+        for (const auto & kv : orderedEntries(args[0])) {
             vals.push_back(kv.second);
         }
         return fromVector(vals);
@@ -307,7 +302,7 @@ class ArrayModule : public BaseModule {
             throw std::runtime_error("array_flip expects (array)");
         }
         Symbols::ObjectMap out;
-        for (const auto & kv : args[0]->get<Symbols::ObjectMap>()) {
+        for (const auto & kv : orderedEntries(args[0])) {
             out[kv.second->toString()] = Symbols::ValuePtr(kv.first);
         }
         return Symbols::ValuePtr(out);
@@ -335,8 +330,7 @@ class ArrayModule : public BaseModule {
         switch (type) {
             case Symbols::Variables::Type::OBJECT:
                 {
-                    const auto & map = val->get<Symbols::ObjectMap>();
-                    return static_cast<int>(map.size());
+                    return static_cast<int>(val->objectSize());
                 }
             case Symbols::Variables::Type::STRING:
                 {
@@ -345,8 +339,7 @@ class ArrayModule : public BaseModule {
                 }
             case Symbols::Variables::Type::CLASS:
                 {
-                    const auto & map = val->get<Symbols::ObjectMap>();
-                    return static_cast<int>(map.size());
+                    return static_cast<int>(val->objectSize());
                 }
             case Symbols::Variables::Type::INTEGER:
             case Symbols::Variables::Type::DOUBLE:
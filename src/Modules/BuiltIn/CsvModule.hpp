@@ -120,23 +120,28 @@ class CsvModule : public BaseModule {
             endRow();
         }
 
-        Symbols::ObjectMap outRows;
-        for (size_t r = 0; r < rows.size(); ++r) {
-            Symbols::ObjectMap cols;
-            for (size_t c = 0; c < rows[r].size(); ++c) {
-                cols[std::to_string(c)] = Symbols::ValuePtr(rows[r][c]);
+        Symbols::ArrayVector outRows;
+        outRows.reserve(rows.size());
+        for (const auto & row : rows) {
+            Symbols::ArrayVector cols;
+            cols.reserve(row.size());
+            for (const auto & col : row) {
+                cols.emplace_back(col);
             }
-            outRows[std::to_string(r)] = Symbols::ValuePtr(cols);
+            outRows.emplace_back(std::move(cols));
         }
-        return Symbols::ValuePtr(outRows);
+        return Symbols::ValuePtr(std::move(outRows));
     }
 
-    // Read an array (ObjectMap) back in index order.
+    // Read an array back in index order.
     static std::vector<Symbols::ValuePtr> indexed(const Symbols::ValuePtr & v) {
         std::vector<Symbols::ValuePtr> out;
         if (v->getType() != Symbols::Variables::Type::OBJECT && v->getType() != Symbols::Variables::Type::CLASS) {
             return out;
         }
+        if (v->isArray()) {
+            return v->get<Symbols::ArrayVector>();
+        }
         const auto & map = v->get<Symbols::ObjectMap>();
         for (size_t i = 0;; ++i) {
             auto it = map.find(std::to_string(i));
@@ -4,15 +4,24 @@
 
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#    include <sys/sendfile.h>
+#endif
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
 #include <filesystem>
 #include <fstream>
 #include <iterator>
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include <system_error>
 #include <vector>
 
+#include "Interpreter/Output.hpp"
 #include "Modules/BaseModule.hpp"
 #include "Symbols/RegistrationMacros.hpp"
 #include "Symbols/SymbolContainer.hpp"
@@ -26,6 +35,8 @@ namespace Modules {
  *  file_get_contents(filename) -> string content
  *  file_put_contents(filename, content, overwrite) -> undefined, throws on error
  *  file_exists(filename) -> bool
+ *  file_passthru(path [, offset, length]) -> int bytes written to the output; a range
+ *      the int result cannot count (2 GiB or more) is an error, nothing is written
  */
 class FileModule : public BaseModule {
 
@@ -403,6 +414,132 @@ class FileModule : public BaseModule {
                               out["type"]  = Symbols::ValuePtr(type);
                               return Symbols::ValuePtr(out);
                           });
+
+        // file_passthru
+        std::vector<Symbols::FunctionParameterInfo> passthru_params = {
+            { "path",   Symbols::Variables::Type::STRING,  "Path to the file",                              false, false },
+            { "offset", Symbols::Variables::Type::INTEGER, "First byte to write (default 0)",               true,  false },
+            { "length", Symbols::Variables::Type::INTEGER, "Number of bytes to write (default: to the end)", true,  false }
+        };
+        REGISTER_FUNCTION("file_passthru", Symbols::Variables::Type::INTEGER, passthru_params,
+                          "Write a file, or a byte range of it, to the output without reading it into a string; "
+                          "returns the number of bytes written",
+                          [](const Symbols::FunctionArguments & args) -> Symbols::ValuePtr {
+                              if (args.empty() || args.size() > 3 || args[0] != Symbols::Variables::Type::STRING ||
+                                  (args.size() > 1 && args[1] != Symbols::Variables::Type::INTEGER) ||
+                                  (args.size() > 2 && args[2] != Symbols::Variables::Type::INTEGER)) {
+                                  throw std::runtime_error(
+                                      "file_passthru expects (string path [, int offset [, int length]])");
+                              }
+                              const std::string path   = args[0];
+                              // Script integers are int, so neither reaches past 2 GiB
+                              const off_t       offset = args.size() > 1 ? static_cast<int>(args[1]) : 0;
+                              const off_t       length = args.size() > 2 ? static_cast<int>(args[2]) : -1;
+                              if (offset < 0 || (args.size() > 2 && length < 0)) {
+                                  throw std::runtime_error("file_passthru: offset and length must not be negative");
+                              }
+                              const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+                              if (fd < 0) {
+                                  throw std::runtime_error("file_passthru: cannot open: " + path);
+                              }
+                              struct stat info;
+                              if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+                                  ::close(fd);
+                                  throw std::runtime_error("file_passthru: not a regular file: " + path);
+                              }
+                              off_t count = info.st_size > offset ? info.st_size - offset : 0;
+                              if (length >= 0) {
+                                  count = std::min(count, length);
+                              }
+                              if (count > std::numeric_limits<int>::max()) {
+                                  ::close(fd);
+                                  throw std::runtime_error(
+                                      "file_passthru: cannot write 2 GiB or more in one call (the count would not fit "
+                                      "in an int); pass a smaller length, or use x_sendfile(): " + path);
+                              }
+                              off_t written = 0;
+                              try {
+                                  written = passthru(fd, offset, count);
+                              } catch (...) {
+                                  ::close(fd);
+                                  throw;
+                              }
+                              ::close(fd);
+                              return Symbols::ValuePtr(static_cast<int>(written));  // written <= count
+                          });
+    }
+
+  private:
+    static constexpr off_t kChunk = 64 * 1024;
+
+    /**
+     * @brief Write @p count bytes of @p fd, from @p offset, to the script output.
+     * @return The number of bytes written; fewer than @p count if the file shrank meanwhile.
+     *
+     * When the output is the process's standard output (see Interpreter::Output::direct())
+     * the kernel copies the bytes: sendfile(), or splice() into a pipe where sendfile()
+     * refuses one. Otherwise, or if neither works, the file is read in chunks of 64 KiB that
+     * are written to Output::out(); voidscript-fcgi sends chunks that large on as they come.
+     */
+    static off_t passthru(int fd, off_t offset, off_t count) {
+        off_t done = 0;
+        if (Interpreter::Output::direct()) {
+            Interpreter::Output::out().flush();
+            std::fflush(stdout);
+#ifdef __linux__
+            struct stat target;
+            const bool  pipe        = ::fstat(STDOUT_FILENO, &target) == 0 && S_ISFIFO(target.st_mode);
+            bool        useSendfile = true;
+            while (done < count) {
+                const size_t chunk = static_cast<size_t>(std::min<off_t>(count - done, 1 << 30));
+                ssize_t      n     = 0;
+                if (useSendfile) {
+                    off_t position = offset + done;
+                    n              = ::sendfile(STDOUT_FILENO, fd, &position, chunk);
+                } else {
+                    loff_t position = offset + done;
+                    n               = ::splice(fd, &position, STDOUT_FILENO, nullptr, chunk, SPLICE_F_MORE);
+                }
+                if (n > 0) {
+                    done += n;
+                    continue;
+                }
+                if (n == 0) {
+                    return done;
+                }
+                if (errno == EINTR) {
+                    continue;
+                }
+                if (useSendfile && pipe && (errno == EINVAL || errno == ENOSYS)) {
+                    useSendfile = false;
+                    continue;
+                }
+                break;
+            }
+#endif
+        }
+
+        std::vector<char> buffer(static_cast<size_t>(std::min(count - done, kChunk)));
+        std::ostream &    out = Interpreter::Output::out();
+        while (done < count) {
+            const size_t  chunk = static_cast<size_t>(std::min(count - done, kChunk));
+            const ssize_t n     = ::pread(fd, buffer.data(), chunk, offset + done);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n < 0) {
+                throw std::runtime_error("file_passthru: read failed");
+            }
+            if (n == 0) {
+                break;
+            }
+            out.write(buffer.data(), n);
+            if (!out) {
+                throw std::runtime_error("file_passthru: write failed");
+            }
+            done += n;
+        }
+        return done;
     }
 };
 
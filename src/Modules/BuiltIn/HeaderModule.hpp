@@ -13,7 +13,8 @@
 namespace Modules {
 
 /**
- * @brief FastCGI header management (header setting like PHP header()).
+ * @brief FastCGI header management (header setting like PHP header()), and x_sendfile() /
+ * x_accel_redirect(), which leave sending a file to the web server.
  */
 class HeaderModule : public BaseModule {
   public:
@@ -36,11 +37,36 @@ class HeaderModule : public BaseModule {
                                   args[1]->getType() != Symbols::Variables::Type::STRING) {
                                   throw Exception("header(key, value) requires two string arguments");
                               }
+                              if (locked_) {
+                                  throw Exception("header(): the headers were already sent with the output");
+                              }
                               const std::string & key = args[0]->get<std::string>();
                               const std::string & val = args[1]->get<std::string>();
                               setHeader(key, val);
                               return Symbols::ValuePtr::null();
                           });
+
+        std::vector<Symbols::FunctionParameterInfo> sendfileParams = {
+            { "path", Symbols::Variables::Type::STRING, "Absolute path of the file to send", false, false }
+        };
+        REGISTER_FUNCTION("x_sendfile", Symbols::Variables::Type::NULL_TYPE, sendfileParams,
+                          "Let the web server send a file as the response body (X-Sendfile: Apache "
+                          "mod_xsendfile, lighttpd)",
+                          [](const Symbols::FunctionArguments & args) -> Symbols::ValuePtr {
+                              setOffloadHeader("x_sendfile", "X-Sendfile", args);
+                              return Symbols::ValuePtr::null();
+                          });
+
+        std::vector<Symbols::FunctionParameterInfo> accelParams = {
+            { "uri", Symbols::Variables::Type::STRING, "URI of an nginx internal location serving the file", false,
+             false }
+        };
+        REGISTER_FUNCTION("x_accel_redirect", Symbols::Variables::Type::NULL_TYPE, accelParams,
+                          "Let nginx send a file from an internal location as the response body (X-Accel-Redirect)",
+                          [](const Symbols::FunctionArguments & args) -> Symbols::ValuePtr {
+                              setOffloadHeader("x_accel_redirect", "X-Accel-Redirect", args);
+                              return Symbols::ValuePtr::null();
+                          });
     }
 
     /**
@@ -54,13 +80,43 @@ class HeaderModule : public BaseModule {
     static const std::unordered_map<std::string, std::string> & getHeaders() noexcept { return headers_; }
 
     /**
-     * @brief Clear all previously set headers.
+     * @brief Clear all previously set headers, and accept header() calls again.
+     */
+    static void clearHeaders() noexcept {
+        headers_.clear();
+        locked_ = false;
+    }
+
+    /**
+     * @brief Refuse further header() calls: the headers have gone out with the first part of
+     * the response body.
      */
-    static void clearHeaders() noexcept { headers_.clear(); }
+    static void lockHeaders() noexcept { locked_ = true; }
 
   private:
-    // Inline static for single definition across translation units
-    inline static std::unordered_map<std::string, std::string> headers_;
+    /**
+     * @brief Set the header that hands the response body to the web server (x_sendfile(),
+     * x_accel_redirect()). The value must be a single line: it is not a free-form header.
+     */
+    static void setOffloadHeader(const std::string & function, const std::string & key,
+                                 const Symbols::FunctionArguments & args) {
+        if (args.size() != 1 || args[0]->getType() != Symbols::Variables::Type::STRING) {
+            throw Exception(function + "() requires one string argument");
+        }
+        if (locked_) {
+            throw Exception(function + "(): the headers were already sent with the output");
+        }
+        const std::string & value = args[0]->get<std::string>();
+        if (value.empty() || value.find_first_of("\r\n") != std::string::npos) {
+            throw Exception(function + "(): the path must be a non-empty single line");
+        }
+        setHeader(key, value);
+    }
+
+    // Inline static for single definition across translation units; per thread, since each
+    // thread of `voidscript-fcgi --threads` answers its own request
+    inline static thread_local std::unordered_map<std::string, std::string> headers_;
+    inline static thread_local bool                                         locked_ = false;
 };
 
 }  // namespace Modules
@@ -62,7 +62,7 @@ std::string createJsonErrorMessage(const std::string& operation,
  * @param json The JSON number value
  * @return Symbols::ValuePtr The converted numeric ValuePtr
  */
-Symbols::ValuePtr convertJsonNumberToValue(const nlohmann::json& json) {
+Symbols::ValuePtr convertJsonNumberToValue(const nlohmann::ordered_json& json) {
     if (json.is_number_integer()) {
         return Symbols::ValuePtr(static_cast<int>(json.get<int64_t>()));
     } else if (json.is_number_unsigned()) {
@@ -88,12 +88,12 @@ Symbols::ValuePtr convertJsonNumberToValue(const nlohmann::json& json) {
  * @param context Additional context information
  * @return Symbols::ObjectMap The converted ObjectMap
  */
-Symbols::ObjectMap convertJsonObjectToMap(const nlohmann::json& json, const std::string& context = "") {
+Symbols::ObjectMap convertJsonObjectToMap(const nlohmann::ordered_json& json, const std::string& context = "") {
     Symbols::ObjectMap result;
 
     for (auto it = json.begin(); it != json.end(); ++it) {
         const std::string& key = it.key();
-        const nlohmann::json& value = it.value();
+        const nlohmann::ordered_json& value = it.value();
 
         if (value.is_null()) {
             result[key] = Symbols::ValuePtr::null(Symbols::Variables::Type::NULL_TYPE);
@@ -108,31 +108,7 @@ Symbols::ObjectMap convertJsonObjectToMap(const nlohmann::json& json, const std:
         } else if (value.is_string()) {
             result[key] = Symbols::ValuePtr(value.get<std::string>());
         } else if (value.is_array()) {
-            // Convert JSON array to ObjectMap with numeric string keys
-            Symbols::ObjectMap arrayMap;
-            for (size_t i = 0; i < value.size(); ++i) {
-                const std::string indexKey = std::to_string(i);
-                const nlohmann::json& element = value[i];
-
-                if (element.is_null()) {
-                    arrayMap[indexKey] = Symbols::ValuePtr::null(Symbols::Variables::Type::NULL_TYPE);
-                } else if (element.is_boolean()) {
-                    arrayMap[indexKey] = Symbols::ValuePtr(element.get<bool>());
-                } else if (element.is_number_integer()) {
-                    arrayMap[indexKey] = Symbols::ValuePtr(static_cast<int>(element.get<int64_t>()));
-                } else if (element.is_number_unsigned()) {
-                    arrayMap[indexKey] = Symbols::ValuePtr(static_cast<int>(element.get<uint64_t>()));
-                } else if (element.is_number_float()) {
-                    arrayMap[indexKey] = Symbols::ValuePtr(element.get<double>());
-                } else if (element.is_string()) {
-                    arrayMap[indexKey] = Symbols::ValuePtr(element.get<std::string>());
-                } else if (element.is_object()) {
-                    arrayMap[indexKey] = jsonToValueWithContext(element, context);
-                } else if (element.is_array()) {
-                    arrayMap[indexKey] = jsonToValueWithContext(element, context);
-                }
-            }
-            result[key] = Symbols::ValuePtr(arrayMap);
+            result[key] = jsonToValueWithContext(value, context);
         } else if (value.is_object()) {
             result[key] = jsonToValueWithContext(value, context);
         }
@@ -145,7 +121,7 @@ Symbols::ObjectMap convertJsonObjectToMap(const nlohmann::json& json, const std:
  * @brief Recursively converts a VoidScript ObjectMap to JSON object
  *
  * @param objMap The ObjectMap to convert
- * @return nlohmann::json The converted JSON object
+ * @return nlohmann::ordered_json The converted JSON object
  */
 // Detect array-shape ObjectMap: every key is "0","1",...,"N-1" with no
 // gaps. Such maps were created from JSON arrays (jsonToValueWithContext)
@@ -160,10 +136,10 @@ static bool isArrayShape(const Symbols::ObjectMap& m) {
     return true;
 }
 
-nlohmann::json convertMapToJson(const Symbols::ObjectMap& objMap) {
-    nlohmann::json result = isArrayShape(objMap) ? nlohmann::json::array()
-                                                 : nlohmann::json::object();
-    auto put = [&](const std::string& key, nlohmann::json v) {
+nlohmann::ordered_json convertMapToJson(const Symbols::ObjectMap& objMap) {
+    nlohmann::ordered_json result = isArrayShape(objMap) ? nlohmann::ordered_json::array()
+                                                 : nlohmann::ordered_json::object();
+    auto put = [&](const std::string& key, nlohmann::ordered_json v) {
         if (result.is_array()) result.push_back(std::move(v));
         else                   result[key] = std::move(v);
     };
@@ -208,7 +184,7 @@ nlohmann::json convertMapToJson(const Symbols::ObjectMap& objMap) {
 
             case Symbols::Variables::Type::OBJECT:
             case Symbols::Variables::Type::CLASS:
-                put(key, convertMapToJson(value.get<Symbols::ObjectMap>()));
+                put(key, valueToJsonWithContext(value, ""));
                 break;
 
             case Symbols::Variables::Type::ENUM:
@@ -228,7 +204,7 @@ nlohmann::json convertMapToJson(const Symbols::ObjectMap& objMap) {
 
 } // anonymous namespace
 
-nlohmann::json valueToJson(const Symbols::ValuePtr& value) {
+nlohmann::ordered_json valueToJson(const Symbols::ValuePtr& value) {
     // No null guard here on purpose. `if (!value)` would use ValuePtr::operator bool(),
     // which reports the VALUE's truthiness - so it rejected 0, "" and false - and throws
     // outright on a genuinely null value. The switch below already maps NULL_TYPE to
@@ -236,11 +212,11 @@ nlohmann::json valueToJson(const Symbols::ValuePtr& value) {
     return valueToJsonWithContext(value, "");
 }
 
-Symbols::ValuePtr jsonToValue(const nlohmann::json& json) {
+Symbols::ValuePtr jsonToValue(const nlohmann::ordered_json& json) {
     return jsonToValueWithContext(json, "");
 }
 
-nlohmann::json valueToJsonWithContext(const Symbols::ValuePtr& value, const std::string& context) {
+nlohmann::ordered_json valueToJsonWithContext(const Symbols::ValuePtr& value, const std::string& context) {
     // See valueToJson: no `if (!value)` guard - NULL_TYPE is handled by the switch.
     Symbols::Variables::Type type = value.getType();
 
@@ -265,6 +241,13 @@ nlohmann::json valueToJsonWithContext(const Symbols::ValuePtr& value, const std:
 
         case Symbols::Variables::Type::OBJECT:
         case Symbols::Variables::Type::CLASS:
+            if (value->isArray()) {
+                nlohmann::ordered_json result = nlohmann::ordered_json::array();
+                for (const auto & element : value.get<Symbols::ArrayVector>()) {
+                    result.push_back(valueToJsonWithContext(element, context));
+                }
+                return result;
+            }
             return convertMapToJson(value.get<Symbols::ObjectMap>());
 
         case Symbols::Variables::Type::ENUM:
@@ -275,7 +258,7 @@ nlohmann::json valueToJsonWithContext(const Symbols::ValuePtr& value, const std:
     }
 }
 
-Symbols::ValuePtr jsonToValueWithContext(const nlohmann::json& json, const std::string& context) {
+Symbols::ValuePtr jsonToValueWithContext(const nlohmann::ordered_json& json, const std::string& context) {
     if (json.is_null()) {
         return Symbols::ValuePtr::null(Symbols::Variables::Type::NULL_TYPE);
     } else if (json.is_boolean()) {
@@ -289,31 +272,13 @@ Symbols::ValuePtr jsonToValueWithContext(const nlohmann::json& json, const std::
     } else if (json.is_string()) {
         return Symbols::ValuePtr(json.get<std::string>());
     } else if (json.is_array()) {
-        // Convert JSON array to ObjectMap with numeric string keys
-        Symbols::ObjectMap arrayMap;
-        for (size_t i = 0; i < json.size(); ++i) {
-            const std::string indexKey = std::to_string(i);
-            const nlohmann::json& element = json[i];
-
-            if (element.is_null()) {
-                arrayMap[indexKey] = Symbols::ValuePtr::null(Symbols::Variables::Type::NULL_TYPE);
-            } else if (element.is_boolean()) {
-                arrayMap[indexKey] = Symbols::ValuePtr(element.get<bool>());
-            } else if (element.is_number_integer()) {
-                arrayMap[indexKey] = Symbols::ValuePtr(static_cast<int>(element.get<int64_t>()));
-            } else if (element.is_number_unsigned()) {
-                arrayMap[indexKey] = Symbols::ValuePtr(static_cast<int>(element.get<uint64_t>()));
-            } else if (element.is_number_float()) {
-                arrayMap[indexKey] = Symbols::ValuePtr(element.get<double>());
-            } else if (element.is_string()) {
-                arrayMap[indexKey] = Symbols::ValuePtr(element.get<std::string>());
-            } else if (element.is_object()) {
-                arrayMap[indexKey] = jsonToValueWithContext(element, context);
-            } else if (element.is_array()) {
-                arrayMap[indexKey] = jsonToValueWithContext(element, context);
-            }
+        // JSON arrays decode straight into a dense array.
+        Symbols::ArrayVector elements;
+        elements.reserve(json.size());
+        for (const auto & element : json) {
+            elements.push_back(jsonToValueWithContext(element, context));
         }
-        return Symbols::ValuePtr(arrayMap);
+        return Symbols::ValuePtr(std::move(elements));
     } else if (json.is_object()) {
         return Symbols::ValuePtr(convertJsonObjectToMap(json, context));
     } else {
@@ -343,7 +308,7 @@ bool canConvertToJson(const Symbols::ValuePtr& value) {
     }
 }
 
-bool canConvertToValue(const nlohmann::json& json) {
+bool canConvertToValue(const nlohmann::ordered_json& json) {
     return json.is_null() || json.is_boolean() || json.is_number() ||
            json.is_string() || json.is_array() || json.is_object();
 }
@@ -16,47 +16,47 @@
 namespace Modules {
 
 /**
- * @brief Namespace containing conversion functions between VoidScript ValuePtr and nlohmann::json objects
+ * @brief Namespace containing conversion functions between VoidScript ValuePtr and nlohmann::ordered_json objects
  */
 namespace JsonConverters {
 
 /**
- * @brief Converts a VoidScript ValuePtr to nlohmann::json
+ * @brief Converts a VoidScript ValuePtr to nlohmann::ordered_json
  *
  * @param value The VoidScript ValuePtr to convert
- * @return nlohmann::json The converted JSON object
+ * @return nlohmann::ordered_json The converted JSON object
  * @throws std::runtime_error If conversion fails due to unsupported type or error
  */
-nlohmann::json valueToJson(const Symbols::ValuePtr & value);
+nlohmann::ordered_json valueToJson(const Symbols::ValuePtr & value);
 
 /**
- * @brief Converts an nlohmann::json to VoidScript ValuePtr
+ * @brief Converts an nlohmann::ordered_json to VoidScript ValuePtr
  *
- * @param json The nlohmann::json object to convert
+ * @param json The nlohmann::ordered_json object to convert
  * @return Symbols::ValuePtr The converted VoidScript value
  * @throws std::runtime_error If conversion fails due to unsupported type or error
  */
-Symbols::ValuePtr jsonToValue(const nlohmann::json & json);
+Symbols::ValuePtr jsonToValue(const nlohmann::ordered_json & json);
 
 /**
- * @brief Converts a VoidScript ValuePtr to nlohmann::json with error context
+ * @brief Converts a VoidScript ValuePtr to nlohmann::ordered_json with error context
  *
  * @param value The VoidScript ValuePtr to convert
  * @param context Error context string for better error messages
- * @return nlohmann::json The converted JSON object
+ * @return nlohmann::ordered_json The converted JSON object
  * @throws std::runtime_error If conversion fails with detailed error information
  */
-nlohmann::json valueToJsonWithContext(const Symbols::ValuePtr & value, const std::string & context = "");
+nlohmann::ordered_json valueToJsonWithContext(const Symbols::ValuePtr & value, const std::string & context = "");
 
 /**
- * @brief Converts an nlohmann::json to VoidScript ValuePtr with error context
+ * @brief Converts an nlohmann::ordered_json to VoidScript ValuePtr with error context
  *
- * @param json The nlohmann::json object to convert
+ * @param json The nlohmann::ordered_json object to convert
  * @param context Error context string for better error messages
  * @return Symbols::ValuePtr The converted VoidScript value
  * @throws std::runtime_error If conversion fails with detailed error information
  */
-Symbols::ValuePtr jsonToValueWithContext(const nlohmann::json & json, const std::string & context = "");
+Symbols::ValuePtr jsonToValueWithContext(const nlohmann::ordered_json & json, const std::string & context = "");
 
 /**
  * @brief Validates if a VoidScript ValuePtr can be converted to JSON
@@ -68,13 +68,13 @@ Symbols::ValuePtr jsonToValueWithContext(const nlohmann::json & json, const std:
 bool canConvertToJson(const Symbols::ValuePtr & value);
 
 /**
- * @brief Validates if an nlohmann::json can be converted to VoidScript ValuePtr
+ * @brief Validates if an nlohmann::ordered_json can be converted to VoidScript ValuePtr
  *
  * @param json The JSON object to validate
  * @return true If the JSON can be converted to VoidScript
  * @return false If the JSON cannot be converted to VoidScript
  */
-bool canConvertToValue(const nlohmann::json & json);
+bool canConvertToValue(const nlohmann::ordered_json & json);
 
 }  // namespace JsonConverters
 
@@ -25,7 +25,7 @@ Symbols::ValuePtr JsonModule::JsonDecode(const Symbols::FunctionArguments & args
 
     try {
         // Use nlohmann's robust JSON parser to parse the string
-        nlohmann::json jsonData = nlohmann::json::parse(s);
+        nlohmann::ordered_json jsonData = nlohmann::ordered_json::parse(s);
 
         // Convert the parsed JSON to a VoidScript ValuePtr using the existing converter
         return Modules::JsonConverters::jsonToValueWithContext(jsonData, "json_decode");
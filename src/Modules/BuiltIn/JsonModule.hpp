@@ -41,8 +41,8 @@ class JsonModule : public BaseModule {
                               }
 
                               try {
-                                  // Use the JsonConverters library to convert ValuePtr to nlohmann::json
-                                  nlohmann::json jsonData = Modules::JsonConverters::valueToJson(args.at(0));
+                                  // Use the JsonConverters library to convert ValuePtr to nlohmann::ordered_json
+                                  nlohmann::ordered_json jsonData = Modules::JsonConverters::valueToJson(args.at(0));
 
                                   // Serialize to string using nlohmann's robust serialization
                                   return Symbols::ValuePtr(jsonData.dump());
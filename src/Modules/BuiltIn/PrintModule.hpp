@@ -4,7 +4,9 @@
 
 #include <iostream>
 #include <cstdlib>
+#include <string>
 
+#include "Interpreter/Output.hpp"
 #include "Modules/BaseModule.hpp"
 #include "Symbols/Value.hpp"
 #include "Symbols/RegistrationMacros.hpp"
@@ -47,6 +49,18 @@ class PrintModule : public BaseModule {
         REGISTER_FUNCTION("print", Symbols::Variables::Type::NULL_TYPE, params, "Output any to the standard output",
                           &PrintModule::Print);
 
+        REGISTER_FUNCTION("ob_start", Symbols::Variables::Type::NULL_TYPE, {},
+                          "Collect the output in a buffer until ob_get_clean(); buffers nest",
+                          &PrintModule::ObStart);
+
+        REGISTER_FUNCTION("ob_get_clean", Symbols::Variables::Type::STRING, {},
+                          "Close the innermost output buffer and return what it collected",
+                          &PrintModule::ObGetClean);
+
+        REGISTER_FUNCTION("flush", Symbols::Variables::Type::NULL_TYPE, {},
+                          "Send the output written so far (outside output buffers) to the terminal or client",
+                          &PrintModule::Flush);
+
         params = {
             { "exit_code", Symbols::Variables::Type::INTEGER, "The exit code to return to the operating system" }
         };
@@ -64,25 +78,55 @@ class PrintModule : public BaseModule {
     }
 
     static Symbols::ValuePtr Error(const FunctionArguments & args) {
+        std::ostream & err = Interpreter::Output::err();
         for (const auto & v : args) {
-            std::cerr << v.toString();  // we will print everything here we don't care about the type
+            err << v.toString();  // we will print everything here we don't care about the type
         }
-        std::cerr << "\n";
+        err << "\n";
         return Symbols::ValuePtr::null();
     }
 
     static Symbols::ValuePtr PrintNL(const FunctionArguments & args) {
+        std::ostream & out = Interpreter::Output::out();
         for (const auto & v : args) {
-            std::cout << v.toString();
+            out << v.toString();
         }
-        std::cout << "\n" << std::flush;
+        out << "\n" << std::flush;
         return Symbols::ValuePtr::null();
     }
 
     static Symbols::ValuePtr Print(const FunctionArguments & args) {
+        std::ostream & out = Interpreter::Output::out();
         for (const auto & v : args) {
-            std::cout << v.toString();
+            out << v.toString();
+        }
+        return Symbols::ValuePtr::null();
+    }
+
+    static Symbols::ValuePtr ObStart(const FunctionArguments & args) {
+        if (!args.empty()) {
+            throw Exception("ob_start expects no arguments");
+        }
+        Interpreter::Output::startBuffer();
+        return Symbols::ValuePtr::null();
+    }
+
+    static Symbols::ValuePtr ObGetClean(const FunctionArguments & args) {
+        if (!args.empty()) {
+            throw Exception("ob_get_clean expects no arguments");
+        }
+        std::string contents;
+        if (!Interpreter::Output::endBuffer(contents)) {
+            throw Exception("ob_get_clean: no output buffer is open");
+        }
+        return contents;
+    }
+
+    static Symbols::ValuePtr Flush(const FunctionArguments & args) {
+        if (!args.empty()) {
+            throw Exception("flush expects no arguments");
         }
+        Interpreter::Output::flush();
         return Symbols::ValuePtr::null();
     }
 
@@ -2,6 +2,9 @@
 #ifndef MODULES_VARIABLEHELPERSMODULE_HPP
 #define MODULES_VARIABLEHELPERSMODULE_HPP
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <stdexcept>
 #include <string>
 
@@ -11,6 +14,7 @@
 #include "Symbols/SymbolContainer.hpp"
 #include "Symbols/Value.hpp"
 #include "Symbols/VariableTypes.hpp"
+#include "TemplateCache.hpp"
 
 namespace Modules {
 
@@ -73,6 +77,18 @@ class VariableHelpersModule : public BaseModule {
 
                     // Try to get object map for iteration
                     try {
+                        if (value->isArray()) {
+                            const auto & elements = value->get<Symbols::ArrayVector>();
+                            for (size_t index = 0; index < elements.size(); ++index) {
+                                result += indent + "  [" + std::to_string(index) + "] => \n";
+                                result += var_dump_recursive(elements[index], indent_level + 2, max_depth);
+                            }
+                            if (elements.empty()) {
+                                result += indent + "  [empty]\n";
+                            }
+                            result += indent + "}\n";
+                            break;
+                        }
                         const auto & obj_map = value->get<Symbols::ObjectMap>();
                         if (!obj_map.empty()) {
                             // Check if this looks like an array (all numeric keys)
@@ -151,6 +167,45 @@ class VariableHelpersModule : public BaseModule {
                               std::vector<Symbols::ValuePtr> forwarded(args.begin() + 1, args.end());
                               return Interpreter::Interpreter::callUserFunction(name, forwarded);
                           });
+        Symbols::SymbolContainer::instance()->markReentrant("call_user_func");
+
+        // vm_stats(): call-frame counters of the interpreter, to check that deep or long
+        // runs release their frames (frames_live and scopes stay flat).
+        REGISTER_FUNCTION("vm_stats", Symbols::Variables::Type::OBJECT, {},
+                          "Get call-frame counters: frames_entered, frames_allocated, frames_live, "
+                          "frames_pooled and scopes",
+                          [](const Symbols::FunctionArguments & /*args*/) -> Symbols::ValuePtr {
+                              const auto stats = Symbols::SymbolContainer::instance()->frameStats();
+                              // Script integers are int; a long-lived worker saturates rather than wraps.
+                              auto count = [](std::uint64_t n) {
+                                  return Symbols::ValuePtr(static_cast<int>(
+                                      std::min<std::uint64_t>(n, std::numeric_limits<int>::max())));
+                              };
+                              Symbols::ObjectMap out;
+                              out["frames_entered"]   = count(stats.entered);
+                              out["frames_allocated"] = count(stats.allocated);
+                              out["frames_live"]      = count(stats.live);
+                              out["frames_pooled"]    = count(stats.pooled);
+                              out["scopes"]           = count(stats.scopes);
+                              return Symbols::ValuePtr(out);
+                          });
+
+        // template_cache_stats(): the parsed-template cache of the calling thread in a
+        // long-lived process (the FastCGI server); all zero where nothing enables it.
+        REGISTER_FUNCTION("template_cache_stats", Symbols::Variables::Type::OBJECT, {},
+                          "Get template cache counters: hits, misses and entries",
+                          [](const Symbols::FunctionArguments & /*args*/) -> Symbols::ValuePtr {
+                              const TemplateCache & cache = TemplateCache::instance();
+                              auto count = [](std::uint64_t n) {
+                                  return Symbols::ValuePtr(static_cast<int>(
+                                      std::min<std::uint64_t>(n, std::numeric_limits<int>::max())));
+                              };
+                              Symbols::ObjectMap out;
+                              out["hits"]    = count(cache.hits());
+                              out["misses"]  = count(cache.misses());
+                              out["entries"] = count(cache.size());
+                              return Symbols::ValuePtr(out);
+                          });
 
         std::vector<Symbols::FunctionParameterInfo> param_list = {
             { "string", Symbols::Variables::Type::STRING, "The string to calculate the length of", false, false },
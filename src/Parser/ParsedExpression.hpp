@@ -17,7 +17,7 @@ struct ParsedExpression;
 using ParsedExpressionPtr = std::shared_ptr<ParsedExpression>;
 
 struct ParsedExpression {
-    enum class Kind : std::uint8_t { Literal, Variable, Binary, Unary, Ternary, Call, MethodCall, New, Object, Member, EnumAccess, Unknown };
+    enum class Kind : std::uint8_t { Literal, Variable, Binary, Unary, Ternary, Call, MethodCall, New, Object, Member, EnumAccess, Interpolation, Unknown };
 
     static std::string kindToString(ParsedExpression::Kind kind) {
         const std::unordered_map<Kind, std::string> kindstringmap = {
@@ -32,6 +32,7 @@ struct ParsedExpression {
             { Kind::Object,     "Object"     },
             { Kind::Member,     "Member"     },
             { Kind::EnumAccess, "EnumAccess" },
+            { Kind::Interpolation, "Interpolation" },
             { Kind::Unknown,    "Unknown"    }
         };
 
@@ -213,6 +214,18 @@ struct ParsedExpression {
         return expr;
     }
 
+    // Constructor for an interpolated string literal: its text and references in order, in args
+    static ParsedExpressionPtr makeInterpolation(std::vector<ParsedExpressionPtr> parts, const std::string & filename,
+                                                 int line, size_t column) {
+        auto expr      = std::make_shared<ParsedExpression>();
+        expr->kind     = Kind::Interpolation;
+        expr->args     = std::move(parts);
+        expr->filename = filename;
+        expr->line     = line;
+        expr->column   = column;
+        return expr;
+    }
+
     Symbols::Variables::Type getType() const {
         switch (kind) {
             case Kind::Literal:
@@ -283,6 +296,9 @@ struct ParsedExpression {
                 // Enum values should have ENUM type for type checking
                 return Symbols::Variables::Type::ENUM;
 
+            case Kind::Interpolation:
+                return Symbols::Variables::Type::STRING;
+
             default:
                 throw std::runtime_error("Unknown expression kind");
         }
@@ -358,6 +374,14 @@ struct ParsedExpression {
                 return objectMembers[0].second->toString() + "->" + objectMembers[0].first;
             case Kind::EnumAccess:
                 return name + "." + op; // name is enum name, op is value name
+            case Kind::Interpolation:
+                {
+                    std::string result = "\"";
+                    for (const auto & part : args) {
+                        result += "${" + part->toString() + "}";
+                    }
+                    return result + "\"";
+                }
             default:
                 return "Unknown expression kind";
         }
@@ -5,6 +5,7 @@
 #include <stack>
 
 #include "Interpreter/ExpressionBuilder.hpp"
+#include "Interpreter/LocalResolver.hpp"
 #include "Interpreter/Nodes/Expression/ArrayAccessExpressionNode.hpp"
 #include "Interpreter/Nodes/Statement/AssignmentStatementNode.hpp"
 #include "Interpreter/Nodes/Statement/IndexedAssignmentStatementNode.hpp"
@@ -34,7 +35,7 @@
 namespace Parser {
 
 // Static filename for unified error reporting in Parser::Exception
-std::string Parser::Parser::Exception::current_filename_;
+thread_local std::string Parser::Parser::Exception::current_filename_;
 
 const std::unordered_map<std::string, Lexer::Tokens::Type> Parser::keywords = {
     { "if",       Lexer::Tokens::Type::KEYWORD_IF                   },
@@ -435,10 +436,8 @@ std::unique_ptr<Interpreter::StatementNode> Parser::parseForStatementNode() {
         --loop_depth_;
     auto iterableExprNode = buildExpressionFromParsed(iterableExpr);
 
-    // Pass loopScope (created at function start) to the ForStatementNode constructor
     auto forNode = std::make_unique<Interpreter::ForStatementNode>(
-        keyType, keyName, valName, std::move(iterableExprNode), std::move(body), currentScope,  // <-- Pass loopScope
-        this->current_filename_, forToken.line_number, forToken.column_number);
+        keyType, keyName, valName, std::move(iterableExprNode), std::move(body), this->current_filename_, forToken.line_number, forToken.column_number);
 
     return forNode;
 }
@@ -707,9 +706,24 @@ void Parser::parseFunctionDefinition() {
 
     parseBlockInNewScope(opening_brace_idx, func_name);
 
+    // Bind the body's locals to frame slots and work out what the body reaches outside
+    // them. A redefinition appends to the same operation list, so the whole list is
+    // resolved again.
+    const std::string body_scope_name = parent_scope_name + Symbols::SymbolContainer::SCOPE_SEPARATOR + func_name;
+    Interpreter::LocalResolver resolver(Symbols::AtomTable::intern(body_scope_name), param_infos);
+    for (const auto & op : Operations::Container::instance()->getAll(body_scope_name)) {
+        if (op->statement) {
+            op->statement->resolveLocals(resolver);
+        } else {
+            resolver.escapes();
+        }
+    }
+    resolver.finish();
+
     Interpreter::OperationsFactory::defineFunction(func_name, param_infos, func_return_type,
                                                 parent_scope_name,
-                                                this->current_filename_, id_token.line_number, id_token.column_number);
+                                                this->current_filename_, id_token.line_number, id_token.column_number,
+                                                resolver.reach());
 }
 
 // Parse a top-level class definition: class Name { ... }
@@ -725,6 +739,14 @@ void Parser::parseClassDefinition() {
     // Use :: as namespace separator
     const std::string classNs = fileNs + Symbols::SymbolContainer::SCOPE_SEPARATOR + className;
 
+    // A script class registered before this parser started comes from an earlier parse of a
+    // file run in the same process (the FastCGI server); this definition replaces it. A
+    // class defined twice in one script is still an error, reported by registerClass().
+    auto * sc = Symbols::SymbolContainer::instance();
+    if (!parsed_class_names_.count(className) && sc->hasClass(className) && !sc->getClassInfo(className).module) {
+        sc->removeClass(className);
+    }
+
     // Track this class name for parseType to recognize it as CLASS type
     parsed_class_names_.insert(className);
     parsed_class_names_.insert(classNs);  // Also add fully qualified name
@@ -1869,6 +1891,12 @@ void Parser::parseIncludeStatement() {
     // Construct the full path to the included file
     std::string fullPath = baseDir + "/" + filename;
 
+    // Stamp the file before reading it, so a cached template that included it is parsed
+    // again once it changes. One that cannot be examined keeps an empty stamp that never
+    // matches.
+    includes_.push_back({ fullPath, {}, 0 });
+    TemplateCache::stamp(includes_.back());
+
     // Read the contents of the included file
     std::ifstream file(fullPath);
     if (!file.is_open()) {
@@ -5,6 +5,7 @@
 #include <vector>
 #include <set>
 #include <stack>
+#include <utility>
 
 #include "BaseException.hpp"
 #include "Interpreter/StatementNode.hpp"
@@ -14,6 +15,7 @@
 #include "Symbols/ParameterContainer.hpp"
 #include "Symbols/Value.hpp"
 #include "Symbols/SymbolContainer.hpp"
+#include "TemplateCache.hpp"
 
 namespace Parser {
 
@@ -25,7 +27,7 @@ class Parser {
       public:
         using BaseException::BaseException;
         // Filename for error reporting
-        static std::string current_filename_;
+        static thread_local std::string current_filename_;
 
         Exception(const std::string & msg, const std::string & expected, const Lexer::Tokens::Token & token) {
             rawMessage_ = msg + ": " + token.dump();
@@ -60,6 +62,12 @@ class Parser {
     static const std::unordered_map<std::string, Lexer::Tokens::Type>              keywords;
     static const std::unordered_map<Lexer::Tokens::Type, Symbols::Variables::Type> variable_types;
 
+    /**
+     * @brief The files `include` statements read since the last call, each stamped before it
+     * was read (see TemplateCache::Template::includes).
+     */
+    std::vector<TemplateCache::Source> takeIncludes() { return std::exchange(includes_, {}); }
+
     // Helper method to parse a statement body enclosed in { }
     std::vector<std::unique_ptr<Interpreter::StatementNode>> parseStatementBody(const std::string & errorContext);
 
@@ -70,6 +78,7 @@ class Parser {
     std::string                       current_filename_;
     std::set<std::string>             parsed_class_names_;  // Track class names encountered during parsing
     std::set<std::string>             parsed_enum_names_;   // Track enum names encountered during parsing
+    std::vector<TemplateCache::Source> includes_;           // Files read by include statements
 
     // Validation functions
     void validateTokenStream();
@@ -10,8 +10,8 @@
 namespace Parser {
 
 /**
- * @brief Splits a double-quoted string literal into a concatenation of literal text
- *        and the variables interpolated into it.
+ * @brief Splits a double-quoted string literal into the literal text and the variables
+ *        interpolated into it, for an InterpolatedStringNode to join.
  *
  * Works from the token's raw lexeme rather than its processed value, because by the
  * time the lexer has resolved escapes an escaped `\$` is indistinguishable from a real
@@ -156,13 +156,10 @@ inline ParsedExpressionPtr interpolate(std::string_view rawWithQuotes, const std
         parts.push_back(ParsedExpression::makeLiteral(Symbols::ValuePtr(unescape(literal))));
     }
 
-    // Start from an empty string so a literal that is nothing but a reference still
-    // produces a string, e.g. "$n" with an int $n yields "42" rather than 42.
-    auto expr = ParsedExpression::makeLiteral(Symbols::ValuePtr(std::string{}));
-    for (auto & part : parts) {
-        expr = ParsedExpression::makeBinary("+", std::move(expr), std::move(part), filename, line, column);
-    }
-    return expr;
+    // One node for the whole literal: it sizes the result once instead of building a
+    // temporary string per '+'. A literal that is nothing but a reference still produces
+    // a string, e.g. "$n" with an int $n yields "42" rather than 42.
+    return ParsedExpression::makeInterpolation(std::move(parts), filename, line, column);
 }
 
 }  // namespace interpolation
@@ -0,0 +1,94 @@
+#ifndef SYMBOLS_ATOM_HPP
+#define SYMBOLS_ATOM_HPP
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Symbols {
+
+/**
+ * @brief Interned string id.
+ *
+ * Identifiers, symbol names and namespace names are interned once (by the parser when it
+ * builds a node, by a Symbol when it is constructed) and from then on compared and hashed
+ * as a 32-bit integer. Atom 0 is the empty string; kNoAtom means "never interned", which
+ * lets a lookup by a string nobody has defined fail without growing the table.
+ */
+using Atom = std::uint32_t;
+
+inline constexpr Atom kNoAtom = static_cast<Atom>(-1);
+
+/**
+ * @brief Process-wide atom table. Atoms are never freed, so ids and the strings behind
+ * them stay valid for the lifetime of the process.
+ */
+class AtomTable {
+  public:
+    /** @brief Return the atom for @p text, interning it on first use. */
+    static Atom intern(std::string_view text) {
+        AtomTable & table = instance();
+        {
+            std::shared_lock lock(table.mutex_);
+            auto             it = table.ids_.find(text);
+            if (it != table.ids_.end()) {
+                return it->second;
+            }
+        }
+        std::unique_lock lock(table.mutex_);
+        auto             it = table.ids_.find(text);
+        if (it != table.ids_.end()) {
+            return it->second;
+        }
+        return table.intern_unlocked(text);
+    }
+
+    /** @brief Return the atom for @p text, or kNoAtom if it was never interned. */
+    static Atom find(std::string_view text) {
+        AtomTable &      table = instance();
+        std::shared_lock lock(table.mutex_);
+        auto             it = table.ids_.find(text);
+        return it == table.ids_.end() ? kNoAtom : it->second;
+    }
+
+    /** @brief The string an atom stands for. */
+    static const std::string & name(Atom atom) {
+        AtomTable &      table = instance();
+        std::shared_lock lock(table.mutex_);
+        return table.names_.at(atom);
+    }
+
+    static size_t size() {
+        AtomTable &      table = instance();
+        std::shared_lock lock(table.mutex_);
+        return table.names_.size();
+    }
+
+  private:
+    AtomTable() { intern_unlocked(""); }
+
+    static AtomTable & instance() {
+        static AtomTable table;
+        return table;
+    }
+
+    Atom intern_unlocked(std::string_view text) {
+        const Atom          atom   = static_cast<Atom>(names_.size());
+        const std::string & stored = names_.emplace_back(text);
+        ids_.emplace(std::string_view(stored), atom);
+        return atom;
+    }
+
+    // A deque never moves its elements, so the views used as keys stay valid.
+    std::deque<std::string>                     names_;
+    std::unordered_map<std::string_view, Atom> ids_;
+    mutable std::shared_mutex                   mutex_;
+};
+
+}  // namespace Symbols
+
+#endif  // SYMBOLS_ATOM_HPP
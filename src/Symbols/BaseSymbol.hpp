@@ -6,6 +6,7 @@
 #include <string>
 #include <utility>
 
+#include "Atom.hpp"
 #include "SymbolKind.hpp"
 #include "Symbols/VariableTypes.hpp"
 #include "Value.hpp"
@@ -15,6 +16,7 @@ namespace Symbols {
 class Symbol {
   protected:
     std::string   name_;
+    Atom          nameAtom_;
     ValuePtr      value_;
     std::string   context_;  // ns
     Symbols::Kind kind_;
@@ -22,6 +24,7 @@ class Symbol {
   public:
     Symbol(const std::string & name, ValuePtr value, const std::string & context, Symbols::Kind type) :
         name_(name),
+        nameAtom_(AtomTable::intern(name)),
         value_(value),
         context_(context),
         kind_(type) {}
@@ -32,6 +35,8 @@ class Symbol {
 
     const std::string & name() const { return name_; }
 
+    Atom nameAtom() const { return nameAtom_; }
+
     const std::string & context() const { return context_; }
 
     Symbols::Kind getKind() const { return kind_; }
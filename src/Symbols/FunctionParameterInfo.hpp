@@ -1,6 +1,7 @@
 #ifndef SYMBOLS_FUNCTION_PARAMETER_INFO_HPP
 #define SYMBOLS_FUNCTION_PARAMETER_INFO_HPP
 
+#include <memory>
 #include <string>
 #include "Symbols/VariableTypes.hpp"
 
@@ -2,9 +2,12 @@
 #ifndef FUNCTION_SYMBOL_HPP
 #define FUNCTION_SYMBOL_HPP
 
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "BaseSymbol.hpp"
+#include "Symbols/Atom.hpp"
 #include "Lexer/Token.hpp"
 #include "Symbols/ParameterContainer.hpp"
 #include "Symbols/VariableTypes.hpp"
@@ -12,12 +15,24 @@
 
 namespace Symbols {
 
+/**
+ * @brief What a script function's body may do beyond its own frames, as the local
+ * resolver found it when the function was parsed (see Interpreter::LocalResolver::reach()).
+ */
+struct FunctionReach {
+    bool                     known    = false;  // false: anything at all
+    std::vector<Atom>        names;             // variables it may look up in a caller's scopes
+    std::vector<std::string> calls;             // functions it calls by name
+    bool                     nullable = true;   // a return may give null
+};
+
 class FunctionSymbol : public Symbol {
     // store the variables name and type
     std::vector<FunctionParameterInfo> parameters_;
     Symbols::Variables::Type          returnType_;
     std::string                       plainBody_;
     std::vector<Lexer::Tokens::Token> tokens_;
+    std::shared_ptr<const FunctionReach> reach_;
 
   public:
     FunctionSymbol(const std::string & name, const std::string & context, const std::vector<FunctionParameterInfo> & parameters,
@@ -36,6 +51,11 @@ class FunctionSymbol : public Symbol {
 
     const std::string & plainBody() const { return plainBody_; }
 
+    /** @brief What the body may touch outside its frames; nullptr if it was not resolved. */
+    const FunctionReach * reach() const { return reach_.get(); }
+
+    void setReach(std::shared_ptr<const FunctionReach> reach) { reach_ = std::move(reach); }
+
     // Dump function symbol: name, context, and declared return type
     std::string dump() const override {
         std::string r = "\t\t  " + kindToString(this->kind_) + " name: '" + name_ + "' \n\t\t\tContext: " + context_;
@@ -0,0 +1,264 @@
+#ifndef SYMBOLS_ORDEREDMAP_HPP
+#define SYMBOLS_ORDEREDMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace Symbols {
+
+/**
+ * @brief Insertion-ordered string-keyed hash map, the storage behind ObjectMap.
+ *
+ * Entries live in one dense vector in insertion order, so iteration is a linear walk
+ * and objects, JSON and var_dump come out in the order the script wrote them. Lookups
+ * go through an open-addressing index (linear probing, power-of-two table) of entry
+ * positions; maps of up to kLinearLimit entries skip the index and scan, which is what
+ * most script objects are. Keys are looked up by std::string_view, so callers never
+ * build a std::string just to probe.
+ *
+ * The interface is the subset of std::map that the interpreter and the modules use.
+ * Two differences matter:
+ *  - Like std::vector, an insert may invalidate references and iterators into the map.
+ *    Do not hold a reference from operator[] across another insert.
+ *  - erase() is O(n): it closes the gap to keep the order and rebuilds the index.
+ */
+template <typename T> class OrderedMap {
+  public:
+    using key_type       = std::string;
+    using mapped_type    = T;
+    using value_type     = std::pair<std::string, T>;
+    using size_type      = std::size_t;
+    using iterator       = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+    OrderedMap() = default;
+
+    OrderedMap(std::initializer_list<value_type> init) {
+        reserve(init.size());
+        for (const auto & entry : init) {
+            insert(entry);
+        }
+    }
+
+    template <typename InputIt> OrderedMap(InputIt first, InputIt last) { insert(first, last); }
+
+    iterator       begin() noexcept { return entries_.begin(); }
+    iterator       end() noexcept { return entries_.end(); }
+    const_iterator begin() const noexcept { return entries_.begin(); }
+    const_iterator end() const noexcept { return entries_.end(); }
+    const_iterator cbegin() const noexcept { return entries_.cbegin(); }
+    const_iterator cend() const noexcept { return entries_.cend(); }
+
+    size_type size() const noexcept { return entries_.size(); }
+    bool      empty() const noexcept { return entries_.empty(); }
+
+    void reserve(size_type n) {
+        entries_.reserve(n);
+        if (n > kLinearLimit) {
+            rehash(n);
+        }
+    }
+
+    void clear() noexcept {
+        entries_.clear();
+        slots_.clear();
+    }
+
+    void swap(OrderedMap & other) noexcept {
+        entries_.swap(other.entries_);
+        slots_.swap(other.slots_);
+    }
+
+    iterator find(std::string_view key) {
+        const size_type pos = locate(key);
+        return pos == npos ? entries_.end() : entries_.begin() + static_cast<std::ptrdiff_t>(pos);
+    }
+
+    const_iterator find(std::string_view key) const {
+        const size_type pos = locate(key);
+        return pos == npos ? entries_.end() : entries_.begin() + static_cast<std::ptrdiff_t>(pos);
+    }
+
+    /**
+     * @brief Position of @p key in insertion order, or npos. The position @p hint is tried
+     * before the index: maps filled in the same order (instances of one class) keep a key
+     * at the same position, so a caller that remembers where it last found a key usually
+     * skips the lookup.
+     */
+    size_type position(std::string_view key, size_type hint = npos) const {
+        if (hint < entries_.size() && entries_[hint].first == key) {
+            return hint;
+        }
+        return locate(key);
+    }
+
+    value_type &       entryAt(size_type pos) { return entries_[pos]; }
+    const value_type & entryAt(size_type pos) const { return entries_[pos]; }
+
+    size_type count(std::string_view key) const { return locate(key) == npos ? 0 : 1; }
+
+    bool contains(std::string_view key) const { return locate(key) != npos; }
+
+    T & at(std::string_view key) {
+        const size_type pos = locate(key);
+        if (pos == npos) {
+            throw std::out_of_range("OrderedMap::at: key not found: " + std::string(key));
+        }
+        return entries_[pos].second;
+    }
+
+    const T & at(std::string_view key) const {
+        const size_type pos = locate(key);
+        if (pos == npos) {
+            throw std::out_of_range("OrderedMap::at: key not found: " + std::string(key));
+        }
+        return entries_[pos].second;
+    }
+
+    T & operator[](std::string_view key) { return try_emplace(std::string(key)).first->second; }
+
+    T & operator[](const std::string & key) { return try_emplace(key).first->second; }
+
+    T & operator[](std::string && key) { return try_emplace(std::move(key)).first->second; }
+
+    T & operator[](const char * key) { return operator[](std::string_view(key)); }
+
+    template <typename K, typename... Args> std::pair<iterator, bool> try_emplace(K && key, Args &&... args) {
+        const size_type pos = locate(key);
+        if (pos != npos) {
+            return { entries_.begin() + static_cast<std::ptrdiff_t>(pos), false };
+        }
+        entries_.emplace_back(std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+                              std::forward_as_tuple(std::forward<Args>(args)...));
+        indexLast();
+        return { std::prev(entries_.end()), true };
+    }
+
+    template <typename K, typename M> std::pair<iterator, bool> insert_or_assign(K && key, M && value) {
+        auto result = try_emplace(std::forward<K>(key));
+        result.first->second = std::forward<M>(value);
+        return result;
+    }
+
+    std::pair<iterator, bool> insert(const value_type & entry) { return try_emplace(entry.first, entry.second); }
+
+    std::pair<iterator, bool> insert(value_type && entry) {
+        return try_emplace(std::move(entry.first), std::move(entry.second));
+    }
+
+    template <typename InputIt> void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            insert(*first);
+        }
+    }
+
+    template <typename... Args> std::pair<iterator, bool> emplace(Args &&... args) {
+        return insert(value_type(std::forward<Args>(args)...));
+    }
+
+    // The hint is ignored; new keys always go to the end.
+    template <typename... Args> iterator emplace_hint(const_iterator /*hint*/, Args &&... args) {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+
+    iterator erase(const_iterator pos) {
+        auto next = entries_.erase(pos);
+        rebuildIndex();
+        return next;
+    }
+
+    size_type erase(std::string_view key) {
+        const size_type pos = locate(key);
+        if (pos == npos) {
+            return 0;
+        }
+        erase(entries_.cbegin() + static_cast<std::ptrdiff_t>(pos));
+        return 1;
+    }
+
+  private:
+    static constexpr size_type kLinearLimit = 8;
+
+    std::vector<value_type>    entries_;
+    // Open-addressing table of entry positions + 1 (0 marks an empty slot). Empty
+    // while the map is small enough to scan.
+    std::vector<std::uint32_t> slots_;
+
+    static size_type hashOf(std::string_view key) { return std::hash<std::string_view>{}(key); }
+
+    size_type locate(std::string_view key) const {
+        if (slots_.empty()) {
+            for (size_type i = 0; i < entries_.size(); ++i) {
+                if (entries_[i].first == key) {
+                    return i;
+                }
+            }
+            return npos;
+        }
+        const size_type mask = slots_.size() - 1;
+        for (size_type slot = hashOf(key) & mask;; slot = (slot + 1) & mask) {
+            const std::uint32_t stored = slots_[slot];
+            if (stored == 0) {
+                return npos;
+            }
+            if (entries_[stored - 1].first == key) {
+                return stored - 1;
+            }
+        }
+    }
+
+    void placeSlot(size_type pos) {
+        const size_type mask = slots_.size() - 1;
+        size_type       slot = hashOf(entries_[pos].first) & mask;
+        while (slots_[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots_[slot] = static_cast<std::uint32_t>(pos + 1);
+    }
+
+    // Index the entry just appended, growing the table to keep the load at most 1/2.
+    void indexLast() {
+        if (entries_.size() <= kLinearLimit && slots_.empty()) {
+            return;
+        }
+        if (entries_.size() * 2 > slots_.size()) {
+            rehash(entries_.size());
+            return;
+        }
+        placeSlot(entries_.size() - 1);
+    }
+
+    void rehash(size_type forEntries) {
+        size_type capacity = 16;
+        while (capacity < forEntries * 2) {
+            capacity *= 2;
+        }
+        slots_.assign(capacity, 0);
+        for (size_type i = 0; i < entries_.size(); ++i) {
+            placeSlot(i);
+        }
+    }
+
+    void rebuildIndex() {
+        if (entries_.size() <= kLinearLimit) {
+            slots_.clear();
+        } else {
+            rehash(entries_.size());
+        }
+    }
+};
+
+}  // namespace Symbols
+
+#endif  // SYMBOLS_ORDEREDMAP_HPP
@@ -2,6 +2,12 @@
 #include "Parser/ParsedExpression.hpp"  // For implementation methods using ParsedExpressionPtr
 #include "Modules/BaseModule.hpp"  // For module implementation methods
 
+#include <cstdint>
+
+#if defined(__linux__) || defined(__APPLE__)
+#    include <pthread.h>
+#endif
+
 namespace Modules {
     void BaseModuleDeleter::operator()(BaseModule* module) const {
         delete module;
@@ -13,8 +19,46 @@ namespace Modules {
 }
 
 namespace Symbols {
-    std::string SymbolContainer::initial_scope_name_for_singleton_;
-    bool SymbolContainer::is_initialized_for_singleton_ = false;
+    namespace {
+        // Native stack left below the deepest call: room for what a call level runs besides
+        // nested calls (module functions, regular expressions, error handling).
+        constexpr size_t kStackReserve = 512 * 1024;
+
+        // The lowest address of this thread's stack a call may start at, or 0 where the
+        // stack's bounds are unknown. The stack grows down on every supported target.
+        std::uintptr_t findStackFloor() {
+#if defined(__linux__)
+            pthread_attr_t attr;
+            if (pthread_getattr_np(pthread_self(), &attr) != 0) {
+                return 0;
+            }
+            void * low  = nullptr;
+            size_t size = 0;
+            const bool known = pthread_attr_getstack(&attr, &low, &size) == 0;
+            pthread_attr_destroy(&attr);
+#elif defined(__APPLE__)
+            const size_t size = pthread_get_stacksize_np(pthread_self());
+            void * low = static_cast<char *>(pthread_get_stackaddr_np(pthread_self())) - size;
+            const bool known = true;
+#else
+            void * low  = nullptr;
+            size_t size = 0;
+            const bool known = false;
+#endif
+            if (!known || low == nullptr || size < 2 * kStackReserve) {
+                return 0;
+            }
+            return reinterpret_cast<std::uintptr_t>(low) + std::max(kStackReserve, size / 16);
+        }
+
+        std::uintptr_t stackFloor() {
+            static thread_local const std::uintptr_t floor = findStackFloor();
+            return floor;
+        }
+    }  // namespace
+
+    thread_local std::string SymbolContainer::initial_scope_name_for_singleton_;
+    thread_local bool SymbolContainer::is_initialized_for_singleton_ = false;
 
     SymbolContainer::SymbolContainer(const std::string & default_scope_name) {
         if (default_scope_name.empty()) {
@@ -24,22 +68,97 @@ namespace Symbols {
     }
 
     void SymbolContainer::create(const std::string & name) {
-        scopes_[name] = std::make_shared<SymbolTable>(SCOPE_SEPARATOR);
-        scopeStack_.push_back(name);
+        auto table    = std::make_shared<SymbolTable>();
+        scopes_[name] = table;
+        ++definitionEpoch_;
+        scopeStack_.push_back(std::move(name));
+        tableStack_.push_back(std::move(table));
     }
 
     void SymbolContainer::enter(const std::string & name) {
         auto it = scopes_.find(name);
         if (it != scopes_.end()) {
             scopeStack_.push_back(name);
+            tableStack_.push_back(it->second);
         } else {
             throw std::runtime_error("Scope does not exist: " + name);
         }
     }
 
+    SymbolTable * SymbolContainer::enterFrame(const std::string & name, Atom frame) {
+        // Only calls can nest without bound; a loop scope is as deep as the source nests it.
+        const std::uintptr_t floor = stackFloor();
+        const char           here  = 0;
+        if (floor != 0 ? reinterpret_cast<std::uintptr_t>(&here) < floor : callDepth_ >= kFallbackCallDepth) {
+            throw std::runtime_error("Maximum call depth exceeded: " + std::to_string(callDepth_) +
+                                     " nested calls fill the native stack (infinite recursion?)");
+        }
+        std::string scope = pooledName();
+        scope.assign(name);
+        SymbolTable * table = pushFrame(std::move(scope), frame);
+        table->setCall(true);
+        ++callDepth_;
+        return table;
+    }
+
+    SymbolTable * SymbolContainer::enterLoopFrame(std::string_view suffix, Atom frame) {
+        std::string scope = pooledName();
+        scope.assign(scopeStack_.back());
+        scope.append(suffix);
+        return pushFrame(std::move(scope), frame);
+    }
+
+    std::string SymbolContainer::pooledName() {
+        if (framePoolNames_.empty()) {
+            return std::string();
+        }
+        std::string name = std::move(framePoolNames_.back());
+        framePoolNames_.pop_back();
+        return name;
+    }
+
+    SymbolTable * SymbolContainer::pushFrame(std::string name, Atom frame) {
+        std::shared_ptr<SymbolTable> table;
+        if (framePool_.empty()) {
+            table = std::make_shared<SymbolTable>();
+            table->setPooled(true);
+            ++frameStats_.allocated;
+        } else {
+            table = std::move(framePool_.back());
+            framePool_.pop_back();
+        }
+        table->setFrame(frame);
+        ++frameStats_.entered;
+        ++frameStats_.live;
+        scopeStack_.push_back(name);
+        tableStack_.push_back(std::move(table));
+        return tableStack_.back().get();
+    }
+
+    void SymbolContainer::popScope() {
+        std::shared_ptr<SymbolTable> table = std::move(tableStack_.back());
+        tableStack_.pop_back();
+        std::string name = std::move(scopeStack_.back());
+        scopeStack_.pop_back();
+        if (!table->pooled()) {
+            return;
+        }
+        if (table->call()) {
+            --callDepth_;
+        }
+        --frameStats_.live;
+        table->clearAll();
+        table->setFrame(kNoAtom);
+        table->setCall(false);
+        if (framePool_.size() < kMaxPooledFrames) {
+            framePool_.push_back(std::move(table));
+            framePoolNames_.push_back(std::move(name));
+        }
+    }
+
     void SymbolContainer::enterPreviousScope() {
         if (scopeStack_.size() > 1) {
-            scopeStack_.pop_back();
+            popScope();
         }
     }
 
@@ -48,15 +167,26 @@ namespace Symbols {
         auto it = std::find(scopeStack_.rbegin(), scopeStack_.rend(), expectedScope);
         if (it != scopeStack_.rend()) {
             // Remove everything above it
-            auto forward_it = it.base() - 1;
-            scopeStack_.erase(forward_it, scopeStack_.end());
+            const auto depth = static_cast<size_t>(it.base() - 1 - scopeStack_.begin());
+            while (scopeStack_.size() > depth) {
+                popScope();
+            }
         } else {
             if (!scopeStack_.empty()) {
-                scopeStack_.pop_back();
+                popScope();
             }
         }
     }
 
+    void SymbolContainer::unwindScopeStack(size_t depth) {
+        if (depth == 0) {
+            return;
+        }
+        while (scopeStack_.size() > depth) {
+            popScope();
+        }
+    }
+
     bool SymbolContainer::enterPreviousScopeWithValidation(const std::string & expectedCurrentScope) {
         if (scopeStack_.size() <= 1) {
             return false;
@@ -64,7 +194,7 @@ namespace Symbols {
         if (!expectedCurrentScope.empty() && currentScopeName() != expectedCurrentScope) {
             return false;
         }
-        scopeStack_.pop_back();
+        popScope();
         return true;
     }
 
@@ -89,12 +219,18 @@ namespace Symbols {
     }
 
     std::string SymbolContainer::enterFunctionCallScope(const std::string & baseFunctionScopeName) {
-        unsigned long long call_id = next_call_frame_id_++;
-        std::string callScopeName = baseFunctionScopeName + Symbols::SymbolContainer::CALL_SCOPE + std::to_string(call_id);
-        create(callScopeName);
+        std::string callScopeName = baseFunctionScopeName + Symbols::SymbolContainer::CALL_SCOPE;
+        enterFrame(callScopeName);
         return callScopeName;
     }
 
+    FrameStats SymbolContainer::frameStats() const {
+        FrameStats stats = frameStats_;
+        stats.pooled     = framePool_.size();
+        stats.scopes     = scopes_.size();
+        return stats;
+    }
+
     std::string SymbolContainer::add(const SymbolPtr & symbol) {
         switch (symbol->kind()) {
             case Symbols::Kind::Variable:
@@ -111,7 +247,7 @@ namespace Symbols {
                 return addEnum(symbol);
             default:
                 const std::string ns = getNamespaceForSymbol(symbol);
-                scopes_[currentScopeName()]->define(ns, symbol);
+                tableStack_.back()->define(ns, symbol);
                 return ns;
         }
     }
@@ -121,7 +257,8 @@ namespace Symbols {
             throw std::runtime_error("Symbol must be a function to use addFunction");
         }
         const std::string ns = DEFAULT_FUNCTIONS_SCOPE;
-        scopes_[currentScopeName()]->define(ns, function);
+        tableStack_.back()->define(ns, function);
+        ++definitionEpoch_;
         return ns;
     }
 
@@ -135,6 +272,7 @@ namespace Symbols {
         }
         const std::string ns = DEFAULT_FUNCTIONS_SCOPE;
         it->second->define(ns, function);
+        ++definitionEpoch_;
         return ns;
     }
 
@@ -143,7 +281,8 @@ namespace Symbols {
             throw std::runtime_error("Symbol must be a function or method to use addMethod");
         }
         const std::string ns = METHOD_SCOPE;
-        scopes_[currentScopeName()]->define(ns, method);
+        tableStack_.back()->define(ns, method);
+        ++classEpoch_;
         return ns;
     }
 
@@ -157,6 +296,7 @@ namespace Symbols {
         }
         const std::string ns = METHOD_SCOPE;
         it->second->define(ns, method);
+        ++classEpoch_;
         return ns;
     }
 
@@ -164,9 +304,8 @@ namespace Symbols {
         if (variable->kind() != Symbols::Kind::Variable) {
             throw std::runtime_error("Symbol must be a variable to use addVariable");
         }
-        const std::string current_scope = currentScopeName();
         const std::string ns = DEFAULT_VARIABLES_SCOPE;
-        scopes_[current_scope]->define(ns, variable);
+        tableStack_.back()->define(ns, variable);
         return ns;
     }
 
@@ -188,7 +327,7 @@ namespace Symbols {
             throw std::runtime_error("Symbol must be a constant to use addConstant");
         }
         const std::string ns = DEFAULT_CONSTANTS_SCOPE;
-        scopes_[currentScopeName()]->define(ns, constant);
+        tableStack_.back()->define(ns, constant);
         return ns;
     }
 
@@ -210,7 +349,7 @@ namespace Symbols {
             throw std::runtime_error("Symbol must be a class to use addClass");
         }
         const std::string ns = DEFAULT_VARIABLES_SCOPE;
-        scopes_[currentScopeName()]->define(ns, classSymbol);
+        tableStack_.back()->define(ns, classSymbol);
         return ns;
     }
 
@@ -232,7 +371,7 @@ namespace Symbols {
             throw std::runtime_error("Symbol must be an enum to use addEnum");
         }
         const std::string ns = DEFAULT_VARIABLES_SCOPE;
-        scopes_[currentScopeName()]->define(ns, enumSymbol);
+        tableStack_.back()->define(ns, enumSymbol);
         return ns;
     }
 
@@ -254,25 +393,19 @@ namespace Symbols {
         if (fullNamespace.empty()) {
             fullNamespace = currentScopeName();
         }
-        for (auto it = scopeStack_.rbegin(); it != scopeStack_.rend(); ++it) {
-            const auto & scopeName = *it;
-            auto tableIt = scopes_.find(scopeName);
-            if (tableIt != scopes_.end() && tableIt->second->exists(fullNamespace, name)) {
-                return true;
-            }
-        }
-        return false;
+        return get(fullNamespace, name) != nullptr;
     }
 
     SymbolPtr SymbolContainer::get(const std::string & fullNamespace, const std::string & name) const {
-        for (auto it = scopeStack_.rbegin(); it != scopeStack_.rend(); ++it) {
-            const auto & scopeName = *it;
-            auto tableIt = scopes_.find(scopeName);
-            if (tableIt != scopes_.end()) {
-                auto sym = tableIt->second->get(fullNamespace, name);
-                if (sym) {
-                    return sym;
-                }
+        const Atom nsAtom   = AtomTable::find(fullNamespace);
+        const Atom nameAtom = AtomTable::find(name);
+        if (nsAtom == kNoAtom || nameAtom == kNoAtom) {
+            return nullptr;
+        }
+        for (auto it = tableStack_.rbegin(); it != tableStack_.rend(); ++it) {
+            auto sym = (*it)->get(nsAtom, nameAtom);
+            if (sym) {
+                return sym;
             }
         }
         return nullptr;
@@ -280,14 +413,14 @@ namespace Symbols {
 
 
     SymbolPtr SymbolContainer::getFunction(const std::string & name) const {
-        for (auto it = scopeStack_.rbegin(); it != scopeStack_.rend(); ++it) {
-            const std::string & scopeName = *it;
-            auto tableIt = scopes_.find(scopeName);
-            if (tableIt != scopes_.end()) {
-                auto func = tableIt->second->get(DEFAULT_FUNCTIONS_SCOPE, name);
-                if (func && func->getKind() == Kind::Function) {
-                    return func;
-                }
+        const Atom atom = AtomTable::find(name);
+        if (atom == kNoAtom) {
+            return nullptr;
+        }
+        for (auto it = tableStack_.rbegin(); it != tableStack_.rend(); ++it) {
+            auto func = (*it)->get(functionsAtom(), atom);
+            if (func && func->getKind() == Kind::Function) {
+                return func;
             }
         }
         return nullptr;
@@ -306,14 +439,10 @@ namespace Symbols {
     }
 
     SymbolPtr SymbolContainer::getMethod(const std::string & name) const {
-        for (auto it = scopeStack_.rbegin(); it != scopeStack_.rend(); ++it) {
-            const std::string & scopeName = *it;
-            auto tableIt = scopes_.find(scopeName);
-            if (tableIt != scopes_.end()) {
-                auto method = tableIt->second->get(METHOD_SCOPE, name);
-                if (method && method->getKind() == Kind::Function) {
-                    return method;
-                }
+        for (auto it = tableStack_.rbegin(); it != tableStack_.rend(); ++it) {
+            auto method = (*it)->get(METHOD_SCOPE, name);
+            if (method && method->getKind() == Kind::Function) {
+                return method;
             }
         }
         return nullptr;
@@ -350,20 +479,14 @@ namespace Symbols {
 
 
     bool SymbolContainer::hasClass(const std::string & className) const {
-        static thread_local int recursionDepth = 0;
-        static thread_local std::unordered_set<std::string> visitedClasses;
-        if (recursionDepth > 10) {
-            return false;
-        }
-        if (visitedClasses.find(className) != visitedClasses.end()) {
-            return false;
-        }
-        recursionDepth++;
-        visitedClasses.insert(className);
-        bool result = classes_.find(className) != classes_.end();
-        visitedClasses.erase(className);
-        recursionDepth--;
-        return result;
+        return classes_.find(className) != classes_.end();
+    }
+
+    void SymbolContainer::removeClass(const std::string & className) {
+        classes_.erase(className);
+        classScopes_.erase(className);
+        // Dispatch tables of other classes may point into the removed ClassInfo.
+        ++classEpoch_;
     }
 
     ClassInfo & SymbolContainer::getClassInfo(const std::string & className) {
@@ -395,6 +518,7 @@ namespace Symbols {
         propertyInfo.isPrivate = isPrivate;
         propertyInfo.defaultValueExpr = defaultValueExpr;
         classInfo.properties.push_back(propertyInfo);
+        ++classEpoch_;
     }
 
     void SymbolContainer::addMethod(const std::string & className, const std::string & methodName, Variables::Type returnType, std::vector<FunctionParameterInfo> parameters, bool isPrivate) {
@@ -416,6 +540,7 @@ namespace Symbols {
         doc.parameterList = parameters;
         methodInfo.documentation = doc;
         classInfo.methods.push_back(methodInfo);
+        ++classEpoch_;
     }
 
     void SymbolContainer::addNativeMethod(const std::string & className, const std::string & methodName, std::function<ValuePtr(const std::vector<ValuePtr> &)> implementation, Variables::Type returnType, std::vector<FunctionParameterInfo> parameters, bool isPrivate, const std::string & description) {
@@ -439,6 +564,7 @@ namespace Symbols {
         doc.description = description;
         methodInfo.documentation = doc;
         classInfo.methods.push_back(methodInfo);
+        ++classEpoch_;
     }
 
     bool SymbolContainer::hasProperty(const std::string & className, const std::string & propertyName) const {
@@ -458,8 +584,76 @@ namespace Symbols {
     }
 
     bool SymbolContainer::hasMethod(const std::string & className, const std::string & methodName) const {
-        std::unordered_set<std::string> visited;
-        return hasMethodInternal(className, methodName, visited, 0);
+        return findMethodEntry(className, methodName) != nullptr;
+    }
+
+    const ClassInfo * SymbolContainer::dispatchClass(const std::string & className) const {
+        auto it = classes_.find(className);
+        if (it == classes_.end()) {
+            return nullptr;
+        }
+        if (it->second.dispatchEpoch != classEpoch_) {
+            buildDispatch(it->second, 0);
+        }
+        return &it->second;
+    }
+
+    const MethodEntry * SymbolContainer::findMethodEntry(const std::string & className, Atom methodName) const {
+        const ClassInfo * classInfo = dispatchClass(className);
+        if (!classInfo) {
+            return nullptr;
+        }
+        auto entry = classInfo->dispatch.find(methodName);
+        return entry == classInfo->dispatch.end() ? nullptr : &entry->second;
+    }
+
+    const MethodEntry * SymbolContainer::findMethodEntry(const std::string & className,
+                                                         const std::string & methodName) const {
+        // Building the table interns every method name, so a name without an atom after
+        // that is no method of this class.
+        const ClassInfo * classInfo = dispatchClass(className);
+        const Atom        atom      = classInfo ? AtomTable::find(methodName) : kNoAtom;
+        if (atom == kNoAtom) {
+            return nullptr;
+        }
+        auto entry = classInfo->dispatch.find(atom);
+        return entry == classInfo->dispatch.end() ? nullptr : &entry->second;
+    }
+
+    void SymbolContainer::buildDispatch(const ClassInfo & classInfo, int depth) const {
+        // Deep enough for any real hierarchy; stops a circular one from recursing forever.
+        constexpr int kMaxInheritanceDepth = 10;
+
+        classInfo.dispatch.clear();
+        if (!classInfo.parentClass.empty() && depth < kMaxInheritanceDepth) {
+            auto parent = classes_.find(classInfo.parentClass);
+            if (parent != classes_.end() && &parent->second != &classInfo) {
+                if (parent->second.dispatchEpoch != classEpoch_) {
+                    buildDispatch(parent->second, depth + 1);
+                }
+                classInfo.dispatch = parent->second.dispatch;
+            }
+        }
+
+        // Script method symbols and bodies live under the scope the class was parsed in.
+        const std::string classScope = findClassNamespace(classInfo.name);
+        const std::string methodsNs  = classScope.empty() ? "" : classScope + SCOPE_SEPARATOR + classInfo.name;
+        auto              methods    = methodsNs.empty() ? nullptr : getScopeTable(methodsNs);
+
+        for (const auto & method : classInfo.methods) {
+            MethodEntry entry;
+            entry.info  = &method;
+            entry.owner = &classInfo;
+            if (!method.nativeImplementation && methods) {
+                auto sym = methods->get(METHOD_SCOPE, method.name);
+                if (sym && (sym->getKind() == Kind::Method || sym->getKind() == Kind::Function)) {
+                    entry.script = std::static_pointer_cast<FunctionSymbol>(sym);
+                }
+                entry.bodyScope = methodsNs + SCOPE_SEPARATOR + method.name;
+            }
+            classInfo.dispatch[AtomTable::intern(method.name)] = std::move(entry);
+        }
+        classInfo.dispatchEpoch = classEpoch_;
     }
 
 
@@ -582,6 +776,12 @@ namespace Symbols {
         return nullptr;
     }
 
+    void SymbolContainer::releaseScriptResources() {
+        for (auto & [_, module] : modules_) {
+            module->releaseScriptResources();
+        }
+    }
+
     // --- Function Management Methods ---
 
     void SymbolContainer::registerDoc(const std::string & name, const FunctionDoc & doc) {
@@ -592,6 +792,7 @@ namespace Symbols {
                                           Variables::Type returnType, Modules::BaseModule * module) {
         functions_[name] = callback;
         functionModules_[name] = module;
+        ++definitionEpoch_;
 
         // Create basic documentation
         FunctionDoc doc;
@@ -614,6 +815,11 @@ namespace Symbols {
         return functions_.find(name) != functions_.end();
     }
 
+    const CallbackFunction * SymbolContainer::findFunction(const std::string & name) const {
+        auto it = functions_.find(name);
+        return it == functions_.end() ? nullptr : &it->second;
+    }
+
     ValuePtr SymbolContainer::callFunction(const std::string & name, const std::vector<ValuePtr> & args) {
         auto it = functions_.find(name);
         if (it == functions_.end()) {
@@ -628,36 +834,20 @@ namespace Symbols {
             throw std::runtime_error("Class not found: " + className);
         }
 
-        const ClassInfo & classInfo = getClassInfo(className);
-
-        for (const auto & method : classInfo.methods) {
-            if (method.name == methodName) {
-                if (method.nativeImplementation) {
-                    return method.nativeImplementation(args);
-                } else {
-                    throw std::runtime_error("Method has no native implementation: " + className + "::" + methodName);
-                }
-            }
+        const MethodEntry * entry = findMethodEntry(className, methodName);
+        if (!entry) {
+            throw std::runtime_error("Method not found: " + className + "::" + methodName);
         }
-
-        throw std::runtime_error("Method not found: " + className + "::" + methodName);
+        if (!entry->native()) {
+            throw std::runtime_error("Method has no native implementation: " + className + "::" + methodName);
+        }
+        return entry->info->nativeImplementation(args);
     }
 
     std::vector<FunctionParameterInfo> SymbolContainer::getMethodParameters(const std::string & className,
                                                                            const std::string & methodName) const {
-        if (!hasClass(className)) {
-            return {};
-        }
-
-        const ClassInfo & classInfo = getClassInfo(className);
-
-        for (const auto & method : classInfo.methods) {
-            if (method.name == methodName) {
-                return method.parameters;
-            }
-        }
-
-        return {};
+        const MethodEntry * entry = findMethodEntry(className, methodName);
+        return entry ? entry->info->parameters : std::vector<FunctionParameterInfo>{};
     }
 
     const FunctionDoc & SymbolContainer::getFunctionDoc(const std::string & name) const {
@@ -678,19 +868,8 @@ namespace Symbols {
     }
 
     Variables::Type SymbolContainer::getMethodReturnType(const std::string & className, const std::string & methodName) const {
-        if (!hasClass(className)) {
-            return Variables::Type::NULL_TYPE;
-        }
-
-        const ClassInfo & classInfo = getClassInfo(className);
-
-        for (const auto & method : classInfo.methods) {
-            if (method.name == methodName) {
-                return method.returnType;
-            }
-        }
-
-        return Variables::Type::NULL_TYPE;
+        const MethodEntry * entry = findMethodEntry(className, methodName);
+        return entry ? entry->info->returnType : Variables::Type::NULL_TYPE;
     }
 
     std::vector<std::string> SymbolContainer::getFunctionNamesByModule(const Modules::BaseModule * module) const {
@@ -739,17 +918,8 @@ namespace Symbols {
     }
 
     bool SymbolContainer::isMethodPrivate(const std::string & className, const std::string & methodName) const {
-        if (!hasClass(className)) {
-            return false;
-        }
-
-        const ClassInfo & classInfo = getClassInfo(className);
-        for (const auto & method : classInfo.methods) {
-            if (method.name == methodName) {
-                return method.isPrivate;
-            }
-        }
-        return false;
+        const MethodEntry * entry = findMethodEntry(className, methodName);
+        return entry && entry->info->isPrivate;
     }
 
     bool SymbolContainer::isPropertyPrivate(const std::string & className, const std::string & propertyName) const {
@@ -8,6 +8,7 @@
 #include <memory>
 #include <sstream>  // For std::stringstream
 #include <stdexcept>
+#include <string_view>
 #include <thread>   // For thread_local
 #include <unordered_map>
 #include <unordered_set>
@@ -78,6 +79,20 @@ struct MethodInfo {
     FunctionDoc                                            documentation;
 };
 
+struct ClassInfo;
+
+/**
+ * @brief A method as dispatched on a class: its own or an inherited one.
+ */
+struct MethodEntry {
+    const MethodInfo *              info  = nullptr;  // in the owner's ClassInfo::methods
+    const ClassInfo *               owner = nullptr;  // class that declares the method
+    std::shared_ptr<FunctionSymbol> script;           // script method symbol, once declared
+    std::string                     bodyScope;        // scope holding a script method's operations
+
+    bool native() const { return static_cast<bool>(info->nativeImplementation); }
+};
+
 /**
  * @brief Information about a class
  */
@@ -88,29 +103,82 @@ struct ClassInfo {
     std::vector<MethodInfo>                   methods;
     std::unordered_map<std::string, ValuePtr> staticProperties;
     Modules::BaseModule *                     module = nullptr;  // Module that defined this class
+
+    // Method name atom -> entry, parents' methods included; see SymbolContainer::findMethodEntry.
+    mutable std::unordered_map<Atom, MethodEntry> dispatch;
+    mutable std::uint64_t                         dispatchEpoch = 0;
 };
 
 using FunctionArguments = const std::vector<ValuePtr>;
 using CallbackFunction  = std::function<ValuePtr(FunctionArguments &)>;
 
+/**
+ * @brief Call-frame counters, as reported by vm_stats().
+ */
+struct FrameStats {
+    std::uint64_t entered   = 0;  // frames entered (function calls and loop executions)
+    std::uint64_t allocated = 0;  // frames that needed a new table, the pool being empty
+    size_t        live      = 0;  // frames on the scope stack now
+    size_t        pooled    = 0;  // emptied frames waiting for reuse
+    size_t        scopes    = 0;  // named scopes (files, classes, function bodies)
+};
+
 class SymbolContainer {
     std::unordered_map<std::string, std::shared_ptr<SymbolTable>> scopes_;
     // Stack of active scope names (supports nested scope entry)
     std::vector<std::string>                                      scopeStack_;
+    // The tables behind scopeStack_, entry for entry, so lookups walk pointers instead of
+    // hashing every scope name on the way up.
+    std::vector<std::shared_ptr<SymbolTable>>                     tableStack_;
+
+    // Call frames and loop scopes live only while they are on the stack, so they are not
+    // registered in scopes_: a frame is taken from this pool on entry and handed back,
+    // emptied, when its scope is popped.
+    std::vector<std::shared_ptr<SymbolTable>>                     framePool_;
+    // Their names likewise: a popped frame's name keeps its buffer for the next one.
+    std::vector<std::string>                                      framePoolNames_;
+    FrameStats                                                    frameStats_;
+
+    // See definitionEpoch(); starts at 1 so a zeroed cache never matches.
+    std::uint64_t                                                 definitionEpoch_ = 1;
+
+    // Tables kept for reuse; deeper recursion allocates and frees the excess.
+    static constexpr size_t kMaxPooledFrames = 1024;
 
-    // For unique call frame IDs
-    inline static std::atomic<unsigned long long> next_call_frame_id_ = 0;
+    // Function and method calls open now; loop scopes are not counted.
+    size_t                                                        callDepth_ = 0;
 
-    // For singleton initialization
-    static std::string initial_scope_name_for_singleton_;
-    static bool        is_initialized_for_singleton_;
+    // Every call is a level of C++ recursion in the interpreter, so enterFrame() refuses one
+    // once the native stack is nearly full (see SymbolContainer.cpp), and a runaway script
+    // recursion stops with a runtime error instead of a crash. Where the stack's bounds are
+    // unknown, it refuses the call past this many instead.
+    static constexpr size_t kFallbackCallDepth = 2000;
+
+    void popScope();
+
+    SymbolTable * pushFrame(std::string name, Atom frame);
+    std::string   pooledName();
+
+    // For singleton initialization; per thread, like the instance
+    static thread_local std::string initial_scope_name_for_singleton_;
+    static thread_local bool        is_initialized_for_singleton_;
 
     // Class registry
     std::unordered_map<std::string, ClassInfo> classes_;
+    // Bumped whenever any class gains a method or property. A new method makes every
+    // dispatch table stale, since a child's table holds copies of its parents' entries;
+    // property access caches check it too. Starts at 1 like definitionEpoch_.
+    std::uint64_t                              classEpoch_ = 1;
+    // findClassNamespace() results; a class symbol never moves once defined.
+    mutable std::unordered_map<std::string, std::string> classScopes_;
+
+    void              buildDispatch(const ClassInfo & classInfo, int depth) const;
+    const ClassInfo * dispatchClass(const std::string & className) const;
 
     // Function registry
     std::unordered_map<std::string, CallbackFunction> functions_;
     std::unordered_map<std::string, FunctionDoc>      functionDocs_;
+    std::unordered_set<std::string>                   reentrant_;  // call back into script functions
     
     // Function-to-module mapping
     std::unordered_map<std::string, Modules::BaseModule*> functionModules_;
@@ -143,47 +211,44 @@ class SymbolContainer {
     }
 
     static SymbolContainer * instance() {
-        static thread_local int callDepth = 0;
-        static thread_local bool inRecursiveCall = false;
-        
-        // Prevent infinite recursion during function calls
-        if (inRecursiveCall) {
-            throw std::runtime_error("Infinite recursion detected in SymbolContainer::instance()");
-        }
-        
-        callDepth++;
-        if (callDepth > 100) {  // Reasonable limit for nested calls
-            throw std::runtime_error("SymbolContainer instance call depth exceeded - infinite recursion detected");
-        }
-        
-        inRecursiveCall = true;
-        
         if (!is_initialized_for_singleton_) {
-            inRecursiveCall = false;
-            callDepth--;
             throw std::runtime_error(
                 "SymbolContainer has not been initialized. Call SymbolContainer::initialize() with the top-level "
                 "script/file name first.");
         }
-        
-        // Meyer's Singleton: instance_ is constructed on first call using the initialized name
-        static SymbolContainer instance_(initial_scope_name_for_singleton_);
-        
-        inRecursiveCall = false;
-        callDepth--;
+
+        // Meyer's Singleton: instance_ is constructed on first call using the initialized name.
+        // One per thread, so the threads of `voidscript-fcgi --threads` run isolated scripts.
+        static thread_local SymbolContainer instance_(initial_scope_name_for_singleton_);
         return &instance_;
     }
 
     // default scope names
-    constexpr static const std::string SCOPE_SEPARATOR         = "::";
-    constexpr static const std::string DEFAULT_VARIABLES_SCOPE = SCOPE_SEPARATOR + "variables";
-    constexpr static const std::string DEFAULT_CONSTANTS_SCOPE = "constants";
-    constexpr static const std::string DEFAULT_FUNCTIONS_SCOPE = SCOPE_SEPARATOR + "functions";
-    constexpr static const std::string DEFAULT_OTHERS_SCOPE    = SCOPE_SEPARATOR + "others";
-    constexpr static const std::string METHOD_SCOPE            = SCOPE_SEPARATOR + "methods";
+    inline static const std::string SCOPE_SEPARATOR         = "::";
+    inline static const std::string DEFAULT_VARIABLES_SCOPE = SCOPE_SEPARATOR + "variables";
+    inline static const std::string DEFAULT_CONSTANTS_SCOPE = "constants";
+    inline static const std::string DEFAULT_FUNCTIONS_SCOPE = SCOPE_SEPARATOR + "functions";
+    inline static const std::string DEFAULT_OTHERS_SCOPE    = SCOPE_SEPARATOR + "others";
+    inline static const std::string METHOD_SCOPE            = SCOPE_SEPARATOR + "methods";
 
     // other scope names
-    constexpr static const std::string CALL_SCOPE = SCOPE_SEPARATOR + "call_";
+    inline static const std::string CALL_SCOPE = SCOPE_SEPARATOR + "call";
+
+    // Interned forms of the sub-namespaces searched on every identifier lookup.
+    static Atom variablesAtom() {
+        static const Atom atom = AtomTable::intern(DEFAULT_VARIABLES_SCOPE);
+        return atom;
+    }
+
+    static Atom constantsAtom() {
+        static const Atom atom = AtomTable::intern(DEFAULT_CONSTANTS_SCOPE);
+        return atom;
+    }
+
+    static Atom functionsAtom() {
+        static const Atom atom = AtomTable::intern(DEFAULT_FUNCTIONS_SCOPE);
+        return atom;
+    }
 
     // --- Scope management ---
 
@@ -210,6 +275,12 @@ class SymbolContainer {
      */
     void validateAndCleanupScopeStack(const std::string & expectedScope);
 
+    /**
+     * @brief Pop scopes until only @p depth remain (see getScopeStack().size()). Used where an
+     * error is caught, to drop the scopes of the calls it unwound through.
+     */
+    void unwindScopeStack(size_t depth);
+
     /**
      * @brief Enhanced enterPreviousScope with validation
      */
@@ -229,16 +300,55 @@ class SymbolContainer {
      */
     [[nodiscard]] const std::vector<std::string>& getScopeStack() const;
 
+    /** @brief The table of the current scope. */
+    [[nodiscard]] SymbolTable * currentTable() const { return tableStack_.back().get(); }
+
+    /**
+     * @brief The call frame of function @p frame, expected @p depth scopes below the current
+     * one (see Interpreter::LocalResolver). Returns nullptr when the scope there is not such
+     * a frame, e.g. when a callee's scope was left on the stack by an error.
+     */
+    [[nodiscard]] SymbolTable * frameTable(size_t depth, Atom frame) const {
+        if (depth >= tableStack_.size()) {
+            return nullptr;
+        }
+        SymbolTable * table = tableStack_[tableStack_.size() - 1 - depth].get();
+        return table->frame() == frame ? table : nullptr;
+    }
+
+    /** @brief The scope @p depth levels below the current one, or nullptr. */
+    [[nodiscard]] SymbolTable * scopeTable(size_t depth) const {
+        return depth < tableStack_.size() ? tableStack_[tableStack_.size() - 1 - depth].get() : nullptr;
+    }
+
     // --- Symbol operations ---
 
     /**
-     * @brief Enters a new, unique scope for a function call.
-     * This scope is used for local variables of that specific call.
+     * @brief Enter a call frame or loop scope: a pooled table pushed under @p name, which
+     * need not be unique. It is emptied and returned to the pool when the scope is popped.
+     * @param frame Atom of the called function, checked by slot reads (see frameTable()).
+     * @return The frame's table.
+     * @throws std::runtime_error if the calls already open leave too little native stack for
+     * another (a recursion too deep to run).
+     */
+    SymbolTable * enterFrame(const std::string & name, Atom frame = kNoAtom);
+
+    /**
+     * @brief Enter a loop scope named after the current scope plus @p suffix (e.g.
+     * "::for_12_5"), as enterFrame() does; the name is built in a pooled buffer.
+     */
+    SymbolTable * enterLoopFrame(std::string_view suffix, Atom frame = kNoAtom);
+
+    /**
+     * @brief Enter a call frame for a function call.
      * @param baseFunctionScopeName The definition scope name of the function being called.
-     * @return The name of the newly created unique call scope.
+     * @return The name of the call scope, used as the context of its symbols.
      */
     std::string enterFunctionCallScope(const std::string & baseFunctionScopeName);
 
+    /** @brief Current call-frame counters. */
+    [[nodiscard]] FrameStats frameStats() const;
+
     /**
      * @brief Add a symbol to the current scope.
      * @param symbol Symbol to add.
@@ -369,68 +479,61 @@ class SymbolContainer {
      * @param className Name of the class to find.
      * @return The namespace containing the class, or empty string if not found.
      */
-    std::string findClassNamespace(const std::string & className) {
+    std::string findClassNamespace(const std::string & className) const {
+        auto cached = classScopes_.find(className);
+        if (cached != classScopes_.end()) {
+            return cached->second;
+        }
+        const Atom classAtom = AtomTable::find(className);
+        if (classAtom == kNoAtom) {
+            return "";
+        }
         // Look in all scopes for a symbol with metadata indicating it's the class definition
         for (const auto & [scopeName, table] : scopes_) {
             // Classes are registered in the variables namespace (as per addClass method)
-            auto classSymbol = table->get(DEFAULT_VARIABLES_SCOPE, className);
+            auto classSymbol = table->get(variablesAtom(), classAtom);
             if (classSymbol && classSymbol->getKind() == Kind::Class) {
                 // Found the class definition
+                classScopes_.emplace(className, scopeName);
                 return scopeName;
             }
         }
         return "";
     }
 
+    /**
+     * @brief The method @p methodName as dispatched on @p className, inherited ones
+     * included, or nullptr. The table behind it is rebuilt after any class gains a method,
+     * so the pointer is only good until then.
+     */
+    const MethodEntry * findMethodEntry(const std::string & className, Atom methodName) const;
+
+    const MethodEntry * findMethodEntry(const std::string & className, const std::string & methodName) const;
+
+    /**
+     * @brief Counter bumped whenever a class gains a method or property; see
+     * findMethodEntry(). Member access nodes cache what they looked up against it.
+     */
+    [[nodiscard]] std::uint64_t classEpoch() const { return classEpoch_; }
+
     /**
      * @brief Find a method within a class scope
      * @param className The name of the class
      * @param methodName The name of the method to find
-     * @return Shared pointer to the found method symbol, or nullptr if not found
+     * @return The script method symbol; a placeholder symbol for a native method, which is
+     * called through callMethod(); nullptr if there is no such method
      */
     SymbolPtr findMethod(const std::string & className, const std::string & methodName) {
-        // First check the class registry (where native methods are stored)
-        if (hasClass(className)) {
-            const ClassInfo & classInfo = getClassInfo(className);
-            
-            for (const auto & method : classInfo.methods) {
-                if (method.name == methodName) {
-                    // For native methods, we need to indicate that the method exists but the actual call
-                    // will go through callMethod() which handles native methods directly.
-                    // Since MethodCallExpressionNode only checks if the return is nullptr or not,
-                    // we need to return a non-null pointer. Let's return a pointer to a static value.
-                    static SymbolPtr dummySymbol = nullptr;
-                    if (!dummySymbol) {
-                        dummySymbol = std::make_shared<Symbols::VariableSymbol>(
-                            "dummy",
-                            Symbols::ValuePtr::null(),
-                            "",
-                            Variables::Type::NULL_TYPE
-                        );
-                    }
-                    return dummySymbol;
-                }
-            }
-        }
-        
-        // If not found in class registry, try scope-based lookup (for script-defined methods)
-        std::string classScope = findClassNamespace(className);
-        if (classScope.empty()) {
-            return nullptr;  // Class not found
-        }
-
-        // The method is stored in a class-specific namespace: classScope::className
-        std::string classMethodScope = classScope + SCOPE_SEPARATOR + className;
-
-        // Get the symbol table for the class-specific method scope
-        auto scopeTable = getScopeTable(classMethodScope);
-        if (!scopeTable) {
+        const MethodEntry * entry = findMethodEntry(className, methodName);
+        if (!entry) {
             return nullptr;
         }
-
-        // Look for the method in the methods namespace within the class-specific scope
-        auto result = scopeTable->get(METHOD_SCOPE, methodName);
-        return result;
+        if (entry->native()) {
+            static const SymbolPtr dummySymbol = std::make_shared<Symbols::VariableSymbol>(
+                "dummy", Symbols::ValuePtr::null(), "", Variables::Type::NULL_TYPE);
+            return dummySymbol;
+        }
+        return entry->script;
     }
 
     /**
@@ -440,16 +543,8 @@ class SymbolContainer {
      * @return Vector of parameter info for the method, empty if not found
      */
     std::vector<Symbols::FunctionParameterInfo> getNativeMethodParameters(const std::string & className, const std::string & methodName) {
-        if (hasClass(className)) {
-            const ClassInfo & classInfo = getClassInfo(className);
-            
-            for (const auto & method : classInfo.methods) {
-                if (method.name == methodName) {
-                    return method.parameters;
-                }
-            }
-        }
-        return {}; // Return empty vector if not found
+        const MethodEntry * entry = findMethodEntry(className, methodName);
+        return entry ? entry->info->parameters : std::vector<Symbols::FunctionParameterInfo>{};
     }
 
     /**
@@ -498,15 +593,21 @@ class SymbolContainer {
      * @return Shared pointer to the found variable, or nullptr if not found
      */
     SymbolPtr getVariable(const std::string & name) const {
+        const Atom atom = AtomTable::find(name);
+        return atom == kNoAtom ? nullptr : getVariable(atom);
+    }
+
+    /**
+     * @brief Get a variable by its interned name from the current scope or parent scopes
+     * @param name Atom of the variable name (see IdentifierExpressionNode)
+     * @return Shared pointer to the found variable, or nullptr if not found
+     */
+    SymbolPtr getVariable(Atom name) const {
         // Search scopes in innermost-to-outermost order
-        for (auto it = scopeStack_.rbegin(); it != scopeStack_.rend(); ++it) {
-            const auto & scopeName = *it;
-            auto                tableIt   = scopes_.find(scopeName);
-            if (tableIt != scopes_.end()) {
-                auto variable = tableIt->second->get(DEFAULT_VARIABLES_SCOPE, name);
-                if (variable && variable->getKind() == Kind::Variable) {
-                    return variable;
-                }
+        for (auto it = tableStack_.rbegin(); it != tableStack_.rend(); ++it) {
+            auto variable = (*it)->get(variablesAtom(), name);
+            if (variable && variable->getKind() == Kind::Variable) {
+                return variable;
             }
         }
         return nullptr;
@@ -538,15 +639,21 @@ class SymbolContainer {
      * @return Shared pointer to the found constant, or nullptr if not found
      */
     SymbolPtr getConstant(const std::string & name) const {
+        const Atom atom = AtomTable::find(name);
+        return atom == kNoAtom ? nullptr : getConstant(atom);
+    }
+
+    /**
+     * @brief Get a constant by its interned name from the current scope or parent scopes
+     * @param name Atom of the constant name
+     * @return Shared pointer to the found constant, or nullptr if not found
+     */
+    SymbolPtr getConstant(Atom name) const {
         // Search scopes in innermost-to-outermost order
-        for (auto it = scopeStack_.rbegin(); it != scopeStack_.rend(); ++it) {
-            const auto & scopeName = *it;
-            auto                tableIt   = scopes_.find(scopeName);
-            if (tableIt != scopes_.end()) {
-                auto constant = tableIt->second->get(DEFAULT_CONSTANTS_SCOPE, name);
-                if (constant && constant->getKind() == Kind::Constant) {
-                    return constant;
-                }
+        for (auto it = tableStack_.rbegin(); it != tableStack_.rend(); ++it) {
+            auto constant = (*it)->get(constantsAtom(), name);
+            if (constant && constant->getKind() == Kind::Constant) {
+                return constant;
             }
         }
         return nullptr;
@@ -577,14 +684,10 @@ class SymbolContainer {
      */
     SymbolPtr getEnum(const std::string & name) const {
         // Search scopes in innermost-to-outermost order
-        for (auto it = scopeStack_.rbegin(); it != scopeStack_.rend(); ++it) {
-            const auto & scopeName = *it;
-            auto                tableIt   = scopes_.find(scopeName);
-            if (tableIt != scopes_.end()) {
-                auto enumSymbol = tableIt->second->get(DEFAULT_VARIABLES_SCOPE, name);
-                if (enumSymbol && enumSymbol->getKind() == Kind::ENUM) {
-                    return enumSymbol;
-                }
+        for (auto it = tableStack_.rbegin(); it != tableStack_.rend(); ++it) {
+            auto enumSymbol = (*it)->get(DEFAULT_VARIABLES_SCOPE, name);
+            if (enumSymbol && enumSymbol->getKind() == Kind::ENUM) {
+                return enumSymbol;
             }
         }
         return nullptr;
@@ -667,6 +770,13 @@ class SymbolContainer {
      */
     bool hasClass(const std::string & className) const;
 
+    /**
+     * @brief Forget a registered class, so it can be registered again. Used when a file is
+     * parsed again in the same process (see Parser::parseClassDefinition).
+     * @param className Name of the class to remove
+     */
+    void removeClass(const std::string & className);
+
     /**
      * @brief Get information about a registered class
      * @param className Name of the class to get information for
@@ -735,48 +845,6 @@ class SymbolContainer {
      */
     bool hasMethod(const std::string & className, const std::string & methodName) const;
 
-private:
-    /**
-     * @brief Internal recursive method with cycle detection
-     */
-    bool hasMethodInternal(const std::string & className, const std::string & methodName,
-                          std::unordered_set<std::string>& visited, int depth) const {
-        const int MAX_RECURSION_DEPTH = 10;
-        
-        // Check for infinite recursion
-        if (depth > MAX_RECURSION_DEPTH) {
-            return false;
-        }
-        
-        // Check for circular inheritance
-        if (visited.find(className) != visited.end()) {
-            return false;
-        }
-        
-        visited.insert(className);
-        
-        if (!hasClass(className)) {
-            return false;
-        }
-
-        const ClassInfo & classInfo = getClassInfo(className);
-
-        // Check in this class
-        for (const auto & method : classInfo.methods) {
-            if (method.name == methodName) {
-                return true;
-            }
-        }
-
-        // Check in parent class if exists
-        if (!classInfo.parentClass.empty()) {
-            return hasMethodInternal(classInfo.parentClass, methodName, visited, depth + 1);
-        }
-
-        return false;
-    }
-
-public:
     /**
      * @brief Get all registered class names
      * @return Vector of class names
@@ -863,6 +931,12 @@ public:
      */
     Modules::BaseModule * getModule(const std::string & moduleName) const;
 
+    /**
+     * @brief Let every module free what the scripts run so far left open (see
+     * Modules::BaseModule::releaseScriptResources()).
+     */
+    void releaseScriptResources();
+
     // --- Function Management Methods ---
 
     /**
@@ -902,6 +976,26 @@ public:
      */
     bool hasFunction(const std::string & name) const;
 
+    /**
+     * @brief The callback of a registered function, or nullptr. The pointer stays valid
+     * until the definition epoch changes.
+     */
+    const CallbackFunction * findFunction(const std::string & name) const;
+
+    /**
+     * @brief Mark the registered function @p name as one that calls script functions back
+     * (Interpreter::callUserFunction); a compiled loop never calls it (see Bytecode::Compiler).
+     */
+    void markReentrant(const std::string & name) { reentrant_.insert(name); }
+
+    [[nodiscard]] bool reentrant(const std::string & name) const { return reentrant_.count(name) > 0; }
+
+    /**
+     * @brief Counter bumped whenever a function is registered or defined, or a named scope
+     * is (re)created. Call sites cache what they resolved against it.
+     */
+    [[nodiscard]] std::uint64_t definitionEpoch() const { return definitionEpoch_; }
+
     /**
      * @brief Call a registered function
      * @param name Function name
@@ -1,79 +1,140 @@
 #ifndef SYMBOL_TABLE_HPP
 #define SYMBOL_TABLE_HPP
 
+#include <cstdint>
 #include <vector>
 #include <string>
-#include <iostream> // For std::cerr, std::endl
-#include <sstream>  // For std::stringstream
+#include "Atom.hpp"
 #include "SymbolTypes.hpp"
 #include <unordered_map>
 
 namespace Symbols {
 
 class SymbolTable {
-    // NamespaceMap symbols_; // OLD
-    std::unordered_map<std::string, SymbolPtr> flat_symbols_; // NEW: Flattened map
-    const std::string key_separator = "::"; // Separator for flat key
+    // Flat map keyed by the (namespace, name) atom pair, so a lookup hashes one integer
+    // instead of building and hashing "ns::name".
+    std::unordered_map<std::uint64_t, SymbolPtr> flat_symbols_;
+    // Frame slots of a function call scope, indexed as assigned by Interpreter::LocalResolver.
+    // Every slot also has its entry in flat_symbols_; an empty slot means "not bound yet".
+    std::vector<SymbolPtr>                       slots_;
+    // Atom of the function whose call this scope is; kNoAtom for any other scope.
+    Atom                                         frame_ = kNoAtom;
+    // Owned by SymbolContainer's frame pool rather than registered as a named scope.
+    bool                                         pooled_ = false;
+    // A function or method call's frame, as opposed to a loop scope (see
+    // SymbolContainer::enterFrame()).
+    bool                                         call_ = false;
+
+    static std::uint64_t key(Atom ns, Atom name) { return (static_cast<std::uint64_t>(ns) << 32) | name; }
+
+    static Atom nsOf(std::uint64_t key) { return static_cast<Atom>(key >> 32); }
 
   public:
-  SymbolTable(const std::string &separator) : key_separator(separator) {}
-    void define(const std::string & ns, const SymbolPtr & symbol) {
+    void define(const std::string & ns, const SymbolPtr & symbol) { define(AtomTable::intern(ns), symbol); }
+
+    void define(Atom ns, const SymbolPtr & symbol) {
         // ns is sub-ns like "variables"
-        std::string flat_key = ns + key_separator + symbol->name();
-        flat_symbols_[flat_key] = symbol;
+        flat_symbols_[key(ns, symbol->nameAtom())] = symbol;
     }
 
-    bool exists(const std::string & ns, const std::string & name) {
-        // ns is sub-ns like "variables"
-        std::string flat_key = ns + key_separator + name;
-        auto it = flat_symbols_.find(flat_key);
-        if (it != flat_symbols_.end()) {
-            return it->second != nullptr;
+    bool exists(const std::string & ns, const std::string & name) { return get(ns, name) != nullptr; }
+
+    SymbolPtr get(const std::string & ns, const std::string & name) {
+        // A string that was never interned cannot name a defined symbol.
+        const Atom nsAtom   = AtomTable::find(ns);
+        const Atom nameAtom = AtomTable::find(name);
+        if (nsAtom == kNoAtom || nameAtom == kNoAtom) {
+            return nullptr;
         }
-        return false;
+        return get(nsAtom, nameAtom);
     }
 
-    SymbolPtr get(const std::string & ns, const std::string & name) {
-        // ns is sub-ns like "variables"
-        std::string flat_key = ns + key_separator + name;
-        auto it = flat_symbols_.find(flat_key);
+    SymbolPtr get(Atom ns, Atom name) {
+        auto it = flat_symbols_.find(key(ns, name));
         if (it != flat_symbols_.end()) {
             return it->second;
         }
         return nullptr;
     }
 
-    void remove(const std::string & ns, const std::string & name) {
-        // ns is sub-ns like "variables"
-        std::string flat_key = ns + key_separator + name;
-        flat_symbols_.erase(flat_key);
+    /** @brief Whether @p pred holds for every symbol in the table. */
+    template <typename Pred> bool allOf(Pred && pred) const {
+        for (const auto & entry : flat_symbols_) {
+            if (!pred(*entry.second)) {
+                return false;
+            }
+        }
+        return true;
     }
 
+    Atom frame() const { return frame_; }
+
+    void setFrame(Atom frame) { frame_ = frame; }
+
+    bool pooled() const { return pooled_; }
+
+    void setPooled(bool pooled) { pooled_ = pooled; }
+
+    bool call() const { return call_; }
 
-    std::vector<SymbolPtr> listAll(const std::string & prefix_ns = "") const {
+    void setCall(bool call) { call_ = call; }
+
+    Symbol * slot(size_t index) const { return index < slots_.size() ? slots_[index].get() : nullptr; }
+
+    const SymbolPtr & slotPtr(size_t index) const {
+        static const SymbolPtr empty;
+        return index < slots_.size() ? slots_[index] : empty;
+    }
+
+    void bindSlot(size_t index, const SymbolPtr & symbol) {
+        if (index >= slots_.size()) {
+            slots_.resize(index + 1);
+        }
+        slots_[index] = symbol;
+    }
+
+    void remove(const std::string & ns, const std::string & name) {
+        const Atom nsAtom   = AtomTable::find(ns);
+        const Atom nameAtom = AtomTable::find(name);
+        if (nsAtom != kNoAtom && nameAtom != kNoAtom) {
+            flat_symbols_.erase(key(nsAtom, nameAtom));
+            slots_.clear();
+        }
+    }
+
+    std::vector<SymbolPtr> listAll(const std::string & ns = "") const {
         std::vector<SymbolPtr> result;
-        std::string prefix_key = prefix_ns.empty() ? "" : (prefix_ns + key_separator);
-        for (const auto & [key, sym] : flat_symbols_) {
-            if (prefix_key.empty() || key.rfind(prefix_key, 0) == 0) { // Check if key starts with prefix_key
-                 result.push_back(sym);
+        const Atom             nsAtom = ns.empty() ? kNoAtom : AtomTable::find(ns);
+        if (!ns.empty() && nsAtom == kNoAtom) {
+            return result;
+        }
+        for (const auto & [k, sym] : flat_symbols_) {
+            if (ns.empty() || nsOf(k) == nsAtom) {
+                result.push_back(sym);
             }
         }
         return result;
     }
 
     void clear(const std::string & ns) {
-        // ns is sub-ns like "variables"
-        std::string prefix_key = ns + key_separator;
+        const Atom nsAtom = AtomTable::find(ns);
+        if (nsAtom == kNoAtom) {
+            return;
+        }
+        slots_.clear();
         for (auto it = flat_symbols_.begin(); it != flat_symbols_.end(); /* no increment */) {
-            if (it->first.rfind(prefix_key, 0) == 0) { // Check if key starts with prefix_key
-                it = flat_symbols_.erase(it); // Erase and advance iterator
+            if (nsOf(it->first) == nsAtom) {
+                it = flat_symbols_.erase(it);  // Erase and advance iterator
             } else {
-                ++it; // Advance iterator
+                ++it;  // Advance iterator
             }
         }
-     }
+    }
 
-    void clearAll() { flat_symbols_.clear(); }
+    void clearAll() {
+        flat_symbols_.clear();
+        slots_.clear();
+    }
 };
 
 }  // namespace Symbols
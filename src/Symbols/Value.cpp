@@ -27,92 +27,139 @@ namespace Symbols {
 
 void Value::setNULL() {
     is_null_flag = true;
+    storage_     = Storage::NONE;
     data_.reset();
 }
 
+void Value::throwBadCast(Storage expected) const {
+    auto storageName = [](Storage storage) -> std::string {
+        switch (storage) {
+            case Storage::INTEGER: return Variables::TypeToString(Variables::Type::INTEGER);
+            case Storage::DOUBLE:  return Variables::TypeToString(Variables::Type::DOUBLE);
+            case Storage::FLOAT:   return Variables::TypeToString(Variables::Type::FLOAT);
+            case Storage::BOOLEAN: return Variables::TypeToString(Variables::Type::BOOLEAN);
+            case Storage::STRING:  return Variables::TypeToString(Variables::Type::STRING);
+            case Storage::OBJECT:  return Variables::TypeToString(Variables::Type::OBJECT);
+            case Storage::ARRAY:   return "array";
+            case Storage::NONE:    return "null";
+        }
+        return "null";
+    };
+    throw std::runtime_error("Bad cast, expected: " + storageName(expected) + " got: " + storageName(storage_));
+}
+
+void Value::promoteToObject() const {
+    const auto & elements = *static_cast<const ArrayVector *>(data_.get());
+    const bool   shared   = data_.use_count() > 1;
+    auto         map      = std::make_shared<ObjectMap>();
+    for (size_t i = 0; i < elements.size(); ++i) {
+        // A shared vector's elements belong to the other copy too; the new map must not
+        // alias them.
+        map->emplace_hint(map->end(), std::to_string(i), shared ? elements[i].clone() : elements[i]);
+    }
+    data_    = std::move(map);
+    storage_ = Storage::OBJECT;
+}
+
+void Value::detach() {
+    // One level only: the cloned elements share their own payloads in turn, so a write
+    // deep inside a large structure copies just the path down to it.
+    if (storage_ == Storage::ARRAY) {
+        const auto & source = *static_cast<const ArrayVector *>(data_.get());
+        auto         copy   = std::make_shared<ArrayVector>();
+        copy->reserve(source.size());
+        for (const auto & element : source) {
+            copy->push_back(element.clone());
+        }
+        data_ = std::move(copy);
+    } else if (storage_ == Storage::OBJECT) {
+        const auto & source = *static_cast<const ObjectMap *>(data_.get());
+        auto         copy   = std::make_shared<ObjectMap>();
+        for (const auto & pair : source) {
+            copy->emplace_hint(copy->end(), pair.first, pair.second.clone());
+        }
+        data_ = std::move(copy);
+    }
+}
+
+size_t Value::objectSize() const {
+    switch (storage_) {
+        case Storage::ARRAY:
+            return static_cast<const ArrayVector *>(data_.get())->size();
+        case Storage::OBJECT:
+            return static_cast<const ObjectMap *>(data_.get())->size();
+        default:
+            return 0;
+    }
+}
+
+bool Value::adoptArrayStorage() {
+    if (storage_ == Storage::OBJECT && type_ == Variables::Type::OBJECT && !is_null_flag &&
+        static_cast<const ObjectMap *>(data_.get())->empty()) {
+        data_    = std::make_shared<ArrayVector>();
+        storage_ = Storage::ARRAY;
+    }
+    return storage_ == Storage::ARRAY;
+}
+
+bool Value::parseArrayIndex(const std::string & key, size_t & index) {
+    if (key.empty() || key.size() > 18 || (key.size() > 1 && key[0] == '0')) {
+        return false;
+    }
+    size_t result = 0;
+    for (char c : key) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        result = result * 10 + static_cast<size_t>(c - '0');
+    }
+    index = result;
+    return true;
+}
+
 Value::Value() {
     setNULL();  // Calls the moved Value::setNULL()
 }
 
 void Value::clone_data_from(const Value & other) {
-    // Reset current data
+    // Scalars live inline and copy with the Value itself; strings are copied, and object
+    // payloads are shared until one side writes (see Value::detach).
+    this->type_        = other.type_;
+    this->storage_     = other.storage_;
+    this->scalar_      = other.scalar_;
+    this->is_null_flag = other.is_null_flag;
     this->data_.reset();
-    this->is_null_flag = true;  // Default to null until data is set
 
-    switch (other.type_) {
-        case Symbols::Variables::Type::INTEGER:
-            this->set<int>(other.get<int>());
-            break;
-        case Symbols::Variables::Type::DOUBLE:
-            this->set<double>(other.get<double>());
-            break;
-        case Symbols::Variables::Type::FLOAT:
-            this->set<float>(other.get<float>());
+    switch (other.storage_) {
+        case Storage::STRING:
+            this->data_ = std::make_shared<std::string>(other.get<std::string>());
             break;
-        case Symbols::Variables::Type::BOOLEAN:
-            this->set<bool>(other.get<bool>());
+        case Storage::OBJECT:
+        case Storage::ARRAY:
+            // Copy-on-write: share the payload; the first mutable access splits it.
+            // type_ was copied above, so a CLASS stays a CLASS.
+            this->data_ = other.data_;
             break;
-        case Symbols::Variables::Type::STRING:
-            this->set<std::string>(other.get<std::string>());
+        case Storage::INTEGER:
+        case Storage::DOUBLE:
+        case Storage::FLOAT:
+        case Storage::BOOLEAN:
+        case Storage::NONE:
             break;
-        case Symbols::Variables::Type::OBJECT:
-            {
-                const auto & source_map = other.get<ObjectMap>();
-                ObjectMap    new_map;
-                for (const auto & pair : source_map) {
-                    new_map[pair.first] = pair.second.clone();  // Assumes ValuePtr::clone() exists
-                }
-                this->set<ObjectMap>(new_map);
-                break;
-            }
-        case Symbols::Variables::Type::CLASS:
-            {
-                const auto & source_map = other.get<ObjectMap>();
-                ObjectMap    new_map;
-                for (const auto & pair : source_map) {
-                    new_map[pair.first] = pair.second.clone();
-                }
-                this->set<ObjectMap>(new_map);
-                this->type_ = Symbols::Variables::Type::CLASS;  // Override the type to CLASS
-                break;
-            }
-        case Symbols::Variables::Type::NULL_TYPE:
-            this->setNULL();
-            break;
-        default:
-            this->setNULL();
-            break;
-    }
-
-    if (this->data_) {
-        this->is_null_flag = false;
-        // type_ and type_id_ are set by set<T>()
-    } else {
-        // Data was not set (e.g., setNULL() was called or unhandled type).
-        this->is_null_flag  = true;
-        this->type_    = other.type_;  // Preserve original type info for null values
-        this->type_id_ = other.type_id_;
     }
 }
 
 std::shared_ptr<Value> Value::clone() const {
     auto new_value = std::make_shared<Value>();
-
-    new_value->type_    = this->type_;
-    new_value->type_id_ = this->type_id_;
-    new_value->is_null_flag  = this->is_null_flag;
-
-    if (!this->is_null_flag && this->data_) {
-        new_value->clone_data_from(*this);
-    }
+    new_value->clone_data_from(*this);
     return new_value;
 }
 
 bool Value::is_null() const {
-    // is_null_flag is the primary flag. data_ check is secondary.
+    // is_null_flag is the primary flag. The storage tag check is secondary.
     // A Value can be semantically null (is_null_flag = true) but have a type (e.g. null string).
-    // A Value might also be is_null_flag = false, but data_ is null if improperly handled (should not happen).
-    return is_null_flag || !data_;
+    // A Value might also be is_null_flag = false with no payload if improperly handled (should not happen).
+    return is_null_flag || storage_ == Storage::NONE;
 }
 
 Symbols::Variables::Type Value::getType() const {
@@ -124,22 +171,22 @@ std::string Value::toString() const {
         return "undefined";
     }
     if (is_null() && type_ != Variables::Type::STRING) {  // Allow toString on null strings/objects
-        if (type_ == Variables::Type::NULL_TYPE || (!data_ && type_ != Variables::Type::STRING)) {
+        if (type_ == Variables::Type::NULL_TYPE || (storage_ == Storage::NONE && type_ != Variables::Type::STRING)) {
             return "null";
         }
     }
 
     // Specific handling for STRING to allow "null" for null strings vs empty string ""
     if (type_ == Variables::Type::STRING) {
-        if (!data_ || is_null_flag) {  // if is_null_flag is true, it's a "null string"
+        if (storage_ == Storage::NONE || is_null_flag) {  // if is_null_flag is true, it's a "null string"
             return "null";
         }
         return get<std::string>();  // Will return "" if string is empty but not null
     }
 
-    // For other types, if data_ is null but is_null_flag wasn't true (e.g. uninitialized non-string)
+    // For other types, if there is no payload but is_null_flag wasn't true (e.g. uninitialized non-string)
     // or if is_null_flag is true, then it's "null"
-    if (!data_ || is_null_flag) {
+    if (storage_ == Storage::NONE || is_null_flag) {
         return "null";
     }
 
@@ -168,6 +215,19 @@ std::string Value::toString() const {
             }
         case Variables::Type::OBJECT:
             {
+                if (storage_ == Storage::ARRAY) {
+                    const auto & elements = get<ArrayVector>();
+                    if (elements.empty()) {
+                        return "{}";
+                    }
+                    std::string result = "{";
+                    for (size_t i = 0; i < elements.size(); ++i) {
+                        if (i != 0) result += ", ";
+                        result += "\"" + std::to_string(i) + "\": " + elements[i].toString();
+                    }
+                    result += "}";
+                    return result;
+                }
                 const auto & objMap = get<ObjectMap>();
                 if (objMap.empty()) {
                     return "{}";
@@ -398,6 +458,15 @@ bool ValuePtr::operator!=(Symbols::Variables::Type type) const {
 
 ValuePtr & ValuePtr::operator[](const std::string & key) {
     ensure_object();                           // Ensures ptr_ is valid and type is OBJECT
+    if (ptr_->isArray()) {
+        // Existing elements are addressed in place. Anything else could grow the
+        // vector and invalidate references handed out earlier, so take the map path.
+        auto & elements = ptr_->get<ArrayVector>();
+        size_t index    = 0;
+        if (Value::parseArrayIndex(key, index) && index < elements.size()) {
+            return elements[index];
+        }
+    }
     ObjectMap & map = ptr_->get<ObjectMap>();  // get<ObjectMap>() must return a reference
     return map[key];                           // map operator[] default-constructs ValuePtr if key not found
 }
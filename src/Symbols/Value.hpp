@@ -6,11 +6,14 @@
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <typeindex>
 #include <typeinfo>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "Symbols/OrderedMap.hpp"
 #include "Symbols/VariableTypes.hpp"
 #include "VariableTypes.hpp"
 
@@ -19,7 +22,9 @@ namespace Symbols {
 class Value;
 class ValuePtr;
 
-using ObjectMap = std::map<std::string, ValuePtr>;
+// Objects keep their keys in insertion order (see OrderedMap).
+using ObjectMap   = OrderedMap<ValuePtr>;
+using ArrayVector = std::vector<ValuePtr>;
 
 // Type mapping
 const static std::unordered_map<std::type_index, Symbols::Variables::Type> type_names = {
@@ -36,9 +41,34 @@ class Value {
     friend class ValuePtr;  // ValuePtr needs access to Value's private members
 
   private:
-    Symbols::Variables::Type type_ = Variables::Type::NULL_TYPE;
-    std::shared_ptr<void>    data_;
-    std::type_index          type_id_ = typeid(void);
+    // Where the payload lives. The scalar types are stored inline in scalar_, so a
+    // ValuePtr(int) costs one allocation (the Value itself) instead of two, and get<int>()
+    // is a tag compare instead of a type_index compare plus a pointer cast. Only strings
+    // and object maps keep an out-of-line, type-erased allocation in data_.
+    //
+    // A list ("0", "1", ... "N-1") is an OBJECT held as a dense ArrayVector (ARRAY). It
+    // stays dense while it is read by index, appended to or overwritten in place, and is
+    // promoted to an ObjectMap the first time anything needs map semantics - a
+    // non-sequential key, or a get<ObjectMap>() from code that is not array-aware.
+    enum class Storage : unsigned char { NONE, INTEGER, DOUBLE, FLOAT, BOOLEAN, STRING, OBJECT, ARRAY };
+
+    union Scalar {
+        int    i;
+        double d;
+        float  f;
+        bool   b;
+    };
+
+    Symbols::Variables::Type type_    = Variables::Type::NULL_TYPE;
+    // Mutable so a const get<ObjectMap>() can promote an ARRAY in place. Promotion
+    // changes the representation, never the observable contents.
+    //
+    // OBJECT and ARRAY payloads are copy-on-write: clone() shares data_, and the first
+    // mutable access through a Value whose payload is shared (use_count() > 1) splits it
+    // with detach(). Reads go through the const accessors and never split.
+    mutable Storage               storage_ = Storage::NONE;
+    Scalar                        scalar_{};
+    mutable std::shared_ptr<void> data_;
   public: // Temporarily public for debugging
     bool                     is_null_flag  = false;
   private: // Back to private
@@ -46,21 +76,57 @@ class Value {
     // Private methods - Declarations only
     void setNULL();
     void clone_data_from(const Value & other);
+    [[noreturn]] void throwBadCast(Storage expected) const;
+    void promoteToObject() const;
+    void detach();
+
+    template <typename T> static constexpr Storage storageOf() {
+        if constexpr (std::is_same_v<T, int>) {
+            return Storage::INTEGER;
+        } else if constexpr (std::is_same_v<T, double>) {
+            return Storage::DOUBLE;
+        } else if constexpr (std::is_same_v<T, float>) {
+            return Storage::FLOAT;
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return Storage::BOOLEAN;
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            return Storage::STRING;
+        } else if constexpr (std::is_same_v<T, ArrayVector>) {
+            return Storage::ARRAY;
+        } else {
+            static_assert(std::is_same_v<T, ObjectMap>, "Value can only hold int, double, float, bool, string, ObjectMap or ArrayVector");
+            return Storage::OBJECT;
+        }
+    }
 
     // Templated methods remain in the header
     template <typename T> void set(T data) {
-        this->data_    = std::make_shared<T>(std::move(data));
-        this->type_id_ = std::type_index(typeid(T));
-        // Safely access type_names, ensuring the type exists
-        auto it        = type_names.find(std::type_index(typeid(T)));
-        if (it != type_names.end()) {
-            this->type_ = it->second;
+        constexpr Storage storage = storageOf<T>();
+        if constexpr (storage == Storage::INTEGER) {
+            this->scalar_.i = data;
+            this->data_.reset();
+            this->type_ = Variables::Type::INTEGER;
+        } else if constexpr (storage == Storage::DOUBLE) {
+            this->scalar_.d = data;
+            this->data_.reset();
+            this->type_ = Variables::Type::DOUBLE;
+        } else if constexpr (storage == Storage::FLOAT) {
+            this->scalar_.f = data;
+            this->data_.reset();
+            this->type_ = Variables::Type::FLOAT;
+        } else if constexpr (storage == Storage::BOOLEAN) {
+            this->scalar_.b = data;
+            this->data_.reset();
+            this->type_ = Variables::Type::BOOLEAN;
+        } else if constexpr (storage == Storage::STRING) {
+            this->data_ = std::make_shared<T>(std::move(data));
+            this->type_ = Variables::Type::STRING;
         } else {
-            // Handle unknown type, perhaps throw or set to a default/unknown type
-            // For now, let's assume types used with set<T> are in type_names
-            // or this could be an assertion point depending on design philosophy.
-            throw std::runtime_error("Type not found in type_names map during Value::set");
+            // ObjectMap and ArrayVector are both script-level objects.
+            this->data_ = std::make_shared<T>(std::move(data));
+            this->type_ = Variables::Type::OBJECT;
         }
+        this->storage_     = storage;
         this->is_null_flag = false;  // Successfully setting data means it's not null.
     }
 
@@ -74,46 +140,73 @@ class Value {
     Symbols::Variables::Type getType() const;
     std::string              toString() const;
 
+    // True while this object is held as a dense ArrayVector. Array-aware code checks this
+    // before get<ObjectMap>(), which would promote the value to a map.
+    bool isArray() const { return storage_ == Storage::ARRAY; }
+
+    // Element count of an OBJECT/CLASS without promoting a dense array.
+    size_t objectSize() const;
+
+    // Switches an empty plain OBJECT map to an empty dense array, so a list built by
+    // appending to `[]` stays dense. Returns isArray().
+    bool adoptArrayStorage();
+
+    // True when this OBJECT/ARRAY payload is still shared with a clone. Readers that hand
+    // out a nested object or array must split first (see ArrayAccessExpressionNode), or a
+    // write through that element would show up in both copies.
+    bool isShared() const {
+        return (storage_ == Storage::OBJECT || storage_ == Storage::ARRAY) && data_.use_count() > 1;
+    }
+
+    // Splits a shared payload now, keeping its representation (array or map).
+    void unshare() {
+        if (isShared()) {
+            detach();
+        }
+    }
+
+    // Parses a canonical array key ("0", "17"; no sign, no leading zeros) into an index.
+    static bool parseArrayIndex(const std::string & key, size_t & index);
+
     std::string getDebugStateString() const {
-        std::string type_str       = Symbols::Variables::TypeToString(this->type_);
-        std::string null_str       = this->is_null_flag ? "true" : "false";
-        std::string data_valid_str = this->data_ ? "true" : "false";
-        return "type='" + type_str + "', is_null='" + null_str + "', data_ptr_valid='" + data_valid_str + "'";
+        std::string type_str     = Symbols::Variables::TypeToString(this->type_);
+        std::string null_str     = this->is_null_flag ? "true" : "false";
+        std::string payload_str  = this->storage_ != Storage::NONE ? "true" : "false";
+        return "type='" + type_str + "', is_null='" + null_str + "', has_payload='" + payload_str + "'";
     }
 
     // Templated methods remain in the header
     template <typename T> const T & get() const {
-        if (type_id_ != typeid(T)) {
-            std::string expected_name = Symbols::Variables::TypeToString(type_names.at(typeid(T)));
-            std::string got_name      = Symbols::Variables::TypeToString(type_names.at(type_id_));
-            std::string error_msg     = "Bad cast, expected: " + expected_name + " got: " + got_name;
-            throw std::runtime_error(error_msg);
+        constexpr Storage storage = storageOf<T>();
+        if constexpr (storage == Storage::OBJECT) {
+            if (storage_ == Storage::ARRAY) {
+                promoteToObject();
+            }
         }
-        if (!data_) {  // Check if data pointer is null
-            std::string type_str = Symbols::Variables::TypeToString(this->type_);
-            std::string err_msg =
-                "Attempted to access data from a Value object with null data pointer. Value state: type='" + type_str +
-                "', is_null='" + (this->is_null_flag ? "true" : "false") + "'.";
-            throw std::runtime_error(err_msg);
+        if (storage_ != storage) {
+            throwBadCast(storage);
+        }
+        if constexpr (storage == Storage::INTEGER) {
+            return scalar_.i;
+        } else if constexpr (storage == Storage::DOUBLE) {
+            return scalar_.d;
+        } else if constexpr (storage == Storage::FLOAT) {
+            return scalar_.f;
+        } else if constexpr (storage == Storage::BOOLEAN) {
+            return scalar_.b;
+        } else {
+            return *static_cast<const T *>(data_.get());
         }
-        return *std::static_pointer_cast<T>(data_);
     }
 
     template <typename T> T & get() {
-        if (type_id_ != typeid(T)) {
-            std::string expected_name = Symbols::Variables::TypeToString(type_names.at(typeid(T)));
-            std::string got_name      = Symbols::Variables::TypeToString(type_names.at(type_id_));
-            std::string error_msg     = "Bad cast, expected: " + expected_name + " got: " + got_name;
-            throw std::runtime_error(error_msg);
+        constexpr Storage storage = storageOf<T>();
+        if constexpr (storage == Storage::OBJECT || storage == Storage::ARRAY) {
+            if (isShared()) {
+                detach();
+            }
         }
-        if (!data_) {  // Check if data pointer is null
-            std::string type_str = Symbols::Variables::TypeToString(this->type_);
-            std::string err_msg =
-                "Attempted to access data from a Value object with null data pointer. Value state: type='" + type_str +
-                "', is_null='" + (this->is_null_flag ? "true" : "false") + "'.";
-            throw std::runtime_error(err_msg);
-        }
-        return *std::static_pointer_cast<T>(data_);
+        return const_cast<T &>(std::as_const(*this).template get<T>());
     }
 };
 
@@ -165,6 +258,8 @@ class ValuePtr {
 
     ValuePtr(const ObjectMap & v) : ptr_(std::make_shared<Value>()) { ptr_->set(v); }
 
+    ValuePtr(ArrayVector v) : ptr_(std::make_shared<Value>()) { ptr_->set(std::move(v)); }
+
     // Constructor for class types
     ValuePtr(const ObjectMap & v, bool isClass) : ptr_(std::make_shared<Value>()) {
         ptr_->set(v);
@@ -249,7 +344,7 @@ class ValuePtr {
         if (!ptr_) {
             throw std::runtime_error("ValuePtr has null internal pointer in const get<T>().");
         }
-        return ptr_->get<T>();
+        return std::as_const(*ptr_).template get<T>();
     }
 
     // Universal conversion operator with type constraints
@@ -271,7 +366,7 @@ class ValuePtr {
             throw std::runtime_error("Cannot convert NULL value (universal conversion operator)");
         }
 
-        return ptr_->get<T>();
+        return std::as_const(*ptr_).template get<T>();
     }
 
     // Specialized boolean conversion operator
@@ -299,7 +394,7 @@ class ValuePtr {
                 try {
                     return ptr_->get<bool>();
                 } catch (const std::runtime_error &) {
-                    return !ptr_->get<ObjectMap>().empty();
+                    return ptr_->objectSize() != 0;
                 }
             default:
                 throw std::runtime_error("Cannot convert type to boolean");
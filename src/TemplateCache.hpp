@@ -0,0 +1,138 @@
+#ifndef VOIDSCRIPT_TEMPLATE_CACHE_HPP
+#define VOIDSCRIPT_TEMPLATE_CACHE_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Interpreter/Operation.hpp"
+
+/**
+ * @brief Parsed templates kept between runs in one process (the FastCGI server; see
+ * VoidScript::setTemplateCacheEnabled).
+ *
+ * An entry holds a file's segments as VoidScript::run split them: the text outside the tags,
+ * and for each code segment the operations the parser, optimizer and type checker left in the
+ * file's namespace. Statement nodes are run again as they are for every call of a function,
+ * so a hit puts the operations back into the container and executes them.
+ *
+ * Entries are keyed by path and checked against the modification time and size of the file
+ * and of every file its parse included on every lookup; `include` is expanded when the
+ * including file is parsed, so a change to any of them is a miss and the file is parsed again.
+ *
+ * There is one cache per thread, like the containers the operations run from: a parsed
+ * function's body stays in its thread's Operations::Container, and statement nodes keep
+ * caches of what they resolved in their thread's SymbolContainer. Each thread of
+ * `voidscript-fcgi --threads` parses a template once.
+ */
+class TemplateCache {
+  public:
+    struct Segment {
+        bool        code = false;
+        std::string text;
+        // Code segments: the operations parsed from the text. Empty for a segment the run
+        // that filled the entry never reached (a `return` earlier in the file); such a
+        // segment is parsed when it is reached.
+        bool                                                  compiled = false;
+        std::vector<std::shared_ptr<Operations::Operation>> operations;
+    };
+
+    /** @brief A file a template was parsed from, as it was when it was read. */
+    struct Source {
+        std::string                     path;
+        std::filesystem::file_time_type mtime;
+        std::uintmax_t                  size = 0;
+    };
+
+    struct Template {
+        std::filesystem::file_time_type mtime;
+        std::uintmax_t                  size = 0;
+        std::string                     content;
+        std::vector<Segment>            segments;
+        // The files `include` pulled into the parse of the segments above
+        std::vector<Source>             includes;
+    };
+
+    static TemplateCache & instance() {
+        static thread_local TemplateCache instance_;
+        return instance_;
+    }
+
+    /**
+     * @brief The entry for @p path if the file and every file it included still have the
+     * modification time and size they had when they were read, else nullptr. Counts a hit
+     * or a miss.
+     */
+    std::shared_ptr<const Template> find(const std::string & path) {
+        std::shared_ptr<const Template> found;
+        const auto                      it = entries_.find(path);
+        if (it != entries_.end() && unchanged({ path, it->second->mtime, it->second->size })) {
+            found = it->second;
+            for (const Source & include : found->includes) {
+                if (!unchanged(include)) {
+                    found.reset();
+                    break;
+                }
+            }
+        }
+        ++(found ? hits_ : misses_);
+        return found;
+    }
+
+    /**
+     * @brief The modification time and size to store with @p path's entry, read before the
+     * file is, so a write that lands while it is parsed makes the next lookup a miss.
+     * @return false if the file cannot be examined; such a file is not cached.
+     */
+    static bool stamp(const std::string & path, Template & entry) {
+        std::error_code ec;
+        entry.mtime = std::filesystem::last_write_time(path, ec);
+        if (!ec) {
+            entry.size = std::filesystem::file_size(path, ec);
+        }
+        return !ec;
+    }
+
+    /**
+     * @brief Record the modification time and size of @p source.path, read before the file
+     * is, as stamp() does for the template itself.
+     * @return false if the file cannot be examined.
+     */
+    static bool stamp(Source & source) {
+        std::error_code ec;
+        source.mtime = std::filesystem::last_write_time(source.path, ec);
+        if (!ec) {
+            source.size = std::filesystem::file_size(source.path, ec);
+        }
+        return !ec;
+    }
+
+    /** @brief Store (or replace) the entry for @p path. */
+    void store(const std::string & path, std::shared_ptr<const Template> entry) { entries_[path] = std::move(entry); }
+
+    /** @brief Drop every entry. */
+    void clear() { entries_.clear(); }
+
+    size_t size() const { return entries_.size(); }
+
+    std::uint64_t hits() const { return hits_; }
+
+    std::uint64_t misses() const { return misses_; }
+
+  private:
+    TemplateCache() = default;
+
+    static bool unchanged(const Source & source) {
+        Source current{ source.path, {}, 0 };
+        return stamp(current) && current.mtime == source.mtime && current.size == source.size;
+    }
+
+    std::unordered_map<std::string, std::shared_ptr<const Template>> entries_;
+    std::uint64_t                                                    hits_   = 0;
+    std::uint64_t                                                    misses_ = 0;
+};
+
+#endif  // VOIDSCRIPT_TEMPLATE_CACHE_HPP
@@ -1,5 +1,6 @@
 #ifndef VOIDSCRIPT_HPP
 #define VOIDSCRIPT_HPP
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <iterator>
@@ -9,7 +10,7 @@
 #include <unistd.h>  // for readlink
 
 #include "Interpreter/Interpreter.hpp"
-#include "Interpreter/ReturnException.hpp"
+#include "Interpreter/Jit.hpp"
 #include "Lexer/Lexer.hpp"
 #include "Modules/BuiltIn/ArrayModule.hpp"
 #include "Modules/BuiltIn/ConversionModule.hpp"
@@ -43,9 +44,13 @@
 #    include "Modules/BuiltIn/HeaderModule.hpp"
 #endif
 #include "Interpreter/OperationsFactory.hpp"
+#include "Interpreter/Optimizer.hpp"
+#include "Interpreter/Output.hpp"
+#include "Interpreter/TypeChecker.hpp"
 #include "Parser/Parser.hpp"
 #include "Symbols/SymbolContainer.hpp"
 #include "Symbols/Value.hpp"
+#include "TemplateCache.hpp"
 
 class VoidScript {
   private:
@@ -54,6 +59,14 @@ class VoidScript {
     bool                            debugParser_      = false;
     bool                            debugInterpreter_ = false;
     bool                            debugSymbolTable_ = false;
+    // Run loops on the bytecode VM; false walks every statement (--engine=tree)
+    bool                            bytecode_         = true;
+    // Report proven type errors before running instead of when they are reached (--typecheck)
+    bool                            typecheck_        = false;
+    // Fold constants before running; false leaves the tree as parsed (--no-optimize)
+    bool                            optimize_         = true;
+    // Keep parsed templates in the calling thread's TemplateCache (the FastCGI server)
+    bool                            templateCache_    = false;
     std::vector<std::string>        files;
     // Only parse between open/close tags if enabled
     bool                            enableTags_          = false;
@@ -88,8 +101,16 @@ class VoidScript {
         return content;
     }
 
+    using PluginInitFunc = void (*)();
+
+    // A loaded plugin library and its entry point
+    struct Plugin {
+        std::string    path;
+        PluginInitFunc init = nullptr;
+    };
+
     // Load dynamic plugins from a directory
-    void loadPlugins(const std::string & directory) {
+    static void loadPlugins(const std::string & directory, std::vector<Plugin> & plugins) {
         if (!utils::exists(directory) || !utils::is_directory(directory)) {
             return;
         }
@@ -109,12 +130,12 @@ class VoidScript {
             }
 #endif
             
-            loadPlugin(entry.path().string());
+            loadPlugin(entry.path().string(), plugins);
         }
     }
     
-    // Load a single plugin library
-    void loadPlugin(const std::string & path) {
+    // Load a single plugin library; its plugin_init is called by initPlugin()
+    static void loadPlugin(const std::string & path, std::vector<Plugin> & plugins) {
         void * handle;
         
 #ifndef _WIN32
@@ -124,7 +145,6 @@ class VoidScript {
             return;
         }
 
-        using PluginInitFunc = void (*)();
         dlerror();  // Clear any existing errors
         PluginInitFunc init = reinterpret_cast<PluginInitFunc>(dlsym(handle, "plugin_init"));
         const char * dlsym_error = dlerror();
@@ -133,13 +153,6 @@ class VoidScript {
             dlclose(handle);
             return;
         }
-        
-        // Call the plugin initialization function with error handling
-        try {
-            init();
-        } catch (const std::exception & e) {
-            std::cerr << "Warning: Plugin initialization failed for " << path << ": " << e.what() << std::endl;
-        }
 #else
         handle = LoadLibraryA(path.c_str());
         if (!handle) {
@@ -147,72 +160,142 @@ class VoidScript {
             return;
         }
 
-        using PluginInitFunc = void (*)();
         PluginInitFunc init = reinterpret_cast<PluginInitFunc>(GetProcAddress((HMODULE) handle, "plugin_init"));
         if (!init) {
             std::cerr << "Warning: Plugin missing 'plugin_init' symbol: " << path << std::endl;
             FreeLibrary((HMODULE) handle);
             return;
         }
-        
-        // Call the plugin initialization function
-        init();
 #endif
-        // Note: We're not storing the handle for cleanup since modules register globally
-        // In a production system, you might want to track loaded plugins for cleanup
+        // The handle is never closed: the modules every thread registers run its code
+        plugins.push_back({ path, init });
     }
 
-  public:
-    /**
-     * @param file               initial script file
-     * @param debugLexer         enable lexer debug output
-     * @param debugParser        enable parser debug output
-     * @param debugInterpreter   enable interpreter debug output
-     */
-    VoidScript(const std::string & file, bool debugLexer = false, bool debugParser = false,
-               bool debugInterpreter = false, bool debugSymbolTable = false, bool enableTags = false,
-               bool suppressTagsOutside = false, std::vector<std::string> scriptArgs = {}) :
-        debugLexer_(debugLexer),
-        debugParser_(debugParser),
-        debugInterpreter_(debugInterpreter),
-        debugSymbolTable_(debugSymbolTable),
-        enableTags_(enableTags),
-        suppressTagsOutside_(suppressTagsOutside),
-        scriptArgs_(std::move(scriptArgs)),
-        lexer(std::make_shared<Lexer::Lexer>()),
-        parser(std::make_shared<Parser::Parser>()) {
-        // Initialize SymbolContainer with the main script file path
-        // Assuming 'file' parameter is the absolute path desired for the scope name.
-        Symbols::SymbolContainer::initialize(file);
+    // Register a loaded plugin's modules into the calling thread's SymbolContainer
+    static void initPlugin(const Plugin & plugin) {
+        // Call the plugin initialization function with error handling
+        try {
+            plugin.init();
+        } catch (const std::exception & e) {
+            std::cerr << "Warning: Plugin initialization failed for " << plugin.path << ": " << e.what() << std::endl;
+        }
+    }
+
+    // The plugin libraries, loaded once per process and shared by every thread
+    static const std::vector<Plugin> & plugins() {
+        static const std::vector<Plugin> loaded = [] {
+            std::vector<Plugin> plugins;
+            // Load dynamic plugins from modules directory
+            // Try installed location first, then fall back to development location
+            std::string modulesPath = MODULES_FOLDER;
+            if (!utils::exists(modulesPath) || !utils::is_directory(modulesPath)) {
+                // Fall back to development location relative to binary
+                // Get the current executable path and assume modules are in the same directory
+                char exePath[1024];
+                ssize_t count = readlink("/proc/self/exe", exePath, sizeof(exePath));
+                if (count != -1) {
+                    exePath[count] = '\0';
+                    std::string binPath(exePath);
+                    size_t lastSlash = binPath.find_last_of("/\\");
+                    std::string binDir = (lastSlash != std::string::npos) ? binPath.substr(0, lastSlash) : ".";
+                    modulesPath = binDir + "/Modules";
+                } else {
+                    // Fallback if readlink fails - assume we're in build directory
+                    modulesPath = "./Modules";
+                }
+            }
+
+            if (utils::exists(modulesPath) && utils::is_directory(modulesPath)) {
+                loadPlugins(modulesPath, plugins);
+            } else {
+                std::cerr << "Warning: modules directory not found: " << modulesPath << std::endl;
+            }
+            return plugins;
+        }();
+        return loaded;
+    }
+
+    // Split content into segments: code inside tags and outside tags
+    std::vector<TemplateCache::Segment> split(const std::string & file_content) const {
+        std::vector<TemplateCache::Segment> segments;
+        const auto                          add = [&segments](bool code, std::string text) {
+            segments.push_back({ code, std::move(text) });
+        };
+        if (!enableTags_) {
+            // Whole file is code to parse
+            add(true, file_content);
+            return segments;
+        }
+        std::string openTag(PARSER_OPEN_TAG);
+        std::string closeTag(PARSER_CLOSE_TAG);
+        size_t      pos = 0;
+        while (pos < file_content.size()) {
+            size_t start = file_content.find(openTag, pos);
+            if (start == std::string::npos) {
+                // Remaining outside text
+                if (!suppressTagsOutside_) {
+                    add(false, file_content.substr(pos));
+                }
+                break;
+            }
+            // Outside text before tag
+            if (start > pos && !suppressTagsOutside_) {
+                add(false, file_content.substr(pos, start - pos));
+            }
+            // Inside tag code
+            size_t code_start = start + openTag.size();
+            size_t end        = file_content.find(closeTag, code_start);
+            if (end != std::string::npos) {
+                add(true, file_content.substr(code_start, end - code_start));
+                pos = end + closeTag.size();
+            } else {
+                // No closing tag: take until end
+                add(true, file_content.substr(code_start));
+                pos = file_content.size();
+            }
+        }
+        return segments;
+    }
+
+    // Built-in modules and plugins register into the thread's SymbolContainer, so only the
+    // first VoidScript of a thread registers them. A server that runs a script per request
+    // (fastcgi/src/main.cpp) would otherwise register every module, and initialise every
+    // plugin, again for each request. Plugin libraries are loaded once per process.
+    static void registerModules() {
+        static thread_local bool registered = false;
+        if (registered) {
+            return;
+        }
+        registered = true;
 
         // Register built-in modules (print, etc.)
         auto symbolContainer = Symbols::SymbolContainer::instance();
-        
+
         // print functions
         auto printModule = std::make_unique<Modules::PrintModule>();
         printModule->setModuleName("Print");
         symbolContainer->registerModule(Modules::make_base_module_ptr(std::move(printModule)));
-        
+
         // variable helpers (typeof)
         auto varHelpersModule = std::make_unique<Modules::VariableHelpersModule>();
         varHelpersModule->setModuleName("VariableHelpers");
         symbolContainer->registerModule(Modules::make_base_module_ptr(std::move(varHelpersModule)));
-        
+
         // string helper functions
         auto stringModule = std::make_unique<Modules::StringModule>();
         stringModule->setModuleName("String");
         symbolContainer->registerModule(Modules::make_base_module_ptr(std::move(stringModule)));
-        
+
         // conversion functions (string_to_number, number_to_string)
         auto conversionModule = std::make_unique<Modules::ConversionModule>();
         conversionModule->setModuleName("Conversion");
         symbolContainer->registerModule(Modules::make_base_module_ptr(std::move(conversionModule)));
-        
+
         // array helper functions (sizeof)
         auto arrayModule = std::make_unique<Modules::ArrayModule>();
         arrayModule->setModuleName("Array");
         symbolContainer->registerModule(Modules::make_base_module_ptr(std::move(arrayModule)));
-        
+
         // file I/O builtin
         auto fileModule = std::make_unique<Modules::FileModule>();
         fileModule->setModuleName("File");
@@ -232,17 +315,17 @@ class VoidScript {
         auto processModule = std::make_unique<Modules::ProcessModule>();
         processModule->setModuleName("Process");
         symbolContainer->registerModule(Modules::make_base_module_ptr(std::move(processModule)));
-        
+
         // JSON encode/decode builtin
         auto jsonModule = std::make_unique<Modules::JsonModule>();
         jsonModule->setModuleName("Json");
         symbolContainer->registerModule(Modules::make_base_module_ptr(std::move(jsonModule)));
-        
+
         // date/time functions
         auto dateTimeModule = std::make_unique<Modules::DateTimeModule>();
         dateTimeModule->setModuleName("DateTime");
         symbolContainer->registerModule(Modules::make_base_module_ptr(std::move(dateTimeModule)));
-        
+
         // math functions (sin, cos, sqrt, etc.)
         auto mathModule = std::make_unique<Modules::MathModule>();
         mathModule->setModuleName("Math");
@@ -267,12 +350,12 @@ class VoidScript {
         auto socketModule = std::make_unique<Modules::SocketModule>();
         socketModule->setModuleName("Socket");
         symbolContainer->registerModule(Modules::make_base_module_ptr(std::move(socketModule)));
-        
+
         // module helper functions (module_list, module_info, etc.)
         auto moduleHelperModule = std::make_unique<Modules::ModuleHelperModule>();
         moduleHelperModule->setModuleName("ModuleHelper");
         symbolContainer->registerModule(Modules::make_base_module_ptr(std::move(moduleHelperModule)));
-        
+
 #ifdef CLI
         // readline functions for CLI input (readline, readchar, getline)
         auto readlineModule = std::make_unique<Modules::ReadlineModule>();
@@ -287,31 +370,36 @@ class VoidScript {
         symbolContainer->registerModule(Modules::make_base_module_ptr(std::move(headerModule)));
 #endif
 
-        // Load dynamic plugins from modules directory
-        // Try installed location first, then fall back to development location
-        std::string modulesPath = MODULES_FOLDER;
-        if (!utils::exists(modulesPath) || !utils::is_directory(modulesPath)) {
-            // Fall back to development location relative to binary
-            // Get the current executable path and assume modules are in the same directory
-            char exePath[1024];
-            ssize_t count = readlink("/proc/self/exe", exePath, sizeof(exePath));
-            if (count != -1) {
-                exePath[count] = '\0';
-                std::string binPath(exePath);
-                size_t lastSlash = binPath.find_last_of("/\\");
-                std::string binDir = (lastSlash != std::string::npos) ? binPath.substr(0, lastSlash) : ".";
-                modulesPath = binDir + "/Modules";
-            } else {
-                // Fallback if readlink fails - assume we're in build directory
-                modulesPath = "./Modules";
-            }
-        }
-        
-        if (utils::exists(modulesPath) && utils::is_directory(modulesPath)) {
-            loadPlugins(modulesPath);
-        } else {
-            std::cerr << "Warning: modules directory not found: " << modulesPath << std::endl;
+        // Dynamic plugins from the modules directory
+        for (const Plugin & plugin : plugins()) {
+            initPlugin(plugin);
         }
+    }
+
+  public:
+    /**
+     * @param file               initial script file
+     * @param debugLexer         enable lexer debug output
+     * @param debugParser        enable parser debug output
+     * @param debugInterpreter   enable interpreter debug output
+     */
+    VoidScript(const std::string & file, bool debugLexer = false, bool debugParser = false,
+               bool debugInterpreter = false, bool debugSymbolTable = false, bool enableTags = false,
+               bool suppressTagsOutside = false, std::vector<std::string> scriptArgs = {}) :
+        debugLexer_(debugLexer),
+        debugParser_(debugParser),
+        debugInterpreter_(debugInterpreter),
+        debugSymbolTable_(debugSymbolTable),
+        enableTags_(enableTags),
+        suppressTagsOutside_(suppressTagsOutside),
+        scriptArgs_(std::move(scriptArgs)),
+        lexer(std::make_shared<Lexer::Lexer>()),
+        parser(std::make_shared<Parser::Parser>()) {
+        // Initialize SymbolContainer with the main script file path
+        // Assuming 'file' parameter is the absolute path desired for the scope name.
+        Symbols::SymbolContainer::initialize(file);
+
+        registerModules();
 
         this->files.emplace(this->files.begin(), file);
 
@@ -327,57 +415,91 @@ class VoidScript {
         hasDirectContent_ = true;
     }
 
+    /**
+     * Choose between the bytecode VM and the tree walker for loops
+     * @param enabled false to walk every statement
+     */
+    void setBytecodeEnabled(bool enabled) { bytecode_ = enabled; }
+
+    /**
+     * Report type errors the type checker proves before the script starts
+     * @param enabled true to refuse to run a script with such errors
+     */
+    void setTypeCheckEnabled(bool enabled) { typecheck_ = enabled; }
+
+    /**
+     * Fold constant expressions, enum members and constants before the script runs
+     * @param enabled false to run the tree exactly as parsed, e.g. while debugging
+     */
+    void setOptimizeEnabled(bool enabled) { optimize_ = enabled; }
+
+    /**
+     * Keep the parsed template in the TemplateCache and run it from there while the file and
+     * the files it includes keep their modification time and size. There is one cache per
+     * thread, so each thread parses a template once. For a process that runs the same files
+     * again and again; debug output of the lexer and parser only shows on a miss
+     * @param enabled true to look the file up in the cache
+     */
+    void setTemplateCacheEnabled(bool enabled) { templateCache_ = enabled; }
+
+    /**
+     * Compile hot script functions to native code (see Interpreter/Jit.hpp). The tier is
+     * process-wide, so this applies to every script run in the process
+     * @param threshold calls plus loop iterations before a function is compiled; 0 disables
+     */
+    void setJitThreshold(std::uint32_t threshold) { Interpreter::Jit::Tier::instance().configure(threshold); }
+
     int run() {
+        // Leave the scope stack as it was found: the file scope pushed below (and whatever a
+        // failed script left above it) would otherwise keep the variables of every run alive
+        // in a process that runs many, such as voidscript-fcgi.
+        struct ScopeRestore {
+            size_t depth = Symbols::SymbolContainer::instance()->getScopeStack().size();
+
+            ~ScopeRestore() { Symbols::SymbolContainer::instance()->unwindScopeStack(depth); }
+        } scopeRestore;
+        // Output buffers the script leaves open (ob_start()) are written out when it ends
+        Interpreter::Output::BufferScope outputBuffers;
+
         try {
             // Plugin loading is now handled directly by the modules themselves
             // Each module registers its functions with SymbolContainer
             while (!files.empty()) {
-                std::string       file         = files.back();
-                const std::string file_content = readFile(file);
+                std::string file = files.back();
                 files.pop_back();
-                // Split content into segments: code inside tags and outside tags
-                std::vector<std::pair<bool, std::string>> segments;
-                if (!enableTags_) {
-                    // Whole file is code to parse
-                    segments.emplace_back(true, file_content);
-                } else {
-                    std::string openTag(PARSER_OPEN_TAG);
-                    std::string closeTag(PARSER_CLOSE_TAG);
-                    size_t      pos = 0;
-                    while (pos < file_content.size()) {
-                        size_t start = file_content.find(openTag, pos);
-                        if (start == std::string::npos) {
-                            // Remaining outside text
-                            std::string outside = file_content.substr(pos);
-                            if (!suppressTagsOutside_) {
-                                segments.emplace_back(false, outside);
-                            }
-                            break;
-                        }
-                        // Outside text before tag
-                        if (start > pos && !suppressTagsOutside_) {
-                            segments.emplace_back(false, file_content.substr(pos, start - pos));
-                        }
-                        // Inside tag code
-                        size_t      code_start = start + openTag.size();
-                        size_t      end        = file_content.find(closeTag, code_start);
-                        std::string code;
-                        if (end != std::string::npos) {
-                            code = file_content.substr(code_start, end - code_start);
-                            pos  = end + closeTag.size();
-                        } else {
-                            // No closing tag: take until end
-                            code = file_content.substr(code_start);
-                            pos  = file_content.size();
+
+                // A cached template goes straight to execution; on a miss the file is read,
+                // split and parsed below, and the result is stored once it has run.
+                const bool cacheable = templateCache_ && !hasDirectContent_ && file != "-";
+                std::shared_ptr<const TemplateCache::Template> cached;
+                std::shared_ptr<TemplateCache::Template>       filling;
+                if (cacheable) {
+                    cached = TemplateCache::instance().find(file);
+                    if (!cached) {
+                        filling = std::make_shared<TemplateCache::Template>();
+                        if (!TemplateCache::stamp(file, *filling)) {
+                            filling.reset();
                         }
-                        segments.emplace_back(true, code);
                     }
                 }
+                std::shared_ptr<const TemplateCache::Template> parsed = cached;
+                if (!parsed) {
+                    auto fresh      = filling ? filling : std::make_shared<TemplateCache::Template>();
+                    fresh->content  = readFile(file);
+                    fresh->segments = split(fresh->content);
+                    parsed          = fresh;
+                    // Function and class bodies of an earlier run of this file are still in
+                    // the container; parsing it again would append to them.
+                    Operations::Container::instance()->clearNested(file);
+                }
+                const std::string & file_content = parsed->content;
 
                 const std::string & current_file_scope_name = file;
                 Symbols::SymbolContainer::instance()->create(current_file_scope_name);
 
                 const std::string ns = Symbols::SymbolContainer::instance()->currentScopeName();
+                // Whatever an earlier run of this file left unexecuted when it failed
+                Operations::Container::instance()->clear(ns);
                 // Pre-define script arguments: $argc (int) and $argv (string array as object map)
                 {
                     // Define argc (including the script name)
@@ -394,14 +516,25 @@ class VoidScript {
                     Interpreter::OperationsFactory::defineSimpleConstantVariable("argv", argv_map, ns, file, 0, 0);
                 }
 
+                // One optimizer for the file's segments, so what one declares counts for the next
+                Interpreter::Optimizer optimizer;
+                bool                   optimizerPrimed = false;
+
                 // Process each segment: either plain text or code to execute
-                for (const auto & seg : segments) {
-                    if (!seg.first) {
+                for (size_t index = 0; index < parsed->segments.size(); ++index) {
+                    const TemplateCache::Segment & seg = parsed->segments[index];
+                    if (!seg.code) {
                         // Outside tag text: print as-is
-                        std::cout << seg.second;
+                        Interpreter::Output::out() << seg.text;
+                        continue;
+                    }
+                    if (seg.compiled) {
+                        Operations::Container::instance()->add(ns, seg.operations);
                     } else {
                         // Inside tag code: tokenize, parse, and execute
-                        this->lexer->addNamespaceInput(ns, seg.second);
+                        const auto * pending  = Operations::Container::instance()->find(ns);
+                        const size_t argument = pending ? pending->size() : 0;  // $argc and $argv
+                        this->lexer->addNamespaceInput(ns, seg.text);
                         const auto tokens = this->lexer->tokenizeNamespace(ns);
                         if (debugLexer_) {
                             std::cerr << "[Debug][Lexer] Tokens for namespace '" << ns << "':\n";
@@ -409,37 +542,81 @@ class VoidScript {
                                 std::cerr << tok.dump();
                             }
                         }
+                        auto * container = Operations::Container::instance();
+                        if (optimize_ && !optimizerPrimed) {
+                            // Bodies parsed before this run may declare what it would inline
+                            optimizer.declarations(container->getAll());
+                            optimizerPrimed = true;
+                        }
+                        Operations::Container::Recording recording(*container);
+                        parser->takeIncludes();  // left over from a parse that failed
                         parser->parseScript(tokens, file_content, file);
+                        auto includes = parser->takeIncludes();
+                        if (filling) {
+                            filling->includes.insert(filling->includes.end(), includes.begin(), includes.end());
+                        }
                         if (debugParser_) {
                             std::cerr << "[Debug][Parser] Operations for namespace '" << ns << "':\n";
                             for (const auto & op : Operations::Container::instance()->getAll(ns)) {
                                 std::cerr << op->toString() << "\n";
                             }
                         }
-                        Interpreter::Interpreter interpreter(debugInterpreter_);
-                        interpreter.run();
-                        // Clear operations after execution to avoid re-running
+                        // Both passes see only what this segment added: the operations of
+                        // earlier segments, function bodies included, were done with them.
+                        const auto & added = recording.operations;
+                        if (optimize_) {
+                            const auto & fileScope = *container->find(ns);
+                            optimizer.run(added, std::vector<std::shared_ptr<Operations::Operation>>(
+                                                     fileScope.begin() + argument, fileScope.end()));
+                        }
+                        // Annotate what the type checker proves
+                        Interpreter::TypeChecker checker;
+                        for (const auto & op : added) {
+                            checker.check(op->statement);
+                        }
+                        if (typecheck_ && !checker.diagnostics().empty()) {
+                            for (const auto & diagnostic : checker.diagnostics()) {
+                                Interpreter::Output::err() << diagnostic.toString() << '\n';
+                            }
+                            return 1;
+                        }
+                        if (filling) {
+                            const auto & operations = *Operations::Container::instance()->find(ns);
+                            filling->segments[index].operations.assign(operations.begin() + argument,
+                                                                       operations.end());
+                            filling->segments[index].compiled = true;
+                        }
+                    }
+                    Interpreter::Interpreter interpreter(debugInterpreter_);
+                    interpreter.setBytecodeEnabled(bytecode_);
+                    if (interpreter.run()) {
+                        // A return outside any function ends the script, as it does in PHP.
                         Operations::Container::instance()->clear(ns);
-                        if (debugSymbolTable_) {
-                            std::cout << Symbols::SymbolContainer::dump() << "\n";
+                        if (filling) {
+                            TemplateCache::instance().store(file, filling);
                         }
+                        return 0;
+                    }
+                    // Clear operations after execution to avoid re-running
+                    Operations::Container::instance()->clear(ns);
+                    if (debugSymbolTable_) {
+                        std::cout << Symbols::SymbolContainer::dump() << "\n";
                     }
                 }
+                if (filling) {
+                    TemplateCache::instance().store(file, filling);
+                }
             }  // while (!files.empty())
 
-            return 0;
-        } catch (const Interpreter::ReturnException &) {
-            // A return outside any function ends the script, as it does in PHP.
             return 0;
         } catch (const std::exception & e) {
-            std::cerr << e.what() << '\n';
+            Interpreter::Output::err() << e.what() << '\n';
             return 1;
         } catch (...) {
-            // Backstop. Nothing thrown by the interpreter should reach here, but
-            // ReturnException is not a std::exception and neither are any future
-            // control-flow signals, so without this an escaped one aborts the process
-            // via std::terminate with no diagnostic at all.
-            std::cerr << "Internal error: unhandled exception\n";
+            // Backstop. Nothing thrown by the interpreter should reach here, but a
+            // native module could throw something that is not a std::exception, and
+            // without this it aborts the process via std::terminate with no diagnostic.
+            Interpreter::Output::err() << "Internal error: unhandled exception\n";
             return 1;
         }
         return 1;
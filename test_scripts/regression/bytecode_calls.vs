@@ -0,0 +1,79 @@
+// Loops that build strings and call script functions run on the bytecode VM too. Each
+// case must print the same with either engine: concatenation with nested calls,
+// interpolation, a callee reading a variable the loop writes (which keeps that loop on
+// the tree walker), errors thrown inside callees, and string comparison.
+
+function cell(int $v) string {
+    return "<td>" + $v + "</td>";
+}
+
+function twice(int $v) int {
+    return $v * 2;
+}
+
+function label() string {
+    return "n=" + $n;
+}
+
+function check(int $v) string {
+    if ($v > 3) {
+        throw "too big: " + $v;
+    }
+    return "ok";
+}
+
+function div(int $a, int $b) int {
+    return $a / $b;
+}
+
+string $html = "";
+for (int $i = 0; $i < 5; $i++) {
+    $html = $html + "<tr>" + cell($i) + cell(twice($i)) + "</tr>";
+}
+printnl($html);
+
+string $s = "";
+int $k = 0;
+while ($k < 4) {
+    $s = "$s[$k:" + ($k % 2 == 0) + "]";
+    printnl($s);
+    $k++;
+}
+
+int $n = 0;
+string $out = "";
+for (int $j = 0; $j < 3; $j++) {
+    $n = $n + 1;
+    $out = $out + label() + ";";
+}
+printnl($out);
+
+string $log = "";
+try {
+    for (int $t = 0; $t < 10; $t++) {
+        $log = $log + check($t);
+    }
+} catch (string $e) {
+    printnl("caught: ", $e);
+}
+printnl($log);
+
+int $acc = 0;
+try {
+    for (int $t = 3; $t > -3; $t--) {
+        $acc = $acc + twice(div(12, $t));
+    }
+} catch (string $e) {
+    printnl("caught: ", $e);
+}
+printnl($acc);
+
+string $same = "x";
+int $count = 0;
+for (int $t = 0; $t < 3; $t++) {
+    if ($same == "x" && $same != "y") {
+        $count = $count + 1;
+    }
+    $same = $same + $same;
+}
+printnl($same, " ", $count, " ", 1.5 + "|" + true);
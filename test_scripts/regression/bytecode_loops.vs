@@ -0,0 +1,61 @@
+// Scalar loops run on the bytecode VM unless --engine=tree is given. Each case here
+// must print the same with either engine: typed arithmetic and promotion, widening
+// assignments, break and continue in nested loops, declarations in loop bodies, and a
+// runtime error part way through, after which the variables keep what they had.
+
+int $sum = 0;
+double $half = 0.0;
+float $f = 0;
+for (int $i = 0; $i < 10; $i++) {
+    if ($i % 2 == 0) {
+        $sum = $sum + $i * $i;
+    } else {
+        $half = $half + $i / 2;
+        $f = $f + 0.5;
+    }
+}
+printnl($sum, " ", $half, " ", $f);
+
+int $pairs = 0;
+int $i = 0;
+while (true) {
+    $i++;
+    if ($i > 6) {
+        break;
+    }
+    if ($i == 3) {
+        continue;
+    }
+    for (int $j = 0; $j < 10; $j++) {
+        if ($j >= $i) {
+            break;
+        }
+        int $k = $j << 1;
+        if (($k & 2) != 0 || $j == 0) {
+            $pairs = $pairs + 1;
+        }
+    }
+}
+printnl($pairs, " ", $i);
+
+bool $flag = false;
+double $x = 1.5;
+int $n = 0;
+while ($x < 100.0 && !$flag) {
+    $x = $x * 2;
+    $n = $n + 1;
+    $flag = $n >= 5;
+}
+printnl($x, " ", $n, " ", $flag);
+
+int $d = 5;
+int $q = 0;
+try {
+    for (int $c = 0; $c < 10; $c++) {
+        $q = $q + 100 / $d;
+        $d = $d - 1;
+    }
+} catch (string $e) {
+    printnl("caught: ", $e);
+}
+printnl($q, " ", $d);
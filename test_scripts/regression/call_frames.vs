@@ -0,0 +1,55 @@
+// Call frames come from a pool and are released on return, so a long run neither grows
+// the scope table nor keeps frames alive. Pass a call count to soak it, e.g.
+//   voidscript call_frames.vs 10000000
+int $calls = 200000;
+if ($argc > 1) {
+    $calls = string_to_number($argv[1]);
+}
+
+function step(int $x) int {
+    int $y = $x + 1;
+    for (int $k = 0; $k < 1; $k++) {
+        $y = $y + 0;
+    }
+    return $y;
+}
+
+function depth(int $n) int {
+    if ($n == 0) {
+        return 0;
+    }
+    return depth($n - 1) + 1;
+}
+
+function fails(int $x) int {
+    throw "fail " + $x;
+}
+
+class Box {
+    private: int $v = 0;
+    public:
+        function construct(int $v) { $this->v = $v; }
+        function get() int { return $this->v; }
+}
+
+object $before = vm_stats();
+
+int $n = 0;
+for (int $i = 0; $i < $calls; $i++) {
+    $n = step($n);
+}
+int $d = depth(200);
+Box $b = new Box(7);
+int $m = $b->get();
+string $caught = "";
+try {
+    fails(1);
+} catch ($e) {
+    $caught = $e;
+}
+
+object $after = vm_stats();
+printnl($n == $calls, " ", $d, " ", $m, " ", $caught);
+printnl("live ", $after["frames_live"], " scopes ", $after["scopes"] - $before["scopes"]);
+printnl("reused ", $after["frames_allocated"] < 1000, " ", $after["frames_entered"] - $before["frames_entered"] > $calls);
+printnl("frames-done");
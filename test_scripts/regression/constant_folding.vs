@@ -0,0 +1,78 @@
+// Constant folding, enum and const inlining, and `if` pruning (Interpreter/Optimizer.hpp).
+// Every line must read the same with --no-optimize.
+// Expected: clean exit 0.
+
+enum Color {
+    RED,
+    GREEN = 5,
+    BLUE
+};
+
+const int $DAY = 60 * 60 * 24;
+const int $WEEK = $DAY * 7;
+const string $PREFIX = "pre_" + "fix";
+const double $RATIO = 1.5;
+const int $SHADOWED = 1;
+const float $WIDENED = 2;
+
+function shadow(int $SHADOWED) int {
+    return $SHADOWED;
+}
+
+function week() int {
+    return $WEEK;
+}
+
+printnl("a", $DAY, " ", week(), " ", $PREFIX, " ", $RATIO * 2, " ", -$DAY, " ", !true);
+printnl("b", Color.RED, " ", Color.GREEN, " ", Color.BLUE, " ", "$PREFIX-${DAY}");
+printnl("c", shadow(7), " ", $SHADOWED, " ", $WIDENED);
+
+string $s = "";
+for (int $i = 0; $i < 3; $i++) {
+    string $t = "x" + "y";
+    $t = $t + $i;
+    $s = $s + $t + ",";
+}
+printnl("d", $s);
+
+if (1 < 2) {
+    printnl("e", "taken");
+} else {
+    printnl("e", "NOT REACHED");
+}
+if (false) {
+    printnl("NOT REACHED");
+}
+string $picked = true ? "then" : "else";
+printnl("f", $picked);
+
+try {
+    int $z = 1 / 0;
+} catch (string $e) {
+    printnl("g", $e);
+}
+
+// A reference is inlined only where its declaration has run: a function called before it
+// fails to find the constant, with or without the optimizer, and so does an early read.
+function late() int {
+    return $LATE;
+}
+
+try {
+    printnl(late());
+} catch (string $e) {
+    printnl("h", string_contains($e, "Identifier 'LATE' not found"));
+}
+try {
+    printnl(Shade.DARK);
+} catch (string $e) {
+    printnl("h", string_contains($e, "Enum 'Shade' not found"));
+}
+
+const int $LATE = 5;
+enum Shade {
+    LIGHT,
+    DARK
+};
+printnl("i", late(), " ", Shade.DARK);
+printnl("done");
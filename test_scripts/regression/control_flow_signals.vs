@@ -0,0 +1,119 @@
+// Regression: break, continue and return are handed up as statement results instead of
+// being thrown. Each case below leaves through a different mix of enclosing statements;
+// the caller's variables must still be in scope afterwards, so a return that skipped a
+// loop's scope exit would show up as a wrong or missing value.
+// Expected: clean exit 0.
+
+// --- return from two nested loops ---
+function firstPair(int $target) int {
+    for (int $a = 0; $a < 10; $a++) {
+        int $b = 0;
+        while ($b < 10) {
+            if ($a * $b == $target) {
+                return $a * 10 + $b;
+            }
+            $b++;
+        }
+    }
+    return -1;
+}
+int $outer = 7;
+printnl("a", firstPair(12), " ", firstPair(1000), " ", $outer);   // a26 -1 7
+
+// --- return from a for-each, inside a switch ---
+function pick(string[] $items) string {
+    for (string $it : $items) {
+        switch ($it) {
+            case "skip":
+                continue;
+            case "stop":
+                return "stopped";
+            default:
+                printnl("b", $it);
+        }
+    }
+    return "end";
+}
+printnl(pick(["x", "skip", "y", "stop", "z"]));                    // bx by stopped
+printnl(pick(["q"]));                                              // bq end
+
+// --- break in a switch ends the switch, not the loop ---
+int $hits = 0;
+for (int $i = 0; $i < 4; $i++) {
+    switch ($i) {
+        case 1:
+            break;
+        default:
+            $hits++;
+    }
+}
+printnl("c", $hits);                                               // c3
+
+// --- return from try and from catch ---
+function guarded(int $x) int {
+    try {
+        if ($x > 0) {
+            return $x;
+        }
+        throw "negative";
+    } catch (string $e) {
+        return -100;
+    }
+    return 0;
+}
+printnl("d", guarded(5), " ", guarded(-5));                        // d5 -100
+
+// --- break out of a loop inside a try ---
+int $spins = 0;
+while (true) {
+    try {
+        $spins++;
+        if ($spins == 3) {
+            break;
+        }
+    } catch (string $e) {
+        printnl("NOT REACHED");
+    }
+}
+printnl("e", $spins);                                              // e3
+
+// --- early return from a method, and from a constructor ---
+class Counter {
+    public:
+        int $n = 0;
+
+    function construct(int $start) {
+        if ($start < 0) {
+            return;
+        }
+        $this->n = $start;
+    }
+
+    function below(int $limit) bool {
+        for (int $i = 0; $i < $this->n; $i++) {
+            if ($i >= $limit) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+Counter $c = new Counter(5);
+Counter $z = new Counter(-1);
+printnl("f", $c->below(10), " ", $c->below(2), " ", $z->n);        // ftrue false 0
+
+// --- recursion returning from inside a loop ---
+// A thrown return skipped the loop's scope exit, so the next call resolved names from
+// inside a stale loop scope: "Function not found: depth".
+function depth(int $n) int {
+    for (int $i = 0; $i < 2; $i++) {
+        if ($n == 0) {
+            return 0;
+        }
+        return depth($n - 1) + 1;
+    }
+    return -1;
+}
+printnl("g", depth(50));                                           // g50
+
+printnl("done");
@@ -0,0 +1,43 @@
+// Function arguments are copy-on-write: the callee shares the caller's object payload
+// until it writes. Every write below must stay inside the callee.
+function touch(object $p) int {
+    $p[0] = 100;
+    $p[] = 7;
+    return sizeof($p);
+}
+function nested(object $p) int {
+    $p[1][0] = 99;
+    return $p[1][0];
+}
+function member(object $o) int {
+    $o->inner->v = 5;
+    return $o->inner->v;
+}
+function loop(object $rows) int {
+    for (string $k, object $r : $rows) {
+        $r->n = 0;
+    }
+    return 0;
+}
+function pick(object $rows) int {
+    object $r = $rows[0];
+    $r->n = 42;
+    return $r->n;
+}
+
+int[] $a = [1, 2, 3];
+printnl(touch($a), " ", sizeof($a), " ", $a[0]);    // 4 3 1
+
+object $n = [[1, 2], [3, 4]];
+printnl(nested($n), " ", $n[1][0]);                 // 99 3
+
+object $o = {};
+$o->inner = {};
+$o->inner->v = 1;
+printnl(member($o), " ", $o->inner->v);             // 5 1
+
+object $rows = [{n: 1}, {n: 2}];
+int $z = loop($rows);
+printnl($rows[0]->n, " ", $rows[1]->n);             // 1 2
+printnl(pick($rows), " ", $rows[0]->n);             // 42 1
+printnl("cow-done");
@@ -0,0 +1,31 @@
+// Arrays are held as a dense vector until something needs map semantics. Guards the
+// vector paths (index read/write, append, for-in order, json round trip) and the
+// promotion to a map when a non-sequential key is written.
+
+// --- build by appending, read back past index 9 (the map ordered "10" < "2") ---
+int[] $a = [];
+for (int $i = 0; $i < 12; $i++) {
+    $a[] = $i * 10;
+}
+printnl(sizeof($a), " ", $a[11], " ", $a["10"]);   // 12 110 100
+
+string $order = "";
+for (string $k, int $v : $a) {
+    $order = $order + $k + ",";
+}
+printnl($order);                                   // 0,1,...,11,
+
+// --- overwrite in place, write at size appends ---
+$a[0] = 5;
+$a[12] = 120;
+printnl($a[0], " ", sizeof($a));                   // 5 13
+
+// --- json round trip keeps the list shape ---
+printnl(json_encode(json_decode("[1,[2,3],{\"k\":4}]")));
+
+// --- a non-sequential key promotes to a map and keeps every element ---
+int[] $b = [1, 2, 3];
+$b[7] = 8;
+printnl(sizeof($b), " ", $b[2], " ", $b[7]);       // 4 3 8
+printnl(json_encode($b));
+printnl("dense-done");
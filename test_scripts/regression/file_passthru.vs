@@ -0,0 +1,31 @@
+// file_passthru() writes a file, or a byte range of it, to the output and returns the number
+// of bytes written; inside ob_start() the bytes are collected like any other output.
+// Expected: the lines below in order.
+
+string $path = "/tmp/voidscript_file_passthru.txt";
+file_put_contents($path, "0123456789\n", true);
+
+printnl("before");
+int $all = file_passthru($path);
+printnl("all: ", $all);
+int $range = file_passthru($path, 3, 4);
+printnl("");
+printnl("range: ", $range);
+printnl("past end: ", file_passthru($path, 100));
+
+string $big = "0123456789abcdef";
+for (int $i = 0; $i < 14; $i++) {
+    $big = $big + $big;
+}
+file_put_contents($path, $big, true);
+ob_start();
+int $written = file_passthru($path, 1);
+string $captured = ob_get_clean();
+printnl("buffered: ", $written, " ", $captured == string_substr($big, 1, $written));
+
+try {
+    file_passthru($path, -1);
+} catch (string $e) {
+    printnl("negative: ", string_contains($e, "must not be negative"));
+}
+file_unlink($path);
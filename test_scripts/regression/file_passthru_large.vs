@@ -0,0 +1,14 @@
+// file_passthru() of a file of 2 GiB or more: the count would not fit the int it returns,
+// so the call throws before writing anything. The test passes a sparse 3 GiB file.
+// Expected: "refused: true", then "range: 3" after three bytes of the file.
+
+string $path = $argv[1];
+try {
+    int $written = file_passthru($path);
+    printnl("returned: ", $written);
+} catch (string $e) {
+    printnl("refused: ", string_contains($e, "2 GiB or more"));
+}
+int $range = file_passthru($path, 5, 3);
+printnl("");
+printnl("range: ", $range);
@@ -0,0 +1,90 @@
+// Hot functions tier up to native code when run with --jit=N. Whether a call runs native
+// or interpreted depends on when the background compile finishes, so every result here
+// must be the same either way, including the errors a native call hands back to the
+// interpreter to report.
+// Expected: clean exit 0.
+
+function fib(int $n) int {
+    if ($n < 2) {
+        return $n;
+    }
+    return fib($n - 1) + fib($n - 2);
+}
+
+function mix(int $count, double $step, float $scale) double {
+    double $acc = 0.0;
+    for (int $i = 0; $i < $count; $i++) {
+        if ($i % 2 == 0) {
+            $acc = $acc + $step * $i;
+        } else {
+            $acc = $acc - $scale;
+        }
+    }
+    return $acc;
+}
+
+function inRange(int $x, int $lo, int $hi) bool {
+    return $x >= $lo && $x <= $hi;
+}
+
+function ratio(int $a, int $b) int {
+    return $a / $b;
+}
+
+// Reads a global: never compiled, always sees the current value.
+int $offset = 1;
+function shifted(int $x) int {
+    return $x + $offset;
+}
+
+int $sum = 0;
+for (int $k = 0; $k < 200; $k++) {
+    $sum = $sum + fib(10);
+}
+printnl("a", $sum, " ", fib(20));                                   // a11000 6765
+
+double $acc = 0.0;
+for (int $k = 0; $k < 200; $k++) {
+    $acc = $acc + mix(7, 0.5, 1.5);
+}
+printnl("b", $acc);                                                 // b300.000000
+
+int $hits = 0;
+for (int $k = 0; $k < 300; $k++) {
+    if (inRange($k, 10, 19)) {
+        $hits++;
+    }
+}
+printnl("c", $hits);                                                // c10
+
+int $q = 0;
+for (int $k = 0; $k < 300; $k++) {
+    $q = $q + ratio($k, 7);
+}
+printnl("d", $q);                                                   // d6279
+
+// A native division by zero is reported by the interpreter, at the same place.
+for (int $k = 0; $k < 3; $k++) {
+    try {
+        printnl(ratio(5, 0));
+        printnl("NOT REACHED");
+    } catch (string $e) {
+        printnl("e", $e);
+    }
+}
+
+// Arguments of another type than declared are bound as they are, by the interpreter.
+try {
+    printnl(ratio(7.5, 2));
+} catch (string $e) {
+    printnl("f", $e);
+}
+
+int $t = 0;
+for (int $k = 0; $k < 100; $k++) {
+    $t = $t + shifted($k);
+    $offset = 2;
+}
+printnl("g", $t);                                                   // g5149
+
+printnl("done");
@@ -0,0 +1,69 @@
+// Function locals are bound to frame slots after parsing. Each case below is one where
+// a slot must either hold the right symbol or fall back to the dynamic name lookup.
+function sum(int $n) int {
+    int $total = 0;
+    for (int $i = 1; $i <= $n; $i++) {
+        $total += $i;
+    }
+    return $total;
+}
+
+// Recursion: every call has its own frame.
+function fact(int $n) int {
+    if ($n <= 1) {
+        return 1;
+    }
+    int $rest = fact($n - 1);
+    return $n * $rest;
+}
+
+// A loop variable shadows the local of the same name inside the loop only.
+function shadow() string {
+    string $v = "outer";
+    string $seen = "";
+    object $items = ["a", "b"];
+    for (string $k, string $v : $items) {
+        $seen = $seen + $v;
+    }
+    return $seen + " " + $v;
+}
+
+// Read before the local is declared: the caller's variable is visible.
+function early() int {
+    int $before = $g;
+    int $g = 5;
+    return $before * 10 + $g;
+}
+
+// A catch variable joins the frame without a declaration.
+function caught() string {
+    string $msg = "none";
+    try {
+        throw "boom";
+    } catch ($e) {
+        $msg = $e;
+    }
+    return $msg;
+}
+
+// An error thrown through a call leaves the caller's frame in place.
+function fail(int $x) int {
+    throw "inner " + $x;
+}
+function survive(int $x) string {
+    string $r = "";
+    try {
+        fail(7);
+    } catch ($err) {
+        $r = $err;
+    }
+    return $r + " " + $x;
+}
+
+int $g = 3;
+printnl(sum(10), " ", fact(6));     // 55 720
+printnl(shadow());                  // ab outer
+printnl(early());                   // 35
+printnl(caught());                  // boom
+printnl(survive(2));                // inner 7 2
+printnl("slots-done");
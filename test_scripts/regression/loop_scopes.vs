@@ -0,0 +1,71 @@
+// Loop scopes are entered without rebuilding their names, and the variables a loop
+// declares live in slots of its scope. Shadowing must stay that of the name lookup: a
+// loop variable hides the function's variable of the same name only once declared.
+// Expected: clean exit 0.
+
+function nested(int $n) int {
+    int $x = 100;
+    int $sum = 0;
+    for (int $i = 0; $i < $n; $i++) {
+        $sum = $sum + $x;
+        int $x = $i;
+        $sum = $sum + $x;
+        for (int $i = 0; $i < 2; $i++) {
+            $sum = $sum + $i + $x;
+        }
+        while ($x < 3) {
+            int $y = $x * 10;
+            $x = $x + 1;
+            $sum = $sum + $y;
+        }
+    }
+    return $sum + $x;
+}
+
+function keys(object $items) string {
+    string $out = "";
+    for (int $k, auto $v : $items) {
+        $out = $out + $k + "=" + $v + ";";
+        for (string $kk, auto $vv : $items) {
+            $out = $out + $kk;
+        }
+    }
+    for (auto $v : $items) {
+        $out = $out + $v;
+    }
+    return $out;
+}
+
+// An int key over a dense array is the index itself.
+function weighted(object $items) int {
+    int $t = 0;
+    for (int $k, auto $v : $items) {
+        $t = $t + $k * $v;
+    }
+    return $t;
+}
+
+// Keys are bound the same way whether the array is stored dense or as a map: an int key
+// gets every index as an int, a string key gets strings.
+function keyTypes(object $items) string {
+    string $out = "";
+    for (int $k, auto $v : $items) {
+        $out = $out + typeof($k) + ":" + $k + ",";
+    }
+    for (string $s, auto $v : $items) {
+        $out = $out + typeof($s) + ",";
+    }
+    return $out;
+}
+
+object $named = { string a: 1, string b: 2 };
+
+printnl("a", nested(4));
+printnl("b", keys([5, 6, 7]));
+printnl("c", keys($named));
+printnl("d", weighted([10, 20, 30]));
+object $dense = [10, 20, 30];
+printnl("e", keyTypes($dense));
+$dense["x"] = 5;
+printnl("f", keyTypes($dense));
+printnl("done");
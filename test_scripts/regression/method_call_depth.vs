@@ -2,8 +2,8 @@
 // was incremented on entry but not decremented on several return paths (native methods,
 // comparison methods). It therefore measured cumulative calls, not nesting depth, so a
 // program that made more than ~100 method calls TOTAL aborted with a bogus
-// "Infinite loop detected in method calls". A DepthGuard RAII object now restores it on
-// every exit path.
+// "Infinite loop detected in method calls". Method calls are now bounded like function
+// calls, by the native stack they use.
 // Expected: clean exit 0.
 
 class Counter {
@@ -11,6 +11,12 @@ class Counter {
     public:
         function bump() { $this->n = $this->n + 1; }
         function value() int { return $this->n; }
+        function depth(int $n) int {
+            if ($n == 0) {
+                return 0;
+            }
+            return 1 + $this->depth($n - 1);
+        }
 }
 
 Counter $c = new Counter();
@@ -20,5 +26,13 @@ for (int $i = 0; $i < 500; $i++) {
 }
 printnl($c->value());           // 500
 
-// genuine deep recursion must still be caught, not silently allowed
+// Recursion deeper than the old ceiling of 100 runs...
+printnl($c->depth(1000));       // 1000
+
+// ...and genuine runaway recursion must still be caught, not crash.
+try {
+    $c->depth(10000000);
+} catch (string $e) {
+    printnl(string_contains($e, "Maximum call depth exceeded"));
+}
 printnl("done");
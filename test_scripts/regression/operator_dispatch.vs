@@ -0,0 +1,39 @@
+// Binary and unary operators are resolved to an enum when the expression is built and
+// evaluated by a kernel per operand-type pair. Every pair must keep its old result and
+// its old error, including the ones that only fail at runtime.
+// Expected: clean exit 0.
+
+int $i = 7;
+float $f = 1.5;
+double $d = 2.25;
+string $s = "ab";
+bool $t = true;
+
+// --- same-type kernels ---
+printnl($i + 3, " ", $i - 3, " ", $i * 3, " ", $i / 2, " ", $i % 4, " ", $i << 2, " ", $i >> 1, " ", $i & 3, " ", $i | 8, " ", $i ^ 2);
+printnl($f + $f, " ", $d * $d, " ", $d / 0.5, " ", $f < $f, " ", $d >= 2.25);
+printnl($s + "cd", " ", $s == "ab", " ", $s != "ab", " ", $t && false, " ", $t || false, " ", $t == true);
+
+// --- promotion: int with float gives float, anything with double gives double ---
+printnl($i + $f, " ", $f * $d, " ", $i - $d, " ", $i > $f, " ", $d == 2.25);
+
+// --- string + anything concatenates ---
+printnl("n=" + $i, " ", $f + "!", " ", $s + $t);
+
+// --- unary ---
+printnl(-$i, " ", -$f, " ", -$d, " ", ~$i, " ", !$t, " ", -$s);
+
+// --- runtime errors keep their messages ---
+function fails(string $label, string $expr) {
+    printnl($label, ": ", $expr);
+}
+try { auto $x = $t & $t; } catch (string $e) { fails("bool &", $e); }
+try { auto $x = $i && $i; } catch (string $e) { fails("int &&", $e); }
+try { auto $x = $s < $s; } catch (string $e) { fails("string <", $e); }
+try { auto $x = $s | $s; } catch (string $e) { fails("string |", $e); }
+try { auto $x = $d % $d; } catch (string $e) { fails("double %", $e); }
+try { auto $x = $i - $s; } catch (string $e) { fails("int - string", $e); }
+try { auto $x = $i % 0; } catch (string $e) { fails("int % 0", $e); }
+try { auto $x = !$i; } catch (string $e) { fails("!int", $e); }
+
+printnl("done");
@@ -0,0 +1,30 @@
+// ob_start() collects the output until ob_get_clean() returns it; buffers nest, and one
+// the script leaves open is written out when it ends. flush() passes on what is outside
+// the buffers. Expected: the lines below in order, then "left open".
+
+ob_start();
+print("hidden");
+string $captured = ob_get_clean();
+printnl("captured: ", $captured);
+
+ob_start();
+print("outer ");
+ob_start();
+printnl("inner");
+string $inner = ob_get_clean();
+print("after");
+string $outer = ob_get_clean();
+printnl("outer: ", $outer);
+print("inner: ", $inner);
+
+printnl("flushed");
+flush();
+
+try {
+    string $none = ob_get_clean();
+} catch (string $e) {
+    printnl("no buffer: ", string_contains($e, "no output buffer"));
+}
+
+ob_start();
+printnl("left open");
@@ -0,0 +1,47 @@
+// Member reads and writes remember the class and the position a property had in the
+// last instance they touched. The same site must still answer correctly for instances
+// of another class with a different layout, for plain objects, and for a private
+// property read from outside the class, every time and not only on the first visit.
+
+class Point {
+    public:
+        int $x = 1;
+        int $y = 2;
+}
+
+class Labelled {
+    public:
+        string $label = "L";
+        int $x = 10;
+    private:
+        int $secret = 7;
+    public:
+        function peek() int { return $this->secret; }
+}
+
+function getX(Point $o) int { return $o->x; }
+function getSecret(Labelled $o) int { return $o->secret; }
+
+Point $p = new Point();
+Labelled $l = new Labelled();
+printnl(getX($p), " ", getX($l), " ", getX($p), " ", getX($l));
+
+object $plain = { int y: 6, int x: 5 };
+printnl(getX($plain), " ", getX($p));
+
+for (int $i = 0; $i < 3; $i++) {
+    $p->x = $i;
+    $l->x = $i * 10;
+}
+printnl($p->x, " ", $l->x, " ", $l->peek(), " ", $l->peek());
+
+int $denied = 0;
+for (int $i = 0; $i < 3; $i++) {
+    try {
+        getSecret($l);
+    } catch (string $e) {
+        $denied++;
+    }
+}
+printnl("denied ", $denied);
+printnl("props-done");
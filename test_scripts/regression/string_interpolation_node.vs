@@ -0,0 +1,30 @@
+// An interpolated string is built in one piece by InterpolatedStringNode. Every value must
+// read as it does with '+': numbers as std::to_string writes them, objects as toString().
+// A null reads "null" and keeps the text around it.
+// Expected: clean exit 0.
+
+int $i = -42;
+double $d = 3.25;
+float $f = 1.5;
+bool $b = false;
+string $s = "str";
+object $o = { string name: "box", int count: 3 };
+
+printnl("a$i|$d|$f|$b|$s|");
+printnl("b${o->name} has ${o->count} items, \$literal and 100% $ too");
+printnl("c$i");
+
+string $n = NULL;
+printnl("dn=$n end");
+
+string $page = "";
+for (int $k = 0; $k < 3; $k++) {
+    $page = "$page<li>$k:${o->name}</li>";
+}
+printnl("e$page");
+
+double $big = 1e300;
+string $wide = "$big";
+printnl("f" + string_length($wide));
+
+printnl("done");
@@ -0,0 +1,61 @@
+// A switch whose case labels are all constants dispatches through a table built on its
+// first run. Fallthrough, duplicate labels, enum members and the errors of a label of the
+// wrong type must stay those of comparing the labels in order.
+// Expected: clean exit 0.
+
+enum Method {
+    GET = 1,
+    POST = 2,
+    DELETE = 3
+};
+
+function route(string $path) string {
+    string $out = "";
+    switch ($path) {
+        case "/": $out = $out + "root";
+        case "/index": $out = $out + "+index"; break;
+        case "/about": $out = $out + "about"; break;
+        case "/": $out = "NOT REACHED"; break;
+        default: $out = $out + "404";
+    }
+    return $out;
+}
+
+function verb(int $m) string {
+    switch ($m) {
+        case Method.GET: return "get";
+        case Method.POST: return "post";
+        case 7: return "seven";
+    }
+    return "other";
+}
+
+// The int label comes before the match: the ordered comparison reports it.
+function mixed(string $s) string {
+    switch ($s) {
+        case "a": return "a";
+        case 2: return "NOT REACHED";
+        case "b": return "b";
+    }
+    return "none";
+}
+
+// Labels that are not constants keep the ordered comparison.
+string $dynamic = "/about";
+function byVariable(string $path) string {
+    switch ($path) {
+        case $dynamic: return "dynamic";
+        default: return "static";
+    }
+}
+
+printnl("a", route("/"), " ", route("/index"), " ", route("/about"), " ", route("/x"));
+printnl("b", verb(1), " ", verb(2), " ", verb(3), " ", verb(7));
+printnl("c", mixed("a"));
+try {
+    printnl(mixed("b"));
+} catch (string $e) {
+    printnl("d", $e);
+}
+printnl("e", byVariable("/about"), " ", byVariable("/"));
+printnl("done");
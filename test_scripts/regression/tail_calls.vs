@@ -0,0 +1,144 @@
+// A `return f(...)` in tail position reuses the caller's frame, so recursion that only
+// recurses there runs in constant memory, from loop bodies too. Whatever the callee could see
+// of the caller (its locals and loop variables, a try around the return) keeps the ordinary
+// call; errors carry every call site they unwind through, and too deep a recursion is one.
+// Expected: clean exit 0.
+
+function down(int $n, int $acc) int {
+    if ($n == 0) {
+        return $acc;
+    }
+    return down($n - 1, $acc + 1);
+}
+
+function isEven(int $n) bool {
+    if ($n == 0) {
+        return true;
+    }
+    return isOdd($n - 1);
+}
+
+function isOdd(int $n) bool {
+    if ($n == 0) {
+        return false;
+    }
+    return isEven($n - 1);
+}
+
+function countdown(int $n) int {
+    while ($n > 0) {
+        return countdown($n - 1);
+    }
+    return 42;
+}
+
+// $k is the caller's own variable: the call is made, not handed over.
+function local(int $n) int {
+    int $k = $n * 2;
+    if ($n == 0) {
+        return $k;
+    }
+    return local($n - 1);
+}
+
+function boom(int $n) int {
+    if ($n == 0) {
+        return 1 / $n;
+    }
+    return boom($n - 1);
+}
+
+function guarded(int $n) int {
+    try {
+        return boom($n);
+    } catch (string $e) {
+        return -1;
+    }
+}
+
+function label(int $n) string {
+    return "n=" + $n;
+}
+
+function wrongType(int $n) int {
+    if ($n == 0) {
+        return label($n);
+    }
+    return wrongType($n - 1);
+}
+
+printnl("a", down(1000000, 0));
+printnl("b", isEven(100000), " ", isOdd(7));
+printnl("c", countdown(10000), " ", local(3));
+printnl("d", guarded(3));
+try {
+    printnl(boom(2));
+} catch (string $e) {
+    printnl("e", $e);
+}
+try {
+    printnl(wrongType(1));
+} catch (string $e) {
+    printnl("f", $e);
+}
+
+// A loop scope holding nothing the callee could see is handed over like the frame...
+function viaLoop(int $n) int {
+    while ($n >= 0) {
+        if ($n == 0) {
+            return 7;
+        }
+        return viaLoop($n - 1);
+    }
+    return -1;
+}
+
+// ...but a loop variable the callee reads keeps the ordinary call, as a local does.
+function peek() int {
+    return $i;
+}
+
+function peekLoop() int {
+    for (int $i = 7; $i < 8; $i++) {
+        return peek();
+    }
+    return -1;
+}
+
+// Recursion outside tail position stops with a runtime error, not a crash, once the native
+// stack is nearly full; loop scopes on the way do not count as calls.
+function deep(int $n) int {
+    if ($n == 0) {
+        return 0;
+    }
+    return 1 + deep($n - 1);
+}
+
+function walk(int $n) int {
+    if ($n == 0) {
+        return 0;
+    }
+    int $sum = 0;
+    for (int $k = 0; $k < 1; $k++) {
+        $sum = $sum + walk($n - 1);
+    }
+    return $sum + 1;
+}
+
+printnl("g", viaLoop(100000), " ", peekLoop());
+for (int $j = 0; $j < 2; $j++) {
+    try {
+        printnl(deep(100000));
+    } catch (string $e) {
+        printnl("h", string_contains($e, "Maximum call depth exceeded"));
+    }
+}
+printnl("i", deep(3000), " ", walk(2500));
+
+// However deep the error is raised, its message names each site once, with a count.
+try {
+    printnl(boom(200000));
+} catch (string $e) {
+    printnl("j", string_contains($e, "line: 48, column: 16 (×200000) << : "), " ", string_length($e) < 400);
+}
+printnl("done");
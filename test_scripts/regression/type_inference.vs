@@ -0,0 +1,51 @@
+// Regression: conditions and declarations the type checker proves skip their runtime
+// checks. Whatever was proven, results must match the checked path, and anything not
+// proven - a variable read, a null - must still be checked.
+// Expected: clean exit 0.
+
+// --- proven boolean conditions: unboxed comparisons of ints, doubles, floats ---
+int $n = 0;
+for (int $i = 0; $i < 5; $i++) {
+    $n = $n + $i;
+}
+double $d = 0.5;
+while ($d < 4.0) {
+    $d = $d * 2.0;
+}
+float $f = 1.5;
+if ($f >= 1.5 && $f != 2.0) {
+    printnl("a", $n, " ", $d);                                    // a10 4.000000
+}
+
+// --- a null operand still compares through the kernels ---
+int $k = NULL;
+if ($k < 3) {
+    printnl("NOT REACHED");
+} else {
+    printnl("b", $k == NULL);                                      // btrue
+}
+
+// --- proven initialisers, with and without the declared type ---
+int    $sum   = 1 + 2 * 3;
+float  $wide  = 1.5 * 2.0;
+auto   $label = "n=" + 4;
+bool   $flag  = !(1 > 2);
+printnl("c", $sum, " ", $wide, " ", typeof($wide), " ", $label, " ", $flag);   // c7 3.000000 float n=4 true
+
+// --- conditions that are not proven keep their runtime check ---
+try {
+    if ($n) {
+        printnl("NOT REACHED");
+    }
+} catch (string $e) {
+    printnl("d", $e);
+}
+try {
+    while ($n + 1) {
+        printnl("NOT REACHED");
+    }
+} catch (string $e) {
+    printnl("e", $e);
+}
+
+printnl("done");
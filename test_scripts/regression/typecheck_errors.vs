@@ -0,0 +1,13 @@
+// Regression: with --typecheck, type errors the checker proves are reported before the
+// script starts, including those in code that would never run.
+// Expected: exit 1, four diagnostics, nothing printed by the script.
+
+printnl("NOT REACHED");
+
+function never() {
+    int $n = "seven";
+    while (1) {
+    }
+    auto $x = "a" - 1;
+    bool $b = !5;
+}
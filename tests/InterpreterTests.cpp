@@ -0,0 +1,52 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <memory>
+#include <string>
+
+#include "Interpreter/Interpreter.hpp"
+#include "Interpreter/Nodes/Statement/BreakNode.hpp"
+#include "Interpreter/Nodes/Statement/ContinueNode.hpp"
+#include "Interpreter/OperationContainer.hpp"
+#include "Symbols/SymbolContainer.hpp"
+
+using namespace Interpreter::Nodes::Statement;
+
+namespace {
+
+// Run the operations queued in the current scope; returns the error the run raised, or an
+// empty string.
+std::string runError() {
+    try {
+        Interpreter::Interpreter interpreter;
+        interpreter.run();
+    } catch (const Interpreter::Exception & e) {
+        return e.what();
+    }
+    return "";
+}
+
+}  // namespace
+
+TEST_CASE("Stray break and continue at the top level", "[Interpreter]") {
+    SECTION("break is a runtime error") {
+        Symbols::SymbolContainer::initialize("stray_break_scope");
+        const std::string ns = Symbols::SymbolContainer::instance()->currentScopeName();
+        Operations::Container::instance()->add(
+            ns, Operations::Operation{ Operations::Type::Block, "", std::make_unique<BreakNode>("stray.vs", 3, 5) });
+
+        const std::string error = runError();
+        REQUIRE(error.find("'break' outside of a loop or switch") != std::string::npos);
+        REQUIRE(error.find("stray.vs\" at line: 3") != std::string::npos);
+        Operations::Container::instance()->clear(ns);
+    }
+
+    SECTION("continue is a runtime error") {
+        Symbols::SymbolContainer::initialize("stray_continue_scope");
+        const std::string ns = Symbols::SymbolContainer::instance()->currentScopeName();
+        Operations::Container::instance()->add(
+            ns, Operations::Operation{ Operations::Type::Block, "", std::make_unique<ContinueNode>("stray.vs", 7, 1) });
+
+        REQUIRE(runError().find("'continue' outside of a loop") != std::string::npos);
+        Operations::Container::instance()->clear(ns);
+    }
+}
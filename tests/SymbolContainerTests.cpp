@@ -120,4 +120,57 @@ TEST_CASE("SymbolContainer class operations", "[SymbolContainer]") {
         container->addMethod("TestClass", "test_method", Variables::Type::INTEGER);
         REQUIRE(container->hasMethod("TestClass", "test_method"));
     }
-}
\ No newline at end of file
+
+    SECTION("A child class dispatches its own and inherited methods") {
+        container->registerClass("DispatchBase");
+        container->addNativeMethod("DispatchBase", "who", [](const std::vector<ValuePtr> &) { return ValuePtr("base"); });
+        container->addNativeMethod("DispatchBase", "only_base", [](const std::vector<ValuePtr> &) { return ValuePtr(1); },
+                                   Variables::Type::INTEGER, {}, true);
+        container->registerClass("DispatchChild", "DispatchBase");
+        container->addNativeMethod("DispatchChild", "who", [](const std::vector<ValuePtr> &) { return ValuePtr("child"); });
+
+        std::vector<ValuePtr> args;
+        REQUIRE(container->callMethod("DispatchChild", "who", args).get<std::string>() == "child");
+        REQUIRE(container->callMethod("DispatchBase", "who", args).get<std::string>() == "base");
+        REQUIRE(container->callMethod("DispatchChild", "only_base", args).get<int>() == 1);
+        REQUIRE(container->isMethodPrivate("DispatchChild", "only_base"));
+        REQUIRE(container->getMethodReturnType("DispatchChild", "only_base") == Variables::Type::INTEGER);
+        REQUIRE(container->findMethodEntry("DispatchChild", "only_base")->owner->name == "DispatchBase");
+        REQUIRE_FALSE(container->hasMethod("DispatchBase", "never_defined"));
+
+        // A method added to the parent later reaches the child's table too
+        container->addNativeMethod("DispatchBase", "late", [](const std::vector<ValuePtr> &) { return ValuePtr(2); });
+        REQUIRE(container->callMethod("DispatchChild", "late", args).get<int>() == 2);
+    }
+}
+
+TEST_CASE("Atom interning", "[SymbolContainer]") {
+    SECTION("Equal strings share one atom") {
+        const Atom a = AtomTable::intern("atom_test_name");
+        REQUIRE(AtomTable::intern(std::string("atom_test_") + "name") == a);
+        REQUIRE(AtomTable::find("atom_test_name") == a);
+        REQUIRE(AtomTable::name(a) == "atom_test_name");
+        REQUIRE(AtomTable::intern("") == 0);
+    }
+
+    SECTION("Looking up an unknown string does not intern it") {
+        const size_t before = AtomTable::size();
+        REQUIRE(AtomTable::find("atom_test_never_defined") == kNoAtom);
+        REQUIRE(AtomTable::size() == before);
+    }
+
+    SECTION("Symbol tables resolve by string and by atom alike") {
+        SymbolTable table;
+        auto        var = std::make_shared<VariableSymbol>("atom_var", ValuePtr(7), "atom_scope",
+                                                             Variables::Type::INTEGER);
+        table.define(SymbolContainer::DEFAULT_VARIABLES_SCOPE, var);
+
+        REQUIRE(table.get(SymbolContainer::DEFAULT_VARIABLES_SCOPE, "atom_var") == var);
+        REQUIRE(table.get(SymbolContainer::variablesAtom(), var->nameAtom()) == var);
+        REQUIRE(table.get(SymbolContainer::DEFAULT_CONSTANTS_SCOPE, "atom_var") == nullptr);
+        REQUIRE(table.listAll(SymbolContainer::DEFAULT_VARIABLES_SCOPE).size() == 1);
+
+        table.clear(SymbolContainer::DEFAULT_VARIABLES_SCOPE);
+        REQUIRE_FALSE(table.exists(SymbolContainer::DEFAULT_VARIABLES_SCOPE, "atom_var"));
+    }
+}
@@ -0,0 +1,58 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "Interpreter/Output.hpp"
+#include "TemplateCache.hpp"
+#include "VoidScript.hpp"
+
+namespace {
+
+void writeFile(const std::filesystem::path & path, const std::string & content) {
+    std::ofstream out(path, std::ios::trunc);
+    out << content;
+}
+
+// One run of @p path from the template cache, as voidscript-fcgi runs a request; returns
+// what the script printed.
+std::string runCached(const std::filesystem::path & path) {
+    std::ostringstream body;
+    std::ostringstream errors;
+    {
+        Interpreter::Output::Redirect redirect(body, errors);
+        VoidScript                    voidscript(path.string(), false, false, false, false, /*enableTags=*/true);
+        voidscript.setTemplateCacheEnabled(true);
+        REQUIRE(voidscript.run() == 0);
+    }
+    REQUIRE(errors.str().empty());
+    return body.str();
+}
+
+}  // namespace
+
+TEST_CASE("A cached template is parsed again when a file it includes changes", "[TemplateCache]") {
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "voidscript_template_cache_test";
+    std::filesystem::create_directories(dir);
+    const std::filesystem::path page = dir / "page.vs";
+    writeFile(page, "<p><?void include \"part.vs\"; ?></p>\n");
+    writeFile(dir / "part.vs", "print(\"part 1\");\n");
+
+    auto &     cache  = TemplateCache::instance();
+    const auto misses = cache.misses();
+    const auto hits   = cache.hits();
+
+    REQUIRE(runCached(page) == "<p>part 1</p>\n");
+    REQUIRE(runCached(page) == "<p>part 1</p>\n");
+    REQUIRE(cache.misses() == misses + 1);
+    REQUIRE(cache.hits() == hits + 1);
+
+    // A different size is a different file, whatever the clock's resolution.
+    writeFile(dir / "part.vs", "print(\"part 22\");\n");
+    REQUIRE(runCached(page) == "<p>part 22</p>\n");
+    REQUIRE(cache.misses() == misses + 2);
+
+    std::filesystem::remove_all(dir);
+}